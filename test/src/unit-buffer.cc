@@ -34,6 +34,7 @@
 #include "tiledb/sm/buffer/buffer.h"
 
 #include <catch.hpp>
+#include <cstring>
 #include <iostream>
 
 using namespace tiledb::sm;
@@ -96,3 +97,32 @@ TEST_CASE("Buffer: Test default constructor with write void*", "[buffer]") {
 
   delete buff;
 }
+
+TEST_CASE("Buffer: Test write_fill and write_offsets", "[buffer]") {
+  Status st;
+  Buffer buff;
+
+  // Fill sizes with a fixed-width kernel and an arbitrary size
+  int32_t v4 = -7;
+  st = buff.write_fill(&v4, sizeof(v4), 33);
+  REQUIRE(st.ok());
+  CHECK(buff.size() == 33 * sizeof(v4));
+  for (uint64_t i = 0; i < 33; ++i)
+    CHECK(buff.value<int32_t>(i * sizeof(v4)) == v4);
+
+  char v3[3] = {'a', 'b', 'c'};
+  st = buff.write_fill(v3, sizeof(v3), 17);
+  REQUIRE(st.ok());
+  CHECK(buff.size() == 33 * sizeof(v4) + 17 * sizeof(v3));
+  auto data = (char*)buff.data(33 * sizeof(v4));
+  for (uint64_t i = 0; i < 17; ++i)
+    CHECK(!std::memcmp(data + i * sizeof(v3), v3, sizeof(v3)));
+
+  // Offsets
+  Buffer offsets;
+  st = offsets.write_offsets(10, 4, 5);
+  REQUIRE(st.ok());
+  CHECK(offsets.size() == 5 * sizeof(uint64_t));
+  for (uint64_t i = 0; i < 5; ++i)
+    CHECK(offsets.value<uint64_t>(i * sizeof(uint64_t)) == 10 + 4 * i);
+}
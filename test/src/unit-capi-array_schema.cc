@@ -502,7 +502,8 @@ void ArraySchemaFx::load_and_check_array_schema(const std::string& path) {
       "- Tile order: " + TILE_ORDER_STR + "\n" + "- Capacity: " + CAPACITY_STR +
       "\n"
       "- Coordinates compressor: BLOSC_ZSTD\n" +
-      "- Coordinates compression level: -1\n\n" +
+      "- Coordinates compression level: -1\n" +
+      "- Offsets filters: COMPACT_OFFSETS\n\n" +
       "=== Domain ===\n"
       "- Dimensions type: " +
       DIM_TYPE_STR + "\n\n" + "### Dimension ###\n" + "- Name: " + DIM1_NAME +
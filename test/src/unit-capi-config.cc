@@ -183,8 +183,20 @@ void check_save_to_file() {
 
   std::stringstream ss;
   ss << "sm.array_schema_cache_size 10000000\n";
+  ss << "sm.auto_compression_candidates "
+        "NO_COMPRESSION,LZ4,ZSTD:1,ZSTD:9,RLE,DOUBLE_DELTA,GORILLA\n";
+  ss << "sm.compressed_tile_cache_size 50000000\n";
   ss << "sm.fragment_metadata_cache_size 10000000\n";
+  ss << "sm.global_write_queue_depth 0\n";
+  ss << "sm.num_compute_threads " << std::thread::hardware_concurrency()
+     << "\n";
+  ss << "sm.tile_cache_policy slru\n";
+  ss << "sm.tile_cache_shard_num 8\n";
   ss << "sm.tile_cache_size 10000000\n";
+  ss << "sm.tile_chunk_size 1048576\n";
+  ss << "sm.unordered_write_memory_budget 0\n";
+  ss << "sm.write_buffer_max_age_ms 0\n";
+  ss << "sm.write_buffer_size 0\n";
   ss << "vfs.max_parallel_ops " << std::thread::hardware_concurrency() << "\n";
   ss << "vfs.min_parallel_size 10485760\n";
   ss << "vfs.s3.connect_max_tries 5\n";
@@ -350,8 +362,21 @@ TEST_CASE("C API: Test config iter", "[capi], [config]") {
   // Prepare maps
   std::map<std::string, std::string> all_param_values;
   all_param_values["sm.tile_cache_size"] = "100";
+  all_param_values["sm.compressed_tile_cache_size"] = "50000000";
+  all_param_values["sm.tile_cache_shard_num"] = "8";
+  all_param_values["sm.tile_cache_policy"] = "slru";
   all_param_values["sm.array_schema_cache_size"] = "1000";
   all_param_values["sm.fragment_metadata_cache_size"] = "10000000";
+  all_param_values["sm.global_write_queue_depth"] = "0";
+  all_param_values["sm.num_compute_threads"] =
+      std::to_string(std::thread::hardware_concurrency());
+  all_param_values["sm.unordered_write_memory_budget"] = "0";
+  all_param_values["sm.unordered_write_scratch_dir"] = "";
+  all_param_values["sm.write_buffer_size"] = "0";
+  all_param_values["sm.write_buffer_max_age_ms"] = "0";
+  all_param_values["sm.tile_chunk_size"] = "1048576";
+  all_param_values["sm.auto_compression_candidates"] =
+      "NO_COMPRESSION,LZ4,ZSTD:1,ZSTD:9,RLE,DOUBLE_DELTA,GORILLA";
   all_param_values["vfs.max_parallel_ops"] =
       std::to_string(std::thread::hardware_concurrency());
   all_param_values["vfs.min_parallel_size"] = "10485760";
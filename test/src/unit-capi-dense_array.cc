@@ -90,6 +90,8 @@ struct DenseArrayFx {
   void check_invalid_cell_num_in_dense_writes(const std::string& path);
   void check_sparse_writes(const std::string& path);
   void check_simultaneous_writes(const std::string& path);
+  void check_validity_bitmap(const std::string& path);
+  void check_async_global_writes(const std::string& path);
   static std::string random_bucket_name(const std::string& prefix);
 
   /**
@@ -1083,6 +1085,118 @@ void DenseArrayFx::check_simultaneous_writes(const std::string& path) {
   }
 }
 
+void DenseArrayFx::check_validity_bitmap(const std::string& path) {
+  std::string array_name = path + "validity_bitmap_array";
+
+  // Create a 4x4 dense array with 2x2 tiles
+  create_dense_array_2D(
+      array_name, 2, 2, 0, 3, 0, 3, 4, TILEDB_ROW_MAJOR, TILEDB_ROW_MAJOR);
+
+  // Write only the upper-left tile
+  int64_t write_subarray[] = {0, 1, 0, 1};
+  int write_buffer[] = {1, 2, 3, 4};
+  uint64_t write_buffer_sizes[] = {sizeof(write_buffer)};
+  write_dense_subarray_2D(
+      array_name,
+      write_subarray,
+      TILEDB_WRITE,
+      TILEDB_ROW_MAJOR,
+      write_buffer,
+      write_buffer_sizes);
+
+  // Read the entire array along with the validity bitmap
+  const char* attributes[] = {ATTR_NAME};
+  int buffer_a1[16];
+  void* buffers[] = {buffer_a1};
+  uint64_t buffer_sizes[] = {sizeof(buffer_a1)};
+  uint8_t validity[4];
+  uint64_t validity_size = sizeof(validity);
+  int64_t subarray[] = {0, 3, 0, 3};
+  tiledb_query_t* query;
+  int rc = tiledb_query_create(ctx_, &query, array_name.c_str(), TILEDB_READ);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_buffers(
+      ctx_, query, attributes, 1, buffers, buffer_sizes);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_validity_buffer(
+      ctx_, query, "foo", validity, &validity_size);
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_query_set_validity_buffer(
+      ctx_, query, ATTR_NAME, validity, &validity_size);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_subarray(ctx_, query, subarray);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_layout(ctx_, query, TILEDB_ROW_MAJOR);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_submit(ctx_, query);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_finalize(ctx_, query);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_query_free(ctx_, &query);
+
+  // Cells (0,0), (0,1), (1,0) and (1,1) are the only non-empty ones
+  CHECK(buffer_sizes[0] == sizeof(buffer_a1));
+  REQUIRE(validity_size == 2);
+  CHECK(validity[0] == 0x33);
+  CHECK(validity[1] == 0x00);
+  CHECK(buffer_a1[0] == 1);
+  CHECK(buffer_a1[5] == 4);
+}
+
+void DenseArrayFx::check_async_global_writes(const std::string& path) {
+  std::string array_name = path + "async_global_writes_array";
+
+  // Create a 4x4 dense array with 2x2 tiles
+  create_dense_array_2D(
+      array_name, 2, 2, 0, 3, 0, 3, 4, TILEDB_ROW_MAJOR, TILEDB_ROW_MAJOR);
+
+  // Create a context that writes global-order tiles in the background
+  tiledb_config_t* config;
+  tiledb_error_t* error = nullptr;
+  REQUIRE(tiledb_config_create(&config, &error) == TILEDB_OK);
+  REQUIRE(
+      tiledb_config_set(config, "sm.global_write_queue_depth", "2", &error) ==
+      TILEDB_OK);
+  REQUIRE(error == nullptr);
+  tiledb_ctx_t* ctx;
+  REQUIRE(tiledb_ctx_create(&ctx, config) == TILEDB_OK);
+  REQUIRE(tiledb_config_free(&config) == TILEDB_OK);
+
+  // Write one tile per submission, with value = row id * 4 + col id
+  const char* attributes[] = {ATTR_NAME};
+  int buffer[4];
+  void* buffers[] = {buffer};
+  uint64_t buffer_sizes[] = {sizeof(buffer)};
+  tiledb_query_t* query;
+  int rc = tiledb_query_create(ctx, &query, array_name.c_str(), TILEDB_WRITE);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_buffers(
+      ctx, query, attributes, 1, buffers, buffer_sizes);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_layout(ctx, query, TILEDB_GLOBAL_ORDER);
+  REQUIRE(rc == TILEDB_OK);
+  for (int t = 0; t < 4; ++t) {
+    int r = (t / 2) * 2, c = (t % 2) * 2;
+    buffer[0] = r * 4 + c;
+    buffer[1] = r * 4 + c + 1;
+    buffer[2] = (r + 1) * 4 + c;
+    buffer[3] = (r + 1) * 4 + c + 1;
+    rc = tiledb_query_submit(ctx, query);
+    REQUIRE(rc == TILEDB_OK);
+  }
+  rc = tiledb_query_finalize(ctx, query);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_query_free(ctx, &query);
+  CHECK(tiledb_ctx_free(&ctx) == TILEDB_OK);
+
+  // Read back
+  int* read_buffer = read_dense_array_2D(
+      array_name, 0, 3, 0, 3, TILEDB_READ, TILEDB_ROW_MAJOR);
+  for (int i = 0; i < 16; ++i)
+    CHECK(read_buffer[i] == i);
+  delete[] read_buffer;
+}
+
 std::string DenseArrayFx::random_bucket_name(const std::string& prefix) {
   std::stringstream ss;
   ss << prefix << "-" << std::this_thread::get_id() << "-"
@@ -1187,4 +1301,38 @@ TEST_CASE_METHOD(
   create_temp_dir(temp_dir);
   check_simultaneous_writes(temp_dir);
   remove_temp_dir(temp_dir);
-}
\ No newline at end of file
+}
+
+TEST_CASE_METHOD(
+    DenseArrayFx,
+    "C API: Test dense array, validity bitmap",
+    "[capi], [dense]") {
+  std::string temp_dir;
+  if (supports_s3_) {
+    temp_dir = S3_TEMP_DIR;
+  } else if (supports_hdfs_) {
+    temp_dir = HDFS_TEMP_DIR;
+  } else {
+    temp_dir = FILE_URI_PREFIX + FILE_TEMP_DIR;
+  }
+  create_temp_dir(temp_dir);
+  check_validity_bitmap(temp_dir);
+  remove_temp_dir(temp_dir);
+}
+
+TEST_CASE_METHOD(
+    DenseArrayFx,
+    "C API: Test dense array, asynchronous global writes",
+    "[capi], [dense]") {
+  std::string temp_dir;
+  if (supports_s3_) {
+    temp_dir = S3_TEMP_DIR;
+  } else if (supports_hdfs_) {
+    temp_dir = HDFS_TEMP_DIR;
+  } else {
+    temp_dir = FILE_URI_PREFIX + FILE_TEMP_DIR;
+  }
+  create_temp_dir(temp_dir);
+  check_async_global_writes(temp_dir);
+  remove_temp_dir(temp_dir);
+}
@@ -43,6 +43,7 @@
 #include <cassert>
 #include <cstring>
 #include <ctime>
+#include <functional>
 #include <iostream>
 #include <map>
 #include <sstream>
@@ -72,6 +73,7 @@ struct SparseArrayFx {
 #endif
   int ITER_NUM = 5;
   const std::string ARRAY = "sparse_array";
+  const int64_t UNORDERED_DOMAIN_SIZE = 10;
 
   // TileDB context
   tiledb_ctx_t* ctx_;
@@ -87,6 +89,7 @@ struct SparseArrayFx {
   void set_supported_fs();
   void create_temp_dir(const std::string& path);
   void remove_temp_dir(const std::string& path);
+  int fragment_num(const std::string& path);
   static std::string random_bucket_name(const std::string& prefix);
   void check_sorted_reads(
       const std::string& array_name,
@@ -166,6 +169,52 @@ struct SparseArrayFx {
       int64_t domain_size_0,
       int64_t domain_size_1,
       int iter_num);
+
+  /**
+   * Creates the array of the unordered write tests, which has a
+   * `UNORDERED_DOMAIN_SIZE` x `UNORDERED_DOMAIN_SIZE` domain with 5x5 space
+   * tiles and row-major orders.
+   *
+   * @param array_name The array name.
+   * @param capacity The tile capacity.
+   * @param compressor The attribute compressor.
+   */
+  void create_unordered_array_2D(
+      const std::string& array_name,
+      uint64_t capacity,
+      tiledb_compressor_t compressor);
+
+  /**
+   * Fills the buffers with the cells at positions `[start, start + num)` of
+   * the scrambled order of the unordered write tests. Position `i` holds
+   * cell `c = 37 * i % cell_num` (the positions wrap around the cells), with
+   * coordinates `(c / UNORDERED_DOMAIN_SIZE, c % UNORDERED_DOMAIN_SIZE)` and
+   * value `c + value_offset`.
+   *
+   * @param start The first position.
+   * @param num The number of cells.
+   * @param value_offset The offset added to the cell values.
+   * @param buffer_a1 The attribute buffer, resized to `num` values.
+   * @param buffer_coords The coordinates buffer, resized to `2 * num`
+   *     values.
+   */
+  void get_scrambled_cells(
+      int64_t start,
+      int64_t num,
+      int value_offset,
+      std::vector<int>* buffer_a1,
+      std::vector<int64_t>* buffer_coords);
+
+  /**
+   * Reads all cells of the array of the unordered write tests, checking
+   * that each cell `c` is stored once, with value `expected(c)`.
+   *
+   * @param array_name The array name.
+   * @param expected Returns the expected value of a cell.
+   */
+  void check_unordered_array_2D(
+      const std::string& array_name,
+      const std::function<int(int64_t)>& expected);
 };
 
 SparseArrayFx::SparseArrayFx() {
@@ -267,6 +316,22 @@ void SparseArrayFx::remove_temp_dir(const std::string& path) {
     REQUIRE(tiledb_vfs_remove_dir(ctx_, vfs_, path.c_str()) == TILEDB_OK);
 }
 
+int SparseArrayFx::fragment_num(const std::string& path) {
+  std::vector<std::string> paths;
+#ifdef _WIN32
+  CHECK(tiledb::sm::win::ls(path, &paths).ok());
+#else
+  CHECK(tiledb::sm::posix::ls(path, &paths).ok());
+#endif
+  int num = 0;
+  for (const auto& p : paths) {
+    auto name = p.substr(p.find_last_of("/\\") + 1);
+    auto is_file = name.find('.') != std::string::npos;
+    num += (tiledb::sm::utils::starts_with(name, "__") && !is_file) ? 1 : 0;
+  }
+  return num;
+}
+
 std::string SparseArrayFx::random_bucket_name(const std::string& prefix) {
   std::stringstream ss;
   ss << prefix << "-" << std::this_thread::get_id() << "-"
@@ -450,6 +515,76 @@ void SparseArrayFx::write_sparse_array_unsorted_2D(
   delete[] buffer_coords;
 }
 
+void SparseArrayFx::create_unordered_array_2D(
+    const std::string& array_name,
+    uint64_t capacity,
+    tiledb_compressor_t compressor) {
+  create_sparse_array_2D(
+      array_name,
+      5,
+      5,
+      0,
+      UNORDERED_DOMAIN_SIZE - 1,
+      0,
+      UNORDERED_DOMAIN_SIZE - 1,
+      capacity,
+      compressor,
+      TILEDB_ROW_MAJOR,
+      TILEDB_ROW_MAJOR);
+}
+
+void SparseArrayFx::get_scrambled_cells(
+    int64_t start,
+    int64_t num,
+    int value_offset,
+    std::vector<int>* buffer_a1,
+    std::vector<int64_t>* buffer_coords) {
+  auto cell_num = UNORDERED_DOMAIN_SIZE * UNORDERED_DOMAIN_SIZE;
+  buffer_a1->resize(num);
+  buffer_coords->resize(2 * num);
+  for (int64_t i = 0; i < num; ++i) {
+    auto cell = (37 * (start + i)) % cell_num;
+    (*buffer_a1)[i] = (int)cell + value_offset;
+    (*buffer_coords)[2 * i] = cell / UNORDERED_DOMAIN_SIZE;
+    (*buffer_coords)[2 * i + 1] = cell % UNORDERED_DOMAIN_SIZE;
+  }
+}
+
+void SparseArrayFx::check_unordered_array_2D(
+    const std::string& array_name,
+    const std::function<int(int64_t)>& expected) {
+  // Read with room for duplicates, which must not be stored
+  auto cell_num = UNORDERED_DOMAIN_SIZE * UNORDERED_DOMAIN_SIZE;
+  const int64_t subarray[] = {
+      0, UNORDERED_DOMAIN_SIZE - 1, 0, UNORDERED_DOMAIN_SIZE - 1};
+  const char* attributes[] = {ATTR_NAME};
+  std::vector<int> buffer_a1(4 * cell_num);
+  void* buffers[] = {buffer_a1.data()};
+  uint64_t buffer_sizes[] = {buffer_a1.size() * sizeof(int)};
+  tiledb_query_t* query;
+  int rc = tiledb_query_create(ctx_, &query, array_name.c_str(), TILEDB_READ);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_buffers(
+      ctx_, query, attributes, 1, buffers, buffer_sizes);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_subarray(ctx_, query, subarray);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_layout(ctx_, query, TILEDB_ROW_MAJOR);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_submit(ctx_, query);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_finalize(ctx_, query);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_free(ctx_, &query);
+  REQUIRE(rc == TILEDB_OK);
+
+  CHECK(buffer_sizes[0] == cell_num * sizeof(int));
+  bool allok = true;
+  for (int64_t i = 0; i < cell_num; ++i)
+    allok = allok && (buffer_a1[i] == expected(i));
+  CHECK(allok);
+}
+
 void SparseArrayFx::test_random_subarrays(
     const std::string& array_name,
     int64_t domain_size_0,
@@ -856,3 +991,361 @@ TEST_CASE_METHOD(
   rc = tiledb_query_free(ctx_, &query);
   REQUIRE(rc == TILEDB_OK);
 }
+
+TEST_CASE_METHOD(
+    SparseArrayFx,
+    "C API: Test sparse unordered writes with external sort",
+    "[capi], [sparse], [sparse-external-sort]") {
+  // Parameters used in this test
+  int64_t cell_num = UNORDERED_DOMAIN_SIZE * UNORDERED_DOMAIN_SIZE;
+  int64_t submit_num = 4;
+  auto array_name = FILE_URI_PREFIX + FILE_TEMP_DIR + ARRAY;
+
+  create_unordered_array_2D(array_name, 7, TILEDB_NO_COMPRESSION);
+
+  // Create a context with a memory budget that either fits all cells, or is
+  // small enough to spill many runs
+  std::string memory_budget;
+  SECTION("- in memory") {
+    memory_budget = "1000000";
+  }
+  SECTION("- spilled runs") {
+    memory_budget = "512";
+  }
+  tiledb_config_t* config = nullptr;
+  tiledb_error_t* error = nullptr;
+  REQUIRE(tiledb_config_create(&config, &error) == TILEDB_OK);
+  REQUIRE(error == nullptr);
+  REQUIRE(
+      tiledb_config_set(
+          config,
+          "sm.unordered_write_memory_budget",
+          memory_budget.c_str(),
+          &error) == TILEDB_OK);
+  REQUIRE(error == nullptr);
+  tiledb_ctx_t* ctx;
+  REQUIRE(tiledb_ctx_create(&ctx, config) == TILEDB_OK);
+  REQUIRE(tiledb_config_free(&config) == TILEDB_OK);
+
+  // Write all cells in a scrambled order, over multiple submissions
+  tiledb_query_t* query;
+  int rc = tiledb_query_create(ctx, &query, array_name.c_str(), TILEDB_WRITE);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_layout(ctx, query, TILEDB_UNORDERED);
+  REQUIRE(rc == TILEDB_OK);
+  const char* attributes[] = {ATTR_NAME, TILEDB_COORDS};
+  int64_t submit_cell_num = cell_num / submit_num;
+  std::vector<int> buffer_a1;
+  std::vector<int64_t> buffer_coords;
+  get_scrambled_cells(0, submit_cell_num, 0, &buffer_a1, &buffer_coords);
+  void* buffers[] = {buffer_a1.data(), buffer_coords.data()};
+  uint64_t buffer_sizes[] = {submit_cell_num * sizeof(int),
+                             2 * submit_cell_num * sizeof(int64_t)};
+  rc = tiledb_query_set_buffers(
+      ctx, query, attributes, 2, buffers, buffer_sizes);
+  REQUIRE(rc == TILEDB_OK);
+  for (int64_t s = 0; s < submit_num; ++s) {
+    get_scrambled_cells(
+        s * submit_cell_num, submit_cell_num, 0, &buffer_a1, &buffer_coords);
+    rc = tiledb_query_reset_buffers(ctx, query, buffers, buffer_sizes);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_submit(ctx, query);
+    REQUIRE(rc == TILEDB_OK);
+  }
+  rc = tiledb_query_finalize(ctx, query);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_free(ctx, &query);
+  REQUIRE(rc == TILEDB_OK);
+  CHECK(tiledb_ctx_free(&ctx) == TILEDB_OK);
+
+  // Read back and check that all cells were written
+  check_unordered_array_2D(array_name, [](int64_t c) { return (int)c; });
+
+  // Check that a single fragment was created and the runs were removed
+  CHECK(fragment_num(FILE_TEMP_DIR + ARRAY) == 1);
+  std::vector<std::string> paths;
+#ifdef _WIN32
+  CHECK(tiledb::sm::win::ls(FILE_TEMP_DIR + ARRAY, &paths).ok());
+#else
+  CHECK(tiledb::sm::posix::ls(FILE_TEMP_DIR + ARRAY, &paths).ok());
+#endif
+  int hidden_num = 0;
+  for (const auto& path : paths) {
+    auto name = path.substr(path.find_last_of("/\\") + 1);
+    hidden_num += tiledb::sm::utils::starts_with(name, ".") ? 1 : 0;
+  }
+  CHECK(hidden_num == 0);
+}
+
+TEST_CASE_METHOD(
+    SparseArrayFx,
+    "C API: Test sparse unordered writes with a write buffer",
+    "[capi], [sparse], [sparse-write-buffer]") {
+  // Parameters used in this test
+  int64_t cell_num = UNORDERED_DOMAIN_SIZE * UNORDERED_DOMAIN_SIZE;
+  int64_t write_num = 4;
+  auto array_name = FILE_URI_PREFIX + FILE_TEMP_DIR + ARRAY;
+
+  create_unordered_array_2D(array_name, 7, TILEDB_NO_COMPRESSION);
+
+  // Create a context with a write buffer that fits all cells
+  tiledb_config_t* config = nullptr;
+  tiledb_error_t* error = nullptr;
+  REQUIRE(tiledb_config_create(&config, &error) == TILEDB_OK);
+  REQUIRE(error == nullptr);
+  REQUIRE(
+      tiledb_config_set(config, "sm.write_buffer_size", "1000000", &error) ==
+      TILEDB_OK);
+  REQUIRE(error == nullptr);
+  tiledb_ctx_t* ctx;
+  REQUIRE(tiledb_ctx_create(&ctx, config) == TILEDB_OK);
+  REQUIRE(tiledb_config_free(&config) == TILEDB_OK);
+
+  // Write all cells in a scrambled order, with multiple small queries
+  const char* attributes[] = {ATTR_NAME, TILEDB_COORDS};
+  int64_t write_cell_num = cell_num / write_num;
+  std::vector<int> buffer_a1;
+  std::vector<int64_t> buffer_coords;
+  for (int64_t w = 0; w < write_num; ++w) {
+    get_scrambled_cells(
+        w * write_cell_num, write_cell_num, 0, &buffer_a1, &buffer_coords);
+    void* buffers[] = {buffer_a1.data(), buffer_coords.data()};
+    uint64_t buffer_sizes[] = {write_cell_num * sizeof(int),
+                               2 * write_cell_num * sizeof(int64_t)};
+    tiledb_query_t* query;
+    int rc =
+        tiledb_query_create(ctx, &query, array_name.c_str(), TILEDB_WRITE);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_layout(ctx, query, TILEDB_UNORDERED);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_buffers(
+        ctx, query, attributes, 2, buffers, buffer_sizes);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_submit(ctx, query);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_finalize(ctx, query);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_free(ctx, &query);
+    REQUIRE(rc == TILEDB_OK);
+  }
+
+  // The cells must still be buffered
+  CHECK(fragment_num(FILE_TEMP_DIR + ARRAY) == 0);
+
+  SECTION("- flush on read") {
+    // Opening the array for reading flushes the buffered cells
+    tiledb_query_t* query;
+    int rc = tiledb_query_create(ctx, &query, array_name.c_str(), TILEDB_READ);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_free(ctx, &query);
+    REQUIRE(rc == TILEDB_OK);
+    CHECK(fragment_num(FILE_TEMP_DIR + ARRAY) == 1);
+  }
+
+  SECTION("- explicit flush") {
+    CHECK(tiledb_array_flush(ctx, array_name.c_str()) == TILEDB_OK);
+    CHECK(fragment_num(FILE_TEMP_DIR + ARRAY) == 1);
+  }
+
+  SECTION("- flush on context free") {
+    // Freeing the context below flushes the buffered cells
+  }
+
+  CHECK(tiledb_ctx_free(&ctx) == TILEDB_OK);
+  CHECK(fragment_num(FILE_TEMP_DIR + ARRAY) == 1);
+
+  // Read back and check that all cells were written
+  check_unordered_array_2D(array_name, [](int64_t c) { return (int)c; });
+}
+
+TEST_CASE_METHOD(
+    SparseArrayFx,
+    "C API: Test sparse write buffer flush errors",
+    "[capi], [sparse], [sparse-write-buffer]") {
+  auto array_name = FILE_URI_PREFIX + FILE_TEMP_DIR + ARRAY;
+  create_unordered_array_2D(array_name, 7, TILEDB_NO_COMPRESSION);
+
+  // Create a context with a write buffer
+  tiledb_config_t* config = nullptr;
+  tiledb_error_t* error = nullptr;
+  REQUIRE(tiledb_config_create(&config, &error) == TILEDB_OK);
+  REQUIRE(error == nullptr);
+  REQUIRE(
+      tiledb_config_set(config, "sm.write_buffer_size", "1000000", &error) ==
+      TILEDB_OK);
+  REQUIRE(error == nullptr);
+  tiledb_ctx_t* ctx;
+  REQUIRE(tiledb_ctx_create(&ctx, config) == TILEDB_OK);
+  REQUIRE(tiledb_config_free(&config) == TILEDB_OK);
+
+  // Writes a single cell, returning the submission return code
+  auto write = [&](int value) {
+    const char* attributes[] = {ATTR_NAME, TILEDB_COORDS};
+    int64_t coords[] = {1, 2};
+    void* buffers[] = {&value, coords};
+    uint64_t buffer_sizes[] = {sizeof(int), sizeof(coords)};
+    tiledb_query_t* query;
+    int rc =
+        tiledb_query_create(ctx, &query, array_name.c_str(), TILEDB_WRITE);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_layout(ctx, query, TILEDB_UNORDERED);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_buffers(
+        ctx, query, attributes, 2, buffers, buffer_sizes);
+    REQUIRE(rc == TILEDB_OK);
+    auto rc_submit = tiledb_query_submit(ctx, query);
+    rc = tiledb_query_finalize(ctx, query);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_free(ctx, &query);
+    REQUIRE(rc == TILEDB_OK);
+    return rc_submit;
+  };
+
+  CHECK(write(1) == TILEDB_OK);
+  CHECK(fragment_num(FILE_TEMP_DIR + ARRAY) == 0);
+  CHECK(tiledb_array_flush(ctx, array_name.c_str()) == TILEDB_OK);
+  CHECK(fragment_num(FILE_TEMP_DIR + ARRAY) == 1);
+
+  // A failed flush is also reported to the next writer, after which the
+  // array can be written again
+  CHECK(write(2) == TILEDB_OK);
+  REQUIRE(tiledb_object_remove(ctx_, array_name.c_str()) == TILEDB_OK);
+  CHECK(tiledb_array_flush(ctx, array_name.c_str()) == TILEDB_ERR);
+  create_unordered_array_2D(array_name, 7, TILEDB_NO_COMPRESSION);
+  CHECK(write(3) == TILEDB_ERR);
+  CHECK(write(4) == TILEDB_OK);
+
+  SECTION("- flush on context free") {
+    CHECK(tiledb_ctx_free(&ctx) == TILEDB_OK);
+    CHECK(fragment_num(FILE_TEMP_DIR + ARRAY) == 1);
+  }
+
+  SECTION("- failed flush on context free") {
+    // The lost cells are reported upon freeing the context
+    REQUIRE(tiledb_object_remove(ctx_, array_name.c_str()) == TILEDB_OK);
+    CHECK(tiledb_ctx_free(&ctx) == TILEDB_ERR);
+  }
+}
+
+TEST_CASE_METHOD(
+    SparseArrayFx,
+    "C API: Test sparse unordered writes with dedup",
+    "[capi], [sparse], [sparse-dedup]") {
+  // Parameters used in this test
+  int64_t cell_num = UNORDERED_DOMAIN_SIZE * UNORDERED_DOMAIN_SIZE;
+  int64_t copy_num = 3;
+  auto array_name = FILE_URI_PREFIX + FILE_TEMP_DIR + ARRAY;
+
+  create_unordered_array_2D(array_name, 7, TILEDB_NO_COMPRESSION);
+
+  // Every cell is written three times in a scrambled order, with values
+  // 1000 + c, c and 500 + c for cell c
+  const int copy_offsets[] = {1000, 0, 500};
+  std::vector<int> buffer_a1;
+  std::vector<int64_t> buffer_coords;
+  for (int64_t k = 0; k < copy_num; ++k) {
+    std::vector<int> copy_a1;
+    std::vector<int64_t> copy_coords;
+    get_scrambled_cells(
+        k * cell_num, cell_num, copy_offsets[k], &copy_a1, &copy_coords);
+    buffer_a1.insert(buffer_a1.end(), copy_a1.begin(), copy_a1.end());
+    buffer_coords.insert(
+        buffer_coords.end(), copy_coords.begin(), copy_coords.end());
+  }
+
+  // Expected value of cell c
+  tiledb_dedup_t dedup = TILEDB_NO_DEDUP;
+  std::function<int(int64_t)> expected;
+  SECTION("- last") {
+    dedup = TILEDB_DEDUP_LAST;
+    expected = [](int64_t c) { return 500 + (int)c; };
+  }
+  SECTION("- sum") {
+    dedup = TILEDB_DEDUP_SUM;
+    expected = [](int64_t c) { return 1500 + 3 * (int)c; };
+  }
+  SECTION("- min") {
+    dedup = TILEDB_DEDUP_MIN;
+    expected = [](int64_t c) { return (int)c; };
+  }
+  SECTION("- max") {
+    dedup = TILEDB_DEDUP_MAX;
+    expected = [](int64_t c) { return 1000 + (int)c; };
+  }
+
+  // Write
+  tiledb_query_t* query;
+  int rc = tiledb_query_create(ctx_, &query, array_name.c_str(), TILEDB_WRITE);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_layout(ctx_, query, TILEDB_UNORDERED);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_dedup(ctx_, query, (tiledb_dedup_t)100);
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_query_set_dedup(ctx_, query, dedup);
+  REQUIRE(rc == TILEDB_OK);
+  const char* attributes[] = {ATTR_NAME, TILEDB_COORDS};
+  void* buffers[] = {buffer_a1.data(), buffer_coords.data()};
+  uint64_t buffer_sizes[] = {buffer_a1.size() * sizeof(int),
+                             buffer_coords.size() * sizeof(int64_t)};
+  rc = tiledb_query_set_buffers(
+      ctx_, query, attributes, 2, buffers, buffer_sizes);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_submit(ctx_, query);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_finalize(ctx_, query);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_free(ctx_, &query);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Read back and check that each cell was stored once
+  check_unordered_array_2D(array_name, expected);
+}
+
+TEST_CASE_METHOD(
+    SparseArrayFx,
+    "C API: Test sparse array with tiles compressed in multiple chunks",
+    "[capi], [sparse], [sparse-tile-chunks]") {
+  // Parameters used in this test
+  int64_t cell_num = UNORDERED_DOMAIN_SIZE * UNORDERED_DOMAIN_SIZE;
+  auto array_name = FILE_URI_PREFIX + FILE_TEMP_DIR + ARRAY;
+
+  // Replace the context with one that splits every tile into many small
+  // chunks, which are (de)compressed in parallel
+  tiledb_config_t* config = nullptr;
+  tiledb_error_t* error = nullptr;
+  REQUIRE(tiledb_config_create(&config, &error) == TILEDB_OK);
+  REQUIRE(error == nullptr);
+  REQUIRE(
+      tiledb_config_set(config, "sm.tile_chunk_size", "64", &error) ==
+      TILEDB_OK);
+  REQUIRE(error == nullptr);
+  REQUIRE(
+      tiledb_config_set(config, "sm.num_compute_threads", "4", &error) ==
+      TILEDB_OK);
+  REQUIRE(error == nullptr);
+  REQUIRE(tiledb_ctx_free(&ctx_) == TILEDB_OK);
+  REQUIRE(tiledb_ctx_create(&ctx_, config) == TILEDB_OK);
+  REQUIRE(tiledb_config_free(&config) == TILEDB_OK);
+
+  tiledb_compressor_t compressor = TILEDB_NO_COMPRESSION;
+  SECTION("- blosc-lz4") {
+    compressor = TILEDB_BLOSC_LZ4;
+  }
+  SECTION("- gzip") {
+    compressor = TILEDB_GZIP;
+  }
+  SECTION("- rle") {
+    compressor = TILEDB_RLE;
+  }
+  SECTION("- double delta") {
+    compressor = TILEDB_DOUBLE_DELTA;
+  }
+
+  // A single tile holds all cells
+  create_unordered_array_2D(array_name, cell_num, compressor);
+  write_sparse_array_unsorted_2D(
+      array_name, UNORDERED_DOMAIN_SIZE, UNORDERED_DOMAIN_SIZE);
+
+  // Read back and check that all cells were written
+  check_unordered_array_2D(array_name, [](int64_t c) { return (int)c; });
+}
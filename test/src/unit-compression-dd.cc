@@ -34,8 +34,11 @@
 #include "catch.hpp"
 #include "tiledb/sm/compressors/dd_compressor.h"
 
+#include <cstring>
 #include <ctime>
 #include <iostream>
+#include <limits>
+#include <vector>
 
 TEST_CASE(
     "Compression-DoubleDelta: Test 1-element case",
@@ -206,3 +209,68 @@ TEST_CASE(
   delete decomp_out_buff;
   delete[] data;
 }
+
+TEST_CASE(
+    "Compression-DoubleDelta: Test extreme values",
+    "[compression], [double-delta]") {
+  // Double deltas of these values overflow 64-bit signed integers
+  int n = 1000;
+  std::vector<int64_t> data(n);
+  for (int i = 0; i < n; ++i) {
+    if (i % 3 == 0)
+      data[i] = std::numeric_limits<int64_t>::max() - i;
+    else if (i % 3 == 1)
+      data[i] = std::numeric_limits<int64_t>::min() + i;
+    else
+      data[i] = (i < n / 2) ? i : 0;
+  }
+
+  // Compress
+  tiledb::sm::ConstBuffer comp_in_buff(data.data(), n * sizeof(int64_t));
+  tiledb::sm::Buffer comp_out_buff;
+  auto st = tiledb::sm::DoubleDelta::compress(
+      tiledb::sm::Datatype::INT64, &comp_in_buff, &comp_out_buff);
+  REQUIRE(st.ok());
+  CHECK(
+      comp_out_buff.size() <=
+      n * sizeof(int64_t) +
+          tiledb::sm::DoubleDelta::overhead(n * sizeof(int64_t)));
+
+  // Decompress
+  tiledb::sm::ConstBuffer decomp_in_buff(
+      comp_out_buff.data(), comp_out_buff.size());
+  tiledb::sm::Buffer decomp_out_buff;
+  st = tiledb::sm::DoubleDelta::decompress(
+      tiledb::sm::Datatype::INT64, &decomp_in_buff, &decomp_out_buff);
+  REQUIRE(st.ok());
+
+  // Check data
+  REQUIRE(decomp_out_buff.size() == n * sizeof(int64_t));
+  CHECK(
+      std::memcmp(data.data(), decomp_out_buff.data(), n * sizeof(int64_t)) ==
+      0);
+}
+
+TEST_CASE(
+    "Compression-DoubleDelta: Test decompression of the original format",
+    "[compression], [double-delta]") {
+  // Compressed with the original bit by bit format
+  int64_t data[] = {100, 300, 200, 600, -50, -51, 1000000, 7};
+  unsigned char compressed[] = {
+      0x15, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x64,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x2c, 0x01, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x01, 0x48, 0x1f, 0x00,
+      0xb0, 0x04, 0x80, 0x4a, 0xe8, 0xd3, 0x09, 0x3d, 0x89, 0x02,
+      0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0};
+
+  // Decompress
+  tiledb::sm::ConstBuffer decomp_in_buff(compressed, sizeof(compressed));
+  tiledb::sm::Buffer decomp_out_buff;
+  auto st = tiledb::sm::DoubleDelta::decompress(
+      tiledb::sm::Datatype::INT64, &decomp_in_buff, &decomp_out_buff);
+  REQUIRE(st.ok());
+
+  // Check data
+  REQUIRE(decomp_out_buff.size() == sizeof(data));
+  CHECK(std::memcmp(data, decomp_out_buff.data(), sizeof(data)) == 0);
+}
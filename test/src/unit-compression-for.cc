@@ -0,0 +1,167 @@
+/**
+ * @file   unit-compression-for.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB Inc.
+ * @copyright Copyright (c) 2016 MIT and Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the frame of reference compression.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/compressors/for_compressor.h"
+#include "tiledb/sm/tile/filter_pipeline.h"
+
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace tiledb::sm;
+
+/** Compresses and decompresses the input values, checking the round trip. */
+template <class T>
+void check_round_trip(Datatype type, const std::vector<T>& data) {
+  auto nbytes = data.size() * sizeof(T);
+
+  // Compress
+  ConstBuffer comp_in_buff(data.data(), nbytes);
+  Buffer comp_out_buff;
+  auto st = FrameOfReference::compress(type, &comp_in_buff, &comp_out_buff);
+  REQUIRE(st.ok());
+  CHECK(comp_out_buff.size() <= nbytes + FrameOfReference::overhead(nbytes));
+
+  // Decompress
+  ConstBuffer decomp_in_buff(comp_out_buff.data(), comp_out_buff.size());
+  Buffer decomp_out_buff;
+  st = FrameOfReference::decompress(type, &decomp_in_buff, &decomp_out_buff);
+  REQUIRE(st.ok());
+  CHECK(decomp_in_buff.nbytes_left_to_read() == 0);
+
+  // Check data
+  REQUIRE(decomp_out_buff.size() == nbytes);
+  CHECK(std::memcmp(data.data(), decomp_out_buff.data(), nbytes) == 0);
+}
+
+TEST_CASE(
+    "Compression-FrameOfReference: Test small-range values",
+    "[compression], [frame-of-reference]") {
+  // Values in a narrow range around a large base, over several blocks
+  std::vector<int32_t> data(1000);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = -1000000 + (int32_t)(i * 7919 % 100);
+  check_round_trip(Datatype::INT32, data);
+
+  // The values fit in 7 bits, plus the block headers
+  Buffer comp_out_buff;
+  ConstBuffer comp_in_buff(data.data(), data.size() * sizeof(int32_t));
+  REQUIRE(FrameOfReference::compress(
+              Datatype::INT32, &comp_in_buff, &comp_out_buff)
+              .ok());
+  CHECK(comp_out_buff.size() < data.size());
+}
+
+TEST_CASE(
+    "Compression-FrameOfReference: Test edge cases",
+    "[compression], [frame-of-reference]") {
+  SECTION("- single value") {
+    check_round_trip<uint16_t>(Datatype::UINT16, {42});
+  }
+
+  SECTION("- constant values") {
+    check_round_trip(Datatype::UINT64, std::vector<uint64_t>(300, 5));
+  }
+
+  SECTION("- full range") {
+    std::vector<int64_t> data;
+    for (int i = 0; i < 500; ++i) {
+      data.push_back(std::numeric_limits<int64_t>::min() + i);
+      data.push_back(std::numeric_limits<int64_t>::max() - i);
+    }
+    check_round_trip(Datatype::INT64, data);
+  }
+
+  SECTION("- int8") {
+    std::vector<int8_t> data;
+    for (int i = 0; i < 1000; ++i)
+      data.push_back((int8_t)(i % 256 - 128));
+    check_round_trip(Datatype::INT8, data);
+  }
+}
+
+TEST_CASE(
+    "Compression-FrameOfReference: Test float datatypes",
+    "[compression], [frame-of-reference]") {
+  float data[] = {1.0f, 2.0f};
+  ConstBuffer comp_in_buff(data, sizeof(data));
+  Buffer comp_out_buff;
+  CHECK(!FrameOfReference::compress(
+             Datatype::FLOAT32, &comp_in_buff, &comp_out_buff)
+             .ok());
+}
+
+TEST_CASE(
+    "Compression-FrameOfReference: Test compact offsets filter",
+    "[compression], [frame-of-reference]") {
+  std::vector<Filter> filters = {Filter::FILTER_COMPACT_OFFSETS};
+  std::vector<uint64_t> data;
+  uint64_t max_size = 0;
+  SECTION("- offsets") {
+    // Offsets of short strings, shifted by a large base
+    uint64_t offset = 1000000;
+    for (int i = 0; i < 1000; ++i) {
+      data.push_back(offset);
+      offset += (uint64_t)(i * 7919 % 13 + 1);
+    }
+    max_size = data.size();
+  }
+  SECTION("- non-monotonic values") {
+    for (int i = 0; i < 1000; ++i)
+      data.push_back((uint64_t)(i * i % 5));
+    max_size = data.size();
+  }
+  SECTION("- single value") {
+    data.push_back(42);
+    max_size = 64;
+  }
+
+  // Forward
+  auto nbytes = data.size() * sizeof(uint64_t);
+  ConstBuffer input(data.data(), nbytes);
+  Buffer filtered;
+  REQUIRE(FilterPipeline::run_forward(
+              filters, Datatype::UINT64, &input, &filtered)
+              .ok());
+  CHECK(filtered.size() <= max_size);
+
+  // Reverse
+  ConstBuffer filtered_input(filtered.data(), filtered.size());
+  Buffer output;
+  REQUIRE(FilterPipeline::run_reverse(
+              filters, Datatype::UINT64, &filtered_input, &output)
+              .ok());
+  REQUIRE(output.size() == nbytes);
+  CHECK(std::memcmp(data.data(), output.data(), nbytes) == 0);
+}
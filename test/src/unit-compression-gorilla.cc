@@ -0,0 +1,278 @@
+/**
+ * @file   unit-compression-gorilla.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB Inc.
+ * @copyright Copyright (c) 2016 MIT and Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the Gorilla compression. The hidden `[gorilla_benchmark]` test
+ * compares its compression ratio and throughput with those of other
+ * compressors.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/compressors/blosc_compressor.h"
+#include "tiledb/sm/compressors/dd_compressor.h"
+#include "tiledb/sm/compressors/gorilla_compressor.h"
+#include "tiledb/sm/compressors/zstd_compressor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace tiledb::sm;
+
+/**
+ * Compresses and decompresses the input values, checking the round trip,
+ * and returns the compressed size.
+ */
+template <class T>
+uint64_t check_gorilla_round_trip(Datatype type, const std::vector<T>& data) {
+  auto nbytes = data.size() * sizeof(T);
+
+  // Compress
+  ConstBuffer comp_in_buff(data.data(), nbytes);
+  Buffer comp_out_buff;
+  auto st = Gorilla::compress(type, &comp_in_buff, &comp_out_buff);
+  REQUIRE(st.ok());
+  CHECK(comp_out_buff.size() <= nbytes + Gorilla::overhead(nbytes));
+
+  // Decompress
+  ConstBuffer decomp_in_buff(comp_out_buff.data(), comp_out_buff.size());
+  Buffer decomp_out_buff;
+  st = Gorilla::decompress(type, &decomp_in_buff, &decomp_out_buff);
+  REQUIRE(st.ok());
+  CHECK(decomp_in_buff.nbytes_left_to_read() == 0);
+
+  // Check data (bitwise, so that NaNs compare equal)
+  REQUIRE(decomp_out_buff.size() == nbytes);
+  CHECK(std::memcmp(data.data(), decomp_out_buff.data(), nbytes) == 0);
+
+  return comp_out_buff.size();
+}
+
+/** A compressor under comparison. */
+struct Codec {
+  std::string name;
+  std::function<Status(ConstBuffer*, Buffer*)> compress;
+};
+
+/**
+ * Returns Gorilla, ZSTD, DoubleDelta (on the bit patterns of the values,
+ * since it does not support real types) and Blosc (ZSTD with byte
+ * shuffling), in this order.
+ */
+template <class T>
+std::vector<Codec> comparison_codecs(Datatype type, Datatype bits_type) {
+  return {
+      {"Gorilla",
+       [type](ConstBuffer* in, Buffer* out) {
+         return Gorilla::compress(type, in, out);
+       }},
+      {"ZSTD",
+       [](ConstBuffer* in, Buffer* out) {
+         return ZStd::compress(ZStd::default_level(), in, out);
+       }},
+      {"DoubleDelta",
+       [bits_type](ConstBuffer* in, Buffer* out) {
+         return DoubleDelta::compress(bits_type, in, out);
+       }},
+      {"Blosc",
+       [](ConstBuffer* in, Buffer* out) {
+         return Blosc::compress(
+             "zstd", sizeof(T), Blosc::default_level(), in, out);
+       }},
+  };
+}
+
+/**
+ * Compresses the input values with a codec and returns the output size. The
+ * output buffer is preallocated, since ZSTD and Blosc do not grow it.
+ */
+template <class T>
+uint64_t compressed_size(const Codec& codec, const std::vector<T>& data) {
+  auto nbytes = data.size() * sizeof(T);
+  ConstBuffer in(data.data(), nbytes);
+  Buffer out;
+  auto overhead = std::max(ZStd::overhead(nbytes), Blosc::overhead(nbytes));
+  REQUIRE(out.realloc(nbytes + overhead).ok());
+  REQUIRE(codec.compress(&in, &out).ok());
+  return out.size();
+}
+
+/**
+ * A slowly varying temperature reading with 0.1 resolution, sampled faster
+ * than it changes.
+ */
+std::vector<double> sensor_series(size_t num) {
+  std::vector<double> data(num);
+  for (size_t i = 0; i < num; ++i)
+    data[i] = std::round(200 + 50 * std::sin(i / 2000.0)) / 10;
+  return data;
+}
+
+TEST_CASE(
+    "Compression-Gorilla: Test sensor series", "[compression], [gorilla]") {
+  auto data64 = sensor_series(10000);
+  std::vector<float> data32(data64.begin(), data64.end());
+
+  auto size64 = check_gorilla_round_trip(Datatype::FLOAT64, data64);
+  auto size32 = check_gorilla_round_trip(Datatype::FLOAT32, data32);
+  CHECK(size64 < data64.size() * sizeof(double) / 8);
+  CHECK(size32 < data32.size() * sizeof(float) / 4);
+}
+
+TEST_CASE(
+    "Compression-Gorilla: Test smooth series", "[compression], [gorilla]") {
+  // Values sharing sign, exponent and high mantissa bits, but never equal
+  std::vector<double> data(1000);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = 1024 + i * 0.25;
+  auto size = check_gorilla_round_trip(Datatype::FLOAT64, data);
+  CHECK(size < data.size() * sizeof(double) / 2);
+}
+
+TEST_CASE(
+    "Compression-Gorilla: Test against DoubleDelta",
+    "[compression], [gorilla]") {
+  // Double delta encoding of the bit patterns of real values hardly
+  // compresses them, whereas XOR-ing consecutive values does
+  auto data64 = sensor_series(10000);
+  std::vector<float> data32(data64.begin(), data64.end());
+  auto codecs64 = comparison_codecs<double>(Datatype::FLOAT64, Datatype::INT64);
+  auto codecs32 = comparison_codecs<float>(Datatype::FLOAT32, Datatype::INT32);
+  CHECK(
+      compressed_size(codecs64[0], data64) <
+      compressed_size(codecs64[2], data64));
+  CHECK(
+      compressed_size(codecs32[0], data32) <
+      compressed_size(codecs32[2], data32));
+}
+
+/**
+ * Reports the compression ratio and the compression throughput of each
+ * codec on the input values.
+ */
+template <class T>
+void report_comparison(
+    const std::string& series,
+    const std::vector<Codec>& codecs,
+    const std::vector<T>& data) {
+  const int iterations = 20;
+  auto nbytes = data.size() * sizeof(T);
+  auto gorilla_size = compressed_size(codecs[0], data);
+  for (const auto& codec : codecs) {
+    auto start = std::chrono::steady_clock::now();
+    uint64_t size = 0;
+    for (int i = 0; i < iterations; ++i)
+      size = compressed_size(codec, data);
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    WARN(
+        series << " " << codec.name << ": " << size << " bytes, ratio "
+               << (double)nbytes / size << ", Gorilla size relative to it "
+               << (double)gorilla_size / size << ", "
+               << nbytes * iterations / elapsed.count() / 1e6 << " MB/s");
+  }
+}
+
+TEST_CASE(
+    "Compression-Gorilla: Benchmark against other compressors",
+    "[.][gorilla_benchmark]") {
+  auto data64 = sensor_series(1000000);
+  std::vector<float> data32(data64.begin(), data64.end());
+  report_comparison(
+      "float64",
+      comparison_codecs<double>(Datatype::FLOAT64, Datatype::INT64),
+      data64);
+  report_comparison(
+      "float32",
+      comparison_codecs<float>(Datatype::FLOAT32, Datatype::INT32),
+      data32);
+}
+
+TEST_CASE(
+    "Compression-Gorilla: Test special values", "[compression], [gorilla]") {
+  std::vector<double> data64 = {0.0,
+                                -0.0,
+                                std::numeric_limits<double>::infinity(),
+                                -std::numeric_limits<double>::infinity(),
+                                std::numeric_limits<double>::quiet_NaN(),
+                                std::numeric_limits<double>::denorm_min(),
+                                std::numeric_limits<double>::max(),
+                                std::numeric_limits<double>::lowest(),
+                                1.0,
+                                1.0};
+  check_gorilla_round_trip(Datatype::FLOAT64, data64);
+
+  std::vector<float> data32 = {std::numeric_limits<float>::quiet_NaN(),
+                               std::numeric_limits<float>::max(),
+                               -0.0f,
+                               std::numeric_limits<float>::denorm_min(),
+                               1.5f};
+  check_gorilla_round_trip(Datatype::FLOAT32, data32);
+
+  // Empty and single-value inputs
+  check_gorilla_round_trip(Datatype::FLOAT64, std::vector<double>());
+  check_gorilla_round_trip(Datatype::FLOAT32, std::vector<float>{3.14f});
+}
+
+TEST_CASE(
+    "Compression-Gorilla: Test random values", "[compression], [gorilla]") {
+  // Random bit patterns exercise the widest windows
+  std::vector<uint64_t> bits(1000);
+  uint64_t seed = 7;
+  for (auto& b : bits) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    b = seed;
+  }
+  std::vector<double> data(bits.size());
+  std::memcpy(data.data(), bits.data(), bits.size() * sizeof(uint64_t));
+  check_gorilla_round_trip(Datatype::FLOAT64, data);
+}
+
+TEST_CASE(
+    "Compression-Gorilla: Test invalid input", "[compression], [gorilla]") {
+  // Only real values are supported
+  std::vector<int32_t> ints = {1, 2, 3};
+  ConstBuffer in(ints.data(), ints.size() * sizeof(int32_t));
+  Buffer out;
+  CHECK(!Gorilla::compress(Datatype::INT32, &in, &out).ok());
+
+  // A truncated bit stream is rejected
+  std::vector<double> data = {1.0, 2.0, 3.0, 4.0};
+  ConstBuffer comp_in(data.data(), data.size() * sizeof(double));
+  Buffer comp_out;
+  REQUIRE(Gorilla::compress(Datatype::FLOAT64, &comp_in, &comp_out).ok());
+  ConstBuffer decomp_in(comp_out.data(), comp_out.size() - sizeof(uint64_t));
+  Buffer decomp_out;
+  CHECK(!Gorilla::decompress(Datatype::FLOAT64, &decomp_in, &decomp_out).ok());
+}
@@ -0,0 +1,102 @@
+/**
+ * @file   unit-compression-gzip.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB Inc.
+ * @copyright Copyright (c) 2016 MIT and Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the gzip compression.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/compressors/gzip_compressor.h"
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace tiledb::sm;
+
+/** Compresses and decompresses the input, returning true on success. */
+static bool round_trip(int level, const std::vector<char>& data) {
+  auto nbytes = data.size();
+
+  // Compress
+  ConstBuffer comp_in_buff(data.data(), nbytes);
+  Buffer comp_out_buff;
+  if (!comp_out_buff.realloc(nbytes + GZip::overhead(nbytes)).ok() ||
+      !GZip::compress(level, &comp_in_buff, &comp_out_buff).ok())
+    return false;
+
+  // Decompress
+  ConstBuffer decomp_in_buff(comp_out_buff.data(), comp_out_buff.size());
+  Buffer decomp_out_buff;
+  if (!decomp_out_buff.realloc(nbytes).ok() ||
+      !GZip::decompress(&decomp_in_buff, &decomp_out_buff).ok())
+    return false;
+
+  // Check data
+  return decomp_out_buff.size() == nbytes &&
+         std::memcmp(data.data(), decomp_out_buff.data(), nbytes) == 0;
+}
+
+TEST_CASE(
+    "Compression-GZip: Test reused streams", "[compression], [gzip]") {
+  std::vector<std::vector<char>> inputs;
+  for (int i = 0; i < 4; ++i) {
+    std::vector<char> data((size_t)(100 * (i + 1)));
+    for (size_t j = 0; j < data.size(); ++j)
+      data[j] = (char)('a' + (j * (i + 3)) % 7);
+    inputs.push_back(data);
+  }
+
+  SECTION("- successive calls with different levels") {
+    bool allok = true;
+    int levels[] = {-1, 1, 1, 9, -1};
+    for (auto level : levels) {
+      for (const auto& data : inputs)
+        allok = allok && round_trip(level, data);
+    }
+    CHECK(allok);
+  }
+
+  SECTION("- concurrent calls") {
+    std::vector<char> results(8, 0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < results.size(); ++t) {
+      threads.emplace_back([&inputs, &results, t]() {
+        bool ok = true;
+        for (int rep = 0; rep < 50; ++rep)
+          ok = ok && round_trip((int)(t % 3) * 4 - 1, inputs[rep % 4]);
+        results[t] = ok;
+      });
+    }
+    for (auto& thread : threads)
+      thread.join();
+    for (auto ok : results)
+      CHECK(ok);
+  }
+}
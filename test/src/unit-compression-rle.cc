@@ -33,9 +33,11 @@
 
 #include <cstring>
 #include <iostream>
+#include <vector>
 
 #include "catch.hpp"
 #include "tiledb/sm/compressors/rle_compressor.h"
+#include "tiledb/sm/misc/constants.h"
 
 using namespace tiledb::sm;
 
@@ -94,7 +96,8 @@ TEST_CASE("Compression-RLE: Test all values unique", "[compression], [rle]") {
   auto decompressed = new Buffer();
   st = decompressed->realloc(sizeof(data));
   REQUIRE(st.ok());
-  st = tiledb::sm::RLE::decompress(sizeof(int), input, decompressed);
+  st = tiledb::sm::RLE::decompress(
+      sizeof(int), constants::format_version, input, decompressed);
   CHECK(st.ok());
   CHECK_FALSE(memcmp(data, decompressed->data(), sizeof(data)));
 
@@ -105,7 +108,7 @@ TEST_CASE("Compression-RLE: Test all values unique", "[compression], [rle]") {
 
 TEST_CASE("Compression-RLE: Test all values the same", "[compression], [rle]") {
   // Initializations
-  uint64_t run_size = 6;
+  uint64_t run_size = 5;
   auto compressed = new Buffer();
   auto decompressed = new Buffer();
   tiledb::sm::Status st;
@@ -132,7 +135,8 @@ TEST_CASE("Compression-RLE: Test all values the same", "[compression], [rle]") {
   st = decompressed->realloc(sizeof(data));
   REQUIRE(st.ok());
   input = new ConstBuffer(compressed->data(), compressed->size());
-  st = tiledb::sm::RLE::decompress(sizeof(int), input, decompressed);
+  st = tiledb::sm::RLE::decompress(
+      sizeof(int), constants::format_version, input, decompressed);
   CHECK(st.ok());
   CHECK_FALSE(memcmp(data, decompressed->data(), sizeof(data)));
 
@@ -145,7 +149,7 @@ TEST_CASE(
     "Compression-RLE: Test a mix of short and long runs",
     "[compression], [rle]") {
   // Initializations
-  uint64_t run_size = 6;
+  uint64_t run_size = 5;
   tiledb::sm::Status st;
 
   // Prepare data
@@ -174,7 +178,8 @@ TEST_CASE(
   st = decompressed->realloc(sizeof(data));
   REQUIRE(st.ok());
   input = new ConstBuffer(compressed->data(), compressed->size());
-  st = tiledb::sm::RLE::decompress(sizeof(int), input, decompressed);
+  st = tiledb::sm::RLE::decompress(
+      sizeof(int), constants::format_version, input, decompressed);
   CHECK(st.ok());
   CHECK_FALSE(memcmp(data, decompressed->data(), sizeof(int)));
 
@@ -184,10 +189,10 @@ TEST_CASE(
 }
 
 TEST_CASE(
-    "Compression-RLE: Test when a run exceeds max run length",
+    "Compression-RLE: Test a run longer than 65535 values",
     "[compression], [rle]") {
   // Initializations
-  uint64_t run_size = 6;
+  uint64_t run_size = 5;
   auto decompressed = new Buffer();
   tiledb::sm::Status st;
 
@@ -209,14 +214,15 @@ TEST_CASE(
   auto input = new ConstBuffer(data, sizeof(data));
   st = tiledb::sm::RLE::compress(sizeof(int), input, compressed);
   CHECK(st.ok());
-  CHECK(compressed->size() == 32 * run_size);
+  CHECK(compressed->size() == 31 * run_size + 2);
   delete input;
 
   // Decompress data
   st = decompressed->realloc(sizeof(data));
   REQUIRE(st.ok());
   input = new ConstBuffer(compressed->data(), compressed->size());
-  st = tiledb::sm::RLE::decompress(sizeof(int), input, decompressed);
+  st = tiledb::sm::RLE::decompress(
+      sizeof(int), constants::format_version, input, decompressed);
   CHECK(st.ok());
   CHECK_FALSE(memcmp(data, decompressed->data(), sizeof(data)));
 
@@ -231,7 +237,7 @@ TEST_CASE(
   // Initializations
   tiledb::sm::Status st;
   uint64_t value_size = 2 * sizeof(double);
-  uint64_t run_size = value_size + 2;
+  uint64_t run_size = value_size + 1;
 
   // Prepare data
   double data[220];
@@ -272,7 +278,8 @@ TEST_CASE(
   st = decompressed->realloc(sizeof(data));
   REQUIRE(st.ok());
   input = new ConstBuffer(compressed->data(), compressed->size());
-  st = tiledb::sm::RLE::decompress(value_size, input, decompressed);
+  st = tiledb::sm::RLE::decompress(
+      value_size, constants::format_version, input, decompressed);
   CHECK(st.ok());
   CHECK_FALSE(memcmp(data, decompressed->data(), sizeof(data)));
 
@@ -280,3 +287,69 @@ TEST_CASE(
   delete compressed;
   delete decompressed;
 }
+
+TEST_CASE(
+    "Compression-RLE: Test decompression of format version 0",
+    "[compression], [rle]") {
+  // Runs of 3 x 7 and 300 x 9 (int16), with big-endian 2-byte lengths
+  unsigned char runs[] = {7, 0, 0, 3, 9, 0, 1, 44};
+  ConstBuffer input(runs, sizeof(runs));
+  Buffer decompressed;
+  auto st = RLE::decompress(sizeof(int16_t), 0, &input, &decompressed);
+  REQUIRE(st.ok());
+  REQUIRE(decompressed.size() == 303 * sizeof(int16_t));
+  auto values = (const int16_t*)decompressed.data();
+  for (int i = 0; i < 303; ++i)
+    CHECK(values[i] == (i < 3 ? 7 : 9));
+
+  // Truncated runs
+  ConstBuffer truncated(runs, sizeof(runs) - 1);
+  Buffer output;
+  CHECK(!RLE::decompress(sizeof(int16_t), 0, &truncated, &output).ok());
+
+  // Runs exceeding the output size
+  int16_t fixed[100];
+  Buffer bounded(fixed, sizeof(fixed), false);
+  bounded.reset_size();
+  ConstBuffer long_runs(runs, sizeof(runs));
+  CHECK(!RLE::decompress(sizeof(int16_t), 0, &long_runs, &bounded).ok());
+}
+
+TEST_CASE(
+    "Compression-RLE: Test runs of 1, 2, 4 and 8-byte values",
+    "[compression], [rle]") {
+  // Runs of all lengths around the scanned blocks of values, for every
+  // specialized value size
+  for (uint64_t value_size : {1, 2, 4, 8}) {
+    std::vector<unsigned char> data;
+    uint64_t run_num = 0;
+    for (uint64_t run_len = 1; run_len <= 40; ++run_len, ++run_num) {
+      for (uint64_t i = 0; i < run_len; ++i) {
+        for (uint64_t b = 0; b < value_size; ++b)
+          data.push_back((unsigned char)(b == value_size - 1 ? run_num : 0));
+      }
+    }
+
+    ConstBuffer input(&data[0], data.size());
+    Buffer compressed;
+    REQUIRE(RLE::compress(value_size, &input, &compressed).ok());
+    CHECK(compressed.size() == run_num * (value_size + 1));
+
+    ConstBuffer compressed_input(compressed.data(), compressed.size());
+    Buffer decompressed;
+    REQUIRE(RLE::decompress(
+                value_size,
+                constants::format_version,
+                &compressed_input,
+                &decompressed)
+                .ok());
+    REQUIRE(decompressed.size() == data.size());
+    CHECK_FALSE(memcmp(&data[0], decompressed.data(), data.size()));
+  }
+
+  // Invalid run length varint
+  unsigned char runs[] = {1, 0x80, 0x80};
+  ConstBuffer invalid(runs, sizeof(runs));
+  Buffer output;
+  CHECK(!RLE::decompress(1, constants::format_version, &invalid, &output).ok());
+}
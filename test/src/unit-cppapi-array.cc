@@ -32,6 +32,10 @@
 
 #include "catch.hpp"
 #include "tiledb/sm/cpp_api/tiledb"
+#include "tiledb/sm/misc/stats.h"
+
+#include <cmath>
+#include <limits>
 
 using namespace tiledb;
 
@@ -252,3 +256,707 @@ TEST_CASE_METHOD(CPPArrayFx, "C++ API: Arrays", "[cppapi]") {
     query.finalize();
   }
 }
+
+TEST_CASE("C++ API: Sparse array with filters", "[cppapi], [cppapi-filters]") {
+  Context ctx;
+  VFS vfs(ctx);
+  std::string array_name = "cpp_unit_array_filters";
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  Compressor compressor = {TILEDB_NO_COMPRESSION, -1};
+  std::vector<tiledb_filter_t> a1_filters, a2_filters, coords_filters,
+      offsets_filters;
+  SECTION("- No compression") {
+    a1_filters = {TILEDB_FILTER_DELTA, TILEDB_FILTER_BIT_WIDTH_REDUCTION};
+    a2_filters = {TILEDB_FILTER_BITSHUFFLE};
+    coords_filters = {TILEDB_FILTER_DOUBLE_DELTA,
+                      TILEDB_FILTER_BIT_WIDTH_REDUCTION};
+    offsets_filters = {TILEDB_FILTER_DOUBLE_DELTA};
+  }
+  SECTION("- Gzip") {
+    compressor = {TILEDB_GZIP, -1};
+    a1_filters = {TILEDB_FILTER_BIT_WIDTH_REDUCTION,
+                  TILEDB_FILTER_BYTESHUFFLE};
+    a2_filters = {TILEDB_FILTER_BYTESHUFFLE};
+    coords_filters = {TILEDB_FILTER_DELTA, TILEDB_FILTER_BYTESHUFFLE};
+    offsets_filters = {TILEDB_FILTER_DELTA,
+                       TILEDB_FILTER_BIT_WIDTH_REDUCTION};
+  }
+  SECTION("- Double delta") {
+    compressor = {TILEDB_DOUBLE_DELTA, -1};
+    a1_filters = {TILEDB_FILTER_DOUBLE_DELTA, TILEDB_FILTER_BITSHUFFLE};
+    a2_filters = {TILEDB_FILTER_DELTA};
+    coords_filters = {TILEDB_FILTER_BYTESHUFFLE};
+    offsets_filters = {TILEDB_FILTER_BIT_WIDTH_REDUCTION};
+  }
+  SECTION("- Frame of reference") {
+    compressor = {TILEDB_FRAME_OF_REFERENCE, -1};
+  }
+  SECTION("- Auto compression") {
+    compressor = {TILEDB_AUTO_COMPRESSION, -1};
+    a1_filters = {TILEDB_FILTER_DELTA};
+    coords_filters = {TILEDB_FILTER_DOUBLE_DELTA};
+  }
+  SECTION("- Compact offsets") {
+    compressor = {TILEDB_GZIP, -1};
+    a1_filters = {TILEDB_FILTER_DELTA};
+    offsets_filters = {TILEDB_FILTER_COMPACT_OFFSETS};
+  }
+  SECTION("- Frame of reference filter") {
+    compressor = {TILEDB_ZSTD, -1};
+    a1_filters = {TILEDB_FILTER_DELTA, TILEDB_FILTER_FRAME_OF_REFERENCE};
+    a2_filters = {TILEDB_FILTER_FRAME_OF_REFERENCE};
+    coords_filters = {TILEDB_FILTER_FRAME_OF_REFERENCE};
+    offsets_filters = {TILEDB_FILTER_DOUBLE_DELTA,
+                       TILEDB_FILTER_FRAME_OF_REFERENCE};
+  }
+
+  // Create array
+  Domain domain(ctx);
+  auto d1 = Dimension::create<int64_t>(ctx, "d1", {{1, 100}}, 10);
+  auto d2 = Dimension::create<int64_t>(ctx, "d2", {{1, 100}}, 10);
+  domain.add_dimensions(d1, d2);
+  auto a1 = Attribute::create<int64_t>(ctx, "a1");
+  auto a2 = Attribute::create<std::string>(ctx, "a2");
+  a1.set_compressor(compressor).set_filters(a1_filters);
+  a2.set_compressor(compressor).set_filters(a2_filters);
+  CHECK(a1.filters() == a1_filters);
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(30);
+  schema.set_coords_compressor(compressor).set_coords_filters(coords_filters);
+  schema.set_offsets_compressor(compressor)
+      .set_offsets_filters(offsets_filters);
+  schema.add_attributes(a1, a2);
+  Array::create(array_name, schema);
+
+  // Invalid filter types are rejected, and compact offsets apply only to
+  // uint64 values
+  auto a3 = Attribute::create<int64_t>(ctx, "a3");
+  REQUIRE_THROWS(a3.set_filters({(tiledb_filter_t)100}));
+  a3.set_filters({TILEDB_FILTER_COMPACT_OFFSETS});
+  ArraySchema bad_schema(ctx, TILEDB_SPARSE);
+  bad_schema.set_domain(domain).add_attribute(a3);
+  REQUIRE_THROWS(bad_schema.check());
+
+  // The filters are loaded with the schema
+  ArraySchema loaded(ctx, array_name);
+  CHECK(loaded.attribute("a1").filters() == a1_filters);
+  CHECK(loaded.attribute("a2").filters() == a2_filters);
+
+  // Write 100 cells in unordered layout
+  int64_t cell_num = 100;
+  std::vector<int64_t> coords, a1_data;
+  std::vector<std::string> a2_data;
+  for (int64_t i = cell_num - 1; i >= 0; --i) {
+    coords.push_back(i / 10 + 1);
+    coords.push_back(i % 10 + 1);
+    a1_data.push_back(i * 37 - 1000);
+    a2_data.push_back(std::string((size_t)(i % 7 + 1), (char)('a' + i % 26)));
+  }
+  auto a2_buf = ungroup_var_buffer(a2_data);
+  {
+    Query query(ctx, array_name, TILEDB_WRITE);
+    query.set_layout(TILEDB_UNORDERED);
+    query.set_coordinates(coords);
+    query.set_buffer("a1", a1_data);
+    query.set_buffer("a2", a2_buf);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    query.finalize();
+  }
+
+  // Read back in row-major order
+  std::vector<int64_t> subarray = {1, 10, 1, 10};
+  std::vector<int64_t> r_coords(2 * cell_num), r_a1(cell_num);
+  std::vector<uint64_t> r_a2_offsets(cell_num);
+  std::vector<char> r_a2_data(a2_buf.second.size());
+  Query query(ctx, array_name, TILEDB_READ);
+  query.set_layout(TILEDB_ROW_MAJOR);
+  query.set_subarray(subarray);
+  query.set_coordinates(r_coords);
+  query.set_buffer("a1", r_a1);
+  query.set_buffer("a2", r_a2_offsets, r_a2_data);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  query.finalize();
+
+  auto r_a2 = group_by_cell<char, std::string>(
+      r_a2_offsets, r_a2_data, (uint64_t)cell_num, r_a2_data.size());
+  bool allok = true;
+  for (int64_t i = 0; i < cell_num; ++i) {
+    allok = allok && (r_coords[2 * i] == i / 10 + 1);
+    allok = allok && (r_coords[2 * i + 1] == i % 10 + 1);
+    allok = allok && (r_a1[i] == i * 37 - 1000);
+    allok = allok &&
+            (r_a2[i] == std::string((size_t)(i % 7 + 1), (char)('a' + i % 26)));
+  }
+  CHECK(allok);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Dictionary-encoded attribute", "[cppapi], [cppapi-dictionary]") {
+  Context ctx;
+  VFS vfs(ctx);
+  std::string array_name = "cpp_unit_array_dictionary";
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  tiledb_array_type_t array_type = TILEDB_DENSE;
+  tiledb_layout_t write_layout = TILEDB_ROW_MAJOR;
+  Compressor compressor = {TILEDB_NO_COMPRESSION, -1};
+  SECTION("- Dense") {
+    compressor = {TILEDB_GZIP, -1};
+  }
+  SECTION("- Sparse") {
+    array_type = TILEDB_SPARSE;
+    write_layout = TILEDB_UNORDERED;
+  }
+
+  // Dictionary encoding applies only to var-sized attributes
+  auto a0 = Attribute::create<int>(ctx, "a0");
+  a0.set_dictionary_encoding(true);
+  ArraySchema bad_schema(ctx, array_type);
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int64_t>(ctx, "d", {{1, 100}}, 10));
+  bad_schema.set_domain(domain).add_attribute(a0);
+  REQUIRE_THROWS(bad_schema.check());
+
+  // Create array
+  auto a1 = Attribute::create<std::string>(ctx, "a1");
+  a1.set_compressor(compressor).set_dictionary_encoding(true);
+  ArraySchema schema(ctx, array_type);
+  schema.set_domain(domain).set_capacity(10).add_attribute(a1);
+  Array::create(array_name, schema);
+  ArraySchema loaded(ctx, array_name);
+  CHECK(loaded.attribute("a1").dictionary_encoding());
+
+  // Write 100 cells with a few distinct values
+  std::vector<std::string> values = {"red", "green", "blue", "yellow"};
+  int64_t cell_num = 100;
+  std::vector<int64_t> coords;
+  std::vector<std::string> a1_data;
+  for (int64_t i = 0; i < cell_num; ++i) {
+    coords.push_back(i + 1);
+    a1_data.push_back(values[(i * i) % values.size()]);
+  }
+  auto a1_buf = ungroup_var_buffer(a1_data);
+  {
+    Query query(ctx, array_name, TILEDB_WRITE);
+    query.set_layout(write_layout);
+    query.set_buffer("a1", a1_buf);
+    if (array_type == TILEDB_SPARSE)
+      query.set_coordinates(coords);
+    else
+      query.set_subarray<int64_t>({1, cell_num});
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    query.finalize();
+  }
+
+  // Read a subarray that partially overlaps the first and last tiles,
+  // with buffers sized on the decoded values
+  std::vector<int64_t> subarray = {5, 94};
+  auto max_el = Array::max_buffer_elements(ctx, array_name, subarray);
+  uint64_t result_num = 90;
+  std::vector<int64_t> r_coords(result_num);
+  std::vector<uint64_t> r_a1_offsets(max_el["a1"].first);
+  std::vector<char> r_a1_data(max_el["a1"].second);
+  Query query(ctx, array_name, TILEDB_READ);
+  query.set_layout(TILEDB_ROW_MAJOR);
+  query.set_subarray(subarray);
+  query.set_buffer("a1", r_a1_offsets, r_a1_data);
+  if (array_type == TILEDB_SPARSE)
+    query.set_coordinates(r_coords);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  query.finalize();
+
+  auto result_el = query.result_buffer_elements();
+  REQUIRE(result_el["a1"].first == result_num);
+  auto r_a1 = group_by_cell<char, std::string>(
+      r_a1_offsets, r_a1_data, result_num, result_el["a1"].second);
+  bool allok = true;
+  for (uint64_t i = 0; i < result_num; ++i)
+    allok = allok && (r_a1[i] == a1_data[i + 4]);
+  CHECK(allok);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Attribute compression dictionary",
+    "[cppapi], [cppapi-compression-dictionary]") {
+  Context ctx;
+  VFS vfs(ctx);
+  std::string array_name = "cpp_unit_array_compression_dictionary";
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Content common to the attribute values
+  std::string dictionary;
+  for (int i = 0; i < 64; ++i)
+    dictionary += "{\"sensor\": \"temperature\", \"unit\": \"celsius\"}";
+
+  // Compression dictionaries apply only to zstd
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int64_t>(ctx, "d", {{1, 100}}, 10));
+  auto a0 = Attribute::create<std::string>(ctx, "a0");
+  a0.set_compressor({TILEDB_GZIP, -1}).set_compression_dictionary(dictionary);
+  ArraySchema bad_schema(ctx, TILEDB_DENSE);
+  bad_schema.set_domain(domain).add_attribute(a0);
+  REQUIRE_THROWS(bad_schema.check());
+
+  // Create array
+  auto a1 = Attribute::create<std::string>(ctx, "a1");
+  a1.set_compressor({TILEDB_ZSTD, -1}).set_compression_dictionary(dictionary);
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain).add_attribute(a1);
+  Array::create(array_name, schema);
+  ArraySchema loaded(ctx, array_name);
+  CHECK(loaded.attribute("a1").compression_dictionary() == dictionary);
+
+  // Write and read back
+  std::vector<std::string> a1_data;
+  for (int i = 0; i < 100; ++i)
+    a1_data.push_back(
+        "{\"sensor\": \"temperature\", \"value\": " + std::to_string(i) + "}");
+  auto a1_buf = ungroup_var_buffer(a1_data);
+  {
+    Query query(ctx, array_name, TILEDB_WRITE);
+    query.set_layout(TILEDB_ROW_MAJOR);
+    query.set_subarray<int64_t>({1, 100});
+    query.set_buffer("a1", a1_buf);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    query.finalize();
+  }
+
+  std::vector<uint64_t> r_a1_offsets(a1_data.size());
+  std::vector<char> r_a1_data(a1_buf.second.size());
+  Query query(ctx, array_name, TILEDB_READ);
+  query.set_layout(TILEDB_ROW_MAJOR);
+  query.set_subarray<int64_t>({1, 100});
+  query.set_buffer("a1", r_a1_offsets, r_a1_data);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  query.finalize();
+  CHECK(r_a1_offsets == a1_buf.first);
+  CHECK(r_a1_data == a1_buf.second);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Auto compression", "[cppapi], [cppapi-auto-compression]") {
+  // Invalid candidate lists are rejected
+  Config bad_config;
+  REQUIRE_THROWS(bad_config["sm.auto_compression_candidates"] = "FOO");
+  REQUIRE_THROWS(
+      bad_config["sm.auto_compression_candidates"] = "LZ4,AUTO_COMPRESSION");
+  REQUIRE_THROWS(bad_config["sm.auto_compression_candidates"] = "ZSTD:x");
+
+  Config config;
+  SECTION("- Default candidates") {
+  }
+  SECTION("- Custom candidates") {
+    config["sm.auto_compression_candidates"] = "RLE,NO_COMPRESSION,GORILLA";
+  }
+  SECTION("- Small chunks") {
+    config["sm.auto_compression_candidates"] = "DOUBLE_DELTA,RLE";
+    config["sm.tile_chunk_size"] = "64";
+  }
+
+  Context ctx(config);
+  VFS vfs(ctx);
+  std::string array_name = "cpp_unit_array_auto_compression";
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create array, with integer, real and var-sized attributes
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int64_t>(ctx, "d", {{1, 1000}}, 500));
+  auto a1 = Attribute::create<int64_t>(ctx, "a1");
+  auto a2 = Attribute::create<double>(ctx, "a2");
+  auto a3 = Attribute::create<std::string>(ctx, "a3");
+  for (auto attr : {&a1, &a2, &a3})
+    attr->set_compressor({TILEDB_AUTO_COMPRESSION, -1});
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain).add_attributes(a1, a2, a3);
+  schema.set_offsets_compressor({TILEDB_AUTO_COMPRESSION, -1});
+  Array::create(array_name, schema);
+  ArraySchema loaded(ctx, array_name);
+  CHECK(
+      loaded.attribute("a1").compressor().compressor() ==
+      TILEDB_AUTO_COMPRESSION);
+
+  // Constant, sequential and noisy regions in the same attributes
+  std::vector<int64_t> a1_data(1000);
+  std::vector<double> a2_data(1000);
+  std::vector<std::string> a3_data(1000);
+  uint64_t seed = 1;
+  for (int i = 0; i < 1000; ++i) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    a1_data[i] = (i < 300) ? 7 : (i < 600) ? i : (int64_t)(seed >> 20);
+    a2_data[i] = (i < 500) ? 0.5 : (double)(seed >> 11) / (1ULL << 53);
+    a3_data[i] = (i < 400) ? "same" : std::to_string(seed >> 40);
+  }
+  auto a3_buf = ungroup_var_buffer(a3_data);
+  {
+    Query query(ctx, array_name, TILEDB_WRITE);
+    query.set_layout(TILEDB_ROW_MAJOR);
+    query.set_subarray<int64_t>({1, 1000});
+    query.set_buffer("a1", a1_data);
+    query.set_buffer("a2", a2_data);
+    query.set_buffer("a3", a3_buf);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    query.finalize();
+  }
+
+  // Read back
+  std::vector<int64_t> r_a1_data(1000);
+  std::vector<double> r_a2_data(1000);
+  std::vector<uint64_t> r_a3_offsets(1000);
+  std::vector<char> r_a3_data(a3_buf.second.size());
+  Query query(ctx, array_name, TILEDB_READ);
+  query.set_layout(TILEDB_ROW_MAJOR);
+  query.set_subarray<int64_t>({1, 1000});
+  query.set_buffer("a1", r_a1_data);
+  query.set_buffer("a2", r_a2_data);
+  query.set_buffer("a3", r_a3_offsets, r_a3_data);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  query.finalize();
+  CHECK(r_a1_data == a1_data);
+  CHECK(r_a2_data == a2_data);
+  CHECK(r_a3_offsets == a3_buf.first);
+  CHECK(r_a3_data == a3_buf.second);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE("C++ API: Gorilla compression", "[cppapi], [cppapi-gorilla]") {
+  Context ctx;
+  VFS vfs(ctx);
+  std::string array_name = "cpp_unit_array_gorilla";
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Gorilla compresses only real values
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int64_t>(ctx, "d", {{1, 1000}}, 100));
+  auto a0 = Attribute::create<int32_t>(ctx, "a0");
+  a0.set_compressor({TILEDB_GORILLA, -1});
+  ArraySchema bad_schema(ctx, TILEDB_DENSE);
+  bad_schema.set_domain(domain).add_attribute(a0);
+  REQUIRE_THROWS(bad_schema.check());
+
+  // Create array
+  auto a1 = Attribute::create<double>(ctx, "a1");
+  auto a2 = Attribute::create<float>(ctx, "a2");
+  a1.set_compressor({TILEDB_GORILLA, -1});
+  a2.set_compressor({TILEDB_GORILLA, -1});
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain).add_attributes(a1, a2);
+  Array::create(array_name, schema);
+
+  // Write and read back
+  std::vector<double> a1_data(1000);
+  std::vector<float> a2_data(1000);
+  for (int i = 0; i < 1000; ++i) {
+    a1_data[i] = 20 + (i / 7) * 0.1;
+    a2_data[i] = (float)a1_data[i];
+  }
+  {
+    Query query(ctx, array_name, TILEDB_WRITE);
+    query.set_layout(TILEDB_ROW_MAJOR);
+    query.set_subarray<int64_t>({1, 1000});
+    query.set_buffer("a1", a1_data);
+    query.set_buffer("a2", a2_data);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    query.finalize();
+  }
+
+  std::vector<double> r_a1_data(1000);
+  std::vector<float> r_a2_data(1000);
+  Query query(ctx, array_name, TILEDB_READ);
+  query.set_layout(TILEDB_ROW_MAJOR);
+  query.set_subarray<int64_t>({1, 1000});
+  query.set_buffer("a1", r_a1_data);
+  query.set_buffer("a2", r_a2_data);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  query.finalize();
+  CHECK(r_a1_data == a1_data);
+  CHECK(r_a2_data == a2_data);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Quantization of real attributes",
+    "[cppapi], [cppapi-quantization]") {
+  Context ctx;
+  VFS vfs(ctx);
+  std::string array_name = "cpp_unit_array_quantization";
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int64_t>(ctx, "d", {{1, 1000}}, 100));
+
+  // Invalid precision
+  auto a0 = Attribute::create<double>(ctx, "a0");
+  REQUIRE_THROWS(a0.set_quantization(-1));
+  REQUIRE_THROWS(a0.set_quantization(16));
+
+  // Quantization requires a compressed or filtered real attribute
+  a0.set_quantization(2);
+  ArraySchema uncompressed_schema(ctx, TILEDB_DENSE);
+  uncompressed_schema.set_domain(domain).add_attribute(a0);
+  REQUIRE_THROWS(uncompressed_schema.check());
+  auto a_int = Attribute::create<int32_t>(ctx, "a_int");
+  a_int.set_compressor({TILEDB_ZSTD, -1}).set_quantization(2);
+  ArraySchema int_schema(ctx, TILEDB_DENSE);
+  int_schema.set_domain(domain).add_attribute(a_int);
+  REQUIRE_THROWS(int_schema.check());
+
+  // Quantized values are compressed as integers
+  auto a1 = Attribute::create<double>(ctx, "a1");
+  auto a2 = Attribute::create<float>(ctx, "a2");
+  a1.set_compressor({TILEDB_DOUBLE_DELTA, -1}).set_quantization(3);
+  a2.set_compressor({TILEDB_ZSTD, -1})
+      .set_filters({TILEDB_FILTER_DELTA, TILEDB_FILTER_BIT_WIDTH_REDUCTION})
+      .set_quantization(1);
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain).add_attributes(a1, a2);
+  Array::create(array_name, schema);
+
+  ArraySchema loaded(ctx, array_name);
+  CHECK(loaded.attribute("a1").quantized());
+  CHECK(loaded.attribute("a1").quantization_digits() == 3);
+  CHECK(loaded.attribute("a2").quantized());
+  CHECK(loaded.attribute("a2").quantization_digits() == 1);
+
+  // Write and read back
+  std::vector<double> a1_data(1000);
+  std::vector<float> a2_data(1000);
+  for (int i = 0; i < 1000; ++i) {
+    a1_data[i] = 20 + std::sin(i * 0.01) + i * 1e-5;
+    a2_data[i] = (float)(-5 + i * 0.037);
+  }
+  {
+    Query query(ctx, array_name, TILEDB_WRITE);
+    query.set_layout(TILEDB_ROW_MAJOR);
+    query.set_subarray<int64_t>({1, 1000});
+    query.set_buffer("a1", a1_data);
+    query.set_buffer("a2", a2_data);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    query.finalize();
+  }
+
+  std::vector<double> r_a1_data(1000);
+  std::vector<float> r_a2_data(1000);
+  {
+    Query query(ctx, array_name, TILEDB_READ);
+    query.set_layout(TILEDB_ROW_MAJOR);
+    query.set_subarray<int64_t>({1, 1000});
+    query.set_buffer("a1", r_a1_data);
+    query.set_buffer("a2", r_a2_data);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    query.finalize();
+  }
+  for (int i = 0; i < 1000; ++i) {
+    CHECK(std::fabs(r_a1_data[i] - a1_data[i]) <= 0.0005 + 1e-9);
+    CHECK(std::fabs(r_a2_data[i] - a2_data[i]) <= 0.05 + 1e-5);
+    CHECK(r_a1_data[i] == std::round(r_a1_data[i] * 1000) / 1000);
+  }
+
+  // Values that do not fit the quantized integers cannot be written
+  a1_data[10] = 1e300;
+  Query query(ctx, array_name, TILEDB_WRITE);
+  query.set_layout(TILEDB_ROW_MAJOR);
+  query.set_subarray<int64_t>({1, 1000});
+  query.set_buffer("a1", a1_data);
+  query.set_buffer("a2", a2_data);
+  REQUIRE_THROWS(query.submit());
+
+  // A partial dense write fills the rest of its tiles with the empty value,
+  // which must be quantized as well. Written empty values are read back
+  vfs.remove_dir(array_name);
+  Array::create(array_name, schema);
+  a1_data[10] = std::numeric_limits<double>::max();
+  a2_data[10] = std::numeric_limits<float>::max();
+  std::vector<double> p_a1_data(a1_data.begin() + 4, a1_data.begin() + 250);
+  std::vector<float> p_a2_data(a2_data.begin() + 4, a2_data.begin() + 250);
+  {
+    Query query(ctx, array_name, TILEDB_WRITE);
+    query.set_layout(TILEDB_ROW_MAJOR);
+    query.set_subarray<int64_t>({5, 250});
+    query.set_buffer("a1", p_a1_data);
+    query.set_buffer("a2", p_a2_data);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    query.finalize();
+  }
+  {
+    Query query(ctx, array_name, TILEDB_READ);
+    query.set_layout(TILEDB_ROW_MAJOR);
+    query.set_subarray<int64_t>({1, 1000});
+    query.set_buffer("a1", r_a1_data);
+    query.set_buffer("a2", r_a2_data);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    query.finalize();
+  }
+  for (int i = 0; i < 1000; ++i) {
+    if (i >= 4 && i < 250) {
+      CHECK(std::fabs(r_a1_data[i] - a1_data[i]) <= 0.0005 + 1e-9);
+      CHECK(std::fabs(r_a2_data[i] - a2_data[i]) <= 0.05 + 1e-5);
+    } else {
+      CHECK(r_a1_data[i] == std::numeric_limits<double>::max());
+      CHECK(r_a2_data[i] == std::numeric_limits<float>::max());
+    }
+  }
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Compressed tile cache",
+    "[cppapi], [cppapi-compressed-tile-cache]") {
+  std::string array_name = "cpp_unit_array_compressed_tile_cache";
+  {
+    Context ctx;
+    VFS vfs(ctx);
+    if (vfs.is_dir(array_name))
+      vfs.remove_dir(array_name);
+
+    Domain domain(ctx);
+    domain.add_dimension(
+        Dimension::create<int64_t>(ctx, "d", {{1, 1000}}, 100));
+    auto a = Attribute::create<int32_t>(ctx, "a");
+    a.set_compressor({TILEDB_ZSTD, -1});
+    ArraySchema schema(ctx, TILEDB_DENSE);
+    schema.set_domain(domain).add_attribute(a);
+    Array::create(array_name, schema);
+
+    std::vector<int32_t> data(1000);
+    for (int i = 0; i < 1000; ++i)
+      data[i] = i % 7;
+    Query query(ctx, array_name, TILEDB_WRITE);
+    query.set_layout(TILEDB_ROW_MAJOR);
+    query.set_subarray<int64_t>({1, 1000});
+    query.set_buffer("a", data);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    query.finalize();
+  }
+
+  // Reads the array, returning the number of bytes read from storage
+  auto read = [&](Context& ctx) {
+    tiledb_stats_reset();
+    std::vector<int32_t> data(1000);
+    Query query(ctx, array_name, TILEDB_READ);
+    query.set_layout(TILEDB_ROW_MAJOR);
+    query.set_subarray<int64_t>({1, 1000});
+    query.set_buffer("a", data);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    query.finalize();
+    for (int i = 0; i < 1000; ++i)
+      CHECK(data[i] == i % 7);
+    return (uint64_t)tiledb::sm::stats::all_stats.counter_vfs_read_total_bytes;
+  };
+
+  tiledb_stats_enable();
+
+  // The decompressed tiles are not cached, but are promoted from the
+  // compressed tile cache without reading from storage again
+  Config config;
+  config["sm.tile_cache_size"] = "0";
+  {
+    Context ctx(config);
+    CHECK(read(ctx) > 0);
+    CHECK(read(ctx) == 0);
+  }
+
+  // Without caches every read goes to storage
+  config["sm.compressed_tile_cache_size"] = "0";
+  {
+    Context ctx(config);
+    read(ctx);
+    CHECK(read(ctx) > 0);
+  }
+
+  tiledb_stats_disable();
+
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Query cache fill", "[cppapi], [cppapi-query-cache-fill]") {
+  std::string array_name = "cpp_unit_array_query_cache_fill";
+  {
+    Context ctx;
+    VFS vfs(ctx);
+    if (vfs.is_dir(array_name))
+      vfs.remove_dir(array_name);
+
+    Domain domain(ctx);
+    domain.add_dimension(
+        Dimension::create<int64_t>(ctx, "d", {{1, 1000}}, 100));
+    auto a = Attribute::create<int32_t>(ctx, "a");
+    a.set_compressor({TILEDB_ZSTD, -1});
+    ArraySchema schema(ctx, TILEDB_DENSE);
+    schema.set_domain(domain).add_attribute(a);
+    Array::create(array_name, schema);
+
+    std::vector<int32_t> data(1000);
+    for (int i = 0; i < 1000; ++i)
+      data[i] = i % 7;
+    Query query(ctx, array_name, TILEDB_WRITE);
+    query.set_layout(TILEDB_ROW_MAJOR);
+    query.set_subarray<int64_t>({1, 1000});
+    query.set_buffer("a", data);
+    REQUIRE_THROWS(query.set_cache_fill(false));
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    query.finalize();
+  }
+
+  // Reads the array, returning the number of bytes read from storage
+  auto read = [&](Context& ctx, bool cache_fill) {
+    tiledb_stats_reset();
+    std::vector<int32_t> data(1000);
+    Query query(ctx, array_name, TILEDB_READ);
+    query.set_layout(TILEDB_ROW_MAJOR);
+    query.set_subarray<int64_t>({1, 1000});
+    query.set_buffer("a", data);
+    query.set_cache_fill(cache_fill);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    query.finalize();
+    for (int i = 0; i < 1000; ++i)
+      CHECK(data[i] == i % 7);
+    return (uint64_t)tiledb::sm::stats::all_stats.counter_vfs_read_total_bytes;
+  };
+
+  tiledb_stats_enable();
+
+  // Reads without cache fill leave the caches empty, but use them once
+  // another read has filled them
+  for (auto policy : {"lru", "slru"}) {
+    Config config;
+    config["sm.tile_cache_policy"] = policy;
+    Context ctx(config);
+    CHECK(read(ctx, false) > 0);
+    CHECK(read(ctx, false) > 0);
+    CHECK(read(ctx, true) > 0);
+    CHECK(read(ctx, false) == 0);
+  }
+
+  tiledb_stats_disable();
+
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
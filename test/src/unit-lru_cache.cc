@@ -135,4 +135,165 @@ TEST_CASE_METHOD(LRUCacheFx, "Unit-test class LRUCache", "[lru_cache]") {
   auto it = lru_cache_->item_iter_begin();
   auto it_end = lru_cache_->item_iter_end();
   CHECK(it == it_end);
+  st = lru_cache_->read("v2", &b2, 0, sizeof(int), &success);
+  CHECK(st.ok());
+  CHECK(!success);
+}
+
+TEST_CASE_METHOD(
+    LRUCacheFx, "Unit-test class LRUCache, shared buffers", "[lru_cache]") {
+  // Insert a null buffer
+  Status st = lru_cache_->insert("key", std::shared_ptr<Buffer>());
+  CHECK(!st.ok());
+
+  // Insert two buffers
+  auto b1 = std::make_shared<Buffer>();
+  auto b2 = std::make_shared<Buffer>();
+  for (int i = 0; i < 3; ++i) {
+    CHECK(b1->write(&i, sizeof(int)).ok());
+    int j = 3 + i;
+    CHECK(b2->write(&j, sizeof(int)).ok());
+  }
+  st = lru_cache_->insert("b1", b1);
+  CHECK(st.ok());
+  st = lru_cache_->insert("b2", b2);
+  CHECK(st.ok());
+  CHECK(check_key_order("b1b2"));
+
+  // The buffer is shared, not copied
+  std::shared_ptr<Buffer> shared;
+  bool success;
+  st = lru_cache_->read_shared("b1", &shared, &success);
+  CHECK(st.ok());
+  CHECK(success);
+  CHECK(shared == b1);
+  CHECK(check_key_order("b2b1"));
+
+  // Shared items can also be copied out
+  int v;
+  st = lru_cache_->read("b2", &v, sizeof(int), sizeof(int), &success);
+  CHECK(st.ok());
+  CHECK(success);
+  CHECK(v == 4);
+
+  // Items inserted by copy cannot be shared
+  auto v1 = (int*)std::malloc(sizeof(int));
+  *v1 = 7;
+  st = lru_cache_->insert("v1", v1, sizeof(int));
+  CHECK(st.ok());
+  st = lru_cache_->read_shared("v1", &shared, &success);
+  CHECK(st.ok());
+  CHECK(!success);
+
+  // Eviction releases the cache reference, but the buffer survives for
+  // the remaining owners
+  auto b3 = std::make_shared<Buffer>();
+  CHECK(b3->realloc(7 * sizeof(int)).ok());
+  b3->set_size(7 * sizeof(int));
+  st = lru_cache_->insert("b3", b3);
+  CHECK(st.ok());
+  CHECK(check_key_order("v1b3"));
+  CHECK(b1.use_count() == 2);
+  CHECK(b2.use_count() == 1);
+  CHECK(((int*)shared->data())[2] == 2);
+
+  // Test clear
+  lru_cache_->clear();
+  CHECK(b3.use_count() == 1);
+}
+
+TEST_CASE("Unit-test class LRUCache, segmented LRU", "[lru_cache]") {
+  LRUCache cache(
+      CACHE_SIZE, nullptr, nullptr, LRUCache::Policy::SEGMENTED_LRU);
+  LRUCache lru_cache(CACHE_SIZE);
+  CHECK(cache.policy() == LRUCache::Policy::SEGMENTED_LRU);
+  CHECK(lru_cache.policy() == LRUCache::Policy::LRU);
+
+  // Inserts an integer object
+  auto insert = [](LRUCache* cache, const std::string& key, int v) {
+    auto object = (int*)std::malloc(sizeof(int));
+    *object = v;
+    CHECK(cache->insert(key, object, sizeof(int)).ok());
+  };
+
+  // Reads an integer object, returning whether it was cached
+  auto read = [](LRUCache* cache, const std::string& key) {
+    int v;
+    bool success;
+    CHECK(cache->read(key, &v, 0, sizeof(int), &success).ok());
+    return success;
+  };
+
+  // Returns the keys of the probationary segment in eviction order
+  auto probation_keys = [](const LRUCache& cache) {
+    std::string keys;
+    for (auto it = cache.item_iter_begin(); it != cache.item_iter_end(); ++it)
+      keys += it->key_;
+    return keys;
+  };
+
+  // A read object survives a scan over more objects than the cache fits
+  insert(&cache, "h", 0);
+  insert(&lru_cache, "h", 0);
+  CHECK(read(&cache, "h"));
+  CHECK(read(&lru_cache, "h"));
+  CHECK(probation_keys(cache).empty());
+  for (int i = 0; i < 20; ++i) {
+    insert(&cache, "s" + std::to_string(i), i);
+    insert(&lru_cache, "s" + std::to_string(i), i);
+  }
+  CHECK(read(&cache, "h"));
+  CHECK(!read(&lru_cache, "h"));
+  CHECK(!read(&cache, "s10"));
+  CHECK(read(&cache, "s11"));
+
+  // The protected segment takes up to 80% of the cache, demoting its least
+  // recently used objects to the probationary segment
+  cache.clear();
+  std::string keys = "abcdefghi";
+  for (auto k : keys)
+    insert(&cache, std::string(1, k), 0);
+  for (auto k : keys)
+    CHECK(read(&cache, std::string(1, k)));
+  CHECK(probation_keys(cache) == "a");
+
+  // Demoted objects are evicted first
+  insert(&cache, "x", 0);
+  insert(&cache, "y", 0);
+  CHECK(probation_keys(cache) == "xy");
+  CHECK(!read(&cache, "a"));
+  CHECK(read(&cache, "b"));
+
+  // Overwriting an object resets it to the probationary segment
+  insert(&cache, "b", 1);
+  CHECK(probation_keys(cache) == "xyb");
+
+  // Inserting an existing object without overwriting keeps its segment
+  CHECK(read(&cache, "c"));
+  auto object = (int*)std::malloc(sizeof(int));
+  CHECK(cache.insert("c", object, sizeof(int), false).ok());
+  CHECK(probation_keys(cache) == "xyb");
+
+  // Reading a shared object without promoting it keeps it in probation
+  auto shared = std::make_shared<Buffer>();
+  int value = 0;
+  CHECK(shared->write(&value, sizeof(int)).ok());
+  CHECK(cache.insert("z", shared).ok());
+  std::shared_ptr<Buffer> read_buffer;
+  bool success;
+  CHECK(cache.read_shared("z", &read_buffer, &success, false).ok());
+  CHECK(success);
+  CHECK(probation_keys(cache) == "ybz");
+  CHECK(cache.read_shared("z", &read_buffer, &success).ok());
+  CHECK(probation_keys(cache) == "yb");
+
+  // Invalidation removes the objects of both segments by key prefix
+  cache.clear();
+  for (auto k : {"f1+0", "f1+8", "f2+0"})
+    insert(&cache, k, 0);
+  CHECK(read(&cache, "f1+8"));
+  cache.invalidate("f1+");
+  CHECK(!read(&cache, "f1+0"));
+  CHECK(!read(&cache, "f1+8"));
+  CHECK(read(&cache, "f2+0"));
 }
@@ -0,0 +1,188 @@
+/**
+ * @file unit-sharded_lru_cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file unit-tests class ShardedLRUCache. It also contains a lock
+ * contention benchmark, which is hidden by default and can be run with the
+ * `[sharded_lru_cache_benchmark]` tag.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/cache/sharded_lru_cache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
+using namespace tiledb::sm;
+
+TEST_CASE("Unit-test class ShardedLRUCache", "[sharded_lru_cache]") {
+  ShardedLRUCache cache(100 * sizeof(int), 4);
+  CHECK(cache.shard_num() == 4);
+  CHECK(cache.max_size() == 100 * sizeof(int));
+  CHECK(cache.max_object_size() == 25 * sizeof(int));
+
+  // Objects larger than a shard are not cached
+  auto big = std::make_shared<Buffer>();
+  CHECK(big->realloc(26 * sizeof(int)).ok());
+  big->set_size(26 * sizeof(int));
+  CHECK(cache.insert("big", big).ok());
+  std::shared_ptr<Buffer> shared;
+  bool success;
+  CHECK(cache.read_shared("big", &shared, &success).ok());
+  CHECK(!success);
+
+  // Insert and read back objects spread over the shards
+  for (int i = 0; i < 20; ++i) {
+    auto v = (int*)std::malloc(sizeof(int));
+    *v = i;
+    CHECK(cache.insert("key" + std::to_string(i), v, sizeof(int)).ok());
+  }
+  for (int i = 0; i < 20; ++i) {
+    int v = -1;
+    CHECK(cache.read("key" + std::to_string(i), &v, 0, sizeof(int), &success)
+              .ok());
+    CHECK(success);
+    CHECK(v == i);
+  }
+  Buffer buff;
+  CHECK(cache.read("key3", &buff, &success).ok());
+  CHECK(success);
+  CHECK(buff.size() == sizeof(int));
+  CHECK(buff.value<int>(0) == 3);
+
+  // Shared buffers
+  auto b = std::make_shared<Buffer>();
+  int value = 42;
+  CHECK(b->write(&value, sizeof(int)).ok());
+  CHECK(cache.insert("b", b).ok());
+  CHECK(cache.read_shared("b", &shared, &success).ok());
+  CHECK(success);
+  CHECK(shared == b);
+
+  // Filling the cache evicts objects, but never beyond its size
+  for (int i = 0; i < 1000; ++i) {
+    auto v = (int*)std::malloc(sizeof(int));
+    *v = i;
+    CHECK(cache.insert("fill" + std::to_string(i), v, sizeof(int)).ok());
+  }
+  int cached = 0;
+  for (int i = 0; i < 1000; ++i) {
+    int v;
+    CHECK(cache.read("fill" + std::to_string(i), &v, 0, sizeof(int), &success)
+              .ok());
+    cached += success;
+  }
+  CHECK(cached > 0);
+  CHECK(cached <= 100);
+
+  // Clear
+  cache.clear();
+  CHECK(cache.read("fill999", &value, 0, sizeof(int), &success).ok());
+  CHECK(!success);
+  CHECK(b.use_count() == 2);
+}
+
+TEST_CASE(
+    "Unit-test class ShardedLRUCache, concurrent accesses",
+    "[sharded_lru_cache]") {
+  ShardedLRUCache cache(1000 * sizeof(int), 8);
+  const int thread_num = 8, key_num = 200;
+  std::vector<std::thread> threads;
+  std::vector<int> errors(thread_num, 0);
+  for (int t = 0; t < thread_num; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < 2000; ++i) {
+        auto k = (i * 7 + t) % key_num;
+        auto key = std::to_string(k);
+        std::shared_ptr<Buffer> shared;
+        bool success;
+        if (!cache.read_shared(key, &shared, &success).ok())
+          ++errors[t];
+        if (success) {
+          if (shared->value<int>(0) != k)
+            ++errors[t];
+          continue;
+        }
+        auto b = std::make_shared<Buffer>();
+        if (!b->write(&k, sizeof(int)).ok() || !cache.insert(key, b).ok())
+          ++errors[t];
+      }
+    });
+  }
+  for (auto& t : threads)
+    t.join();
+  for (auto e : errors)
+    CHECK(e == 0);
+}
+
+TEST_CASE(
+    "Benchmark ShardedLRUCache lock contention",
+    "[.], [sharded_lru_cache_benchmark]") {
+  const unsigned thread_num = 32;
+  const int key_num = 4096, lookup_num = 200000;
+
+  std::vector<std::string> keys;
+  for (int k = 0; k < key_num; ++k)
+    keys.push_back("tile_" + std::to_string(k));
+
+  for (unsigned shard_num : {1u, 4u, 16u, 64u}) {
+    ShardedLRUCache cache(key_num * 1024, shard_num);
+    for (int k = 0; k < key_num; ++k) {
+      auto b = std::make_shared<Buffer>();
+      REQUIRE(b->realloc(1024).ok());
+      b->set_size(1024);
+      REQUIRE(cache.insert(keys[k], b).ok());
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < thread_num; ++t) {
+      threads.emplace_back([&, t]() {
+        std::shared_ptr<Buffer> shared;
+        bool success;
+        for (int i = 0; i < lookup_num; ++i) {
+          auto& key = keys[(i * 31 + t * 17) % key_num];
+          cache.read_shared(key, &shared, &success);
+        }
+      });
+    }
+    for (auto& t : threads)
+      t.join();
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                  std::chrono::steady_clock::now() - start)
+                  .count();
+
+    WARN(
+        shard_num << " shard(s), " << thread_num << " threads: "
+                  << (uint64_t)thread_num * lookup_num /
+                         std::max<int64_t>(ms, 1)
+                  << " lookups/ms");
+  }
+}
@@ -0,0 +1,127 @@
+/**
+ * @file unit-tile.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the `Tile` class.
+ */
+
+#include "tiledb/sm/tile/tile.h"
+
+#include <catch.hpp>
+#include <cstdlib>
+#include <vector>
+
+using namespace tiledb::sm;
+
+TEST_CASE("Tile: Test split and zip coordinates", "[tile]") {
+  const uint64_t cell_num = 37;
+  for (uint64_t coord_size : {1, 2, 3, 4, 8}) {
+    for (unsigned int dim_num = 1; dim_num <= 5; ++dim_num) {
+      // Zipped coordinates with distinct bytes
+      auto cell_size = coord_size * dim_num;
+      std::vector<unsigned char> zipped(cell_num * cell_size);
+      for (uint64_t i = 0; i < zipped.size(); ++i)
+        zipped[i] = (unsigned char)(i * 7 + 3);
+
+      Tile tile;
+      REQUIRE(tile.init(
+                      Datatype::UINT8,
+                      Compressor::NO_COMPRESSION,
+                      -1,
+                      zipped.size(),
+                      cell_size,
+                      dim_num)
+                  .ok());
+      REQUIRE(tile.write(zipped.data(), zipped.size()).ok());
+
+      // Split
+      tile.split_coordinates();
+      auto data = (const unsigned char*)tile.data();
+      for (uint64_t i = 0; i < cell_num; ++i) {
+        for (unsigned int j = 0; j < dim_num; ++j) {
+          for (uint64_t b = 0; b < coord_size; ++b) {
+            CHECK(
+                data[(j * cell_num + i) * coord_size + b] ==
+                zipped[i * cell_size + j * coord_size + b]);
+          }
+        }
+      }
+
+      // Zip back
+      tile.zip_coordinates();
+      CHECK(std::vector<unsigned char>(data, data + zipped.size()) == zipped);
+    }
+  }
+}
+
+TEST_CASE("Tile: Test wrapping existing data", "[tile]") {
+  const uint64_t cell_num = 100;
+  const uint64_t size = cell_num * sizeof(int);
+  auto data = (int*)std::malloc(size);
+  REQUIRE(data != nullptr);
+  for (uint64_t i = 0; i < cell_num; ++i)
+    data[i] = (int)i;
+
+  {
+    Tile tile;
+    REQUIRE(tile
+                .init(
+                    Datatype::INT32,
+                    Compressor::NO_COMPRESSION,
+                    -1,
+                    sizeof(int),
+                    0,
+                    data,
+                    size)
+                .ok());
+
+    // The tile aliases the data without owning them
+    CHECK(tile.data() == data);
+    CHECK(tile.size() == size);
+    CHECK(!tile.buffer()->owns_data());
+
+    // The data cannot be reallocated through the tile
+    CHECK(!tile.realloc(2 * size).ok());
+    CHECK(tile.data() == data);
+
+    // Copies alias the same data
+    Tile copy(tile);
+    CHECK(copy.data() == data);
+    CHECK(copy.size() == size);
+    CHECK(!copy.buffer()->owns_data());
+    std::vector<int> read(cell_num);
+    REQUIRE(copy.read(read.data(), size).ok());
+    for (uint64_t i = 0; i < cell_num; ++i)
+      CHECK(read[i] == (int)i);
+  }
+
+  // The tiles did not free the data
+  for (uint64_t i = 0; i < cell_num; ++i)
+    CHECK(data[i] == (int)i);
+  std::free(data);
+}
@@ -0,0 +1,106 @@
+/**
+ * @file unit-utils.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the utility functions.
+ */
+
+#include "tiledb/sm/misc/utils.h"
+
+#include <catch.hpp>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace tiledb::sm;
+
+/** Computes the MBR of the coordinates by expanding it cell by cell. */
+template <class T>
+static std::vector<T> naive_mbr(
+    const std::vector<T>& coords, unsigned int dim_num) {
+  std::vector<T> mbr(2 * dim_num);
+  for (unsigned int d = 0; d < dim_num; ++d)
+    mbr[2 * d] = mbr[2 * d + 1] = coords[d];
+  auto cell_num = coords.size() / dim_num;
+  for (uint64_t i = 1; i < cell_num; ++i) {
+    for (unsigned int d = 0; d < dim_num; ++d) {
+      auto c = coords[i * dim_num + d];
+      if (c < mbr[2 * d])
+        mbr[2 * d] = c;
+      if (c > mbr[2 * d + 1])
+        mbr[2 * d + 1] = c;
+    }
+  }
+  return mbr;
+}
+
+/** Checks `utils::compute_mbr` against `naive_mbr` on random coordinates. */
+template <class T, class Distribution>
+static void check_compute_mbr(Distribution dist) {
+  std::mt19937 gen(7);
+  for (unsigned int dim_num : {1, 2, 3, 4, 5, 7}) {
+    for (uint64_t cell_num : {1, 2, 17, 1000}) {
+      std::vector<T> coords(cell_num * dim_num);
+      for (auto& c : coords)
+        c = (T)dist(gen);
+      std::vector<T> mbr(2 * dim_num);
+      utils::compute_mbr(coords.data(), cell_num, dim_num, mbr.data());
+      CHECK(mbr == naive_mbr(coords, dim_num));
+    }
+  }
+}
+
+TEST_CASE("Utils: Test compute_mbr", "[utils]") {
+  SECTION("- int8") {
+    check_compute_mbr<int8_t>(std::uniform_int_distribution<int>(-128, 127));
+  }
+
+  SECTION("- int32") {
+    check_compute_mbr<int>(std::uniform_int_distribution<int>(-1000, 1000));
+  }
+
+  SECTION("- uint64") {
+    check_compute_mbr<uint64_t>(std::uniform_int_distribution<uint64_t>());
+  }
+
+  SECTION("- float64") {
+    check_compute_mbr<double>(std::uniform_real_distribution<double>(-1, 1));
+  }
+}
+
+TEST_CASE("Utils: Test compute_mbr on a 2D tile", "[utils]") {
+  // All cells are equal, except for one that expands the low bound of the
+  // first dimension and the high bound of the second
+  int64_t coords[] = {3, 5, 3, 5, -2, 9, 3, 5};
+  int64_t mbr[4];
+  utils::compute_mbr(coords, 4, 2, mbr);
+  CHECK(mbr[0] == -2);
+  CHECK(mbr[1] == 3);
+  CHECK(mbr[2] == 5);
+  CHECK(mbr[3] == 9);
+}
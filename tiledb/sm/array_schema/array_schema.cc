@@ -56,6 +56,7 @@ ArraySchema::ArraySchema() {
   cell_var_offsets_compression_ = constants::cell_var_offsets_compression;
   cell_var_offsets_compression_level_ =
       constants::cell_var_offsets_compression_level;
+  cell_var_offsets_filters_ = {constants::cell_var_offsets_filter};
   coords_compression_ = constants::coords_compression;
   coords_compression_level_ = constants::coords_compression_level;
   is_kv_ = false;
@@ -73,6 +74,7 @@ ArraySchema::ArraySchema(ArrayType array_type)
   cell_var_offsets_compression_ = constants::cell_var_offsets_compression;
   cell_var_offsets_compression_level_ =
       constants::cell_var_offsets_compression_level;
+  cell_var_offsets_filters_ = {constants::cell_var_offsets_filter};
   coords_compression_ = constants::coords_compression;
   coords_compression_level_ = constants::coords_compression_level;
   is_kv_ = false;
@@ -94,6 +96,8 @@ ArraySchema::ArraySchema(const ArraySchema* array_schema) {
       array_schema->cell_var_offsets_compression_level_;
   coords_compression_ = array_schema->coords_compression_;
   coords_compression_level_ = array_schema->coords_compression_level_;
+  cell_var_offsets_filters_ = array_schema->cell_var_offsets_filters_;
+  coords_filters_ = array_schema->coords_filters_;
   coords_size_ = array_schema->coords_size_;
   is_kv_ = array_schema->is_kv_;
   domain_ = array_schema->domain_;
@@ -276,6 +280,10 @@ int ArraySchema::cell_var_offsets_compression_level() const {
   return cell_var_offsets_compression_level_;
 }
 
+const std::vector<Filter>& ArraySchema::cell_var_offsets_filters() const {
+  return cell_var_offsets_filters_;
+}
+
 Status ArraySchema::check() const {
   if (domain_ == nullptr)
     return LOG_STATUS(
@@ -303,10 +311,35 @@ Status ArraySchema::check() const {
     }
   }
 
-  if (!check_double_delta_compressor())
+  if (!check_integer_compressors())
     return LOG_STATUS(Status::ArraySchemaError(
-        "Array schema check failed; Double delta compression can be used "
-        "only with integer values"));
+        "Array schema check failed; Double delta and frame of reference "
+        "compression can be used only with integer values"));
+
+  if (!check_real_compressors())
+    return LOG_STATUS(Status::ArraySchemaError(
+        "Array schema check failed; Gorilla compression can be used only "
+        "with real values"));
+
+  if (!check_filters())
+    return LOG_STATUS(Status::ArraySchemaError(
+        "Array schema check failed; Invalid filter type, or compact offsets "
+        "filter used with non-uint64 values"));
+
+  if (!check_compression_dictionaries())
+    return LOG_STATUS(Status::ArraySchemaError(
+        "Array schema check failed; Compression dictionaries can be used "
+        "only with the ZSTD compressor"));
+
+  if (!check_dictionary_encoding())
+    return LOG_STATUS(Status::ArraySchemaError(
+        "Array schema check failed; Dictionary encoding can be used only "
+        "with variable-sized attributes"));
+
+  if (!check_quantization())
+    return LOG_STATUS(Status::ArraySchemaError(
+        "Array schema check failed; Quantization can be used only with "
+        "compressed or filtered fixed-sized real attributes"));
 
   if (!check_attribute_dimension_names())
     return LOG_STATUS(
@@ -367,6 +400,10 @@ int ArraySchema::coords_compression_level() const {
   return coords_compression_level_;
 }
 
+const std::vector<Filter>& ArraySchema::coords_filters() const {
+  return coords_filters_;
+}
+
 uint64_t ArraySchema::coords_size() const {
   return coords_size_;
 }
@@ -402,8 +439,21 @@ void ArraySchema::dump(FILE* out) const {
       compressor_str(coords_compression_));
   fprintf(
       out,
-      "- Coordinates compression level: %d\n\n",
+      "- Coordinates compression level: %d\n",
       coords_compression_level_);
+  if (!coords_filters_.empty()) {
+    fprintf(out, "- Coordinates filters:");
+    for (auto filter : coords_filters_)
+      fprintf(out, " %s", filter_str(filter));
+    fprintf(out, "\n");
+  }
+  if (!cell_var_offsets_filters_.empty()) {
+    fprintf(out, "- Offsets filters:");
+    for (auto filter : cell_var_offsets_filters_)
+      fprintf(out, " %s", filter_str(filter));
+    fprintf(out, "\n");
+  }
+  fprintf(out, "\n");
 
   if (domain_ != nullptr)
     domain_->dump(out);
@@ -414,10 +464,52 @@ void ArraySchema::dump(FILE* out) const {
   }
 }
 
+bool ArraySchema::dictionary_encoding(const std::string& attribute) const {
+  auto it = attribute_map_.find(attribute);
+  if (it == attribute_map_.end())
+    return false;
+  return it->second->dictionary_encoding();
+}
+
+const std::vector<Filter>& ArraySchema::filters(
+    unsigned int attribute_id) const {
+  assert(attribute_id <= attribute_num_ + 1);
+
+  if (attribute_id == attribute_num_ || attribute_id == attribute_num_ + 1)
+    return coords_filters_;
+
+  return attributes_[attribute_id]->filters();
+}
+
+const std::vector<Filter>& ArraySchema::filters(
+    const std::string& attribute) const {
+  auto it = attribute_map_.find(attribute);
+  if (it == attribute_map_.end()) {
+    assert(attribute == constants::coords);  // This should never fail
+    return coords_filters_;
+  }
+
+  return it->second->filters();
+}
+
 bool ArraySchema::is_kv() const {
   return is_kv_;
 }
 
+bool ArraySchema::quantized(const std::string& attribute) const {
+  auto it = attribute_map_.find(attribute);
+  if (it == attribute_map_.end())
+    return false;
+  return it->second->quantized();
+}
+
+int ArraySchema::quantization_digits(const std::string& attribute) const {
+  auto it = attribute_map_.find(attribute);
+  if (it == attribute_map_.end())
+    return 0;
+  return it->second->quantization_digits();
+}
+
 Status ArraySchema::get_attribute_ids(
     const std::vector<std::string>& attributes,
     std::vector<unsigned int>& attribute_ids) const {
@@ -450,6 +542,31 @@ Status ArraySchema::get_attribute_ids(
 //   attribute #1
 //   attribute #2
 //   ...
+// array_schema_version (uint32_t)
+// coords_filters
+// cell_var_offsets_filters
+// attribute #1 filters
+// attribute #2 filters
+// ...
+// attribute #1 dictionary_encoding (char)
+// attribute #2 dictionary_encoding (char)
+// ...
+// attribute #1 compression_dictionary_size (uint64_t)
+//   attribute #1 compression_dictionary (char[])
+// attribute #2 compression_dictionary_size (uint64_t)
+//   attribute #2 compression_dictionary (char[])
+// ...
+// attribute #1 quantized (char)
+//   attribute #1 quantization_digits (int)
+// attribute #2 quantized (char)
+//   attribute #2 quantization_digits (int)
+// ...
+//
+// where each filter list is stored as
+// filter_num (unsigned int)
+//   filter #1 (char)
+//   filter #2 (char)
+//   ...
 Status ArraySchema::serialize(Buffer* buff) const {
   // Write version
   RETURN_NOT_OK(buff->write(constants::version, sizeof(constants::version)));
@@ -485,6 +602,39 @@ Status ArraySchema::serialize(Buffer* buff) const {
   for (auto& attr : attributes_)
     RETURN_NOT_OK(attr->serialize(buff));
 
+  // Write format version
+  RETURN_NOT_OK(buff->write(
+      &constants::array_schema_version,
+      sizeof(constants::array_schema_version)));
+
+  // Write filters
+  RETURN_NOT_OK(serialize_filters(coords_filters_, buff));
+  RETURN_NOT_OK(serialize_filters(cell_var_offsets_filters_, buff));
+  for (auto& attr : attributes_)
+    RETURN_NOT_OK(serialize_filters(attr->filters(), buff));
+
+  // Write dictionary encoding
+  for (auto& attr : attributes_) {
+    auto dictionary_encoding = (char)attr->dictionary_encoding();
+    RETURN_NOT_OK(buff->write(&dictionary_encoding, sizeof(char)));
+  }
+
+  // Write compression dictionaries
+  for (auto& attr : attributes_) {
+    const auto& dictionary = attr->compression_dictionary();
+    uint64_t dictionary_size = dictionary.size();
+    RETURN_NOT_OK(buff->write(&dictionary_size, sizeof(uint64_t)));
+    RETURN_NOT_OK(buff->write(dictionary.data(), dictionary_size));
+  }
+
+  // Write quantization
+  for (auto& attr : attributes_) {
+    auto quantized = (char)attr->quantized();
+    auto digits = attr->quantization_digits();
+    RETURN_NOT_OK(buff->write(&quantized, sizeof(char)));
+    RETURN_NOT_OK(buff->write(&digits, sizeof(int)));
+  }
+
   return Status::Ok();
 }
 
@@ -527,6 +677,14 @@ bool ArraySchema::var_size(const std::string& attribute) const {
   return it->second->var_size();
 }
 
+std::shared_ptr<ZStdDictionary> ArraySchema::zstd_dictionary(
+    const std::string& attribute) const {
+  auto it = attribute_map_.find(attribute);
+  if (it == attribute_map_.end())
+    return nullptr;
+  return it->second->zstd_dictionary();
+}
+
 Status ArraySchema::add_attribute(const Attribute* attr) {
   // Sanity check
   if (attr == nullptr)
@@ -624,6 +782,62 @@ Status ArraySchema::deserialize(ConstBuffer* buff, bool is_kv) {
     attributes_.emplace_back(attr);
   }
 
+  // Load format version, which is absent from array schemas written before
+  // the array schema format was versioned
+  uint32_t array_schema_version = 0;
+  if (buff->nbytes_left_to_read() > 0)
+    RETURN_NOT_OK(buff->read(&array_schema_version, sizeof(uint32_t)));
+  if (array_schema_version > constants::array_schema_version)
+    return LOG_STATUS(Status::ArraySchemaError(
+        "Cannot deserialize array schema; Unsupported format version"));
+
+  // Load filters
+  cell_var_offsets_filters_.clear();
+  if (array_schema_version >= 1) {
+    RETURN_NOT_OK(deserialize_filters(buff, &coords_filters_));
+    RETURN_NOT_OK(deserialize_filters(buff, &cell_var_offsets_filters_));
+    for (auto attr : attributes_) {
+      std::vector<Filter> filters;
+      RETURN_NOT_OK(deserialize_filters(buff, &filters));
+      attr->set_filters(filters);
+    }
+  }
+
+  // Load dictionary encoding
+  if (array_schema_version >= 1) {
+    for (auto attr : attributes_) {
+      char dictionary_encoding;
+      RETURN_NOT_OK(buff->read(&dictionary_encoding, sizeof(char)));
+      attr->set_dictionary_encoding(dictionary_encoding != 0);
+    }
+  }
+
+  // Load compression dictionaries
+  if (array_schema_version >= 1) {
+    for (auto attr : attributes_) {
+      uint64_t dictionary_size;
+      RETURN_NOT_OK(buff->read(&dictionary_size, sizeof(uint64_t)));
+      if (dictionary_size > buff->nbytes_left_to_read())
+        return LOG_STATUS(Status::ArraySchemaError(
+            "Cannot deserialize array schema; Invalid compression dictionary "
+            "size"));
+      std::string dictionary(dictionary_size, '\0');
+      RETURN_NOT_OK(buff->read(&dictionary[0], dictionary_size));
+      attr->set_compression_dictionary(dictionary);
+    }
+  }
+
+  // Load quantization
+  if (array_schema_version >= 1) {
+    for (auto attr : attributes_) {
+      char quantized;
+      int digits;
+      RETURN_NOT_OK(buff->read(&quantized, sizeof(char)));
+      RETURN_NOT_OK(buff->read(&digits, sizeof(int)));
+      RETURN_NOT_OK(attr->set_quantization(quantized != 0, digits));
+    }
+  }
+
   // Initialize the rest of the object members
   RETURN_NOT_OK(init());
 
@@ -709,6 +923,10 @@ void ArraySchema::set_coords_compression_level(int compression_level) {
   coords_compression_level_ = compression_level;
 }
 
+void ArraySchema::set_coords_filters(const std::vector<Filter>& filters) {
+  coords_filters_ = filters;
+}
+
 void ArraySchema::set_cell_var_offsets_compressor(Compressor compressor) {
   cell_var_offsets_compression_ = compressor;
 }
@@ -718,6 +936,11 @@ void ArraySchema::set_cell_var_offsets_compression_level(
   cell_var_offsets_compression_level_ = compression_level;
 }
 
+void ArraySchema::set_cell_var_offsets_filters(
+    const std::vector<Filter>& filters) {
+  cell_var_offsets_filters_ = filters;
+}
+
 void ArraySchema::set_cell_order(Layout cell_order) {
   if (domain_ != nullptr && domain_->dim_num() == 1)
     cell_order_ = Layout::ROW_MAJOR;
@@ -785,18 +1008,99 @@ bool ArraySchema::check_attribute_dimension_names() const {
   return (names.size() == attribute_num_ + dim_num);
 }
 
-bool ArraySchema::check_double_delta_compressor() const {
+bool ArraySchema::check_compression_dictionaries() const {
+  for (auto attr : attributes_) {
+    if (!attr->compression_dictionary().empty() &&
+        attr->compressor() != Compressor::ZSTD)
+      return false;
+  }
+  return true;
+}
+
+bool ArraySchema::check_dictionary_encoding() const {
+  for (auto attr : attributes_) {
+    if (attr->dictionary_encoding() && !attr->var_size())
+      return false;
+  }
+  return true;
+}
+
+bool ArraySchema::check_filters() const {
+  auto valid = [](const std::vector<Filter>& filters, Datatype type) {
+    for (auto filter : filters) {
+      if (!filter_valid(filter) || (filter == Filter::FILTER_COMPACT_OFFSETS &&
+                                    type != Datatype::UINT64))
+        return false;
+    }
+    return true;
+  };
+
+  // Check coordinates and offsets
+  if (!valid(coords_filters_, domain_->type()) ||
+      !valid(cell_var_offsets_filters_, Datatype::UINT64))
+    return false;
+
+  // Check attributes
+  for (auto attr : attributes_) {
+    if (!valid(attr->filters(), attr->type()))
+      return false;
+  }
+
+  return true;
+}
+
+bool ArraySchema::check_integer_compressors() const {
+  auto integer_only = [](Compressor compressor) {
+    return compressor == Compressor::DOUBLE_DELTA ||
+           compressor == Compressor::FRAME_OF_REFERENCE;
+  };
+
   // Check coordinates
   if ((domain_->type() == Datatype::FLOAT32 ||
        domain_->type() == Datatype::FLOAT64) &&
-      coords_compression_ == Compressor::DOUBLE_DELTA)
+      integer_only(coords_compression_))
     return false;
 
-  // Check attributes
+  // Check attributes (quantized reals are compressed as integers)
   for (auto attr : attributes_) {
     if ((attr->type() == Datatype::FLOAT32 ||
          attr->type() == Datatype::FLOAT64) &&
-        attr->compressor() == Compressor::DOUBLE_DELTA)
+        !attr->quantized() && integer_only(attr->compressor()))
+      return false;
+  }
+
+  return true;
+}
+
+bool ArraySchema::check_quantization() const {
+  for (auto attr : attributes_) {
+    if (!attr->quantized())
+      continue;
+    if ((attr->type() != Datatype::FLOAT32 &&
+         attr->type() != Datatype::FLOAT64) ||
+        attr->var_size() || attr->dictionary_encoding())
+      return false;
+    if (attr->compressor() == Compressor::NO_COMPRESSION &&
+        attr->filters().empty())
+      return false;
+  }
+  return true;
+}
+
+bool ArraySchema::check_real_compressors() const {
+  auto real = [](Datatype type) {
+    return type == Datatype::FLOAT32 || type == Datatype::FLOAT64;
+  };
+
+  // Check coordinates and offsets
+  if ((!real(domain_->type()) && coords_compression_ == Compressor::GORILLA) ||
+      cell_var_offsets_compression_ == Compressor::GORILLA)
+    return false;
+
+  // Check attributes (quantized reals are compressed as integers)
+  for (auto attr : attributes_) {
+    if ((!real(attr->type()) || attr->quantized()) &&
+        attr->compressor() == Compressor::GORILLA)
       return false;
   }
 
@@ -836,6 +1140,35 @@ uint64_t ArraySchema::compute_cell_size(unsigned int i) const {
                                 dim_num * datatype_size(type);
 }
 
+Status ArraySchema::deserialize_filters(
+    ConstBuffer* buff, std::vector<Filter>* filters) {
+  unsigned int filter_num;
+  RETURN_NOT_OK(buff->read(&filter_num, sizeof(unsigned int)));
+  filters->clear();
+  for (unsigned int i = 0; i < filter_num; ++i) {
+    char filter;
+    RETURN_NOT_OK(buff->read(&filter, sizeof(char)));
+    if (!filter_valid(static_cast<Filter>(filter)))
+      return LOG_STATUS(Status::ArraySchemaError(
+          "Cannot deserialize filters; Invalid filter type"));
+    filters->push_back(static_cast<Filter>(filter));
+  }
+
+  return Status::Ok();
+}
+
+Status ArraySchema::serialize_filters(
+    const std::vector<Filter>& filters, Buffer* buff) {
+  auto filter_num = (unsigned int)filters.size();
+  RETURN_NOT_OK(buff->write(&filter_num, sizeof(unsigned int)));
+  for (auto filter : filters) {
+    auto f = static_cast<char>(filter);
+    RETURN_NOT_OK(buff->write(&f, sizeof(char)));
+  }
+
+  return Status::Ok();
+}
+
 Status ArraySchema::set_kv_attributes() {
   // Add key attribute
   auto key_attr =
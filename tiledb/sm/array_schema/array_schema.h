@@ -34,6 +34,7 @@
 #ifndef TILEDB_ARRAY_METADATA_H
 #define TILEDB_ARRAY_METADATA_H
 
+#include <memory>
 #include <string>
 #include <typeinfo>
 #include <unordered_map>
@@ -46,6 +47,7 @@
 #include "tiledb/sm/enums/array_type.h"
 #include "tiledb/sm/enums/compressor.h"
 #include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/enums/filter.h"
 #include "tiledb/sm/enums/layout.h"
 #include "tiledb/sm/misc/constants.h"
 #include "tiledb/sm/misc/status.h"
@@ -173,6 +175,9 @@ class ArraySchema {
   /** Returns the compression level used for offsets of variable-sized cells. */
   int cell_var_offsets_compression_level() const;
 
+  /** Returns the filters applied to the offsets of variable-sized cells. */
+  const std::vector<Filter>& cell_var_offsets_filters() const;
+
   /**
    * Checks the correctness of the array schema.
    *
@@ -198,6 +203,9 @@ class ArraySchema {
   /** Returns the compression level of the coordinates. */
   int coords_compression_level() const;
 
+  /** Returns the filters applied to the coordinates. */
+  const std::vector<Filter>& coords_filters() const;
+
   /** Returns the coordinates size. */
   uint64_t coords_size() const;
 
@@ -213,9 +221,27 @@ class ArraySchema {
   /** Returns the number of dimensions. */
   unsigned int dim_num() const;
 
+  /**
+   * Returns true if the values of the input attribute are dictionary-encoded
+   * per tile.
+   */
+  bool dictionary_encoding(const std::string& attribute) const;
+
   /** Dumps the array schema in ASCII format in the selected output. */
   void dump(FILE* out) const;
 
+  /**
+   * Returns the filters applied (in order) prior to compression to the
+   * values of the attribute with the input id.
+   */
+  const std::vector<Filter>& filters(unsigned int attribute_id) const;
+
+  /**
+   * Returns the filters applied (in order) prior to compression to the
+   * values of the input attribute.
+   */
+  const std::vector<Filter>& filters(const std::string& attribute) const;
+
   /**
    * Gets the ids of the input attributes.
    *
@@ -230,6 +256,15 @@ class ArraySchema {
   /** Checks if the array is defined as a key-value store. */
   bool is_kv() const;
 
+  /** Returns true if the values of the input attribute are quantized. */
+  bool quantized(const std::string& attribute) const;
+
+  /**
+   * Returns the number of decimal digits retained by the quantization of
+   * the input attribute (0 if it is not quantized).
+   */
+  int quantization_digits(const std::string& attribute) const;
+
   /**
    * Serializes the array schema object into a buffer.
    *
@@ -253,6 +288,13 @@ class ArraySchema {
   /** Returns *true* if the indicated attribute has variable-sized values. */
   bool var_size(const std::string& attribute) const;
 
+  /**
+   * Returns the dictionary used to compress the values of the input
+   * attribute with zstd (`nullptr` if none).
+   */
+  std::shared_ptr<ZStdDictionary> zstd_dictionary(
+      const std::string& attribute) const;
+
   /** Adds an attribute, copying the input. */
   Status add_attribute(const Attribute* attr);
 
@@ -297,12 +339,18 @@ class ArraySchema {
   /** Sets the variable cell offsets compression level. */
   void set_cell_var_offsets_compression_level(int compression_level);
 
+  /** Sets the filters applied to the variable cell offsets. */
+  void set_cell_var_offsets_filters(const std::vector<Filter>& filters);
+
   /** Sets the coordinates compressor. */
   void set_coords_compressor(Compressor compressor);
 
   /** Sets the coordinates compression level. */
   void set_coords_compression_level(int compression_level);
 
+  /** Sets the filters applied to the coordinates. */
+  void set_coords_filters(const std::vector<Filter>& filters);
+
   /** Sets the tile capacity. */
   void set_capacity(uint64_t capacity);
 
@@ -368,12 +416,18 @@ class ArraySchema {
   /** The compression level used for offsets of variable-sized cells. */
   int cell_var_offsets_compression_level_;
 
+  /** The filters applied to the offsets of variable-sized cells. */
+  std::vector<Filter> cell_var_offsets_filters_;
+
   /** The coordinates compression type. */
   Compressor coords_compression_;
 
   /** The coordinates compression level. */
   int coords_compression_level_;
 
+  /** The filters applied to the coordinates. */
+  std::vector<Filter> coords_filters_;
+
   /** The size (in bytes) of the coordinates. */
   uint64_t coords_size_;
 
@@ -404,10 +458,44 @@ class ArraySchema {
   bool check_attribute_dimension_names() const;
 
   /**
-   * Returns false if double delta compression is used with real attributes
-   * or coordinates and true otherwise.
+   * Returns false if a compression dictionary is set on an attribute that
+   * is not compressed with zstd and true otherwise.
    */
-  bool check_double_delta_compressor() const;
+  bool check_compression_dictionaries() const;
+
+  /**
+   * Returns false if dictionary encoding is set on a fixed-sized attribute
+   * and true otherwise.
+   */
+  bool check_dictionary_encoding() const;
+
+  /**
+   * Returns false if a filter is of an invalid type, or if the compact
+   * offsets filter is used with values that are not uint64, and true
+   * otherwise.
+   */
+  bool check_filters() const;
+
+  /**
+   * Returns false if a compressor that supports only integers (double
+   * delta or frame of reference) is used with real attributes or
+   * coordinates and true otherwise.
+   */
+  bool check_integer_compressors() const;
+
+  /**
+   * Returns false if quantization is set on an attribute that is not a
+   * fixed-sized real, or that is neither compressed nor filtered (for which
+   * it would only lose precision), and true otherwise.
+   */
+  bool check_quantization() const;
+
+  /**
+   * Returns false if a compressor that supports only reals (Gorilla) is
+   * used with non-real attributes, coordinates or offsets and true
+   * otherwise.
+   */
+  bool check_real_compressors() const;
 
   /** Clears all members. Use with caution! */
   void clear();
@@ -415,6 +503,26 @@ class ArraySchema {
   /** Computes and returns the size of an attribute (or coordinates). */
   uint64_t compute_cell_size(unsigned int attribute_id) const;
 
+  /**
+   * Loads a list of filters from the input binary buffer.
+   *
+   * @param buff The buffer to deserialize from.
+   * @param filters The filters to be loaded.
+   * @return Status
+   */
+  static Status deserialize_filters(
+      ConstBuffer* buff, std::vector<Filter>* filters);
+
+  /**
+   * Serializes a list of filters into a binary buffer.
+   *
+   * @param filters The filters to be serialized.
+   * @param buff The buffer to serialize the filters into.
+   * @return Status
+   */
+  static Status serialize_filters(
+      const std::vector<Filter>& filters, Buffer* buff);
+
   /** Sets the special key-value attributes. */
   Status set_kv_attributes();
 
@@ -44,7 +44,11 @@ namespace sm {
 /*     CONSTRUCTORS & DESTRUCTORS    */
 /* ********************************* */
 
-Attribute::Attribute() = default;
+Attribute::Attribute() {
+  dictionary_encoding_ = false;
+  quantized_ = false;
+  quantization_digits_ = 0;
+}
 
 Attribute::Attribute(const char* name, Datatype type) {
   if (name != nullptr)
@@ -53,6 +57,9 @@ Attribute::Attribute(const char* name, Datatype type) {
   cell_val_num_ = (type == Datatype::ANY) ? constants::var_num : 1;
   compressor_ = Compressor::NO_COMPRESSION;
   compression_level_ = -1;
+  dictionary_encoding_ = false;
+  quantized_ = false;
+  quantization_digits_ = 0;
 }
 
 Attribute::Attribute(const Attribute* attr) {
@@ -63,6 +70,11 @@ Attribute::Attribute(const Attribute* attr) {
   cell_val_num_ = attr->cell_val_num();
   compressor_ = attr->compressor();
   compression_level_ = attr->compression_level();
+  compression_dictionary_ = attr->zstd_dictionary();
+  dictionary_encoding_ = attr->dictionary_encoding();
+  quantized_ = attr->quantized();
+  quantization_digits_ = attr->quantization_digits();
+  filters_ = attr->filters();
 }
 
 Attribute::~Attribute() = default;
@@ -121,6 +133,17 @@ Status Attribute::deserialize(ConstBuffer* buff) {
   return Status::Ok();
 }
 
+const std::string& Attribute::compression_dictionary() const {
+  static const std::string empty;
+  return (compression_dictionary_ == nullptr) ?
+             empty :
+             compression_dictionary_->content();
+}
+
+bool Attribute::dictionary_encoding() const {
+  return dictionary_encoding_;
+}
+
 void Attribute::dump(FILE* out) const {
   // Retrieve type and compressor strings
   const char* type_s = datatype_str(type_);
@@ -132,17 +155,44 @@ void Attribute::dump(FILE* out) const {
   fprintf(out, "- Type: %s\n", type_s);
   fprintf(out, "- Compressor: %s\n", compressor_s);
   fprintf(out, "- Compression level: %d\n", compression_level_);
+  if (compression_dictionary_ != nullptr)
+    fprintf(
+        out,
+        "- Compression dictionary: %llu bytes\n",
+        (unsigned long long)compression_dictionary_->content().size());
+  if (!filters_.empty()) {
+    fprintf(out, "- Filters:");
+    for (auto filter : filters_)
+      fprintf(out, " %s", filter_str(filter));
+    fprintf(out, "\n");
+  }
 
   if (!var_size())
     fprintf(out, "- Cell val num: %u\n", cell_val_num_);
   else
     fprintf(out, "- Cell val num: var\n");
+  if (dictionary_encoding_)
+    fprintf(out, "- Dictionary encoding: true\n");
+  if (quantized_)
+    fprintf(out, "- Quantization digits: %d\n", quantization_digits_);
+}
+
+const std::vector<Filter>& Attribute::filters() const {
+  return filters_;
 }
 
 const std::string& Attribute::name() const {
   return name_;
 }
 
+bool Attribute::quantized() const {
+  return quantized_;
+}
+
+int Attribute::quantization_digits() const {
+  return quantization_digits_;
+}
+
 bool Attribute::is_anonymous() const {
   return name_.empty() ||
          utils::starts_with(name_, constants::default_attr_name);
@@ -195,6 +245,33 @@ void Attribute::set_compression_level(int compression_level) {
   compression_level_ = compression_level;
 }
 
+void Attribute::set_compression_dictionary(const std::string& dictionary) {
+  compression_dictionary_ =
+      dictionary.empty() ? nullptr :
+                           std::make_shared<ZStdDictionary>(dictionary);
+}
+
+void Attribute::set_dictionary_encoding(bool dictionary_encoding) {
+  dictionary_encoding_ = dictionary_encoding;
+}
+
+Status Attribute::set_quantization(bool quantized, int digits) {
+  if (quantized && (digits < 0 || digits > constants::max_quantization_digits))
+    return LOG_STATUS(Status::AttributeError(
+        "Cannot set quantization; The number of decimal digits must be "
+        "in [0, " +
+        std::to_string(constants::max_quantization_digits) + "]"));
+
+  quantized_ = quantized;
+  quantization_digits_ = quantized ? digits : 0;
+
+  return Status::Ok();
+}
+
+void Attribute::set_filters(const std::vector<Filter>& filters) {
+  filters_ = filters;
+}
+
 void Attribute::set_name(const std::string& name) {
   name_ = name;
 }
@@ -207,5 +284,9 @@ bool Attribute::var_size() const {
   return cell_val_num_ == constants::var_num;
 }
 
+const std::shared_ptr<ZStdDictionary>& Attribute::zstd_dictionary() const {
+  return compression_dictionary_;
+}
+
 }  // namespace sm
 }  // namespace tiledb
@@ -33,11 +33,15 @@
 #ifndef TILEDB_ATTRIBUTE_H
 #define TILEDB_ATTRIBUTE_H
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/compressors/zstd_compressor.h"
 #include "tiledb/sm/enums/compressor.h"
 #include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/enums/filter.h"
 #include "tiledb/sm/misc/status.h"
 
 namespace tiledb {
@@ -101,12 +105,43 @@ class Attribute {
    */
   Status deserialize(ConstBuffer* buff);
 
+  /**
+   * Returns the dictionary used to compress the attribute values with
+   * zstd (empty if none).
+   */
+  const std::string& compression_dictionary() const;
+
+  /**
+   * Returns true if the values of this (variable-sized) attribute are
+   * stored per tile as a dictionary of distinct cell values plus one code
+   * per cell.
+   */
+  bool dictionary_encoding() const;
+
   /** Dumps the attribute contents in ASCII form in the selected output. */
   void dump(FILE* out) const;
 
+  /**
+   * Returns the filters applied (in order) to the attribute values prior to
+   * compression.
+   */
+  const std::vector<Filter>& filters() const;
+
   /** Returns the attribute name. */
   const std::string& name() const;
 
+  /**
+   * Returns true if the (real) attribute values are quantized on write, i.e.,
+   * stored as integers after being scaled by `10^quantization_digits()`.
+   */
+  bool quantized() const;
+
+  /**
+   * Returns the number of decimal digits retained by quantization (0 if the
+   * attribute is not quantized).
+   */
+  int quantization_digits() const;
+
   /** Returns true if this is an anonymous (unlabeled) attribute **/
   bool is_anonymous() const;
 
@@ -133,6 +168,32 @@ class Attribute {
   /** Sets the attribute compression level. */
   void set_compression_level(int compression_level);
 
+  /**
+   * Sets the dictionary used to compress the attribute values with zstd,
+   * e.g., one trained on sample values with `zstd --train`.
+   */
+  void set_compression_dictionary(const std::string& dictionary);
+
+  /** Sets whether the attribute values are dictionary-encoded per tile. */
+  void set_dictionary_encoding(bool dictionary_encoding);
+
+  /**
+   * Sets whether the attribute values are quantized on write, retaining
+   * `digits` decimal digits. This is lossy: values are read back rounded to
+   * the nearest multiple of `10^-digits`.
+   *
+   * @param quantized Whether to quantize the attribute values.
+   * @param digits The number of decimal digits to retain.
+   * @return Status
+   */
+  Status set_quantization(bool quantized, int digits);
+
+  /**
+   * Sets the filters applied (in order) to the attribute values prior to
+   * compression.
+   */
+  void set_filters(const std::vector<Filter>& filters);
+
   /** Sets the attribute name. */
   void set_name(const std::string& name);
 
@@ -145,6 +206,13 @@ class Attribute {
    */
   bool var_size() const;
 
+  /**
+   * Returns the dictionary used to compress the attribute values with
+   * zstd (`nullptr` if none). The dictionary is shared by the copies of the
+   * attribute and the tiles of its values, so that it is digested once.
+   */
+  const std::shared_ptr<ZStdDictionary>& zstd_dictionary() const;
+
  private:
   /* ********************************* */
   /*         PRIVATE ATTRIBUTES        */
@@ -159,6 +227,21 @@ class Attribute {
   /** The attribute compression level. */
   int compression_level_;
 
+  /** The dictionary used to compress the values with zstd (if any). */
+  std::shared_ptr<ZStdDictionary> compression_dictionary_;
+
+  /** Whether the attribute values are dictionary-encoded per tile. */
+  bool dictionary_encoding_;
+
+  /** The filters applied to the attribute values prior to compression. */
+  std::vector<Filter> filters_;
+
+  /** Whether the attribute values are quantized on write. */
+  bool quantized_;
+
+  /** The number of decimal digits retained by quantization. */
+  int quantization_digits_;
+
   /** The attribute name. */
   std::string name_;
 
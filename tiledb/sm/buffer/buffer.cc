@@ -33,6 +33,7 @@
 #include "tiledb/sm/buffer/buffer.h"
 #include "tiledb/sm/buffer/const_buffer.h"
 #include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/utils.h"
 
 #include <iostream>
 
@@ -62,7 +63,7 @@ Buffer::Buffer(void* data, uint64_t size, bool owns_data)
     , owns_data_(owns_data)
     , size_(size) {
   offset_ = 0;
-  alloced_size_ = 0;
+  alloced_size_ = size;
   owns_data_ = false;
 }
 
@@ -196,11 +197,6 @@ uint64_t Buffer::size() const {
 }
 
 Status Buffer::write(ConstBuffer* buff) {
-  // Sanity check
-  if (!owns_data_)
-    return LOG_STATUS(Status::BufferError(
-        "Cannot write to buffer; Buffer does not own the already stored data"));
-
   uint64_t bytes_left_to_write = alloced_size_ - offset_;
   uint64_t bytes_left_to_read = buff->nbytes_left_to_read();
   uint64_t bytes_to_copy = std::min(bytes_left_to_write, bytes_left_to_read);
@@ -213,11 +209,6 @@ Status Buffer::write(ConstBuffer* buff) {
 }
 
 Status Buffer::write(ConstBuffer* buff, uint64_t nbytes) {
-  // Sanity check
-  if (!owns_data_)
-    return LOG_STATUS(Status::BufferError(
-        "Cannot write to buffer; Buffer does not own the already stored data"));
-
   while (offset_ + nbytes > alloced_size_)
     RETURN_NOT_OK(realloc(MAX(nbytes, 2 * alloced_size_)));
 
@@ -229,11 +220,6 @@ Status Buffer::write(ConstBuffer* buff, uint64_t nbytes) {
 }
 
 Status Buffer::write(const void* buffer, uint64_t nbytes) {
-  // Sanity check
-  if (!owns_data_)
-    return LOG_STATUS(Status::BufferError(
-        "Cannot write to buffer; Buffer does not own the already stored data"));
-
   while (offset_ + nbytes > alloced_size_)
     RETURN_NOT_OK(realloc(MAX(nbytes, 2 * alloced_size_)));
 
@@ -244,12 +230,42 @@ Status Buffer::write(const void* buffer, uint64_t nbytes) {
   return Status::Ok();
 }
 
-Status Buffer::write_with_shift(ConstBuffer* buff, uint64_t offset) {
-  // Sanity check
-  if (!owns_data_)
-    return LOG_STATUS(Status::BufferError(
-        "Cannot write to buffer; Buffer does not own the already stored data"));
+Status Buffer::write_fill(
+    const void* value, uint64_t value_size, uint64_t num) {
+  uint64_t nbytes = value_size * num;
+  while (offset_ + nbytes > alloced_size_)
+    RETURN_NOT_OK(realloc(MAX(offset_ + nbytes, 2 * alloced_size_)));
+
+  utils::fill((char*)data_ + offset_, value, value_size, num);
+  offset_ += nbytes;
+  size_ = offset_;
+
+  return Status::Ok();
+}
+
+Status Buffer::write_offsets(uint64_t start, uint64_t step, uint64_t num) {
+  uint64_t nbytes = num * sizeof(uint64_t);
+  while (offset_ + nbytes > alloced_size_)
+    RETURN_NOT_OK(realloc(MAX(offset_ + nbytes, 2 * alloced_size_)));
+
+  // Use the vectorizable generator when the destination is aligned, and
+  // fall back to unaligned stores otherwise
+  auto dest = (char*)data_ + offset_;
+  if ((uintptr_t)dest % alignof(uint64_t) == 0) {
+    utils::fill_offsets((uint64_t*)dest, num, start, step);
+  } else {
+    for (uint64_t i = 0; i < num; ++i) {
+      uint64_t offset = start + i * step;
+      std::memcpy(dest + i * sizeof(uint64_t), &offset, sizeof(uint64_t));
+    }
+  }
+  offset_ += nbytes;
+  size_ = offset_;
 
+  return Status::Ok();
+}
+
+Status Buffer::write_with_shift(ConstBuffer* buff, uint64_t offset) {
   uint64_t bytes_left_to_write = alloced_size_ - offset_;
   uint64_t bytes_left_to_read = buff->nbytes_left_to_read();
   uint64_t bytes_to_copy = std::min(bytes_left_to_write, bytes_left_to_read);
@@ -269,6 +285,9 @@ Buffer& Buffer::operator=(const Buffer& buff) {
 
   if (!buff.owns_data_) {
     data_ = buff.data_;
+    alloced_size_ = buff.alloced_size_;
+    size_ = buff.size_;
+    offset_ = buff.offset_;
   } else {
     if (buff.data() != nullptr)
       data_ = std::malloc(buff.alloced_size_);
@@ -53,13 +53,17 @@ class Buffer {
   Buffer();
 
   /**
-   * Constructor. Initializes a buffer with the input data and size.
+   * Constructor. Initializes a buffer with the input data and size. The
+   * capacity of the buffer is equal to the input size.
    *
    * @param data The internal data of the buffer.
    * @param size The size of the data.
    * @param owns_data Indicates whether the object will own the data,
    *     i.e., if it has permission to reallocate the data and
    *     is responsible for freeing it.
+   *
+   * @note A buffer that does not own its data can still be written up to
+   *     its allocated size, but any write that needs to grow it fails.
    */
   Buffer(void* data, uint64_t size, bool owns_data);
 
@@ -198,6 +202,28 @@ class Buffer {
    */
   Status write(const void* buffer, uint64_t nbytes);
 
+  /**
+   * Writes `num` consecutive copies of `value` into the local buffer. The
+   * local buffer is expanded if needed.
+   *
+   * @param value The value to be replicated.
+   * @param value_size The size of `value` in bytes.
+   * @param num The number of copies to write.
+   * @return Status.
+   */
+  Status write_fill(const void* value, uint64_t value_size, uint64_t num);
+
+  /**
+   * Writes the `num` uint64_t offsets `start, start + step, ...` into the
+   * local buffer. The local buffer is expanded if needed.
+   *
+   * @param start The first offset.
+   * @param step The distance between two consecutive offsets.
+   * @param num The number of offsets to write.
+   * @return Status.
+   */
+  Status write_offsets(uint64_t start, uint64_t step, uint64_t num);
+
   /**
    * Writes as much data as possible read from the input buffer *buff*, but
    * then adds the *offset* value to the read data. The type of each data
@@ -198,6 +198,31 @@ static bool create_error(tiledb_error_t** error, const tiledb::sm::Status& st) {
   return true;
 }
 
+/*
+ * Converts a C array of filters to a filter list, saving an error in the
+ * context if a filter is invalid.
+ */
+static int to_filters(
+    tiledb_ctx_t* ctx,
+    const tiledb_filter_t* filters,
+    unsigned int filter_num,
+    std::vector<tiledb::sm::Filter>* ret) {
+  ret->clear();
+  ret->reserve(filter_num);
+  for (unsigned int i = 0; i < filter_num; ++i) {
+    if (filters[i] < TILEDB_FILTER_BYTESHUFFLE ||
+        filters[i] > TILEDB_FILTER_COMPACT_OFFSETS) {
+      auto st =
+          tiledb::sm::Status::Error("Cannot set filters; Invalid filter type");
+      LOG_STATUS(st);
+      save_error(ctx, st);
+      return TILEDB_ERR;
+    }
+    ret->push_back(static_cast<tiledb::sm::Filter>(filters[i]));
+  }
+  return TILEDB_OK;
+}
+
 inline int sanity_check(tiledb_config_t* config, tiledb_error_t** error) {
   if (config == nullptr || config->config_ == nullptr) {
     auto st =
@@ -650,7 +675,12 @@ int tiledb_ctx_create(tiledb_ctx_t** ctx, tiledb_config_t* config) {
 }
 
 int tiledb_ctx_free(tiledb_ctx_t** ctx) {
+  int rc = TILEDB_OK;
   if (ctx != nullptr && *ctx != nullptr) {
+    // Buffered writes must not be lost silently
+    if ((*ctx)->storage_manager_ != nullptr &&
+        !(*ctx)->storage_manager_->write_buffers_flush().ok())
+      rc = TILEDB_ERR;
     delete (*ctx)->storage_manager_;
     delete (*ctx)->last_error_;
     delete (*ctx)->mtx_;
@@ -658,8 +688,7 @@ int tiledb_ctx_free(tiledb_ctx_t** ctx) {
     *ctx = nullptr;
   }
 
-  // Always succeeds
-  return TILEDB_OK;
+  return rc;
 }
 
 int tiledb_ctx_get_config(tiledb_ctx_t* ctx, tiledb_config_t** config) {
@@ -816,6 +845,52 @@ int tiledb_attribute_set_compressor(
   return TILEDB_OK;
 }
 
+int tiledb_attribute_set_filters(
+    tiledb_ctx_t* ctx,
+    tiledb_attribute_t* attr,
+    const tiledb_filter_t* filters,
+    unsigned int filter_num) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, attr) == TILEDB_ERR)
+    return TILEDB_ERR;
+  std::vector<tiledb::sm::Filter> sm_filters;
+  if (to_filters(ctx, filters, filter_num, &sm_filters) == TILEDB_ERR)
+    return TILEDB_ERR;
+  attr->attr_->set_filters(sm_filters);
+  return TILEDB_OK;
+}
+
+int tiledb_attribute_set_dictionary_encoding(
+    tiledb_ctx_t* ctx, tiledb_attribute_t* attr, int dictionary_encoding) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, attr) == TILEDB_ERR)
+    return TILEDB_ERR;
+  attr->attr_->set_dictionary_encoding(dictionary_encoding != 0);
+  return TILEDB_OK;
+}
+
+int tiledb_attribute_set_quantization(
+    tiledb_ctx_t* ctx, tiledb_attribute_t* attr, int quantized, int digits) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, attr) == TILEDB_ERR)
+    return TILEDB_ERR;
+  if (save_error(ctx, attr->attr_->set_quantization(quantized != 0, digits)))
+    return TILEDB_ERR;
+  return TILEDB_OK;
+}
+
+int tiledb_attribute_set_compression_dictionary(
+    tiledb_ctx_t* ctx,
+    tiledb_attribute_t* attr,
+    const void* dictionary,
+    uint64_t dictionary_size) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, attr) == TILEDB_ERR)
+    return TILEDB_ERR;
+  if (dictionary == nullptr)
+    attr->attr_->set_compression_dictionary(std::string());
+  else
+    attr->attr_->set_compression_dictionary(
+        std::string((const char*)dictionary, dictionary_size));
+  return TILEDB_OK;
+}
+
 int tiledb_attribute_set_cell_val_num(
     tiledb_ctx_t* ctx, tiledb_attribute_t* attr, unsigned int cell_val_num) {
   if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, attr) == TILEDB_ERR)
@@ -855,6 +930,63 @@ int tiledb_attribute_get_compressor(
   return TILEDB_OK;
 }
 
+int tiledb_attribute_get_filter_num(
+    tiledb_ctx_t* ctx,
+    const tiledb_attribute_t* attr,
+    unsigned int* filter_num) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, attr) == TILEDB_ERR)
+    return TILEDB_ERR;
+  *filter_num = (unsigned int)attr->attr_->filters().size();
+  return TILEDB_OK;
+}
+
+int tiledb_attribute_get_filters(
+    tiledb_ctx_t* ctx,
+    const tiledb_attribute_t* attr,
+    tiledb_filter_t* filters) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, attr) == TILEDB_ERR)
+    return TILEDB_ERR;
+  const auto& attr_filters = attr->attr_->filters();
+  for (size_t i = 0; i < attr_filters.size(); ++i)
+    filters[i] = static_cast<tiledb_filter_t>(attr_filters[i]);
+  return TILEDB_OK;
+}
+
+int tiledb_attribute_get_dictionary_encoding(
+    tiledb_ctx_t* ctx,
+    const tiledb_attribute_t* attr,
+    int* dictionary_encoding) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, attr) == TILEDB_ERR)
+    return TILEDB_ERR;
+  *dictionary_encoding = (int)attr->attr_->dictionary_encoding();
+  return TILEDB_OK;
+}
+
+int tiledb_attribute_get_quantization(
+    tiledb_ctx_t* ctx,
+    const tiledb_attribute_t* attr,
+    int* quantized,
+    int* digits) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, attr) == TILEDB_ERR)
+    return TILEDB_ERR;
+  *quantized = (int)attr->attr_->quantized();
+  *digits = attr->attr_->quantization_digits();
+  return TILEDB_OK;
+}
+
+int tiledb_attribute_get_compression_dictionary(
+    tiledb_ctx_t* ctx,
+    const tiledb_attribute_t* attr,
+    const void** dictionary,
+    uint64_t* dictionary_size) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, attr) == TILEDB_ERR)
+    return TILEDB_ERR;
+  const auto& attr_dictionary = attr->attr_->compression_dictionary();
+  *dictionary = attr_dictionary.empty() ? nullptr : attr_dictionary.data();
+  *dictionary_size = attr_dictionary.size();
+  return TILEDB_OK;
+}
+
 int tiledb_attribute_get_cell_val_num(
     tiledb_ctx_t* ctx,
     const tiledb_attribute_t* attr,
@@ -1317,6 +1449,36 @@ int tiledb_array_schema_set_offsets_compressor(
   return TILEDB_OK;
 }
 
+int tiledb_array_schema_set_coords_filters(
+    tiledb_ctx_t* ctx,
+    tiledb_array_schema_t* array_schema,
+    const tiledb_filter_t* filters,
+    unsigned int filter_num) {
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, array_schema) == TILEDB_ERR)
+    return TILEDB_ERR;
+  std::vector<tiledb::sm::Filter> sm_filters;
+  if (to_filters(ctx, filters, filter_num, &sm_filters) == TILEDB_ERR)
+    return TILEDB_ERR;
+  array_schema->array_schema_->set_coords_filters(sm_filters);
+  return TILEDB_OK;
+}
+
+int tiledb_array_schema_set_offsets_filters(
+    tiledb_ctx_t* ctx,
+    tiledb_array_schema_t* array_schema,
+    const tiledb_filter_t* filters,
+    unsigned int filter_num) {
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, array_schema) == TILEDB_ERR)
+    return TILEDB_ERR;
+  std::vector<tiledb::sm::Filter> sm_filters;
+  if (to_filters(ctx, filters, filter_num, &sm_filters) == TILEDB_ERR)
+    return TILEDB_ERR;
+  array_schema->array_schema_->set_cell_var_offsets_filters(sm_filters);
+  return TILEDB_OK;
+}
+
 int tiledb_array_schema_check(
     tiledb_ctx_t* ctx, tiledb_array_schema_t* array_schema) {
   if (sanity_check(ctx) == TILEDB_ERR ||
@@ -1670,6 +1832,34 @@ int tiledb_query_set_buffers(
   return TILEDB_OK;
 }
 
+int tiledb_query_set_validity_buffer(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* attribute,
+    uint8_t* buffer,
+    uint64_t* buffer_size) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Check attribute
+  if (attribute == nullptr) {
+    auto st = tiledb::sm::Status::Error(
+        "Cannot set validity buffer; Attribute not provided");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    return TILEDB_ERR;
+  }
+
+  // Set validity buffer
+  if (save_error(
+          ctx,
+          query->query_->set_validity_buffer(attribute, buffer, buffer_size)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
 int tiledb_query_set_layout(
     tiledb_ctx_t* ctx, tiledb_query_t* query, tiledb_layout_t layout) {
   // Sanity check
@@ -1685,6 +1875,42 @@ int tiledb_query_set_layout(
   return TILEDB_OK;
 }
 
+int tiledb_query_set_dedup(
+    tiledb_ctx_t* ctx, tiledb_query_t* query, tiledb_dedup_t dedup) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Check the dedup mode, which would be truncated by the cast otherwise
+  if (dedup < TILEDB_NO_DEDUP || dedup > TILEDB_DEDUP_MAX) {
+    auto st = tiledb::sm::Status::Error("Cannot set dedup; Invalid dedup mode");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    return TILEDB_ERR;
+  }
+
+  // Set dedup
+  if (save_error(
+          ctx,
+          query->query_->set_dedup(static_cast<tiledb::sm::Dedup>(dedup))))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int tiledb_query_set_cache_fill(
+    tiledb_ctx_t* ctx, tiledb_query_t* query, int cache_fill) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Set cache fill
+  if (save_error(ctx, query->query_->set_cache_fill(cache_fill != 0)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
 int tiledb_query_finalize(tiledb_ctx_t* ctx, tiledb_query_t* query) {
   // Trivial case
   if (query == nullptr || query->finalized_)
@@ -1815,6 +2041,20 @@ int tiledb_array_consolidate(tiledb_ctx_t* ctx, const char* array_uri) {
   return TILEDB_OK;
 }
 
+int tiledb_array_flush(tiledb_ctx_t* ctx, const char* array_uri) {
+  // Sanity checks
+  if (sanity_check(ctx) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (save_error(
+          ctx,
+          ctx->storage_manager_->write_buffer_flush(
+              tiledb::sm::URI(array_uri))))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
 int tiledb_array_get_non_empty_domain(
     tiledb_ctx_t* ctx, const char* array_uri, void* domain, int* is_empty) {
   if (sanity_check(ctx) == TILEDB_ERR)
@@ -2744,6 +2984,9 @@ int tiledb_vfs_remove_bucket(
   if (save_error(ctx, vfs->vfs_->remove_bucket(tiledb::sm::URI(uri))))
     return TILEDB_ERR;
 
+  // Cached objects of the removed files are stale
+  ctx->storage_manager_->invalidate_cache(tiledb::sm::URI(uri));
+
   return TILEDB_OK;
 }
 
@@ -2755,6 +2998,9 @@ int tiledb_vfs_empty_bucket(
   if (save_error(ctx, vfs->vfs_->empty_bucket(tiledb::sm::URI(uri))))
     return TILEDB_ERR;
 
+  // Cached objects of the removed files are stale
+  ctx->storage_manager_->invalidate_cache(tiledb::sm::URI(uri));
+
   return TILEDB_OK;
 }
 
@@ -2817,6 +3063,9 @@ int tiledb_vfs_remove_dir(
   if (save_error(ctx, vfs->vfs_->remove_dir(tiledb::sm::URI(uri))))
     return TILEDB_ERR;
 
+  // Cached objects of the removed files are stale
+  ctx->storage_manager_->invalidate_cache(tiledb::sm::URI(uri));
+
   return TILEDB_OK;
 }
 
@@ -2841,6 +3090,9 @@ int tiledb_vfs_remove_file(
   if (save_error(ctx, vfs->vfs_->remove_file(tiledb::sm::URI(uri))))
     return TILEDB_ERR;
 
+  // Cached objects of the removed files are stale
+  ctx->storage_manager_->invalidate_cache(tiledb::sm::URI(uri));
+
   return TILEDB_OK;
 }
 
@@ -2869,6 +3121,10 @@ int tiledb_vfs_move_file(
               tiledb::sm::URI(old_uri), tiledb::sm::URI(new_uri))))
     return TILEDB_ERR;
 
+  // Cached objects of the moved (or replaced) files are stale
+  ctx->storage_manager_->invalidate_cache(tiledb::sm::URI(old_uri));
+  ctx->storage_manager_->invalidate_cache(tiledb::sm::URI(new_uri));
+
   return TILEDB_OK;
 }
 
@@ -2886,6 +3142,10 @@ int tiledb_vfs_move_dir(
               tiledb::sm::URI(old_uri), tiledb::sm::URI(new_uri))))
     return TILEDB_ERR;
 
+  // Cached objects of the moved (or replaced) files are stale
+  ctx->storage_manager_->invalidate_cache(tiledb::sm::URI(old_uri));
+  ctx->storage_manager_->invalidate_cache(tiledb::sm::URI(new_uri));
+
   return TILEDB_OK;
 }
 
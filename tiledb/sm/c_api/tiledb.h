@@ -110,6 +110,14 @@ typedef enum {
 #undef TILEDB_LAYOUT_ENUM
 } tiledb_layout_t;
 
+/** Handling of cells with duplicate coordinates in an unordered write. */
+typedef enum {
+/** Helper macro for defining dedup enums. */
+#define TILEDB_DEDUP_ENUM(id) TILEDB_##id
+#include "tiledb_enum.h"
+#undef TILEDB_DEDUP_ENUM
+} tiledb_dedup_t;
+
 /** Compression type. */
 typedef enum {
 /** Helper macro for defining compressor enums. */
@@ -118,6 +126,14 @@ typedef enum {
 #undef TILEDB_COMPRESSOR_ENUM
 } tiledb_compressor_t;
 
+/** Filter type, applied to the tile data prior to compression. */
+typedef enum {
+/** Helper macro for defining filter enums. */
+#define TILEDB_FILTER_ENUM(id) TILEDB_##id
+#include "tiledb_enum.h"
+#undef TILEDB_FILTER_ENUM
+} tiledb_filter_t;
+
 /** Walk traversal order. */
 typedef enum {
 /** Helper macro for defining walk order enums. */
@@ -337,6 +353,30 @@ TILEDB_EXPORT int tiledb_config_free(tiledb_config_t** config);
  * - `sm.tile_cache_size` <br>
  *    The tile cache size in bytes. Any `uint64_t` value is acceptable. <br>
  *    **Default**: 10,000,000
+ * - `sm.compressed_tile_cache_size` <br>
+ *    The size in bytes of the cache of compressed tiles, which backs the
+ *    (decompressed) tile cache: tiles missing from the tile cache are
+ *    decompressed from it instead of being read from storage. It can be
+ *    set to `0` to disable it. <br>
+ *    **Default**: 50,000,000
+ * - `sm.tile_cache_shard_num` <br>
+ *    The number of shards the tile cache and the compressed tile cache
+ *    are split into. Each shard has its own lock, so that concurrent
+ *    reads of tiles in different shards do not contend. The size of each
+ *    cache is split evenly across its shards: a shard of the tile cache
+ *    holds up to `sm.tile_cache_size / sm.tile_cache_shard_num` bytes
+ *    (rounded down; the remainder goes to the first shards), and likewise
+ *    for `sm.compressed_tile_cache_size`. A tile larger than its shard is
+ *    not cached, e.g., by default tiles larger than 1,250,000 bytes are
+ *    not kept in the tile cache. <br>
+ *    **Default**: 8
+ * - `sm.tile_cache_policy` <br>
+ *    The eviction policy of the tile cache and the compressed tile cache.
+ *    With `lru`, the least recently used tile is evicted. With `slru`
+ *    (segmented LRU), tiles are evicted first among those that were not
+ *    read again since they were cached, so that a large scan does not
+ *    flush the tiles that are read frequently. <br>
+ *    **Default**: slru
  * - `sm.array_schema_cache_size` <br>
  *    The array schema cache size in bytes. Any `uint64_t` value is acceptable.
  * <br>
@@ -345,6 +385,59 @@ TILEDB_EXPORT int tiledb_config_free(tiledb_config_t** config);
  *    The fragment metadata cache size in bytes. Any `uint64_t` value is
  *    acceptable. <br>
  *    **Default**: 10,000,000
+ * - `sm.global_write_queue_depth` <br>
+ *    The maximum number of batches of full tiles that a global-order write
+ *    query may have pending compression and I/O in the background. If `0`,
+ *    global-order writes compress and write their tiles in the submitting
+ *    thread. Otherwise, a query submission returns as soon as the user buffers
+ *    are consumed, and finalizing the query waits for all pending writes. Any
+ *    `uint64_t` value is acceptable. <br>
+ *    **Default**: 0
+ * - `sm.num_compute_threads` <br>
+ *    The number of threads in the storage manager pool used for CPU-bound
+ *    tasks, such as compressing the tiles of a write in parallel. Any
+ *    `uint64_t` value is acceptable; `0` is treated as `1`. <br>
+ *    **Default**: number of cores
+ * - `sm.unordered_write_memory_budget` <br>
+ *    The memory budget (in bytes) of an unordered write query. If it is `0`,
+ *    every submission of an unordered write creates a separate fragment.
+ *    Otherwise, the cells of successive submissions are buffered in memory,
+ *    spilled to scratch storage as sorted runs whenever the buffered cells
+ *    exceed half the budget, and merged into a single fragment in the global
+ *    order when the query is finalized. <br>
+ *    **Default**: 0
+ * - `sm.unordered_write_scratch_dir` <br>
+ *    The directory where unordered writes spill their sorted runs, if
+ *    `sm.unordered_write_memory_budget` is not `0`. If it is empty, the runs
+ *    are spilled into a hidden directory inside the array directory. <br>
+ *    **Default**: ""
+ * - `sm.write_buffer_size` <br>
+ *    The size (in bytes) of the in-memory write buffer of each array. If it is
+ *    not `0` (and `sm.unordered_write_memory_budget` is `0`), the cells of
+ *    unordered writes are buffered in memory, and flushed to a single fragment
+ *    when the buffer reaches this size, when `sm.write_buffer_max_age_ms`
+ *    elapses, when the array is read or flushed explicitly, or when the context
+ *    is freed. If a flush that was not triggered by a write fails, the buffered
+ *    cells are discarded and the error is returned by the next write to the
+ *    array (or by freeing the context). Buffered cells that were not flushed
+ *    are lost if the process terminates abnormally. <br>
+ *    **Default**: 0
+ * - `sm.write_buffer_max_age_ms` <br>
+ *    The maximum age (in milliseconds) of the cells in an array write
+ *    buffer. The buffer is flushed in the background once its oldest cell
+ *    exceeds this age. If it is `0`, there is no age limit. <br>
+ *    **Default**: 0
+ * - `sm.tile_chunk_size` <br>
+ *    The maximum size (in bytes) of the chunks a tile is split into upon
+ *    compression. The chunks of a tile are compressed and decompressed in
+ *    parallel on the compute threads. <br>
+ *    **Default**: 1048576
+ * - `sm.auto_compression_candidates` <br>
+ *    The comma-separated `<compressor>[:<level>]` candidates that the
+ *    `AUTO_COMPRESSION` compressor tries on a sample of every chunk,
+ *    keeping the one with the smallest estimated read cost (compressed
+ *    size plus decompression cost). <br>
+ *    **Default**: NO_COMPRESSION,LZ4,ZSTD:1,ZSTD:9,RLE,DOUBLE_DELTA,GORILLA
  * - `vfs.max_parallel_ops` <br>
  *    The maximum number of VFS parallel operations. <br>
  *    **Default**: number of cores
@@ -694,7 +787,9 @@ TILEDB_EXPORT int tiledb_ctx_create(
  * @endcode
  *
  * @param ctx The TileDB context to be freed.
- * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error. An error means
+ *     that buffered writes (see `sm.write_buffer_size`) could not be
+ *     flushed and were lost. The context is freed in any case.
  */
 TILEDB_EXPORT int tiledb_ctx_free(tiledb_ctx_t** ctx);
 
@@ -839,6 +934,105 @@ TILEDB_EXPORT int tiledb_attribute_set_compressor(
     tiledb_compressor_t compressor,
     int compression_level);
 
+/**
+ * Sets the filters applied (in order) to the attribute values prior to
+ * compression. Any previously set filters are replaced. The
+ * `TILEDB_FILTER_COMPACT_OFFSETS` filter can be used only with `TILEDB_UINT64`
+ * values, which is checked along with the array schema.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_filter_t filters[] = {TILEDB_FILTER_DELTA, TILEDB_FILTER_BYTESHUFFLE};
+ * tiledb_attribute_set_filters(ctx, attr, filters, 2);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param attr The target attribute.
+ * @param filters The filters to be set.
+ * @param filter_num The number of filters.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_attribute_set_filters(
+    tiledb_ctx_t* ctx,
+    tiledb_attribute_t* attr,
+    const tiledb_filter_t* filters,
+    unsigned int filter_num);
+
+/**
+ * Sets whether the values of a variable-sized attribute are dictionary
+ * encoded. Each tile then stores every distinct cell value once, plus a
+ * code per cell in place of its offset, which suits attributes with few
+ * distinct values (e.g., categorical strings). Reads return the decoded
+ * values as usual.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_attribute_set_dictionary_encoding(ctx, attr, 1);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param attr The target attribute.
+ * @param dictionary_encoding `1` to enable dictionary encoding, `0` to
+ *     disable it.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_attribute_set_dictionary_encoding(
+    tiledb_ctx_t* ctx, tiledb_attribute_t* attr, int dictionary_encoding);
+
+/**
+ * Sets whether the values of a real (`TILEDB_FLOAT32` or `TILEDB_FLOAT64`)
+ * attribute are quantized on write. Quantization is lossy: each value is
+ * scaled by `10^digits` and rounded to an integer of the same width, which
+ * is then filtered and compressed as such (e.g., with `TILEDB_DOUBLE_DELTA`
+ * or `TILEDB_FRAME_OF_REFERENCE`). Reads return the values rounded to the
+ * nearest multiple of `10^-digits`. The attribute must be compressed or
+ * filtered, and writes fail on non-finite values or values that do not fit
+ * the integer type after scaling. The value that fills empty dense cells is
+ * stored exactly.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * // Keep 3 decimal digits
+ * tiledb_attribute_set_quantization(ctx, attr, 1, 3);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param attr The target attribute.
+ * @param quantized `1` to enable quantization, `0` to disable it.
+ * @param digits The number of decimal digits to retain, in `[0, 15]`.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_attribute_set_quantization(
+    tiledb_ctx_t* ctx, tiledb_attribute_t* attr, int quantized, int digits);
+
+/**
+ * Sets a dictionary of content common to the attribute values, which the
+ * `TILEDB_ZSTD` compressor uses to compress small tiles better and faster.
+ * The dictionary is typically trained on sample values (e.g., with
+ * `zstd --train`) and is stored in the array schema, since it is needed
+ * for decompression.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_attribute_set_compression_dictionary(ctx, attr, dict, dict_size);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param attr The target attribute.
+ * @param dictionary The dictionary (`NULL` to unset).
+ * @param dictionary_size The dictionary size in bytes.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_attribute_set_compression_dictionary(
+    tiledb_ctx_t* ctx,
+    tiledb_attribute_t* attr,
+    const void* dictionary,
+    uint64_t dictionary_size);
+
 /**
  * Sets the number of values per cell for an attribute. If this is not
  * used, the default is `1`.
@@ -924,6 +1118,117 @@ TILEDB_EXPORT int tiledb_attribute_get_compressor(
     tiledb_compressor_t* compressor,
     int* compression_level);
 
+/**
+ * Retrieves the number of filters of the attribute.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * unsigned int filter_num;
+ * tiledb_attribute_get_filter_num(ctx, attr, &filter_num);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param attr The attribute.
+ * @param filter_num The number of filters to be retrieved.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_attribute_get_filter_num(
+    tiledb_ctx_t* ctx,
+    const tiledb_attribute_t* attr,
+    unsigned int* filter_num);
+
+/**
+ * Retrieves the filters of the attribute, in the order they are applied.
+ * The input array must hold at least as many elements as the number of
+ * filters (see `tiledb_attribute_get_filter_num`).
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_filter_t filters[8];
+ * tiledb_attribute_get_filters(ctx, attr, filters);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param attr The attribute.
+ * @param filters The filters to be retrieved.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_attribute_get_filters(
+    tiledb_ctx_t* ctx,
+    const tiledb_attribute_t* attr,
+    tiledb_filter_t* filters);
+
+/**
+ * Checks whether the values of the attribute are dictionary encoded.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * int dictionary_encoding;
+ * tiledb_attribute_get_dictionary_encoding(ctx, attr, &dictionary_encoding);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param attr The attribute.
+ * @param dictionary_encoding Set to `1` if the attribute is dictionary
+ *     encoded, and `0` otherwise.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_attribute_get_dictionary_encoding(
+    tiledb_ctx_t* ctx,
+    const tiledb_attribute_t* attr,
+    int* dictionary_encoding);
+
+/**
+ * Retrieves the quantization of the attribute values.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * int quantized, digits;
+ * tiledb_attribute_get_quantization(ctx, attr, &quantized, &digits);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param attr The attribute.
+ * @param quantized Set to `1` if the attribute values are quantized, and
+ *     `0` otherwise.
+ * @param digits Set to the number of decimal digits retained by
+ *     quantization (`0` if the values are not quantized).
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_attribute_get_quantization(
+    tiledb_ctx_t* ctx,
+    const tiledb_attribute_t* attr,
+    int* quantized,
+    int* digits);
+
+/**
+ * Retrieves the compression dictionary of the attribute. The returned
+ * pointer is valid as long as the attribute is.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * const void* dict;
+ * uint64_t dict_size;
+ * tiledb_attribute_get_compression_dictionary(ctx, attr, &dict, &dict_size);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param attr The attribute.
+ * @param dictionary Set to the dictionary (`NULL` if there is none).
+ * @param dictionary_size Set to the dictionary size in bytes.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_attribute_get_compression_dictionary(
+    tiledb_ctx_t* ctx,
+    const tiledb_attribute_t* attr,
+    const void** dictionary,
+    uint64_t* dictionary_size);
+
 /**
  * Retrieves the number of values per cell for the attribute.
  *
@@ -1471,6 +1776,52 @@ TILEDB_EXPORT int tiledb_array_schema_set_offsets_compressor(
     tiledb_compressor_t compressor,
     int compression_level);
 
+/**
+ * Sets the filters applied (in order) to the coordinates prior to
+ * compression.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_filter_t filters[] = {TILEDB_FILTER_DOUBLE_DELTA};
+ * tiledb_array_schema_set_coords_filters(ctx, array_schema, filters, 1);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param array_schema The array schema.
+ * @param filters The coordinates filters.
+ * @param filter_num The number of filters.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_array_schema_set_coords_filters(
+    tiledb_ctx_t* ctx,
+    tiledb_array_schema_t* array_schema,
+    const tiledb_filter_t* filters,
+    unsigned int filter_num);
+
+/**
+ * Sets the filters applied (in order) to the offsets of variable-sized
+ * attribute values prior to compression.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_filter_t filters[] = {TILEDB_FILTER_DELTA};
+ * tiledb_array_schema_set_offsets_filters(ctx, array_schema, filters, 1);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param array_schema The array schema.
+ * @param filters The offsets filters.
+ * @param filter_num The number of filters.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_array_schema_set_offsets_filters(
+    tiledb_ctx_t* ctx,
+    tiledb_array_schema_t* array_schema,
+    const tiledb_filter_t* filters,
+    unsigned int filter_num);
+
 /**
  * Checks the correctness of the array schema.
  *
@@ -1863,6 +2214,45 @@ TILEDB_EXPORT int tiledb_query_set_buffers(
     void** buffers,
     uint64_t* buffer_sizes);
 
+/**
+ * Sets a validity bitmap buffer for an attribute of a dense read query.
+ * After the read, the buffer holds one bit per result cell, in the order
+ * the cells are stored in the attribute buffers. Bit `i` is stored in byte
+ * `i / 8` at position `i % 8` (least significant bit first), and it is 1
+ * if the cell is non-empty and 0 if the cell is empty. Empty cells are
+ * still filled with the default fill value in the attribute buffers, but
+ * the bitmap allows distinguishing them from legitimate values without
+ * scanning the results.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * uint8_t validity[13];  // 100 cells need 13 bytes
+ * uint64_t validity_size = sizeof(validity);
+ * tiledb_query_set_validity_buffer(
+ *     ctx, query, "attr_1", validity, &validity_size);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The TileDB query.
+ * @param attribute The attribute the bitmap refers to. The attribute buffers
+ *     must have been set with `tiledb_query_set_buffers`.
+ * @param buffer The bitmap buffer.
+ * @param buffer_size Initially the allocated size of *buffer*. After the
+ *     termination of the query it will contain the size of the useful bitmap
+ *     bytes.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ *
+ * @note This is applicable only to read queries on dense arrays. Calling
+ *     `tiledb_query_set_buffers` again drops all the validity buffers.
+ */
+TILEDB_EXPORT int tiledb_query_set_validity_buffer(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* attribute,
+    uint8_t* buffer,
+    uint64_t* buffer_size);
+
 /**
  * Sets the layout of the cells to be written or read.
  *
@@ -1895,6 +2285,63 @@ TILEDB_EXPORT int tiledb_query_set_buffers(
 TILEDB_EXPORT int tiledb_query_set_layout(
     tiledb_ctx_t* ctx, tiledb_query_t* query, tiledb_layout_t layout);
 
+/**
+ * Sets how the cells with duplicate coordinates within a single unordered
+ * write are handled.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_set_dedup(ctx, query, TILEDB_DEDUP_SUM);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The TileDB query.
+ * @param dedup One of the following:
+ *    - `TILEDB_NO_DEDUP`:
+ *      All the cells are stored (default).
+ *    - `TILEDB_DEDUP_LAST`:
+ *      The cells with the same coordinates are collapsed into the last of
+ *      them in the user buffers.
+ *    - `TILEDB_DEDUP_SUM`, `TILEDB_DEDUP_MIN`, `TILEDB_DEDUP_MAX`:
+ *      The cells with the same coordinates are collapsed into one cell
+ *      that stores the sum, minimum or maximum of their values for each
+ *      numeric fixed-sized attribute, and the last of their values for the
+ *      other attributes. Integer sums wrap around on overflow.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ *
+ * @note This is applicable only to write queries, and takes effect only
+ *     for the unordered layout. Such writes bypass the write buffer
+ *     (`sm.write_buffer_size`), and cannot be combined with
+ *     `sm.unordered_write_memory_budget`.
+ */
+TILEDB_EXPORT int tiledb_query_set_dedup(
+    tiledb_ctx_t* ctx, tiledb_query_t* query, tiledb_dedup_t dedup);
+
+/**
+ * Sets whether the tiles that a read query fetches from storage are
+ * inserted into the tile caches (by default they are). Disabling it keeps
+ * reads that touch each tile once, such as bulk exports, from evicting
+ * the tiles that other queries read frequently. Tiles that are already
+ * cached are still read from the caches, but are not promoted to their
+ * protected segments (see `sm.tile_cache_policy`).
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_set_cache_fill(ctx, query, 0);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The TileDB query.
+ * @param cache_fill `1` to insert the tiles into the caches, `0` otherwise.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ *
+ * @note This is applicable only to read queries.
+ */
+TILEDB_EXPORT int tiledb_query_set_cache_fill(
+    tiledb_ctx_t* ctx, tiledb_query_t* query, int cache_fill);
+
 /**
  * Finalizes a TileDB query object, flushing all internal state.
  *
@@ -1902,7 +2349,9 @@ TILEDB_EXPORT int tiledb_query_set_layout(
  *
  * (i) If the query was writing in global order, it flushes the internal state.
  * It is **required** to finalize global-order write query objects in order to
- * ensure correct execution.
+ * ensure correct execution. The same holds for unordered write queries if
+ * `sm.unordered_write_memory_budget` is not `0`, in which case finalization
+ * merges the cells of all the submissions into a single fragment.
  *
  * (ii) For any query, it "closes" the corresponding array. This causes the
  * storage manager to decrement the reference count of the array. When the
@@ -2073,6 +2522,23 @@ TILEDB_EXPORT int tiledb_array_create(
 TILEDB_EXPORT int tiledb_array_consolidate(
     tiledb_ctx_t* ctx, const char* array_uri);
 
+/**
+ * Flushes the cells of the unordered writes that are buffered for an array
+ * (see `sm.write_buffer_size`) into a new fragment. If the flush fails, the
+ * buffered cells are discarded.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_array_flush(ctx, "hdfs:///tiledb_arrays/my_array");
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param array_uri The name of the TileDB array to be flushed.
+ * @return `TILEDB_OK` on success, and `TILEDB_ERR` on error.
+ */
+TILEDB_EXPORT int tiledb_array_flush(tiledb_ctx_t* ctx, const char* array_uri);
+
 /**
  * Retrieves the non-empty domain from an array. This is the union of the
  * non-empty domains of the array fragments.
@@ -108,6 +108,19 @@
     TILEDB_LAYOUT_ENUM(UNORDERED),
 #endif
 
+#ifdef TILEDB_DEDUP_ENUM
+    /** Keep all the cells with the same coordinates */
+    TILEDB_DEDUP_ENUM(NO_DEDUP),
+    /** Keep the last of the cells with the same coordinates */
+    TILEDB_DEDUP_ENUM(DEDUP_LAST),
+    /** Sum the values of the cells with the same coordinates */
+    TILEDB_DEDUP_ENUM(DEDUP_SUM),
+    /** Keep the minimum value of the cells with the same coordinates */
+    TILEDB_DEDUP_ENUM(DEDUP_MIN),
+    /** Keep the maximum value of the cells with the same coordinates */
+    TILEDB_DEDUP_ENUM(DEDUP_MAX),
+#endif
+
 #ifdef TILEDB_COMPRESSOR_ENUM
 #undef BLOSC_LZ4
 #undef BLOSC_LZ4HC
@@ -140,6 +153,29 @@
     TILEDB_COMPRESSOR_ENUM(BZIP2),
     /** Double-delta compressor */
     TILEDB_COMPRESSOR_ENUM(DOUBLE_DELTA),
+    /** Frame of reference (per-block minimum and bit width) compressor */
+    TILEDB_COMPRESSOR_ENUM(FRAME_OF_REFERENCE),
+    /** Picks the best of a candidate set of compressors for every chunk */
+    TILEDB_COMPRESSOR_ENUM(AUTO_COMPRESSION),
+    /** Gorilla (XOR with the previous value) compressor for real values */
+    TILEDB_COMPRESSOR_ENUM(GORILLA),
+#endif
+
+#ifdef TILEDB_FILTER_ENUM
+    /** Byte-shuffle filter (groups the i-th bytes of all values together) */
+    TILEDB_FILTER_ENUM(FILTER_BYTESHUFFLE),
+    /** Bit-shuffle filter (groups the i-th bits of all values together) */
+    TILEDB_FILTER_ENUM(FILTER_BITSHUFFLE),
+    /** Delta filter (stores the differences of consecutive values) */
+    TILEDB_FILTER_ENUM(FILTER_DELTA),
+    /** Double-delta filter (stores the differences of consecutive deltas) */
+    TILEDB_FILTER_ENUM(FILTER_DOUBLE_DELTA),
+    /** Bit-width reduction filter (stores values in the fewest bytes) */
+    TILEDB_FILTER_ENUM(FILTER_BIT_WIDTH_REDUCTION),
+    /** Frame of reference filter (bit-packs values relative to a minimum) */
+    TILEDB_FILTER_ENUM(FILTER_FRAME_OF_REFERENCE),
+    /** Compact offsets filter (bit-packs the lengths of monotonic offsets) */
+    TILEDB_FILTER_ENUM(FILTER_COMPACT_OFFSETS),
 #endif
 
 #ifdef TILEDB_QUERY_STATUS_ENUM
@@ -47,10 +47,14 @@ namespace sm {
 LRUCache::LRUCache(
     uint64_t max_size,
     void* (*evict_callback)(LRUCacheItem*, void*),
-    void* evict_callback_data) {
+    void* evict_callback_data,
+    Policy policy) {
   evict_callback_ = evict_callback;
   evict_callback_data_ = evict_callback_data;
   max_size_ = max_size;
+  protected_max_size_ = max_size - max_size / 5;
+  policy_ = policy;
+  protected_size_ = 0;
   size_ = 0;
 }
 
@@ -63,83 +67,54 @@ LRUCache::~LRUCache() {
 /* ****************************** */
 
 void LRUCache::clear() {
-  for (auto& item : item_ll_) {
-    if (evict_callback_ == nullptr)
-      std::free(item.object_);
-    else
-      (*evict_callback_)(&item, evict_callback_data_);
-  }
+  std::unique_lock<std::mutex> lck(mtx_);
+  for (auto& item : item_ll_)
+    free_object(&item);
+  for (auto& item : protected_ll_)
+    free_object(&item);
   item_ll_.clear();
+  protected_ll_.clear();
+  item_map_.clear();
+  protected_size_ = 0;
+  size_ = 0;
 }
 
 Status LRUCache::insert(
     const std::string& key, void* object, uint64_t size, bool overwrite) {
-  // Do nothing if the object size is bigger than the cache maximum size
-  if (size > max_size_)
-    return Status::Ok();
+  return insert_item(key, object, size, nullptr, overwrite);
+}
 
-  if (object == nullptr)
+Status LRUCache::insert(
+    const std::string& key,
+    const std::shared_ptr<Buffer>& buffer,
+    bool overwrite) {
+  if (buffer == nullptr)
     return LOG_STATUS(Status::LRUCacheError(
-        "Cannot insert into cache; Object cannot be null"));
-
-  // Lock mutex
-  mtx_.lock();
-
-  auto item_it = item_map_.find(key);
-  bool exists = item_it != item_map_.end();
-
-  if (exists && !overwrite) {
-    std::free(object);
-    mtx_.unlock();
+        "Cannot insert into cache; Buffer cannot be null"));
+  if (buffer->size() == 0)
     return Status::Ok();
-  }
-
-  // Evict if necessary
-  while (size_ + size > max_size_)
-    evict();
+  return insert_item(key, buffer->data(), buffer->size(), buffer, overwrite);
+}
 
-  // Key exists
-  if (exists) {
-    // Replace cache item
-    auto& node = item_it->second;
-    auto& item = *node;
-    if (evict_callback_ == nullptr)
-      std::free(item.object_);
-    else
-      (*evict_callback_)(&item, evict_callback_data_);
-    item.object_ = object;
-    item.size_ = size;
-
-    // Move cache item node to the end of the list
-    if (std::next(node) != item_ll_.end()) {
-      item_ll_.splice(item_ll_.end(), item_ll_, node, std::next(node));
+void LRUCache::invalidate(const std::string& prefix) {
+  std::unique_lock<std::mutex> lck(mtx_);
+  for (auto ll : {&item_ll_, &protected_ll_}) {
+    for (auto it = ll->begin(); it != ll->end();) {
+      auto node = it++;
+      if (node->key_.compare(0, prefix.size(), prefix) == 0)
+        erase(node);
     }
-  } else {  // Key does not exist
-    // Create a new cache item
-    LRUCacheItem new_item;
-    new_item.key_ = key;
-    new_item.object_ = object;
-    new_item.size_ = size;
-
-    // Create new node in linked list
-    item_ll_.emplace_back(new_item);
-
-    // Create new element in the hash table
-    item_map_[key] = --(item_ll_.end());
   }
-
-  size_ += size;
-
-  // Unlock mutex
-  mtx_.unlock();
-
-  return Status::Ok();
 }
 
 uint64_t LRUCache::max_size() const {
   return max_size_;
 }
 
+LRUCache::Policy LRUCache::policy() const {
+  return policy_;
+}
+
 Status LRUCache::read(const std::string& key, Buffer* buffer, bool* success) {
   // Lock mutex
   mtx_.lock();
@@ -157,9 +132,7 @@ Status LRUCache::read(const std::string& key, Buffer* buffer, bool* success) {
   buffer->write(item->object_, item->size_);
 
   // Move cache item node to the end of the list
-  if (std::next(item) != item_ll_.end()) {
-    item_ll_.splice(item_ll_.end(), item_ll_, item, std::next(item));
-  }
+  touch(item);
 
   // Unlock mutex
   mtx_.unlock();
@@ -195,10 +168,38 @@ Status LRUCache::read(
   std::memcpy(buffer, (char*)item->object_ + offset, nbytes);
 
   // Move cache item node to the end of the list
-  if (std::next(item) != item_ll_.end()) {
-    item_ll_.splice(item_ll_.end(), item_ll_, item, std::next(item));
+  touch(item);
+
+  // Unlock mutex
+  mtx_.unlock();
+
+  *success = true;
+  return Status::Ok();
+}
+
+Status LRUCache::read_shared(
+    const std::string& key,
+    std::shared_ptr<Buffer>* buffer,
+    bool* success,
+    bool promote) {
+  // Lock mutex
+  mtx_.lock();
+
+  // Find cached item
+  auto item_it = item_map_.find(key);
+  if (item_it == item_map_.end() || item_it->second->buffer_ == nullptr) {
+    mtx_.unlock();
+    *success = false;
+    return Status::Ok();
   }
 
+  // Share the item buffer
+  auto& item = item_it->second;
+  *buffer = item->buffer_;
+
+  // Move cache item node to the end of the list
+  touch(item, promote);
+
   // Unlock mutex
   mtx_.unlock();
 
@@ -221,16 +222,114 @@ std::list<LRUCache::LRUCacheItem>::const_iterator LRUCache::item_iter_end()
 /* ****************************** */
 
 void LRUCache::evict() {
-  assert(!item_ll_.empty());
+  assert(!item_ll_.empty() || !protected_ll_.empty());
 
-  auto item = item_ll_.front();
-  if (evict_callback_ == nullptr)
-    std::free(item.object_);
+  // Evict from the probationary segment first
+  if (!item_ll_.empty())
+    erase(item_ll_.begin());
   else
-    (*evict_callback_)(&item, evict_callback_data_);
-  item_map_.erase(item.key_);
-  size_ -= item.size_;
-  item_ll_.pop_front();
+    erase(protected_ll_.begin());
+}
+
+void LRUCache::erase(std::list<LRUCacheItem>::iterator node) {
+  free_object(&*node);
+  item_map_.erase(node->key_);
+  size_ -= node->size_;
+  if (node->protected_) {
+    protected_size_ -= node->size_;
+    protected_ll_.erase(node);
+  } else {
+    item_ll_.erase(node);
+  }
+}
+
+void LRUCache::free_object(LRUCacheItem* item) {
+  if (item->buffer_ != nullptr)
+    item->buffer_.reset();
+  else if (evict_callback_ == nullptr)
+    std::free(item->object_);
+  else
+    (*evict_callback_)(item, evict_callback_data_);
+  item->object_ = nullptr;
+}
+
+void LRUCache::touch(std::list<LRUCacheItem>::iterator node, bool promote) {
+  // Plain LRU, an item that is already protected, or one not to promote
+  if (policy_ == Policy::LRU || node->protected_ || !promote) {
+    auto& ll = node->protected_ ? protected_ll_ : item_ll_;
+    ll.splice(ll.end(), ll, node);
+    return;
+  }
+
+  // Promote the item to the protected segment
+  node->protected_ = true;
+  protected_size_ += node->size_;
+  protected_ll_.splice(protected_ll_.end(), item_ll_, node);
+
+  // Demote the least recently used protected items if necessary
+  while (protected_size_ > protected_max_size_) {
+    auto demoted = protected_ll_.begin();
+    demoted->protected_ = false;
+    protected_size_ -= demoted->size_;
+    item_ll_.splice(item_ll_.end(), protected_ll_, demoted);
+  }
+}
+
+Status LRUCache::insert_item(
+    const std::string& key,
+    void* object,
+    uint64_t size,
+    const std::shared_ptr<Buffer>& buffer,
+    bool overwrite) {
+  // Do nothing if the object size is bigger than the cache maximum size
+  if (size > max_size_)
+    return Status::Ok();
+
+  if (object == nullptr)
+    return LOG_STATUS(Status::LRUCacheError(
+        "Cannot insert into cache; Object cannot be null"));
+
+  // Lock mutex
+  mtx_.lock();
+
+  auto item_it = item_map_.find(key);
+  bool exists = item_it != item_map_.end();
+
+  if (exists && !overwrite) {
+    if (buffer == nullptr)
+      std::free(object);
+    mtx_.unlock();
+    return Status::Ok();
+  }
+
+  // Remove the replaced item first, so that eviction cannot reach it
+  if (exists)
+    erase(item_it->second);
+
+  // Evict if necessary
+  while (size_ + size > max_size_)
+    evict();
+
+  // Create a new cache item
+  LRUCacheItem new_item;
+  new_item.key_ = key;
+  new_item.object_ = object;
+  new_item.size_ = size;
+  new_item.protected_ = false;
+  new_item.buffer_ = buffer;
+
+  // Create new node in linked list
+  item_ll_.emplace_back(new_item);
+
+  // Create new element in the hash table
+  item_map_[key] = --(item_ll_.end());
+
+  size_ += size;
+
+  // Unlock mutex
+  mtx_.unlock();
+
+  return Status::Ok();
 }
 
 }  // namespace sm
@@ -37,8 +37,9 @@
 #include "tiledb/sm/misc/status.h"
 
 #include <list>
-#include <map>
+#include <memory>
 #include <mutex>
+#include <unordered_map>
 
 namespace tiledb {
 namespace sm {
@@ -49,6 +50,12 @@ namespace sm {
  * copying of portions of the opaque objects. Note that, after inserting
  * an object into the cache, the cache **owns** the object and will delete
  * it upon eviction.
+ *
+ * With the segmented LRU policy, the cache is split into a probationary
+ * and a protected segment. New objects enter the probationary segment, and
+ * are promoted to the protected segment when they are read. Objects are
+ * evicted from the probationary segment first, so a scan over many objects
+ * that are read only once cannot flush the frequently read ones.
  */
 class LRUCache {
  public:
@@ -56,6 +63,18 @@ class LRUCache {
   /*          TYPE DEFINITIONS         */
   /* ********************************* */
 
+  /** The eviction policy of the cache. */
+  enum class Policy : char {
+    /** Evicts the least recently used object. */
+    LRU,
+    /**
+     * Evicts the least recently used object that was not read since its
+     * insertion, if any. The protected segment (objects read since their
+     * insertion) takes up to 80% of the cache size.
+     */
+    SEGMENTED_LRU
+  };
+
   struct LRUCacheItem {
     /** The object lable. */
     std::string key_;
@@ -63,6 +82,14 @@ class LRUCache {
     void* object_;
     /** The object size. */
     uint64_t size_;
+    /** Whether the item is in the protected segment. */
+    bool protected_;
+
+    /**
+     * The buffer holding the object, if it was inserted as a shared buffer
+     * (`object_` then points to its data and is not owned by the item).
+     */
+    std::shared_ptr<Buffer> buffer_;
   };
 
   /* ********************************* */
@@ -76,11 +103,13 @@ class LRUCache {
    *     object. It takes as input the cache object to be evicted, and
    *     `evict_callback_data`.
    * @param evict_callback_data The data input to `evict_callback`.
+   * @param policy The eviction policy.
    */
   LRUCache(
       uint64_t max_size,
       void* (*evict_callback)(LRUCacheItem*, void*) = nullptr,
-      void* evict_callback_data = nullptr);
+      void* evict_callback_data = nullptr,
+      Policy policy = Policy::LRU);
 
   /** Destructor. */
   ~LRUCache();
@@ -95,14 +124,16 @@ class LRUCache {
   /**
    * Returns a constant iterator at the beginning of the linked list of
    * cached items, where items closest to the head (beginning) are going
-   * to be evicted from the cache sooner.
+   * to be evicted from the cache sooner. With the segmented LRU policy,
+   * the list holds only the probationary segment.
    */
   std::list<LRUCacheItem>::const_iterator item_iter_begin() const;
 
   /**
    * Returns a constant iterator at the end of the linked list of
    * cached items, where items closest to the head (beginning) are going
-   * to be evicted from the cache sooner.
+   * to be evicted from the cache sooner. With the segmented LRU policy,
+   * the list holds only the probationary segment.
    */
   std::list<LRUCacheItem>::const_iterator item_iter_end() const;
 
@@ -123,9 +154,35 @@ class LRUCache {
       uint64_t size,
       bool overwrite = true);
 
+  /**
+   * Inserts the data of a buffer into the cache, without copying them. The
+   * cache shares the buffer with the caller (and whoever reads it from the
+   * cache with `read_shared`), so the buffer must not be modified after
+   * insertion.
+   *
+   * @param key The key that describes the inserted object.
+   * @param buffer The buffer holding the object.
+   * @param overwrite If `true`, if the object exists in the cache it will be
+   *     overwritten. Otherwise, the cache does not keep the new buffer.
+   * @return Status
+   */
+  Status insert(
+      const std::string& key,
+      const std::shared_ptr<Buffer>& buffer,
+      bool overwrite = true);
+
+  /**
+   * Removes all the cached objects whose key starts with the input prefix
+   * (e.g., the objects of removed files).
+   */
+  void invalidate(const std::string& prefix);
+
   /** Returns the maximum size of the cache. */
   uint64_t max_size() const;
 
+  /** Returns the eviction policy of the cache. */
+  Policy policy() const;
+
   /**
    * Reads an entire cached object labeled by `key`.
    *
@@ -156,6 +213,24 @@ class LRUCache {
       uint64_t nbytes,
       bool* success);
 
+  /**
+   * Retrieves the buffer of an object that was inserted as a shared buffer,
+   * without copying its data.
+   *
+   * @param key The label of the object to be read.
+   * @param buffer Set to the (read-only) buffer holding the object.
+   * @param success `true` if the object is in the cache and was inserted as
+   *     a shared buffer, and `false` otherwise.
+   * @param promote If `false`, the object is marked as used without being
+   *     promoted to the protected segment (with the segmented LRU policy).
+   * @return Status.
+   */
+  Status read_shared(
+      const std::string& key,
+      std::shared_ptr<Buffer>* buffer,
+      bool* success,
+      bool promote = true);
+
  private:
   /* ********************************* */
   /*         PRIVATE ATTRIBUTES        */
@@ -172,16 +247,37 @@ class LRUCache {
 
   /**
    * Doubly-connected linked list of cache items. The head of the list is the
-   * next item to be evicted.
+   * next item to be evicted. With the segmented LRU policy, this is the
+   * probationary segment.
    */
   std::list<LRUCacheItem> item_ll_;
 
-  /** Maps a key label to an iterator (list node of) of `item_ll_`. */
-  std::map<std::string, std::list<LRUCacheItem>::iterator> item_map_;
+  /**
+   * Doubly-connected linked list of the items of the protected segment,
+   * used only with the segmented LRU policy. Its head is the next item to
+   * be demoted to the probationary segment.
+   */
+  std::list<LRUCacheItem> protected_ll_;
+
+  /**
+   * Maps a key label to an iterator (list node of) of `item_ll_` or
+   * `protected_ll_`.
+   */
+  std::unordered_map<std::string, std::list<LRUCacheItem>::iterator>
+      item_map_;
 
   /** The maximum cache size. */
   uint64_t max_size_;
 
+  /** The maximum size of the protected segment. */
+  uint64_t protected_max_size_;
+
+  /** The eviction policy. */
+  Policy policy_;
+
+  /** The current size of the protected segment. */
+  uint64_t protected_size_;
+
   /** The mutex for thread-safety. */
   std::mutex mtx_;
 
@@ -194,6 +290,37 @@ class LRUCache {
 
   /** Evicts the next object. */
   void evict();
+
+  /**
+   * Removes an item from the cache, freeing its object. The item node is
+   * invalidated.
+   */
+  void erase(std::list<LRUCacheItem>::iterator node);
+
+  /**
+   * Marks an item as used, moving it to the end of its list. With the
+   * segmented LRU policy and `promote` set, an item of the probationary
+   * segment is promoted to the protected segment, demoting the least
+   * recently used protected items if it overflows.
+   */
+  void touch(std::list<LRUCacheItem>::iterator node, bool promote = true);
+
+  /**
+   * Frees the object of the input item, either releasing its shared buffer
+   * or freeing it (through the evict callback, if any).
+   */
+  void free_object(LRUCacheItem* item);
+
+  /**
+   * Inserts an object into the cache. If `buffer` is not `nullptr`, the
+   * object is its data and the cache shares it instead of owning `object`.
+   */
+  Status insert_item(
+      const std::string& key,
+      void* object,
+      uint64_t size,
+      const std::shared_ptr<Buffer>& buffer,
+      bool overwrite);
 };
 
 }  // namespace sm
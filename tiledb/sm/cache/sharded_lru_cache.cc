@@ -0,0 +1,141 @@
+/**
+ * @file   sharded_lru_cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class ShardedLRUCache.
+ */
+
+#include "tiledb/sm/cache/sharded_lru_cache.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace tiledb {
+namespace sm {
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+ShardedLRUCache::ShardedLRUCache(
+    uint64_t max_size,
+    unsigned shard_num,
+    void* (*evict_callback)(LRUCache::LRUCacheItem*, void*),
+    void* evict_callback_data,
+    LRUCache::Policy policy) {
+  max_size_ = max_size;
+  shard_num = std::max(shard_num, 1u);
+
+  // The first shards take the remainder of the division
+  for (unsigned i = 0; i < shard_num; ++i) {
+    uint64_t shard_size = max_size / shard_num + (i < max_size % shard_num);
+    shards_.emplace_back(new LRUCache(
+        shard_size, evict_callback, evict_callback_data, policy));
+  }
+}
+
+ShardedLRUCache::~ShardedLRUCache() = default;
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+void ShardedLRUCache::clear() {
+  for (auto& s : shards_)
+    s->clear();
+}
+
+Status ShardedLRUCache::insert(
+    const std::string& key, void* object, uint64_t size, bool overwrite) {
+  return shard(key)->insert(key, object, size, overwrite);
+}
+
+Status ShardedLRUCache::insert(
+    const std::string& key,
+    const std::shared_ptr<Buffer>& buffer,
+    bool overwrite) {
+  return shard(key)->insert(key, buffer, overwrite);
+}
+
+void ShardedLRUCache::invalidate(const std::string& prefix) {
+  for (auto& s : shards_)
+    s->invalidate(prefix);
+}
+
+uint64_t ShardedLRUCache::max_size() const {
+  return max_size_;
+}
+
+uint64_t ShardedLRUCache::max_object_size() const {
+  return shards_.back()->max_size();
+}
+
+Status ShardedLRUCache::read(
+    const std::string& key, Buffer* buffer, bool* success) {
+  return shard(key)->read(key, buffer, success);
+}
+
+Status ShardedLRUCache::read(
+    const std::string& key,
+    void* buffer,
+    uint64_t offset,
+    uint64_t nbytes,
+    bool* success) {
+  return shard(key)->read(key, buffer, offset, nbytes, success);
+}
+
+Status ShardedLRUCache::read_shared(
+    const std::string& key,
+    std::shared_ptr<Buffer>* buffer,
+    bool* success,
+    bool promote) {
+  return shard(key)->read_shared(key, buffer, success, promote);
+}
+
+unsigned ShardedLRUCache::shard_num() const {
+  return (unsigned)shards_.size();
+}
+
+/* ****************************** */
+/*          PRIVATE METHODS       */
+/* ****************************** */
+
+LRUCache* ShardedLRUCache::shard(const std::string& key) const {
+  if (shards_.size() == 1)
+    return shards_[0].get();
+
+  // The hash is mixed before picking the shard, so that the shard does not
+  // depend on the same bits as the bucket of the key within the shard
+  uint64_t h = std::hash<std::string>()(key);
+  h = (h ^ (h >> 33)) * 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  return shards_[h % shards_.size()].get();
+}
+
+}  // namespace sm
+}  // namespace tiledb
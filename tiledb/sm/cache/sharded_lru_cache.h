@@ -0,0 +1,154 @@
+/**
+ * @file   sharded_lru_cache.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class ShardedLRUCache.
+ */
+
+#ifndef TILEDB_SHARDED_LRU_CACHE_H
+#define TILEDB_SHARDED_LRU_CACHE_H
+
+#include "tiledb/sm/cache/lru_cache.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A cache split into a number of independent `LRUCache` shards. Each key is
+ * mapped to a shard by its hash, and each shard has its own lock and an
+ * equal share of the cache size, so that concurrent lookups of different
+ * keys rarely contend. Eviction is LRU within each shard, which
+ * approximates LRU over the whole cache. Note that an object larger than
+ * a shard (see `max_object_size`) cannot be cached.
+ */
+class ShardedLRUCache {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param max_size The maximum cache size.
+   * @param shard_num The number of shards (at least 1).
+   * @param evict_callback The function to be called upon evicting a cache
+   *     object (see `LRUCache`).
+   * @param evict_callback_data The data input to `evict_callback`.
+   * @param policy The eviction policy of each shard.
+   */
+  ShardedLRUCache(
+      uint64_t max_size,
+      unsigned shard_num,
+      void* (*evict_callback)(LRUCache::LRUCacheItem*, void*) = nullptr,
+      void* evict_callback_data = nullptr,
+      LRUCache::Policy policy = LRUCache::Policy::LRU);
+
+  /** Destructor. */
+  ~ShardedLRUCache();
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Clears the cache, deleting all cached items. */
+  void clear();
+
+  /** See `LRUCache::insert`. */
+  Status insert(
+      const std::string& key,
+      void* object,
+      uint64_t size,
+      bool overwrite = true);
+
+  /** See `LRUCache::insert`. */
+  Status insert(
+      const std::string& key,
+      const std::shared_ptr<Buffer>& buffer,
+      bool overwrite = true);
+
+  /** See `LRUCache::invalidate`. */
+  void invalidate(const std::string& prefix);
+
+  /** Returns the maximum size of the cache. */
+  uint64_t max_size() const;
+
+  /**
+   * Returns the maximum size of an object that can be cached, i.e., the
+   * size of the smallest shard.
+   */
+  uint64_t max_object_size() const;
+
+  /** See `LRUCache::read`. */
+  Status read(const std::string& key, Buffer* buffer, bool* success);
+
+  /** See `LRUCache::read`. */
+  Status read(
+      const std::string& key,
+      void* buffer,
+      uint64_t offset,
+      uint64_t nbytes,
+      bool* success);
+
+  /** See `LRUCache::read_shared`. */
+  Status read_shared(
+      const std::string& key,
+      std::shared_ptr<Buffer>* buffer,
+      bool* success,
+      bool promote = true);
+
+  /** Returns the number of shards. */
+  unsigned shard_num() const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The maximum cache size. */
+  uint64_t max_size_;
+
+  /** The shards. */
+  std::vector<std::unique_ptr<LRUCache>> shards_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Returns the shard the input key is mapped to. */
+  LRUCache* shard(const std::string& key) const;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_SHARDED_LRU_CACHE_H
@@ -32,19 +32,23 @@
 
 #include "tiledb/sm/compressors/dd_compressor.h"
 #include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/utils.h"
+
+#include <cstring>
+#include <type_traits>
 
 /* ****************************** */
 /*             MACROS             */
 /* ****************************** */
 
-#define ABS(x) ((x) < 0) ? uint64_t(-(x)) : uint64_t(x)
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
-#define MAX(a, b) ((a) > (b) ? (a) : (b))
 
 namespace tiledb {
 namespace sm {
 
 const uint64_t DoubleDelta::OVERHEAD = 17;
+const uint64_t DoubleDelta::BLOCK_SIZE = 128;
+const uint8_t DoubleDelta::BLOCK_FORMAT = 255;
 
 /* ****************************** */
 /*               API              */
@@ -133,9 +137,9 @@ Status DoubleDelta::decompress(
 }
 
 uint64_t DoubleDelta::overhead(uint64_t nbytes) {
-  // DoubleDelta has a fixed size overhead
-  (void)nbytes;
-  return DoubleDelta::OVERHEAD;
+  // Fixed size overhead, plus one bit width byte per block of at least
+  // BLOCK_SIZE bytes
+  return DoubleDelta::OVERHEAD + nbytes / BLOCK_SIZE + 1;
 }
 
 /* ****************************** */
@@ -144,102 +148,118 @@ uint64_t DoubleDelta::overhead(uint64_t nbytes) {
 
 template <class T>
 Status DoubleDelta::compress(ConstBuffer* input_buffer, Buffer* output_buffer) {
-  // Calculate number of values and handle trivial case
+  typedef typename std::make_unsigned<T>::type U;
+  const unsigned int bits = 8 * sizeof(T);
+
+  // Calculate number of values
   uint64_t value_size = sizeof(T);
   uint64_t num = input_buffer->size() / value_size;
   assert(num > 0 && (input_buffer->size() % value_size == 0));
 
-  // Calculate bitsize (ignoring the sign bit)
-  auto in = (T*)input_buffer->data();
-  unsigned int bitsize;
-  RETURN_NOT_OK(compute_bitsize(in, num, &bitsize));
-  assert(bitsize <= std::numeric_limits<uint8_t>::max());
-  auto bitsize_c = static_cast<uint8_t>(bitsize);
-
-  // Write bitsize and number of values
-  RETURN_NOT_OK(output_buffer->write(&bitsize_c, sizeof(uint8_t)));
+  // Write format and number of values
+  RETURN_NOT_OK(output_buffer->write(&BLOCK_FORMAT, sizeof(uint8_t)));
   RETURN_NOT_OK(output_buffer->write(&num, sizeof(uint64_t)));
 
-  // Trivial case - no compression
-  if (bitsize >= sizeof(T) * 8 - 1) {
-    RETURN_NOT_OK(output_buffer->write(in, input_buffer->size()));
-    return Status::Ok();
-  }
-
-  // Write first value
-  RETURN_NOT_OK(output_buffer->write(&in[0], value_size));
-  if (num == 1)
+  // Write the first two values
+  auto in = (const U*)input_buffer->data();
+  RETURN_NOT_OK(output_buffer->write(in, MIN(num, 2) * value_size));
+  if (num <= 2)
     return Status::Ok();
 
-  // Write second value
-  RETURN_NOT_OK(output_buffer->write(&in[1], value_size));
-  if (num == 2)
-    return Status::Ok();
+  // Write the double deltas block by block
+  uint64_t zz[BLOCK_SIZE];
+  uint64_t words[BLOCK_SIZE];  // Fits BLOCK_SIZE values of 64 bits
+  U prev_delta = U(in[1] - in[0]);
+  for (uint64_t i = 2; i < num; i += BLOCK_SIZE) {
+    // Zigzag-encode the double deltas of the block
+    auto block_num = MIN(BLOCK_SIZE, num - i);
+    uint64_t all_bits = 0;
+    for (uint64_t j = 0; j < block_num; ++j) {
+      U cur_delta = U(in[i + j] - in[i + j - 1]);
+      U dd = U(cur_delta - prev_delta);
+      zz[j] = U(U(dd << 1) ^ U(-U(dd >> (bits - 1))));
+      all_bits |= zz[j];
+      prev_delta = cur_delta;
+    }
 
-  // Write double deltas
-  int64_t prev_delta = int64_t(in[1]) - int64_t(in[0]);
-  int bit_in_chunk = 63;  // Leftmost bit (MSB)
-  uint64_t chunk = 0;
-  for (uint64_t i = 2; i < num; ++i) {
-    int64_t cur_delta = int64_t(in[i]) - int64_t(in[i - 1]);
-    int64_t dd = cur_delta - prev_delta;
-    RETURN_NOT_OK(
-        write_double_delta(output_buffer, dd, bitsize, &chunk, &bit_in_chunk));
-    prev_delta = cur_delta;
+    // Compute the bit width of the block
+    uint8_t width = 0;
+    for (; all_bits != 0; all_bits >>= 1)
+      ++width;
+
+    // Pack and write the block
+    auto word_num = (block_num * width + 63) / 64;
+    std::memset(words, 0, word_num * sizeof(uint64_t));
+    utils::pack_bits(zz, block_num, width, words);
+    RETURN_NOT_OK(output_buffer->write(&width, sizeof(uint8_t)));
+    RETURN_NOT_OK(output_buffer->write(words, word_num * sizeof(uint64_t)));
   }
 
-  // Write whatever is left in the chunk
-  if (bit_in_chunk < 63)
-    RETURN_NOT_OK(output_buffer->write(&chunk, sizeof(uint64_t)));
-
   return Status::Ok();
 }
 
 template <class T>
-Status DoubleDelta::compute_bitsize(
-    T* in, uint64_t num, unsigned int* bitsize) {
-  // Find maximum absolute double delta
-  *bitsize = 0;
-  int64_t max = 0;
-  if (num <= 2) {
-    *bitsize = 0;
+Status DoubleDelta::decompress(
+    ConstBuffer* input_buffer, Buffer* output_buffer) {
+  typedef typename std::make_unsigned<T>::type U;
+  const unsigned int bits = 8 * sizeof(T);
+
+  // Read format; anything other than the block format is the bitsize of
+  // the original format
+  uint8_t format = 0;
+  RETURN_NOT_OK(input_buffer->read(&format, sizeof(uint8_t)));
+  if (format != BLOCK_FORMAT)
+    return decompress_legacy<T>(format, input_buffer, output_buffer);
+
+  // Read number of values and the first two values
+  uint64_t num = 0;
+  uint64_t value_size = sizeof(T);
+  U first[2];
+  RETURN_NOT_OK(input_buffer->read(&num, sizeof(uint64_t)));
+  RETURN_NOT_OK(input_buffer->read(first, MIN(num, 2) * value_size));
+  RETURN_NOT_OK(output_buffer->write(first, MIN(num, 2) * value_size));
+  if (num <= 2)
     return Status::Ok();
+
+  // Decompress the rest of the values block by block
+  uint64_t zz[BLOCK_SIZE];
+  uint64_t words[BLOCK_SIZE];
+  U out[BLOCK_SIZE];
+  U prev = first[1];
+  U prev_delta = U(first[1] - first[0]);
+  for (uint64_t i = 2; i < num; i += BLOCK_SIZE) {
+    // Read and unpack the block
+    auto block_num = MIN(BLOCK_SIZE, num - i);
+    uint8_t width;
+    RETURN_NOT_OK(input_buffer->read(&width, sizeof(uint8_t)));
+    if (width > bits)
+      return LOG_STATUS(Status::CompressionError(
+          "Cannot decompress with DoubleDelta; Invalid bit width"));
+    auto word_num = (block_num * width + 63) / 64;
+    RETURN_NOT_OK(
+        input_buffer->read(words, word_num * sizeof(uint64_t)));
+    utils::unpack_bits(words, block_num, width, zz);
+
+    // Reconstruct the values
+    for (uint64_t j = 0; j < block_num; ++j) {
+      auto z = U(zz[j]);
+      prev_delta = U(prev_delta + U(U(z >> 1) ^ U(-U(z & 1))));
+      prev = U(prev + prev_delta);
+      out[j] = prev;
+    }
+    RETURN_NOT_OK(output_buffer->write(out, block_num * value_size));
   }
-  int64_t prev_delta = int64_t(in[1]) - int64_t(in[0]);
-  char delta_out_of_bounds = 0;
-  for (uint64_t i = 2; i < num; ++i) {
-    int64_t cur_delta = int64_t(in[i]) - int64_t(in[i - 1]);
-    int64_t dd = cur_delta - prev_delta;
-    delta_out_of_bounds |= (char)(cur_delta < 0 && prev_delta > 0 && dd > 0);
-    delta_out_of_bounds |= (char)(cur_delta > 0 && prev_delta < 0 && dd < 0);
-    max = MAX(std::abs(dd), max);
-    prev_delta = cur_delta;
-  }
-  // Handle error
-  if (delta_out_of_bounds) {
-    return LOG_STATUS(
-        Status::CompressionError("Cannot compress with DoubleDelta; Some "
-                                 "negative double delta is out of bounds"));
-  }
-  // Calculate bitsize of the maximum absolute double delta
-  do {
-    ++(*bitsize);
-    max >>= 1;
-  } while (max);
+
   return Status::Ok();
 }
 
 template <class T>
-Status DoubleDelta::decompress(
-    ConstBuffer* input_buffer, Buffer* output_buffer) {
-  // Read bitsize and number of values
-  uint8_t bitsize_c = 0;
+Status DoubleDelta::decompress_legacy(
+    unsigned int bitsize, ConstBuffer* input_buffer, Buffer* output_buffer) {
+  // Read number of values
   uint64_t num = 0;
   uint64_t value_size = sizeof(T);
-  RETURN_NOT_OK(input_buffer->read(&bitsize_c, sizeof(uint8_t)));
   RETURN_NOT_OK(input_buffer->read(&num, sizeof(uint64_t)));
-  auto bitsize = static_cast<unsigned int>(bitsize_c);
-  auto out = (T*)output_buffer->cur_data();
 
   // Trivial case - no compression
   if (bitsize >= sizeof(T) * 8 - 1) {
@@ -249,9 +269,9 @@ Status DoubleDelta::decompress(
   }
 
   // Read first value
-  T value;
-  RETURN_NOT_OK(input_buffer->read(&value, value_size));
-  RETURN_NOT_OK(output_buffer->write(&value, value_size));
+  T prev_value, value;
+  RETURN_NOT_OK(input_buffer->read(&prev_value, value_size));
+  RETURN_NOT_OK(output_buffer->write(&prev_value, value_size));
   if (num == 1)
     return Status::Ok();
 
@@ -271,7 +291,9 @@ Status DoubleDelta::decompress(
   for (uint64_t i = 2; i < num; ++i) {
     RETURN_NOT_OK(
         read_double_delta(input_buffer, &dd, bitsize, &chunk, &bit_in_chunk));
-    value = (T)(dd + 2 * (int64_t)out[i - 1] - (int64_t)out[i - 2]);
+    auto next_value = (T)(dd + 2 * (int64_t)value - (int64_t)prev_value);
+    prev_value = value;
+    value = next_value;
     RETURN_NOT_OK(output_buffer->write(&value, value_size));
   }
 
@@ -326,54 +348,6 @@ Status DoubleDelta::read_double_delta(
   return Status::Ok();
 }
 
-Status DoubleDelta::write_double_delta(
-    Buffer* buff,
-    int64_t double_delta,
-    int bitsize,
-    uint64_t* chunk,
-    int* bit_in_chunk) {
-  // Write sign
-  uint64_t to_or = (double_delta < 0) ? 1 : 0;
-  to_or <<= (*bit_in_chunk);
-  (*chunk) |= to_or;
-  --(*bit_in_chunk);
-
-  // Write chunk and reset
-  if (*bit_in_chunk < 0) {
-    RETURN_NOT_OK(buff->write(chunk, sizeof(uint64_t)));
-    *bit_in_chunk = 63;
-    *chunk = 0;
-  }
-
-  // Write rest of bits
-  int bits_left_to_write = bitsize;
-  int bit_in_dd = bitsize - 1;
-  int bits_to_fill_in_chunk = MIN((*bit_in_chunk) + 1, bits_left_to_write);
-  uint64_t abs_dd = ABS(double_delta);
-  uint64_t tmp_abs_dd;
-
-  while (bits_left_to_write > 0) {
-    if (bits_to_fill_in_chunk > 0) {
-      tmp_abs_dd = (abs_dd << (63 - bit_in_dd));
-      tmp_abs_dd >>= (63 - (*bit_in_chunk));
-      (*chunk) |= tmp_abs_dd;
-      (*bit_in_chunk) -= bits_to_fill_in_chunk;
-      bit_in_dd -= bits_to_fill_in_chunk;
-      bits_left_to_write -= bits_to_fill_in_chunk;
-    }
-
-    // Write chunk and reset
-    if (*bit_in_chunk < 0) {
-      RETURN_NOT_OK(buff->write(chunk, sizeof(uint64_t)));
-      *bit_in_chunk = 63;
-      *chunk = 0;
-      bits_to_fill_in_chunk = MIN((*bit_in_chunk) + 1, bits_left_to_write);
-    }
-  }
-
-  return Status::Ok();
-}
-
 // Explicit template instantiations
 
 template Status DoubleDelta::compress<char>(
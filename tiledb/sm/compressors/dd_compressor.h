@@ -45,11 +45,23 @@ namespace sm {
 class DoubleDelta {
  public:
   /**
-   * Constant overhead (equal to 1 byte for the bitsize, 8 bytes for
-   * the number of cells, and 8 bytes for a potential extra 64-bit chunk).
+   * Constant overhead (equal to 1 byte for the format marker, 8 bytes for
+   * the number of cells, and 8 bytes for the last, potentially almost empty
+   * 64-bit word). The bit width of each block adds to this (see
+   * `overhead`).
    */
   static const uint64_t OVERHEAD;
 
+  /** Number of double deltas packed together with a common bit width. */
+  static const uint64_t BLOCK_SIZE;
+
+  /**
+   * The first byte of the block format, which distinguishes it from the
+   * original format that starts with the bitsize of all double deltas
+   * (at most 64).
+   */
+  static const uint8_t BLOCK_FORMAT;
+
   /* ****************************** */
   /*               API              */
   /* ****************************** */
@@ -63,45 +75,32 @@ class DoubleDelta {
    *
    * The output buffer will contain the following after compression:
    *
-   * bitsize | n | in_0 | in_1 | b_2 | abs(dd_2) | b_3 | abs(dd_3) | ...
-   *   ...   | b_n | abs(dd_n)
+   * BLOCK_FORMAT | n | in_0 | in_1 | block_1 | block_2 | ...
    *
    * where:
-   *  - *bitsize* (char) is the minimum number of bits required to represent
-   *    any abs(dd_i).
+   *  - *BLOCK_FORMAT* (uint8_t) marks the format of the compressed data.
    *  - *n* (uint64_t) is the number of values in the input buffer.
-   *  - **b_i** is the sign of dd_i
-   *  - **dd_i** is equal to (in_{i} - in_{i-1}) - (in_{i-1} - in_{i-2})
-   *
-   *  In case the bitsize is equal to the size of the data type plus one (for
-   *  the sign), then it does not make sense to compress and, thus, the
-   *  algorithm simply copies the input to the output, though after *bitsize*
-   *  and *n* that are always written to the output buffer.
-   *
-   *  The algorithm populates and writes to the output buffer a 64-bit chunk
-   *  at a time. Therefore, the output buffer may end up having a worst-case
-   *  overhead of 1 (bitsize) + 8 (n) + 8 (last, potentially almost empty chunk)
-   *  bytes.
+   *  - **block_j** holds the double deltas dd_i of `BLOCK_SIZE`
+   *    consecutive values (fewer for the last block), as
+   *    *width* (uint8_t) followed by the zigzag-encoded dd_i bit-packed
+   *    with *width* bits each into 64-bit words.
+   *  - **dd_i** is equal to (in_{i} - in_{i-1}) - (in_{i-1} - in_{i-2}),
+   *    computed with the wrap-around arithmetic of the unsigned type of the
+   *    same size as the values, so that no double delta is out of bounds.
+   *  - *width* is the minimum number of bits required to represent any
+   *    zigzag-encoded dd_i of the block.
    *
    * @param type The type of the input values.
    * @param input_buffer Input buffer to read from.
    * @param output_buffer Output buffer to write to the compressed data.
    * @return Status
-   *
-   * @note The function will fail with an error in two cases: (i) the output
-   *     buffer incurs a memory allocation error, and (ii) some double delta
-   *     value is out of bounds. Note that all double deltas are represented
-   *     as int64_t. Therefore, the out of bounds case occurs when adding
-   *     two huge positive numbers (e.g., INT64_MAX) resulting in a negative
-   *     value, or adding to very small negative numbers (e.g., -INT64_MAX),
-   *     resulting in a positive number. However, both these two cases are
-   *     extreme.
    */
   static Status compress(
       Datatype type, ConstBuffer* input_buffer, Buffer* output_buffer);
 
   /**
-   * Decompression function.
+   * Decompression function. Both the block format and the original
+   * (bit by bit) format are supported.
    *
    * @param type The type of the original decompressed values.
    * @param input_buffer Input buffer to read from.
@@ -124,31 +123,34 @@ class DoubleDelta {
   static Status compress(ConstBuffer* input_buffer, Buffer* output_buffer);
 
   /**
-   * Calculates the bitsize all the double deltas will have. Note that
-   * the sign bit is not counted.
+   * Decompression function.
    *
    * @tparam The datatype of the values.
-   * @param in The input buffer.
-   * @param num The number of values in the buffer.
-   * @param bitsize The bitsize of the double deltas to be retrieved.
+   * @param input_buffer Input buffer to read from.
+   * @param output_buffer Output buffer to write the decompressed data to.
    * @return Status
    */
   template <class T>
-  static Status compute_bitsize(T* in, uint64_t num, unsigned int* bitsize);
+  static Status decompress(ConstBuffer* input_buffer, Buffer* output_buffer);
 
   /**
-   * Decompression function.
+   * Decompresses data in the original format, where the double deltas
+   * are stored with a sign bit and a common bitsize after the first two
+   * values. The bitsize has already been read from the input buffer.
    *
    * @tparam The datatype of the values.
+   * @param bitsize The bitsize of the double deltas.
    * @param input_buffer Input buffer to read from.
    * @param output_buffer Output buffer to write the decompressed data to.
    * @return Status
    */
   template <class T>
-  static Status decompress(ConstBuffer* input_buffer, Buffer* output_buffer);
+  static Status decompress_legacy(
+      unsigned int bitsize, ConstBuffer* input_buffer, Buffer* output_buffer);
 
   /**
-   * Reads/reconstructs a double delta value from a compressed buffer.
+   * Reads/reconstructs a double delta value from a buffer in the original
+   * format.
    *
    * @param buff The input buffer.
    * @param double_delta The double delta value to be retrieved.
@@ -165,27 +167,6 @@ class DoubleDelta {
       int bitsize,
       uint64_t* chunk,
       int* bit_in_chunk);
-
-  /**
-   * Writes a double delta value to a buffer, after reducing its bitsize
-   * to match the input one.
-   *
-   * @param buff The output buffer.
-   * @param double_delta The double delta value to write.
-   * @param bitsize The bitsize the double delta value will reduce to
-   *     before being written to the buffer.
-   * @param chunk The function writes to the buffer in whole 64-bit chunks.
-   *     This parameters represents some state about the current chunk.
-   * @param bit_in_chunk Part of the chunk state. Stores the current bit
-   *     in the chunk the next write will start from.
-   * @return Status
-   */
-  static Status write_double_delta(
-      Buffer* buff,
-      int64_t double_delta,
-      int bitsize,
-      uint64_t* chunk,
-      int* bit_in_chunk);
 };
 
 }  // namespace sm
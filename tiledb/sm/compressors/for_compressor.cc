@@ -0,0 +1,280 @@
+/**
+ * @file   for_compressor.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * This file implements the frame of reference compressor class.
+ */
+
+#include "tiledb/sm/compressors/for_compressor.h"
+#include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/utils.h"
+
+#include <cstring>
+#include <type_traits>
+
+/* ****************************** */
+/*             MACROS             */
+/* ****************************** */
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+namespace tiledb {
+namespace sm {
+
+const uint64_t FrameOfReference::OVERHEAD = 25;
+const uint64_t FrameOfReference::BLOCK_SIZE = 128;
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status FrameOfReference::compress(
+    Datatype type, ConstBuffer* input_buffer, Buffer* output_buffer) {
+  switch (type) {
+    case Datatype::INT8:
+      return FrameOfReference::compress<int8_t>(input_buffer, output_buffer);
+    case Datatype::UINT8:
+      return FrameOfReference::compress<uint8_t>(input_buffer, output_buffer);
+    case Datatype::INT16:
+      return FrameOfReference::compress<int16_t>(input_buffer, output_buffer);
+    case Datatype::UINT16:
+      return FrameOfReference::compress<uint16_t>(
+          input_buffer, output_buffer);
+    case Datatype::INT32:
+      return FrameOfReference::compress<int>(input_buffer, output_buffer);
+    case Datatype::UINT32:
+      return FrameOfReference::compress<uint32_t>(
+          input_buffer, output_buffer);
+    case Datatype::INT64:
+      return FrameOfReference::compress<int64_t>(input_buffer, output_buffer);
+    case Datatype::UINT64:
+      return FrameOfReference::compress<uint64_t>(
+          input_buffer, output_buffer);
+    case Datatype::CHAR:
+      return FrameOfReference::compress<char>(input_buffer, output_buffer);
+    case Datatype::STRING_ASCII:
+    case Datatype::STRING_UTF8:
+    case Datatype::STRING_UTF16:
+    case Datatype::STRING_UTF32:
+    case Datatype::STRING_UCS2:
+    case Datatype::STRING_UCS4:
+    case Datatype::ANY:
+      return FrameOfReference::compress<uint8_t>(input_buffer, output_buffer);
+    case Datatype::FLOAT32:
+    case Datatype::FLOAT64:
+      return LOG_STATUS(Status::CompressionError(
+          "Cannot compress tile with FrameOfReference; Float datatypes are "
+          "not supported"));
+  }
+
+  assert(false);
+  return LOG_STATUS(Status::CompressionError(
+      "Cannot compress tile with FrameOfReference; Not supported datatype"));
+}
+
+Status FrameOfReference::decompress(
+    Datatype type, ConstBuffer* input_buffer, Buffer* output_buffer) {
+  switch (type) {
+    case Datatype::INT8:
+      return FrameOfReference::decompress<int8_t>(input_buffer, output_buffer);
+    case Datatype::UINT8:
+      return FrameOfReference::decompress<uint8_t>(
+          input_buffer, output_buffer);
+    case Datatype::INT16:
+      return FrameOfReference::decompress<int16_t>(
+          input_buffer, output_buffer);
+    case Datatype::UINT16:
+      return FrameOfReference::decompress<uint16_t>(
+          input_buffer, output_buffer);
+    case Datatype::INT32:
+      return FrameOfReference::decompress<int>(input_buffer, output_buffer);
+    case Datatype::UINT32:
+      return FrameOfReference::decompress<uint32_t>(
+          input_buffer, output_buffer);
+    case Datatype::INT64:
+      return FrameOfReference::decompress<int64_t>(
+          input_buffer, output_buffer);
+    case Datatype::UINT64:
+      return FrameOfReference::decompress<uint64_t>(
+          input_buffer, output_buffer);
+    case Datatype::CHAR:
+      return FrameOfReference::decompress<char>(input_buffer, output_buffer);
+    case Datatype::STRING_ASCII:
+    case Datatype::STRING_UTF8:
+    case Datatype::STRING_UTF16:
+    case Datatype::STRING_UTF32:
+    case Datatype::STRING_UCS2:
+    case Datatype::STRING_UCS4:
+    case Datatype::ANY:
+      return FrameOfReference::decompress<uint8_t>(
+          input_buffer, output_buffer);
+    case Datatype::FLOAT32:
+    case Datatype::FLOAT64:
+      return LOG_STATUS(Status::CompressionError(
+          "Cannot decompress tile with FrameOfReference; Float datatypes are "
+          "not supported"));
+  }
+
+  assert(false);
+  return LOG_STATUS(Status::CompressionError(
+      "Cannot decompress tile with FrameOfReference; Not supported datatype"));
+}
+
+uint64_t FrameOfReference::overhead(uint64_t nbytes) {
+  // The header of a block (at most 9 bytes) is amortized over at least
+  // BLOCK_SIZE bytes
+  return FrameOfReference::OVERHEAD + 9 * (nbytes / BLOCK_SIZE);
+}
+
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
+template <class T>
+Status FrameOfReference::compress(
+    ConstBuffer* input_buffer, Buffer* output_buffer) {
+  typedef typename std::make_unsigned<T>::type U;
+
+  // Write number of values
+  uint64_t value_size = sizeof(T);
+  uint64_t num = input_buffer->size() / value_size;
+  assert(input_buffer->size() % value_size == 0);
+  RETURN_NOT_OK(output_buffer->write(&num, sizeof(uint64_t)));
+
+  // Write the values block by block
+  auto in = (const T*)input_buffer->data();
+  uint64_t diffs[BLOCK_SIZE];
+  uint64_t words[BLOCK_SIZE];  // Fits BLOCK_SIZE values of 64 bits
+  for (uint64_t i = 0; i < num; i += BLOCK_SIZE) {
+    // Compute the range of the block
+    auto block = in + i;
+    auto block_num = MIN(BLOCK_SIZE, num - i);
+    T min = block[0], max = block[0];
+    for (uint64_t j = 1; j < block_num; ++j) {
+      min = (block[j] < min) ? block[j] : min;
+      max = (block[j] > max) ? block[j] : max;
+    }
+    uint64_t range = U(U(max) - U(min));
+    uint8_t width = 0;
+    for (; range != 0; range >>= 1)
+      ++width;
+
+    // Pack the differences from the minimum
+    for (uint64_t j = 0; j < block_num; ++j)
+      diffs[j] = U(U(block[j]) - U(min));
+    auto word_num = (block_num * width + 63) / 64;
+    std::memset(words, 0, word_num * sizeof(uint64_t));
+    utils::pack_bits(diffs, block_num, width, words);
+
+    // Write the block
+    RETURN_NOT_OK(output_buffer->write(&min, value_size));
+    RETURN_NOT_OK(output_buffer->write(&width, sizeof(uint8_t)));
+    RETURN_NOT_OK(output_buffer->write(words, word_num * sizeof(uint64_t)));
+  }
+
+  return Status::Ok();
+}
+
+template <class T>
+Status FrameOfReference::decompress(
+    ConstBuffer* input_buffer, Buffer* output_buffer) {
+  typedef typename std::make_unsigned<T>::type U;
+
+  // Read number of values
+  uint64_t value_size = sizeof(T);
+  uint64_t num = 0;
+  RETURN_NOT_OK(input_buffer->read(&num, sizeof(uint64_t)));
+
+  // Decompress the values block by block
+  uint64_t diffs[BLOCK_SIZE];
+  uint64_t words[BLOCK_SIZE];
+  T out[BLOCK_SIZE];
+  for (uint64_t i = 0; i < num; i += BLOCK_SIZE) {
+    // Read the block
+    auto block_num = MIN(BLOCK_SIZE, num - i);
+    T min;
+    uint8_t width;
+    RETURN_NOT_OK(input_buffer->read(&min, value_size));
+    RETURN_NOT_OK(input_buffer->read(&width, sizeof(uint8_t)));
+    if (width > 8 * sizeof(T))
+      return LOG_STATUS(Status::CompressionError(
+          "Cannot decompress with FrameOfReference; Invalid bit width"));
+    auto word_num = (block_num * width + 63) / 64;
+    RETURN_NOT_OK(input_buffer->read(words, word_num * sizeof(uint64_t)));
+
+    // Unpack the differences and add the minimum back
+    utils::unpack_bits(words, block_num, width, diffs);
+    for (uint64_t j = 0; j < block_num; ++j)
+      out[j] = T(U(U(min) + U(diffs[j])));
+    RETURN_NOT_OK(output_buffer->write(out, block_num * value_size));
+  }
+
+  return Status::Ok();
+}
+
+// Explicit template instantiations
+
+template Status FrameOfReference::compress<char>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status FrameOfReference::compress<int8_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status FrameOfReference::compress<uint8_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status FrameOfReference::compress<int16_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status FrameOfReference::compress<uint16_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status FrameOfReference::compress<int>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status FrameOfReference::compress<uint32_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status FrameOfReference::compress<int64_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status FrameOfReference::compress<uint64_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+
+template Status FrameOfReference::decompress<char>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status FrameOfReference::decompress<int8_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status FrameOfReference::decompress<uint8_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status FrameOfReference::decompress<int16_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status FrameOfReference::decompress<uint16_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status FrameOfReference::decompress<int>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status FrameOfReference::decompress<uint32_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status FrameOfReference::decompress<int64_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status FrameOfReference::decompress<uint64_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,121 @@
+/**
+ * @file   for_compressor.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * This file defines the frame of reference compressor class.
+ */
+
+#ifndef TILEDB_FRAME_OF_REFERENCE_H
+#define TILEDB_FRAME_OF_REFERENCE_H
+
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/buffer/const_buffer.h"
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/misc/status.h"
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * Implements a frame of reference compressor, which stores integer values
+ * relative to the minimum of their block, bit-packed to the width of the
+ * block range.
+ */
+class FrameOfReference {
+ public:
+  /**
+   * Constant overhead (equal to 8 bytes for the number of values, 8 bytes
+   * for the last, potentially almost empty 64-bit word, and 9 bytes for
+   * the header of a last, partial block). The headers of the full blocks
+   * add to this (see `overhead`).
+   */
+  static const uint64_t OVERHEAD;
+
+  /** Number of values that share a minimum and a bit width. */
+  static const uint64_t BLOCK_SIZE;
+
+  /* ****************************** */
+  /*               API              */
+  /* ****************************** */
+
+  /**
+   * Compression function. Let the input buffer contain `n` values. The
+   * output buffer will contain the following after compression:
+   *
+   * n | block_1 | block_2 | ...
+   *
+   * where:
+   *  - *n* (uint64_t) is the number of values in the input buffer.
+   *  - **block_j** holds `BLOCK_SIZE` consecutive values (fewer for the
+   *    last block) as *min* (of the input type), *width* (uint8_t) and the
+   *    differences of the values from *min*, bit-packed with *width* bits
+   *    each into 64-bit words.
+   *  - *width* is the minimum number of bits required to represent the
+   *    difference between the maximum and the minimum of the block.
+   *
+   * @param type The type of the input values.
+   * @param input_buffer Input buffer to read from.
+   * @param output_buffer Output buffer to write to the compressed data.
+   * @return Status
+   */
+  static Status compress(
+      Datatype type, ConstBuffer* input_buffer, Buffer* output_buffer);
+
+  /**
+   * Decompression function. Exactly the compressed data of `compress` are
+   * read from the input buffer, so any data following them are left
+   * unread.
+   *
+   * @param type The type of the original decompressed values.
+   * @param input_buffer Input buffer to read from.
+   * @param output_buffer Output buffer to write the decompressed data to.
+   * @return Status
+   */
+  static Status decompress(
+      Datatype type, ConstBuffer* input_buffer, Buffer* output_buffer);
+
+  /** Returns the compression overhead for the given input. */
+  static uint64_t overhead(uint64_t nbytes);
+
+ private:
+  /* ****************************** */
+  /*         PRIVATE METHODS        */
+  /* ****************************** */
+
+  /** Templated version of *compress* on the type of buffer values. */
+  template <class T>
+  static Status compress(ConstBuffer* input_buffer, Buffer* output_buffer);
+
+  /** Templated version of *decompress* on the type of buffer values. */
+  template <class T>
+  static Status decompress(ConstBuffer* input_buffer, Buffer* output_buffer);
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_FRAME_OF_REFERENCE_H
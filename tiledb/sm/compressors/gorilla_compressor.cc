@@ -0,0 +1,367 @@
+/**
+ * @file   gorilla_compressor.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements the Gorilla compressor class.
+ */
+
+#include "tiledb/sm/compressors/gorilla_compressor.h"
+#include "tiledb/sm/misc/logger.h"
+
+#include <cstring>
+
+namespace tiledb {
+namespace sm {
+
+const uint64_t Gorilla::OVERHEAD = 24;
+
+namespace {
+
+/**
+ * Appends values of up to 64 bits to a stream of 64-bit words, stored
+ * (possibly unaligned) at the input address.
+ */
+class BitWriter {
+ public:
+  explicit BitWriter(unsigned char* words)
+      : words_(words) {
+  }
+
+  /** Writes the `bits` lowest bits of `value`, most significant first. */
+  void write(uint64_t value, unsigned bits) {
+    while (bits > 0) {
+      unsigned free = 64 - used_;
+      unsigned n = (bits < free) ? bits : free;
+      uint64_t chunk = value >> (bits - n);
+      if (n < 64)
+        chunk &= (uint64_t(1) << n) - 1;
+      word_ |= chunk << (free - n);
+      used_ += n;
+      bits -= n;
+      if (used_ == 64)
+        store_word();
+    }
+  }
+
+  /** Appends the last, partially filled word. */
+  void flush() {
+    if (used_ > 0)
+      store_word();
+  }
+
+  /** Returns the number of words written. */
+  uint64_t word_num() const {
+    return word_num_;
+  }
+
+ private:
+  /** Appends the current word and starts a new one. */
+  void store_word() {
+    std::memcpy(
+        words_ + word_num_ * sizeof(uint64_t), &word_, sizeof(uint64_t));
+    ++word_num_;
+    word_ = 0;
+    used_ = 0;
+  }
+
+  unsigned char* words_;
+  uint64_t word_num_ = 0;
+  uint64_t word_ = 0;
+  unsigned used_ = 0;
+};
+
+/**
+ * Reads values of up to 64 bits from a stream of 64-bit words, stored
+ * (possibly unaligned) at the input address.
+ */
+class BitReader {
+ public:
+  BitReader(const unsigned char* words, uint64_t word_num)
+      : words_(words)
+      , word_num_(word_num) {
+  }
+
+  /**
+   * Reads `bits` bits into `value`. Returns false if the stream has fewer
+   * bits left.
+   */
+  bool read(unsigned bits, uint64_t* value) {
+    uint64_t result = 0;
+    while (bits > 0) {
+      if (idx_ == word_num_)
+        return false;
+      uint64_t word;
+      std::memcpy(&word, words_ + idx_ * sizeof(uint64_t), sizeof(uint64_t));
+      unsigned avail = 64 - pos_;
+      unsigned n = (bits < avail) ? bits : avail;
+      uint64_t chunk = (word << pos_) >> (64 - n);
+      result = (n == 64) ? chunk : (result << n) | chunk;
+      pos_ += n;
+      bits -= n;
+      if (pos_ == 64) {
+        ++idx_;
+        pos_ = 0;
+      }
+    }
+    *value = result;
+    return true;
+  }
+
+ private:
+  const unsigned char* words_;
+  uint64_t word_num_;
+  uint64_t idx_ = 0;
+  unsigned pos_ = 0;
+};
+
+/** Returns the number of leading zeros of a non-zero 64-bit value. */
+inline unsigned leading_zeros(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (unsigned)__builtin_clzll(x);
+#else
+  unsigned n = 0;
+  for (; (x & (uint64_t(1) << 63)) == 0; x <<= 1)
+    ++n;
+  return n;
+#endif
+}
+
+/** Returns the number of trailing zeros of a non-zero 64-bit value. */
+inline unsigned trailing_zeros(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (unsigned)__builtin_ctzll(x);
+#else
+  unsigned n = 0;
+  for (; (x & 1) == 0; x >>= 1)
+    ++n;
+  return n;
+#endif
+}
+
+}  // namespace
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status Gorilla::compress(
+    Datatype type, ConstBuffer* input_buffer, Buffer* output_buffer) {
+  switch (type) {
+    case Datatype::FLOAT32:
+      return Gorilla::compress<uint32_t>(input_buffer, output_buffer);
+    case Datatype::FLOAT64:
+      return Gorilla::compress<uint64_t>(input_buffer, output_buffer);
+    default:
+      return LOG_STATUS(Status::CompressionError(
+          "Cannot compress tile with Gorilla; Only float datatypes are "
+          "supported"));
+  }
+}
+
+Status Gorilla::decompress(
+    Datatype type, ConstBuffer* input_buffer, Buffer* output_buffer) {
+  switch (type) {
+    case Datatype::FLOAT32:
+      return Gorilla::decompress<uint32_t>(input_buffer, output_buffer);
+    case Datatype::FLOAT64:
+      return Gorilla::decompress<uint64_t>(input_buffer, output_buffer);
+    default:
+      return LOG_STATUS(Status::CompressionError(
+          "Cannot decompress tile with Gorilla; Only float datatypes are "
+          "supported"));
+  }
+}
+
+uint64_t Gorilla::overhead(uint64_t nbytes) {
+  // In the worst case, every 32-bit value costs 12 control bits and every
+  // 64-bit value 14 control bits
+  return Gorilla::OVERHEAD + 3 * nbytes / 8 + 1;
+}
+
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
+template <class T>
+Status Gorilla::compress(ConstBuffer* input_buffer, Buffer* output_buffer) {
+  // For easy reference
+  const unsigned bits = 8 * sizeof(T);
+  const unsigned count_bits = (bits == 32) ? 5 : 6;
+  uint64_t num = input_buffer->size() / sizeof(T);
+  assert(input_buffer->size() % sizeof(T) == 0);
+  auto in = (const T*)input_buffer->data();
+
+  // Size the output for the worst case, in which every value costs a new
+  // window, so that the words are written directly into it after the
+  // number of values and words
+  uint64_t max_word_num = (num * (bits + 2 + 2 * count_bits) + 63) / 64;
+  auto max_size = output_buffer->offset() + 2 * sizeof(uint64_t) +
+                  max_word_num * sizeof(uint64_t);
+  if (max_size > output_buffer->alloced_size())
+    RETURN_NOT_OK(output_buffer->realloc(max_size));
+  auto header = (unsigned char*)output_buffer->cur_data();
+
+  // Encode the values
+  BitWriter writer(header + 2 * sizeof(uint64_t));
+  unsigned prev_lz = 0, prev_len = 0;  // No window yet
+  for (uint64_t i = 0; i < num; ++i) {
+    if (i == 0) {
+      writer.write(in[0], bits);
+      continue;
+    }
+
+    uint64_t x = in[i] ^ in[i - 1];
+    if (x == 0) {
+      writer.write(0, 1);
+      continue;
+    }
+
+    unsigned lz = leading_zeros(x) - (64 - bits);
+    unsigned tz = trailing_zeros(x);
+    if (prev_len != 0 && lz >= prev_lz && tz >= bits - prev_lz - prev_len) {
+      // Fits in the previous window
+      writer.write(2, 2);
+      writer.write(x >> (bits - prev_lz - prev_len), prev_len);
+    } else {
+      // New window
+      unsigned len = bits - lz - tz;
+      writer.write(3, 2);
+      writer.write(lz, count_bits);
+      writer.write(len - 1, count_bits);
+      writer.write(x >> tz, len);
+      prev_lz = lz;
+      prev_len = len;
+    }
+  }
+  writer.flush();
+
+  // Write the number of values and words
+  uint64_t word_num = writer.word_num();
+  std::memcpy(header, &num, sizeof(uint64_t));
+  std::memcpy(header + sizeof(uint64_t), &word_num, sizeof(uint64_t));
+  output_buffer->advance_offset((2 + word_num) * sizeof(uint64_t));
+  output_buffer->set_size(output_buffer->offset());
+
+  return Status::Ok();
+}
+
+template <class T>
+Status Gorilla::decompress(ConstBuffer* input_buffer, Buffer* output_buffer) {
+  // For easy reference
+  const unsigned bits = 8 * sizeof(T);
+  const unsigned count_bits = (bits == 32) ? 5 : 6;
+
+  // Read the number of values and words. Every value but the first costs
+  // at least one bit.
+  uint64_t num = 0, word_num = 0;
+  RETURN_NOT_OK(input_buffer->read(&num, sizeof(uint64_t)));
+  RETURN_NOT_OK(input_buffer->read(&word_num, sizeof(uint64_t)));
+  if (word_num > input_buffer->nbytes_left_to_read() / sizeof(uint64_t))
+    return LOG_STATUS(Status::CompressionError(
+        "Cannot decompress with Gorilla; Invalid number of words"));
+  if (num > 0 && num - 1 > word_num * 64)
+    return LOG_STATUS(Status::CompressionError(
+        "Cannot decompress with Gorilla; Invalid number of values"));
+  auto words = (const unsigned char*)input_buffer->data() +
+               input_buffer->offset();
+  input_buffer->advance_offset(word_num * sizeof(uint64_t));
+
+  // The values are decoded directly into the output
+  auto max_size = output_buffer->offset() + num * sizeof(T);
+  if (max_size > output_buffer->alloced_size())
+    RETURN_NOT_OK(output_buffer->realloc(max_size));
+  auto out = (unsigned char*)output_buffer->cur_data();
+
+  // Decode the values
+  auto corrupted = []() {
+    return LOG_STATUS(Status::CompressionError(
+        "Cannot decompress with Gorilla; Corrupted bit stream"));
+  };
+  BitReader reader(words, word_num);
+  unsigned prev_lz = 0, prev_len = 0;
+  T prev = 0;
+  uint64_t v;
+  for (uint64_t i = 0; i < num; ++i) {
+    if (i == 0) {
+      if (!reader.read(bits, &v))
+        return corrupted();
+      prev = (T)v;
+      std::memcpy(out, &prev, sizeof(T));
+      continue;
+    }
+
+    // Same value
+    if (!reader.read(1, &v))
+      return corrupted();
+    if (v == 0) {
+      std::memcpy(out + i * sizeof(T), &prev, sizeof(T));
+      continue;
+    }
+
+    // New window
+    if (!reader.read(1, &v))
+      return corrupted();
+    if (v == 1) {
+      uint64_t lz, len;
+      if (!reader.read(count_bits, &lz) || !reader.read(count_bits, &len))
+        return corrupted();
+      if (lz + len + 1 > bits)
+        return corrupted();
+      prev_lz = (unsigned)lz;
+      prev_len = (unsigned)len + 1;
+    } else if (prev_len == 0) {
+      return corrupted();
+    }
+
+    uint64_t x;
+    if (!reader.read(prev_len, &x))
+      return corrupted();
+    prev ^= (T)(x << (bits - prev_lz - prev_len));
+    std::memcpy(out + i * sizeof(T), &prev, sizeof(T));
+  }
+
+  output_buffer->advance_offset(num * sizeof(T));
+  output_buffer->set_size(output_buffer->offset());
+
+  return Status::Ok();
+}
+
+// Explicit template instantiations
+
+template Status Gorilla::compress<uint32_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status Gorilla::compress<uint64_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+
+template Status Gorilla::decompress<uint32_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status Gorilla::decompress<uint64_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,129 @@
+/**
+ * @file   gorilla_compressor.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * This file defines the Gorilla compressor class.
+ */
+
+
+#ifndef TILEDB_GORILLA_H
+#define TILEDB_GORILLA_H
+
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/buffer/const_buffer.h"
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/misc/status.h"
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * Implements the Gorilla compressor for real values, which XORs every value
+ * with the previous one and stores only the meaningful bits of the result,
+ * i.e., the bits between its leading and trailing zeros. Consecutive values
+ * of smooth series share the sign, exponent and high mantissa bits, so
+ * their XOR has long runs of leading (and often trailing) zeros.
+ */
+class Gorilla {
+ public:
+  /**
+   * Constant overhead (equal to 8 bytes for the number of values, 8 bytes
+   * for the number of 64-bit words and 8 bytes for the last, potentially
+   * almost empty word). The per-value control bits add to this (see
+   * `overhead`).
+   */
+  static const uint64_t OVERHEAD;
+
+  /* ****************************** */
+  /*               API              */
+  /* ****************************** */
+
+  /**
+   * Compression function. Let the input buffer contain `n` values. The
+   * output buffer will contain the following after compression:
+   *
+   * n | word_num | word_1 | word_2 | ... | word_{word_num}
+   *
+   * where the 64-bit words hold the following bit stream (from the most
+   * significant bit of each word):
+   *  - The bits of the first value.
+   *  - For every following value, the XOR `x` with its previous value as:
+   *    - `0`, if `x` is zero.
+   *    - `10` and the meaningful bits of `x` in the window (leading zeros
+   *      and length) of the last `11` entry, if `x` fits in that window.
+   *    - `11`, the number of leading zeros of `x` (5 bits for 32-bit and 6
+   *      bits for 64-bit values), the length of the meaningful bits of `x`
+   *      minus one (again 5 or 6 bits) and the meaningful bits themselves.
+   *
+   * @param type The type of the input values (FLOAT32 or FLOAT64).
+   * @param input_buffer Input buffer to read from.
+   * @param output_buffer Output buffer to write to the compressed data.
+   * @return Status
+   */
+  static Status compress(
+      Datatype type, ConstBuffer* input_buffer, Buffer* output_buffer);
+
+  /**
+   * Decompression function. Exactly the compressed data of `compress` are
+   * read from the input buffer, so any data following them are left
+   * unread.
+   *
+   * @param type The type of the original decompressed values.
+   * @param input_buffer Input buffer to read from.
+   * @param output_buffer Output buffer to write the decompressed data to.
+   * @return Status
+   */
+  static Status decompress(
+      Datatype type, ConstBuffer* input_buffer, Buffer* output_buffer);
+
+  /** Returns the compression overhead for the given input. */
+  static uint64_t overhead(uint64_t nbytes);
+
+ private:
+  /* ****************************** */
+  /*         PRIVATE METHODS        */
+  /* ****************************** */
+
+  /**
+   * Templated version of *compress* on the unsigned integer type holding
+   * the bits of the buffer values.
+   */
+  template <class T>
+  static Status compress(ConstBuffer* input_buffer, Buffer* output_buffer);
+
+  /**
+   * Templated version of *decompress* on the unsigned integer type holding
+   * the bits of the buffer values.
+   */
+  template <class T>
+  static Status decompress(ConstBuffer* input_buffer, Buffer* output_buffer);
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_GORILLA_H
@@ -39,6 +39,33 @@
 namespace tiledb {
 namespace sm {
 
+/**
+ * The deflate and inflate streams of the calling thread. They are
+ * initialized on first use and then reset between calls, which avoids
+ * allocating the zlib state for every (potentially small) chunk.
+ */
+struct GZipStreams {
+  /** The deflate stream. */
+  z_stream deflate_strm;
+  /** Whether `deflate_strm` is initialized. */
+  bool deflate_init = false;
+  /** The compression level `deflate_strm` was initialized with. */
+  int deflate_level = 0;
+  /** The inflate stream. */
+  z_stream inflate_strm;
+  /** Whether `inflate_strm` is initialized. */
+  bool inflate_init = false;
+
+  ~GZipStreams() {
+    if (deflate_init)
+      (void)deflateEnd(&deflate_strm);
+    if (inflate_init)
+      (void)inflateEnd(&inflate_strm);
+  }
+};
+
+static thread_local GZipStreams gzip_streams;
+
 Status GZip::compress(
     int level, ConstBuffer* input_buffer, Buffer* output_buffer) {
   // Sanity check
@@ -47,18 +74,29 @@ Status GZip::compress(
         "Failed compressing with GZip; invalid buffer format"));
 
   int ret;
-  z_stream strm;
-
-  // Allocate deflate state
-  strm.zalloc = Z_NULL;
-  strm.zfree = Z_NULL;
-  strm.opaque = Z_NULL;
-  ret = deflateInit(&strm, level < 0 ? GZip::default_level() : level);
+  auto& streams = gzip_streams;
+  auto& strm = streams.deflate_strm;
+  level = level < 0 ? GZip::default_level() : level;
 
-  if (ret != Z_OK) {
+  // Reuse the deflate state of this thread, unless it was created with a
+  // different level
+  if (streams.deflate_init && streams.deflate_level != level) {
     (void)deflateEnd(&strm);
-    return LOG_STATUS(Status::GZipError("Cannot compress with GZIP"));
+    streams.deflate_init = false;
   }
+  if (streams.deflate_init) {
+    ret = deflateReset(&strm);
+  } else {
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    ret = deflateInit(&strm, level);
+    streams.deflate_init = (ret == Z_OK);
+    streams.deflate_level = level;
+  }
+
+  if (ret != Z_OK)
+    return LOG_STATUS(Status::GZipError("Cannot compress with GZIP"));
 
   // Compress
   strm.next_in = (unsigned char*)input_buffer->data();
@@ -67,9 +105,6 @@ Status GZip::compress(
   strm.avail_out = (uInt)output_buffer->free_space();
   ret = deflate(&strm, Z_FINISH);
 
-  // Clean up
-  (void)deflateEnd(&strm);
-
   // Return
   if (ret == Z_STREAM_ERROR || strm.avail_in != 0)
     return LOG_STATUS(Status::GZipError("Cannot compress with GZIP"));
@@ -89,15 +124,21 @@ Status GZip::decompress(ConstBuffer* input_buffer, Buffer* output_buffer) {
         "Failed decompressing with GZip; invalid buffer format"));
 
   int ret;
-  z_stream strm;
-
-  // Allocate deflate state
-  strm.zalloc = Z_NULL;
-  strm.zfree = Z_NULL;
-  strm.opaque = Z_NULL;
-  strm.avail_in = 0;
-  strm.next_in = Z_NULL;
-  ret = inflateInit(&strm);
+  auto& streams = gzip_streams;
+  auto& strm = streams.inflate_strm;
+
+  // Reuse the inflate state of this thread
+  if (streams.inflate_init) {
+    ret = inflateReset(&strm);
+  } else {
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    strm.avail_in = 0;
+    strm.next_in = Z_NULL;
+    ret = inflateInit(&strm);
+    streams.inflate_init = (ret == Z_OK);
+  }
 
   if (ret != Z_OK) {
     return LOG_STATUS(Status::GZipError("Cannot decompress with GZIP"));
@@ -120,9 +161,6 @@ Status GZip::decompress(ConstBuffer* input_buffer, Buffer* output_buffer) {
   output_buffer->advance_size(compressed_size);
   output_buffer->advance_offset(compressed_size);
 
-  // Clean up
-  (void)inflateEnd(&strm);
-
   // Success
   return Status::Ok();
 }
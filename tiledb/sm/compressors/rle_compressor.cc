@@ -30,27 +30,151 @@
  * This file implements the rle compressor class.
  */
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 
 #include "tiledb/sm/compressors/rle_compressor.h"
+#include "tiledb/sm/misc/constants.h"
 #include "tiledb/sm/misc/logger.h"
 
 namespace tiledb {
 namespace sm {
 
+namespace {
+
+/** The number of values compared at once when scanning a run. */
+const uint64_t RUN_SCAN_BLOCK = 16;
+
+template <class T>
+inline T load(const unsigned char* p) {
+  T v;
+  std::memcpy(&v, p, sizeof(T));
+  return v;
+}
+
+template <class T>
+inline void store(unsigned char* p, T v) {
+  std::memcpy(p, &v, sizeof(T));
+}
+
+/**
+ * Returns the length of the run of values equal to the first of the
+ * `value_num` values of type `T` in `in`. Blocks of values are first
+ * compared at once through a branch-free mask of their differences, which
+ * the compiler vectorizes, and the end of the run is then located value by
+ * value.
+ */
+template <class T>
+uint64_t scan_run(const unsigned char* in, uint64_t value_num) {
+  auto v = load<T>(in);
+  uint64_t i = 1;
+  for (; i + RUN_SCAN_BLOCK <= value_num; i += RUN_SCAN_BLOCK) {
+    T mask = 0;
+    for (uint64_t k = 0; k < RUN_SCAN_BLOCK; ++k)
+      mask |= (T)(load<T>(in + (i + k) * sizeof(T)) ^ v);
+    if (mask != 0)
+      break;
+  }
+  while (i < value_num && load<T>(in + i * sizeof(T)) == v)
+    ++i;
+  return i;
+}
+
+/** Dispatches `scan_run` on the value size. */
+uint64_t scan_run(
+    const unsigned char* in, uint64_t value_num, uint64_t value_size) {
+  switch (value_size) {
+    case sizeof(uint8_t):
+      return scan_run<uint8_t>(in, value_num);
+    case sizeof(uint16_t):
+      return scan_run<uint16_t>(in, value_num);
+    case sizeof(uint32_t):
+      return scan_run<uint32_t>(in, value_num);
+    case sizeof(uint64_t):
+      return scan_run<uint64_t>(in, value_num);
+    default:
+      uint64_t i = 1;
+      while (i < value_num &&
+             std::memcmp(in + i * value_size, in, value_size) == 0)
+        ++i;
+      return i;
+  }
+}
+
+/** Writes `run_len` copies of the value of type `T` to `out`. */
+template <class T>
+void fill_run(
+    unsigned char* out, const unsigned char* value, uint64_t run_len) {
+  auto v = load<T>(value);
+  for (uint64_t j = 0; j < run_len; ++j)
+    store<T>(out + j * sizeof(T), v);
+}
+
+/** Dispatches `fill_run` on the value size. */
+void fill_run(
+    unsigned char* out,
+    const unsigned char* value,
+    uint64_t run_len,
+    uint64_t value_size) {
+  switch (value_size) {
+    case sizeof(uint8_t):
+      std::memset(out, *value, run_len);
+      break;
+    case sizeof(uint16_t):
+      fill_run<uint16_t>(out, value, run_len);
+      break;
+    case sizeof(uint32_t):
+      fill_run<uint32_t>(out, value, run_len);
+      break;
+    case sizeof(uint64_t):
+      fill_run<uint64_t>(out, value, run_len);
+      break;
+    default:
+      for (uint64_t j = 0; j < run_len; ++j)
+        std::memcpy(out + j * value_size, value, value_size);
+  }
+}
+
+/** Writes `v` as a LEB128 varint to `out` and returns its size. */
+inline uint64_t write_varint(uint64_t v, unsigned char* out) {
+  uint64_t n = 0;
+  while (v >= 0x80) {
+    out[n++] = (unsigned char)(v | 0x80);
+    v >>= 7;
+  }
+  out[n++] = (unsigned char)v;
+  return n;
+}
+
+/**
+ * Reads a LEB128 varint from `*in` (not past `end`) into `v`, advancing
+ * `*in`. Returns false if the varint is truncated or too long.
+ */
+inline bool read_varint(
+    const unsigned char** in, const unsigned char* end, uint64_t* v) {
+  *v = 0;
+  for (unsigned shift = 0; shift < 64 && *in < end; shift += 7) {
+    auto byte = *(*in)++;
+    *v |= (uint64_t)(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0)
+      return true;
+  }
+  return false;
+}
+
+}  // namespace
+
 Status RLE::compress(
     uint64_t value_size, ConstBuffer* input_buffer, Buffer* output_buffer) {
   // Sanity check
   if (input_buffer->data() == nullptr)
     return LOG_STATUS(Status::CompressionError(
         "Failed compressing with RLE; null input buffer"));
-  unsigned int cur_run_len = 1;
-  unsigned int max_run_len = 65535;
-  auto input_cur = (const unsigned char*)input_buffer->data() + value_size;
-  auto input_prev = (const unsigned char*)input_buffer->data();
+  auto input = (const unsigned char*)input_buffer->data();
   uint64_t value_num = input_buffer->size() / value_size;
-  unsigned char byte;
 
   // Trivial case
   if (value_num == 0)
@@ -62,83 +186,98 @@ Status RLE::compress(
         "Failed compressing with RLE; invalid input buffer format"));
   }
 
-  // Make runs
-  for (uint64_t i = 1; i < value_num; ++i) {
-    if (std::memcmp(input_cur, input_prev, value_size) == 0 &&
-        cur_run_len < max_run_len) {  // Expand the run
-      ++cur_run_len;
-    } else {  // Save the run
-      // Copy to output buffer
-      RETURN_NOT_OK(output_buffer->write(input_prev, value_size));
-      byte = (unsigned char)(cur_run_len >> 8);
-      RETURN_NOT_OK(output_buffer->write(&byte, sizeof(char)));
-      byte = (unsigned char)(cur_run_len % 256);
-      RETURN_NOT_OK(output_buffer->write(&byte, sizeof(char)));
-
-      // Reset current run length
-      cur_run_len = 1;
-    }
+  // Size the output for the worst case, so that the runs are written
+  // directly into it
+  auto max_size = output_buffer->offset() + input_buffer->size() +
+                  overhead(input_buffer->size(), value_size);
+  if (max_size > output_buffer->alloced_size())
+    RETURN_NOT_OK(output_buffer->realloc(max_size));
 
-    // Update run info
-    input_prev = input_cur;
-    input_cur = input_prev + value_size;
+  // Make runs
+  auto output_start = (unsigned char*)output_buffer->cur_data();
+  auto output = output_start;
+  for (uint64_t i = 0; i < value_num;) {
+    auto value = input + i * value_size;
+    auto run_len = scan_run(value, value_num - i, value_size);
+    std::memcpy(output, value, value_size);
+    output += value_size;
+    output += write_varint(run_len, output);
+    i += run_len;
   }
 
-  // Save final run
-  RETURN_NOT_OK(output_buffer->write(input_prev, value_size));
-  byte = (unsigned char)(cur_run_len >> 8);
-  RETURN_NOT_OK(output_buffer->write(&byte, sizeof(char)));
-  byte = (unsigned char)(cur_run_len % 256);
-  RETURN_NOT_OK(output_buffer->write(&byte, sizeof(char)));
+  output_buffer->advance_offset(output - output_start);
+  output_buffer->set_size(output_buffer->offset());
 
   return Status::Ok();
 }
 
 Status RLE::decompress(
-    uint64_t value_size, ConstBuffer* input_buffer, Buffer* output_buffer) {
+    uint64_t value_size,
+    uint32_t format_version,
+    ConstBuffer* input_buffer,
+    Buffer* output_buffer) {
   // Sanity check
   if (input_buffer->data() == nullptr)
     return LOG_STATUS(Status::CompressionError(
         "Failed decompressing with RLE; null input buffer"));
+  if (format_version > constants::format_version)
+    return LOG_STATUS(Status::CompressionError(
+        "Failed decompressing with RLE; unsupported format version"));
 
-  auto input_cur = static_cast<const unsigned char*>(input_buffer->data());
-  uint64_t run_size = value_size + 2 * sizeof(char);
-  uint64_t run_num = input_buffer->size() / run_size;
-  unsigned char byte;
-
-  // Trivial case
-  if (run_num == 0)
-    return Status::Ok();
+  auto input = static_cast<const unsigned char*>(input_buffer->data());
+  auto input_end = input + input_buffer->size();
 
   // Sanity check on input buffer format
-  if (input_buffer->size() % run_size != 0) {
+  if (format_version == 0 && input_buffer->size() % (value_size + 2) != 0) {
     return LOG_STATUS(Status::CompressionError(
         "Failed decompressing with RLE; invalid input buffer format"));
   }
 
   // Decompress runs
-  for (uint64_t i = 0; i < run_num; ++i) {
-    // Retrieve the current run length
-    std::memcpy(&byte, input_cur + value_size, sizeof(char));
-    uint64_t run_len = (((uint64_t)byte) << 8);
-    std::memcpy(&byte, input_cur + value_size + sizeof(char), sizeof(char));
-    run_len += (uint64_t)byte;
-
-    // Copy to output buffer
-    for (uint64_t j = 0; j < run_len; ++j)
-      RETURN_NOT_OK(output_buffer->write(input_cur, value_size))
-
-    // Update input/output tracking info
-    input_cur += run_size;
+  while (input < input_end) {
+    // Retrieve the run value and length
+    if ((uint64_t)(input_end - input) < value_size)
+      return LOG_STATUS(Status::CompressionError(
+          "Failed decompressing with RLE; invalid input buffer format"));
+    auto value = input;
+    input += value_size;
+    uint64_t run_len;
+    if (format_version == 0) {
+      run_len = ((uint64_t)input[0] << 8) + (uint64_t)input[1];
+      input += 2;
+    } else if (!read_varint(&input, input_end, &run_len)) {
+      return LOG_STATUS(Status::CompressionError(
+          "Failed decompressing with RLE; invalid run length"));
+    }
+    if (run_len > UINT64_MAX / value_size)
+      return LOG_STATUS(Status::CompressionError(
+          "Failed decompressing with RLE; invalid run length"));
+
+    // Copy to output buffer, growing it if needed. An output that does not
+    // own its data holds exactly the expected decompressed size (e.g., of
+    // a tile chunk), which bounds the run.
+    auto run_size = run_len * value_size;
+    auto offset = output_buffer->offset();
+    if (run_size > output_buffer->alloced_size() - offset) {
+      if (!output_buffer->owns_data())
+        return LOG_STATUS(Status::CompressionError(
+            "Failed decompressing with RLE; run exceeds the output size"));
+      RETURN_NOT_OK(output_buffer->realloc(
+          std::max(offset + run_size, 2 * output_buffer->alloced_size())));
+    }
+    fill_run(
+        (unsigned char*)output_buffer->cur_data(), value, run_len, value_size);
+    output_buffer->advance_offset(run_size);
+    output_buffer->set_size(output_buffer->offset());
   }
 
   return Status::Ok();
 }
 
 uint64_t RLE::overhead(uint64_t nbytes, uint64_t value_size) {
-  // In the worst case, RLE adds two bytes per every value in the buffer.
-  uint64_t value_num = nbytes / value_size;
-  return value_num * 2;
+  // In the worst case (no repeated values), RLE adds a one-byte run length
+  // per value in the buffer.
+  return nbytes / value_size;
 }
 
 }  // namespace sm
@@ -40,11 +40,19 @@
 namespace tiledb {
 namespace sm {
 
-/** Handles compression/decompression Run-Length-Encoding. */
+/**
+ * Handles compression/decompression Run-Length-Encoding.
+ *
+ * Every run of equal values is stored as the value followed by the run
+ * length. Format version 0 stores the run length in 2 bytes (big-endian),
+ * capping runs at 65535 values. Format version 1 (the one written) stores
+ * it as a LEB128 varint, which takes a single byte for runs shorter than 128
+ * values and does not cap the runs.
+ */
 class RLE {
  public:
   /**
-   * Compression function.
+   * Compression function, in the current format version.
    *
    * @param value_size The size of a single value.
    * @param input_buffer Input buffer to read from.
@@ -58,12 +66,16 @@ class RLE {
    * Decompression function.
    *
    * @param value_size The size of a single.
+   * @param format_version The format version the input was compressed in.
    * @param input_buffer Input buffer to read from.
    * @param output_buffer Output buffer to write to the decompressed data.
    * @return Status
    */
   static Status decompress(
-      uint64_t value_size, ConstBuffer* input_buffer, Buffer* output_buffer);
+      uint64_t value_size,
+      uint32_t format_version,
+      ConstBuffer* input_buffer,
+      Buffer* output_buffer);
 
   /** Returns the compression overhead for the given input. */
   static uint64_t overhead(uint64_t nbytes, uint64_t value_size);
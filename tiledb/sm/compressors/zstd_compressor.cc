@@ -39,20 +39,122 @@
 namespace tiledb {
 namespace sm {
 
+/**
+ * The compression and decompression contexts of the calling thread. They
+ * are created on first use and reused across calls, which avoids
+ * allocating the zstd state for every (potentially small) chunk.
+ */
+struct ZStdContexts {
+  /** The compression context. */
+  ZSTD_CCtx* cctx = nullptr;
+  /** The decompression context. */
+  ZSTD_DCtx* dctx = nullptr;
+
+  ~ZStdContexts() {
+    ZSTD_freeCCtx(cctx);
+    ZSTD_freeDCtx(dctx);
+  }
+};
+
+static thread_local ZStdContexts zstd_contexts;
+
+/* ****************************** */
+/*         ZSTD DICTIONARY        */
+/* ****************************** */
+
+ZStdDictionary::ZStdDictionary(const std::string& content)
+    : content_(content)
+    , ddict_(nullptr) {
+}
+
+ZStdDictionary::~ZStdDictionary() {
+  for (auto& cdict : cdicts_)
+    ZSTD_freeCDict(cdict.second);
+  ZSTD_freeDDict(ddict_);
+}
+
+const std::string& ZStdDictionary::content() const {
+  return content_;
+}
+
+Status ZStdDictionary::cdict(int level, ZSTD_CDict** cdict) {
+  std::lock_guard<std::mutex> lock(mtx_);
+  auto it = cdicts_.find(level);
+  if (it == cdicts_.end()) {
+    auto digested = ZSTD_createCDict(content_.data(), content_.size(), level);
+    if (digested == nullptr)
+      return LOG_STATUS(Status::CompressionError(
+          "ZStd compression failed; Cannot digest dictionary"));
+    it = cdicts_.emplace(level, digested).first;
+  }
+  *cdict = it->second;
+
+  return Status::Ok();
+}
+
+Status ZStdDictionary::ddict(ZSTD_DDict** ddict) {
+  std::lock_guard<std::mutex> lock(mtx_);
+  if (ddict_ == nullptr) {
+    ddict_ = ZSTD_createDDict(content_.data(), content_.size());
+    if (ddict_ == nullptr)
+      return LOG_STATUS(Status::CompressionError(
+          "ZStd decompression failed; Cannot digest dictionary"));
+  }
+  *ddict = ddict_;
+
+  return Status::Ok();
+}
+
+/* ****************************** */
+/*              ZSTD              */
+/* ****************************** */
+
 Status ZStd::compress(
     int level, ConstBuffer* input_buffer, Buffer* output_buffer) {
+  return compress(level, nullptr, input_buffer, output_buffer);
+}
+
+Status ZStd::compress(
+    int level,
+    ZStdDictionary* dict,
+    ConstBuffer* input_buffer,
+    Buffer* output_buffer) {
   // Sanity check
   if (input_buffer->data() == nullptr || output_buffer->data() == nullptr)
     return LOG_STATUS(Status::CompressionError(
         "Failed compressing with ZStd; invalid buffer format"));
 
-  // Compress
-  uint64_t zstd_ret = ZSTD_compress(
-      output_buffer->cur_data(),
-      output_buffer->free_space(),
-      input_buffer->data(),
-      input_buffer->size(),
-      level < 0 ? ZStd::default_level() : level);
+  // Get the compression context of this thread
+  auto& cctx = zstd_contexts.cctx;
+  if (cctx == nullptr)
+    cctx = ZSTD_createCCtx();
+  if (cctx == nullptr)
+    return LOG_STATUS(Status::CompressionError(
+        "ZStd compression failed; Cannot allocate context"));
+
+  // Compress, with the digested dictionary if any
+  if (level < 0)
+    level = ZStd::default_level();
+  uint64_t zstd_ret;
+  if (dict == nullptr) {
+    zstd_ret = ZSTD_compressCCtx(
+        cctx,
+        output_buffer->cur_data(),
+        output_buffer->free_space(),
+        input_buffer->data(),
+        input_buffer->size(),
+        level);
+  } else {
+    ZSTD_CDict* cdict;
+    RETURN_NOT_OK(dict->cdict(level, &cdict));
+    zstd_ret = ZSTD_compress_usingCDict(
+        cctx,
+        output_buffer->cur_data(),
+        output_buffer->free_space(),
+        input_buffer->data(),
+        input_buffer->size(),
+        cdict);
+  }
 
   // Handle error
   if (ZSTD_isError(zstd_ret) != 0) {
@@ -69,17 +171,44 @@ Status ZStd::compress(
 }
 
 Status ZStd::decompress(ConstBuffer* input_buffer, Buffer* output_buffer) {
+  return decompress(nullptr, input_buffer, output_buffer);
+}
+
+Status ZStd::decompress(
+    ZStdDictionary* dict, ConstBuffer* input_buffer, Buffer* output_buffer) {
   // Sanity check
   if (input_buffer->data() == nullptr || output_buffer->data() == nullptr)
     return LOG_STATUS(Status::CompressionError(
         "Failed decompressing with ZStd; invalid buffer format"));
 
-  // Decompress
-  uint64_t zstd_ret = ZSTD_decompress(
-      output_buffer->cur_data(),
-      output_buffer->free_space(),
-      input_buffer->data(),
-      input_buffer->size());
+  // Get the decompression context of this thread
+  auto& dctx = zstd_contexts.dctx;
+  if (dctx == nullptr)
+    dctx = ZSTD_createDCtx();
+  if (dctx == nullptr)
+    return LOG_STATUS(Status::CompressionError(
+        "ZStd decompression failed; Cannot allocate context"));
+
+  // Decompress, with the digested dictionary if any
+  uint64_t zstd_ret;
+  if (dict == nullptr) {
+    zstd_ret = ZSTD_decompressDCtx(
+        dctx,
+        output_buffer->cur_data(),
+        output_buffer->free_space(),
+        input_buffer->data(),
+        input_buffer->size());
+  } else {
+    ZSTD_DDict* ddict;
+    RETURN_NOT_OK(dict->ddict(&ddict));
+    zstd_ret = ZSTD_decompress_usingDDict(
+        dctx,
+        output_buffer->cur_data(),
+        output_buffer->free_space(),
+        input_buffer->data(),
+        input_buffer->size(),
+        ddict);
+  }
 
   // Check error
   if (ZSTD_isError(zstd_ret) != 0) {
@@ -37,9 +37,82 @@
 #include "tiledb/sm/buffer/const_buffer.h"
 #include "tiledb/sm/misc/status.h"
 
+#include <map>
+#include <mutex>
+#include <string>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
 namespace tiledb {
 namespace sm {
 
+/**
+ * A dictionary of content common to the values compressed with zstd. The
+ * dictionary is digested on first use, once for decompression and once per
+ * level for compression, and the digested dictionaries are shared by all
+ * threads.
+ */
+class ZStdDictionary {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. */
+  explicit ZStdDictionary(const std::string& content);
+
+  /** Destructor. */
+  ~ZStdDictionary();
+
+  ZStdDictionary(const ZStdDictionary&) = delete;
+
+  ZStdDictionary& operator=(const ZStdDictionary&) = delete;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Returns the dictionary content. */
+  const std::string& content() const;
+
+  /**
+   * Retrieves the dictionary digested for compression with the input
+   * level, digesting it if needed.
+   *
+   * @param level The compression level.
+   * @param cdict The digested dictionary to be retrieved.
+   * @return Status
+   */
+  Status cdict(int level, ZSTD_CDict_s** cdict);
+
+  /**
+   * Retrieves the dictionary digested for decompression, digesting it if
+   * needed.
+   *
+   * @param ddict The digested dictionary to be retrieved.
+   * @return Status
+   */
+  Status ddict(ZSTD_DDict_s** ddict);
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The dictionary digested for compression, per compression level. */
+  std::map<int, ZSTD_CDict_s*> cdicts_;
+
+  /** The dictionary content. */
+  std::string content_;
+
+  /** The dictionary digested for decompression (`nullptr` until used). */
+  ZSTD_DDict_s* ddict_;
+
+  /** Mutex protecting the digested dictionaries. */
+  std::mutex mtx_;
+};
+
 /** Handles compression/decompression with the zstd library. */
 class ZStd {
  public:
@@ -63,6 +136,32 @@ class ZStd {
    */
   static Status decompress(ConstBuffer* input_buffer, Buffer* output_buffer);
 
+  /**
+   * Compression function using a dictionary of common content.
+   *
+   * @param level Compression level.
+   * @param dict The dictionary (`nullptr` for none).
+   * @param input_buffer Input buffer to read from.
+   * @param output_buffer Output buffer to write to the compressed data.
+   * @return Status
+   */
+  static Status compress(
+      int level,
+      ZStdDictionary* dict,
+      ConstBuffer* input_buffer,
+      Buffer* output_buffer);
+
+  /**
+   * Decompression function for data compressed with a dictionary.
+   *
+   * @param dict The dictionary (`nullptr` for none).
+   * @param input_buffer Input buffer to read from.
+   * @param output_buffer Output buffer to write the decompressed data to.
+   * @return Status
+   */
+  static Status decompress(
+      ZStdDictionary* dict, ConstBuffer* input_buffer, Buffer* output_buffer);
+
   /** Returns the default compression level. */
   static int default_level() {
     return 5;
@@ -40,6 +40,10 @@ void Array::consolidate(const Context& ctx, const std::string& uri) {
   ctx.handle_error(tiledb_array_consolidate(ctx, uri.c_str()));
 }
 
+void Array::flush(const Context& ctx, const std::string& uri) {
+  ctx.handle_error(tiledb_array_flush(ctx, uri.c_str()));
+}
+
 void Array::create(const std::string& uri, const ArraySchema& schema) {
   auto& ctx = schema.context();
   ctx.handle_error(tiledb_array_schema_check(ctx, schema));
@@ -62,6 +62,15 @@ class TILEDB_EXPORT Array {
    */
   static void consolidate(const Context& ctx, const std::string& uri);
 
+  /**
+   * Flushes the cells of the unordered writes that are buffered for an array
+   * (see `sm.write_buffer_size`) into a new fragment.
+   *
+   * @param ctx TileDB context
+   * @param uri Array URI
+   */
+  static void flush(const Context& ctx, const std::string& uri);
+
   /** Creates an array on persistent storage from a schema definition. **/
   static void create(const std::string& uri, const ArraySchema& schema);
 
@@ -108,6 +108,22 @@ ArraySchema& ArraySchema::set_offsets_compressor(const Compressor& c) {
   return *this;
 }
 
+ArraySchema& ArraySchema::set_coords_filters(
+    const std::vector<tiledb_filter_t>& filters) {
+  auto& ctx = ctx_.get();
+  ctx.handle_error(tiledb_array_schema_set_coords_filters(
+      ctx, schema_.get(), filters.data(), (unsigned int)filters.size()));
+  return *this;
+}
+
+ArraySchema& ArraySchema::set_offsets_filters(
+    const std::vector<tiledb_filter_t>& filters) {
+  auto& ctx = ctx_.get();
+  ctx.handle_error(tiledb_array_schema_set_offsets_filters(
+      ctx, schema_.get(), filters.data(), (unsigned int)filters.size()));
+  return *this;
+}
+
 Domain ArraySchema::domain() const {
   auto& ctx = ctx_.get();
   tiledb_domain_t* domain;
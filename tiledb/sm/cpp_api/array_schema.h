@@ -45,6 +45,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace tiledb {
 
@@ -154,6 +155,12 @@ class TILEDB_EXPORT ArraySchema : public Schema {
   /** Sets the compressor for the offsets. */
   ArraySchema& set_offsets_compressor(const Compressor& c);
 
+  /** Sets the filters applied (in order) to the coordinates. */
+  ArraySchema& set_coords_filters(const std::vector<tiledb_filter_t>& filters);
+
+  /** Sets the filters applied (in order) to the offsets. */
+  ArraySchema& set_offsets_filters(const std::vector<tiledb_filter_t>& filters);
+
   /** Retruns the array domain of array. */
   Domain domain() const;
 
@@ -102,6 +102,82 @@ Attribute& Attribute::set_compressor(Compressor c) {
   return *this;
 }
 
+std::vector<tiledb_filter_t> Attribute::filters() const {
+  auto& ctx = ctx_.get();
+  unsigned int filter_num;
+  ctx.handle_error(
+      tiledb_attribute_get_filter_num(ctx, attr_.get(), &filter_num));
+  std::vector<tiledb_filter_t> filters(filter_num);
+  if (filter_num > 0)
+    ctx.handle_error(
+        tiledb_attribute_get_filters(ctx, attr_.get(), filters.data()));
+  return filters;
+}
+
+Attribute& Attribute::set_filters(const std::vector<tiledb_filter_t>& filters) {
+  auto& ctx = ctx_.get();
+  ctx.handle_error(tiledb_attribute_set_filters(
+      ctx, attr_.get(), filters.data(), (unsigned int)filters.size()));
+  return *this;
+}
+
+std::string Attribute::compression_dictionary() const {
+  auto& ctx = ctx_.get();
+  const void* dictionary;
+  uint64_t dictionary_size;
+  ctx.handle_error(tiledb_attribute_get_compression_dictionary(
+      ctx, attr_.get(), &dictionary, &dictionary_size));
+  if (dictionary == nullptr)
+    return std::string();
+  return std::string((const char*)dictionary, dictionary_size);
+}
+
+Attribute& Attribute::set_compression_dictionary(
+    const std::string& dictionary) {
+  auto& ctx = ctx_.get();
+  ctx.handle_error(tiledb_attribute_set_compression_dictionary(
+      ctx, attr_.get(), dictionary.data(), dictionary.size()));
+  return *this;
+}
+
+bool Attribute::dictionary_encoding() const {
+  auto& ctx = ctx_.get();
+  int dictionary_encoding;
+  ctx.handle_error(tiledb_attribute_get_dictionary_encoding(
+      ctx, attr_.get(), &dictionary_encoding));
+  return dictionary_encoding != 0;
+}
+
+Attribute& Attribute::set_dictionary_encoding(bool dictionary_encoding) {
+  auto& ctx = ctx_.get();
+  ctx.handle_error(tiledb_attribute_set_dictionary_encoding(
+      ctx, attr_.get(), dictionary_encoding ? 1 : 0));
+  return *this;
+}
+
+bool Attribute::quantized() const {
+  auto& ctx = ctx_.get();
+  int quantized, digits;
+  ctx.handle_error(
+      tiledb_attribute_get_quantization(ctx, attr_.get(), &quantized, &digits));
+  return quantized != 0;
+}
+
+int Attribute::quantization_digits() const {
+  auto& ctx = ctx_.get();
+  int quantized, digits;
+  ctx.handle_error(
+      tiledb_attribute_get_quantization(ctx, attr_.get(), &quantized, &digits));
+  return digits;
+}
+
+Attribute& Attribute::set_quantization(int digits) {
+  auto& ctx = ctx_.get();
+  ctx.handle_error(
+      tiledb_attribute_set_quantization(ctx, attr_.get(), 1, digits));
+  return *this;
+}
+
 std::shared_ptr<tiledb_attribute_t> Attribute::ptr() const {
   return attr_;
 }
@@ -47,6 +47,7 @@
 #include <functional>
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 namespace tiledb {
 
@@ -124,6 +125,43 @@ class TILEDB_EXPORT Attribute {
   /** Sets the attribute compressor. */
   Attribute& set_compressor(Compressor c);
 
+  /** Returns the filters applied (in order) prior to compression. */
+  std::vector<tiledb_filter_t> filters() const;
+
+  /** Sets the filters applied (in order) prior to compression. */
+  Attribute& set_filters(const std::vector<tiledb_filter_t>& filters);
+
+  /** Returns the zstd compression dictionary (empty if none). */
+  std::string compression_dictionary() const;
+
+  /**
+   * Sets a dictionary of content common to the values, used by the
+   * TILEDB_ZSTD compressor (e.g., trained with `zstd --train`).
+   */
+  Attribute& set_compression_dictionary(const std::string& dictionary);
+
+  /** Returns true if the (variable-sized) values are dictionary encoded. */
+  bool dictionary_encoding() const;
+
+  /**
+   * Sets whether the values of this variable-sized attribute are dictionary
+   * encoded per tile, which suits attributes with few distinct values.
+   */
+  Attribute& set_dictionary_encoding(bool dictionary_encoding);
+
+  /** Returns true if the (real) values are quantized on write. */
+  bool quantized() const;
+
+  /** Returns the number of decimal digits retained by quantization. */
+  int quantization_digits() const;
+
+  /**
+   * Quantizes the values of this real attribute on write, retaining `digits`
+   * decimal digits. This is lossy; the quantized values are compressed as
+   * integers, so the attribute must also be compressed or filtered.
+   */
+  Attribute& set_quantization(int digits);
+
   /** Returns the C TileDB attribute object pointer. */
   std::shared_ptr<tiledb_attribute_t> ptr() const;
 
@@ -122,6 +122,12 @@ class TILEDB_EXPORT Compressor {
         return "BZIP2";
       case TILEDB_DOUBLE_DELTA:
         return "DOUBLE_DELTA";
+      case TILEDB_FRAME_OF_REFERENCE:
+        return "FRAME_OF_REFERENCE";
+      case TILEDB_GORILLA:
+        return "GORILLA";
+      case TILEDB_AUTO_COMPRESSION:
+        return "AUTO_COMPRESSION";
     }
     return "Invalid";
   }
@@ -107,6 +107,30 @@ class TILEDB_EXPORT Config {
    * - `sm.tile_cache_size` <br>
    *    The tile cache size in bytes. Any `uint64_t` value is acceptable. <br>
    *    **Default**: 10,000,000
+   * - `sm.compressed_tile_cache_size` <br>
+   *    The size in bytes of the cache of compressed tiles, which backs the
+   *    (decompressed) tile cache: tiles missing from the tile cache are
+   *    decompressed from it instead of being read from storage. It can be
+   *    set to `0` to disable it. <br>
+   *    **Default**: 50,000,000
+   * - `sm.tile_cache_shard_num` <br>
+   *    The number of shards the tile cache and the compressed tile cache
+   *    are split into. Each shard has its own lock, so that concurrent
+   *    reads of tiles in different shards do not contend. The size of each
+   *    cache is split evenly across its shards: a shard of the tile cache
+   *    holds up to `sm.tile_cache_size / sm.tile_cache_shard_num` bytes
+   *    (rounded down; the remainder goes to the first shards), and likewise
+   *    for `sm.compressed_tile_cache_size`. A tile larger than its shard is
+   *    not cached, e.g., by default tiles larger than 1,250,000 bytes are
+   *    not kept in the tile cache. <br>
+   *    **Default**: 8
+   * - `sm.tile_cache_policy` <br>
+   *    The eviction policy of the tile cache and the compressed tile cache.
+   *    With `lru`, the least recently used tile is evicted. With `slru`
+   *    (segmented LRU), tiles are evicted first among those that were not
+   *    read again since they were cached, so that a large scan does not
+   *    flush the tiles that are read frequently. <br>
+   *    **Default**: slru
    * - `sm.array_schema_cache_size` <br>
    *    The array schema cache size in bytes. Any `uint64_t` value is
    *    acceptable. <br>
@@ -115,6 +139,60 @@ class TILEDB_EXPORT Config {
    *    The fragment metadata cache size in bytes. Any `uint64_t` value is
    *    acceptable. <br>
    *    **Default**: 10,000,000
+   * - `sm.global_write_queue_depth` <br>
+   *    The maximum number of batches of full tiles that a global-order write
+   *    query may have pending compression and I/O in the background. If `0`,
+   *    global-order writes compress and write their tiles in the submitting
+   *    thread. Otherwise, a query submission returns as soon as the user
+   *    buffers are consumed, and finalizing the query waits for all pending
+   *    writes. Any `uint64_t` value is acceptable. <br>
+   *    **Default**: 0
+   * - `sm.num_compute_threads` <br>
+   *    The number of threads in the storage manager pool used for CPU-bound
+   *    tasks, such as compressing the tiles of a write in parallel. Any
+   *    `uint64_t` value is acceptable; `0` is treated as `1`. <br>
+   *    **Default**: number of cores
+   * - `sm.unordered_write_memory_budget` <br>
+   *    The memory budget (in bytes) of an unordered write query. If it is `0`,
+   *    every submission of an unordered write creates a separate fragment.
+   *    Otherwise, the cells of successive submissions are buffered in memory,
+   *    spilled to scratch storage as sorted runs whenever the buffered cells
+   *    exceed half the budget, and merged into a single fragment in the global
+   *    order when the query is finalized. <br>
+   *    **Default**: 0
+   * - `sm.unordered_write_scratch_dir` <br>
+   *    The directory where unordered writes spill their sorted runs, if
+   *    `sm.unordered_write_memory_budget` is not `0`. If it is empty, the runs
+   *    are spilled into a hidden directory inside the array directory. <br>
+   *    **Default**: ""
+   * - `sm.write_buffer_size` <br>
+   *    The size (in bytes) of the in-memory write buffer of each array. If it
+   *    is not `0` (and `sm.unordered_write_memory_budget` is `0`), the cells of
+   *    unordered writes are buffered in memory, and flushed to a single
+   *    fragment when the buffer reaches this size, when
+   *    `sm.write_buffer_max_age_ms` elapses, when the array is read or flushed
+   *    explicitly, or when the context is freed. If a flush that was not
+   *    triggered by a write fails, the buffered cells are discarded and the
+   *    error is returned by the next write to the array (or by freeing the
+   *    context). Buffered cells that were not flushed are lost if the process
+   *    terminates abnormally. <br>
+   *    **Default**: 0
+   * - `sm.write_buffer_max_age_ms` <br>
+   *    The maximum age (in milliseconds) of the cells in an array write
+   *    buffer. The buffer is flushed in the background once its oldest cell
+   *    exceeds this age. If it is `0`, there is no age limit. <br>
+   *    **Default**: 0
+   * - `sm.tile_chunk_size` <br>
+   *    The maximum size (in bytes) of the chunks a tile is split into upon
+   *    compression. The chunks of a tile are compressed and decompressed in
+   *    parallel on the compute threads. <br>
+   *    **Default**: 1048576
+    * - `sm.auto_compression_candidates` <br>
+    *    The comma-separated `<compressor>[:<level>]` candidates that the
+    *    `AUTO_COMPRESSION` compressor tries on a sample of every chunk,
+    *    keeping the one with the smallest estimated read cost (compressed
+    *    size plus decompression cost). <br>
+    *    **Default**: NO_COMPRESSION,LZ4,ZSTD:1,ZSTD:9,RLE,DOUBLE_DELTA,GORILLA
    * - `vfs.max_parallel_ops` <br>
    *    The maximum number of VFS parallel operations. <br>
    *    **Default**: number of cores
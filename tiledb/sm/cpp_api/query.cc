@@ -62,6 +62,13 @@ Query& Query::set_layout(tiledb_layout_t layout) {
   return *this;
 }
 
+Query& Query::set_cache_fill(bool cache_fill) {
+  auto& ctx = ctx_.get();
+  ctx.handle_error(
+      tiledb_query_set_cache_fill(ctx, query_.get(), cache_fill ? 1 : 0));
+  return *this;
+}
+
 Query::Status Query::submit() {
   auto& ctx = ctx_.get();
   prepare_submission();
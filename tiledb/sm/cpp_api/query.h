@@ -122,6 +122,13 @@ class TILEDB_EXPORT Query {
   /** Sets the data layout of the buffers.  */
   Query& set_layout(tiledb_layout_t layout);
 
+  /**
+   * Sets whether the tiles a read query fetches from storage are inserted
+   * into the tile caches (by default they are). Applicable only to read
+   * queries.
+   */
+  Query& set_cache_fill(bool cache_fill);
+
   /** Returns the query status. */
   Status query_status() const;
 
@@ -156,7 +163,10 @@ class TILEDB_EXPORT Query {
    *
    * (i) If the query was writing in global order, it flushes the internal
    * state. It is **required** to finalize global-order write query objects in
-   * order to ensure correct execution.
+   * order to ensure correct execution. The same holds for unordered write
+   * queries if `sm.unordered_write_memory_budget` is not `0`, in which case
+   * finalization merges the cells of all the submissions into a single
+   * fragment.
    *
    * (ii) For any query, it "closes" the corresponding array. This causes the
    * storage manager to decrement the reference count of the array. When the
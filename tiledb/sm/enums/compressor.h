@@ -75,6 +75,12 @@ inline const char* compressor_str(Compressor type) {
       return constants::bzip2_str;
     case Compressor::DOUBLE_DELTA:
       return constants::double_delta_str;
+    case Compressor::FRAME_OF_REFERENCE:
+      return constants::frame_of_reference_str;
+    case Compressor::GORILLA:
+      return constants::gorilla_str;
+    case Compressor::AUTO_COMPRESSION:
+      return constants::auto_compression_str;
     default:
       return "";
   }
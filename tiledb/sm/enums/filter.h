@@ -0,0 +1,90 @@
+/**
+ * @file filter.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This defines the tiledb Filter enum that maps to tiledb_filter_t C-api
+ * enum.
+ */
+
+#ifndef TILEDB_FILTER_H
+#define TILEDB_FILTER_H
+
+#include "tiledb/sm/misc/constants.h"
+
+namespace tiledb {
+namespace sm {
+
+/** Defines the filter type. */
+enum class Filter : char {
+#define TILEDB_FILTER_ENUM(id) id
+#include "tiledb/sm/c_api/tiledb_enum.h"
+#undef TILEDB_FILTER_ENUM
+};
+
+/** Returns the string representation of the input filter. */
+inline const char* filter_str(Filter type) {
+  switch (type) {
+    case Filter::FILTER_BYTESHUFFLE:
+      return constants::filter_byteshuffle_str;
+    case Filter::FILTER_BITSHUFFLE:
+      return constants::filter_bitshuffle_str;
+    case Filter::FILTER_DELTA:
+      return constants::filter_delta_str;
+    case Filter::FILTER_DOUBLE_DELTA:
+      return constants::filter_double_delta_str;
+    case Filter::FILTER_BIT_WIDTH_REDUCTION:
+      return constants::filter_bit_width_reduction_str;
+    case Filter::FILTER_FRAME_OF_REFERENCE:
+      return constants::filter_frame_of_reference_str;
+    case Filter::FILTER_COMPACT_OFFSETS:
+      return constants::filter_compact_offsets_str;
+    default:
+      return "";
+  }
+}
+
+/** Returns true if the input is a valid filter type. */
+inline bool filter_valid(Filter type) {
+  switch (type) {
+    case Filter::FILTER_BYTESHUFFLE:
+    case Filter::FILTER_BITSHUFFLE:
+    case Filter::FILTER_DELTA:
+    case Filter::FILTER_DOUBLE_DELTA:
+    case Filter::FILTER_BIT_WIDTH_REDUCTION:
+    case Filter::FILTER_FRAME_OF_REFERENCE:
+    case Filter::FILTER_COMPACT_OFFSETS:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_FILTER_H
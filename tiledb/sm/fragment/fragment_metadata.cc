@@ -61,6 +61,7 @@ FragmentMetadata::FragmentMetadata(
     , fragment_uri_(fragment_uri) {
   domain_ = nullptr;
   non_empty_domain_ = nullptr;
+  format_version_ = constants::format_version;
   std::memcpy(version_, constants::version, sizeof(version_));
 
   auto attributes = array_schema_->attributes();
@@ -76,11 +77,6 @@ FragmentMetadata::~FragmentMetadata() {
   if (non_empty_domain_ != nullptr)
     std::free(non_empty_domain_);
 
-  auto mbr_num = (uint64_t)mbrs_.size();
-  for (uint64_t i = 0; i < mbr_num; ++i)
-    if (mbrs_[i] != nullptr)
-      std::free(mbrs_[i]);
-
   auto bounding_coords_num = (uint64_t)bounding_coords_.size();
   for (uint64_t i = 0; i < bounding_coords_num; ++i)
     if (bounding_coords_[i] != nullptr)
@@ -102,27 +98,31 @@ void FragmentMetadata::append_bounding_coords(const void* bounding_coords) {
 }
 
 Status FragmentMetadata::append_mbr(const void* mbr) {
+  return append_mbrs(mbr, 1);
+}
+
+Status FragmentMetadata::append_mbrs(const void* mbrs, uint64_t mbr_num) {
   switch (array_schema_->coords_type()) {
     case Datatype::INT8:
-      return append_mbr<int8_t>(static_cast<const int8_t*>(mbr));
+      return append_mbrs<int8_t>(mbrs, mbr_num);
     case Datatype::UINT8:
-      return append_mbr<uint8_t>(static_cast<const uint8_t*>(mbr));
+      return append_mbrs<uint8_t>(mbrs, mbr_num);
     case Datatype::INT16:
-      return append_mbr<int16_t>(static_cast<const int16_t*>(mbr));
+      return append_mbrs<int16_t>(mbrs, mbr_num);
     case Datatype::UINT16:
-      return append_mbr<uint16_t>(static_cast<const uint16_t*>(mbr));
+      return append_mbrs<uint16_t>(mbrs, mbr_num);
     case Datatype::INT32:
-      return append_mbr<int>(static_cast<const int*>(mbr));
+      return append_mbrs<int>(mbrs, mbr_num);
     case Datatype::UINT32:
-      return append_mbr<unsigned>(static_cast<const unsigned*>(mbr));
+      return append_mbrs<unsigned>(mbrs, mbr_num);
     case Datatype::INT64:
-      return append_mbr<int64_t>(static_cast<const int64_t*>(mbr));
+      return append_mbrs<int64_t>(mbrs, mbr_num);
     case Datatype::UINT64:
-      return append_mbr<uint64_t>(static_cast<const uint64_t*>(mbr));
+      return append_mbrs<uint64_t>(mbrs, mbr_num);
     case Datatype::FLOAT32:
-      return append_mbr<float>(static_cast<const float*>(mbr));
+      return append_mbrs<float>(mbrs, mbr_num);
     case Datatype::FLOAT64:
-      return append_mbr<double>(static_cast<const double*>(mbr));
+      return append_mbrs<double>(mbrs, mbr_num);
     default:
       return LOG_STATUS(Status::FragmentMetadataError(
           "Cannot append mbr; Unsupported coordinates type"));
@@ -130,16 +130,32 @@ Status FragmentMetadata::append_mbr(const void* mbr) {
 }
 
 template <class T>
-Status FragmentMetadata::append_mbr(const void* mbr) {
+Status FragmentMetadata::append_mbrs(const void* mbrs, uint64_t mbr_num) {
+  if (mbr_num == 0)
+    return Status::Ok();
+
   // For easy reference
+  auto dim_num = array_schema_->dim_num();
   uint64_t mbr_size = 2 * array_schema_->coords_size();
 
-  // Copy and append MBR
-  void* new_mbr = std::malloc(mbr_size);
-  std::memcpy(new_mbr, mbr, mbr_size);
-  mbrs_.push_back(new_mbr);
+  // Copy and append MBRs
+  auto data = static_cast<const unsigned char*>(mbrs);
+  mbrs_.insert(mbrs_.end(), data, data + mbr_num * mbr_size);
+
+  // Expand the non-empty domain once, with the union of the MBRs
+  auto mbr = static_cast<const T*>(mbrs);
+  std::vector<T> mbr_union(mbr, mbr + 2 * dim_num);
+  for (uint64_t m = 1; m < mbr_num; ++m) {
+    mbr += 2 * dim_num;
+    for (unsigned i = 0; i < dim_num; ++i) {
+      if (mbr[2 * i] < mbr_union[2 * i])
+        mbr_union[2 * i] = mbr[2 * i];
+      if (mbr[2 * i + 1] > mbr_union[2 * i + 1])
+        mbr_union[2 * i + 1] = mbr[2 * i + 1];
+    }
+  }
 
-  return expand_non_empty_domain(static_cast<const T*>(mbr));
+  return expand_non_empty_domain(&mbr_union[0]);
 }
 
 void FragmentMetadata::append_tile_offset(
@@ -165,6 +181,12 @@ void FragmentMetadata::append_tile_var_size(
   tile_var_sizes_[attribute_id].push_back(size);
 }
 
+void FragmentMetadata::append_tile_var_decoded_size(
+    const std::string& attribute, uint64_t size) {
+  auto attribute_id = attribute_idx_map_[attribute];
+  tile_var_decoded_sizes_[attribute_id].push_back(size);
+}
+
 uint64_t FragmentMetadata::cell_num(uint64_t tile_pos) const {
   if (dense_)
     return array_schema_->domain()->cell_num_per_tile();
@@ -200,7 +222,7 @@ Status FragmentMetadata::add_max_read_buffer_sizes_dense(
       if (array_schema_->var_size(it.first)) {
         auto cell_num = this->cell_num(tid);
         it.second.first += cell_num * constants::cell_var_offset_size;
-        it.second.second += tile_var_size(it.first, tid);
+        it.second.second += tile_var_decoded_size(it.first, tid);
       } else {
         it.second.first += cell_num(tid) * array_schema_->cell_size(it.first);
       }
@@ -215,21 +237,20 @@ Status FragmentMetadata::add_max_read_buffer_sizes_sparse(
     const T* subarray,
     std::unordered_map<std::string, std::pair<uint64_t, uint64_t>>*
         buffer_sizes) const {
-  unsigned tid = 0;
   auto dim_num = array_schema_->dim_num();
-  for (auto& mbr : mbrs_) {
-    if (utils::overlap(static_cast<T*>(mbr), subarray, dim_num)) {
+  auto mbr_num = mbrs_.size() / (2 * array_schema_->coords_size());
+  for (uint64_t tid = 0; tid < mbr_num; ++tid) {
+    if (utils::overlap(static_cast<const T*>(mbr(tid)), subarray, dim_num)) {
       for (auto& it : *buffer_sizes) {
         if (array_schema_->var_size(it.first)) {
           auto cell_num = this->cell_num(tid);
           it.second.first += cell_num * constants::cell_var_offset_size;
-          it.second.second += tile_var_size(it.first, tid);
+          it.second.second += tile_var_decoded_size(it.first, tid);
         } else {
           it.second.first += cell_num(tid) * array_schema_->cell_size(it.first);
         }
       }
     }
-    tid++;
   }
 
   return Status::Ok();
@@ -251,6 +272,18 @@ Status FragmentMetadata::deserialize(ConstBuffer* buf) {
   RETURN_NOT_OK(load_file_sizes(buf));
   RETURN_NOT_OK(load_file_var_sizes(buf));
 
+  // The decoded variable tile sizes are absent from fragment metadata
+  // written before dictionary encoding was supported
+  tile_var_decoded_sizes_.resize(array_schema_->attribute_num());
+  if (buf->nbytes_left_to_read() > 0)
+    RETURN_NOT_OK(load_tile_var_decoded_sizes(buf));
+
+  // The format version is absent from fragment metadata written before
+  // the tile data format was versioned
+  format_version_ = 0;
+  if (buf->nbytes_left_to_read() > 0)
+    RETURN_NOT_OK(load_format_version(buf));
+
   return Status::Ok();
 }
 
@@ -270,6 +303,10 @@ uint64_t FragmentMetadata::file_var_sizes(const std::string& attribute) const {
   return file_var_sizes_[attribute_id];
 }
 
+uint32_t FragmentMetadata::format_version() const {
+  return format_version_;
+}
+
 const URI& FragmentMetadata::fragment_uri() const {
   return fragment_uri_;
 }
@@ -336,6 +373,7 @@ Status FragmentMetadata::init(const void* non_empty_domain) {
 
   // Initialize variable tile sizes
   tile_var_sizes_.resize(attribute_num);
+  tile_var_decoded_sizes_.resize(attribute_num);
 
   return Status::Ok();
 }
@@ -344,8 +382,8 @@ uint64_t FragmentMetadata::last_tile_cell_num() const {
   return last_tile_cell_num_;
 }
 
-const std::vector<void*>& FragmentMetadata::mbrs() const {
-  return mbrs_;
+const void* FragmentMetadata::mbr(uint64_t tile_idx) const {
+  return &mbrs_[tile_idx * 2 * array_schema_->coords_size()];
 }
 
 const void* FragmentMetadata::non_empty_domain() const {
@@ -363,6 +401,8 @@ Status FragmentMetadata::serialize(Buffer* buf) {
   RETURN_NOT_OK(write_last_tile_cell_num(buf));
   RETURN_NOT_OK(write_file_sizes(buf));
   RETURN_NOT_OK(write_file_var_sizes(buf));
+  RETURN_NOT_OK(write_tile_var_decoded_sizes(buf));
+  RETURN_NOT_OK(write_format_version(buf));
 
   return Status::Ok();
 }
@@ -375,7 +415,7 @@ uint64_t FragmentMetadata::tile_num() const {
   if (dense_)
     return array_schema_->domain()->tile_num(domain_);
 
-  return (uint64_t)mbrs_.size();
+  return (uint64_t)mbrs_.size() / (2 * array_schema_->coords_size());
 }
 
 URI FragmentMetadata::attr_uri(const std::string& attribute) const {
@@ -405,12 +445,16 @@ uint64_t FragmentMetadata::compressed_tile_size(
   auto it = attribute_idx_map_.find(attribute);
   auto attribute_id = it->second;
 
-  // Check if the tile is not compressed
+  // Check if the tile is stored as is (neither compressed nor filtered)
   if (array_schema_->var_size(attribute_id)) {
-    if (constants::cell_var_offsets_compression == Compressor::NO_COMPRESSION)
+    if (array_schema_->cell_var_offsets_compression() ==
+            Compressor::NO_COMPRESSION &&
+        array_schema_->cell_var_offsets_filters().empty())
       return 0;  // Uncompressed offsets tile
   } else {
-    if (array_schema_->compression(attribute_id) == Compressor::NO_COMPRESSION)
+    if (array_schema_->compression(attribute_id) ==
+            Compressor::NO_COMPRESSION &&
+        array_schema_->filters(attribute_id).empty())
       return 0;  // Uncompressed fix-sized value tile
   }
 
@@ -425,7 +469,8 @@ uint64_t FragmentMetadata::compressed_tile_var_size(
     const std::string& attribute, uint64_t tile_idx) const {
   auto it = attribute_idx_map_.find(attribute);
   auto attribute_id = it->second;
-  if (array_schema_->compression(attribute_id) == Compressor::NO_COMPRESSION)
+  if (array_schema_->compression(attribute_id) == Compressor::NO_COMPRESSION &&
+      array_schema_->filters(attribute_id).empty())
     return 0;
 
   auto tile_num = this->tile_num();
@@ -451,6 +496,15 @@ uint64_t FragmentMetadata::tile_var_size(
   return tile_var_sizes_[attribute_id][tile_idx];
 }
 
+uint64_t FragmentMetadata::tile_var_decoded_size(
+    const std::string& attribute, uint64_t tile_idx) const {
+  auto it = attribute_idx_map_.find(attribute);
+  auto attribute_id = it->second;
+  if (tile_var_decoded_sizes_[attribute_id].empty())
+    return tile_var_sizes_[attribute_id][tile_idx];
+  return tile_var_decoded_sizes_[attribute_id][tile_idx];
+}
+
 /* ****************************** */
 /*        PRIVATE METHODS         */
 /* ****************************** */
@@ -605,6 +659,17 @@ Status FragmentMetadata::load_file_var_sizes(ConstBuffer* buff) {
   return Status::Ok();
 }
 
+// ===== FORMAT =====
+// format_version (uint32_t)
+Status FragmentMetadata::load_format_version(ConstBuffer* buff) {
+  auto st = buff->read(&format_version_, sizeof(uint32_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading format version failed"));
+  }
+  return Status::Ok();
+}
+
 // ===== FORMAT =====
 // last_tile_cell_num (uint64_t)
 Status FragmentMetadata::load_last_tile_cell_num(ConstBuffer* buff) {
@@ -633,17 +698,14 @@ Status FragmentMetadata::load_mbrs(ConstBuffer* buff) {
 
   // Get MBRs
   uint64_t mbr_size = 2 * array_schema_->coords_size();
-  void* mbr = nullptr;
-  mbrs_.resize(mbr_num);
-  for (uint64_t i = 0; i < mbr_num; ++i) {
-    mbr = std::malloc(mbr_size);
-    st = buff->read(mbr, mbr_size);
+  mbrs_.resize(mbr_num * mbr_size);
+  if (mbr_num > 0) {
+    st = buff->read(&mbrs_[0], mbr_num * mbr_size);
     if (!st.ok()) {
-      std::free(mbr);
+      mbrs_.clear();
       return LOG_STATUS(Status::FragmentMetadataError(
           "Cannot load fragment metadata; Reading MBR failed"));
     }
-    mbrs_[i] = mbr;
   }
   return Status::Ok();
 }
@@ -806,6 +868,41 @@ Status FragmentMetadata::load_tile_var_sizes(ConstBuffer* buff) {
   return Status::Ok();
 }
 
+// ===== FORMAT =====
+// tile_var_decoded_sizes_attr#0_num (uint64_t)
+// tile_var_decoded_sizes_attr#0_#1 (uint64_t)
+//     tile_var_decoded_sizes_attr#0_#2 (uint64_t) ...
+// ...
+// tile_var_decoded_sizes_attr#<attribute_num-1>_num (uint64_t)
+// tile_var_decoded_sizes_attr#<attribute_num-1>_#1 (uint64_t)
+//     tile_var_decoded_sizes_attr#<attribute_num-1>_#2 (uint64_t) ...
+Status FragmentMetadata::load_tile_var_decoded_sizes(ConstBuffer* buff) {
+  unsigned int attribute_num = array_schema_->attribute_num();
+  uint64_t sizes_num = 0;
+
+  for (unsigned int i = 0; i < attribute_num; ++i) {
+    auto st = buff->read(&sizes_num, sizeof(uint64_t));
+    if (!st.ok()) {
+      return LOG_STATUS(Status::FragmentMetadataError(
+          "Cannot load fragment metadata; Reading number of decoded "
+          "variable tile sizes failed"));
+    }
+
+    if (sizes_num == 0)
+      continue;
+
+    tile_var_decoded_sizes_[i].resize(sizes_num);
+    st = buff->read(
+        &tile_var_decoded_sizes_[i][0], sizes_num * sizeof(uint64_t));
+    if (!st.ok()) {
+      return LOG_STATUS(Status::FragmentMetadataError(
+          "Cannot load fragment metadata; Reading decoded variable tile "
+          "sizes failed"));
+    }
+  }
+  return Status::Ok();
+}
+
 // ===== FORMAT =====
 // version (int[3])
 Status FragmentMetadata::load_version(ConstBuffer* buff) {
@@ -872,6 +969,17 @@ Status FragmentMetadata::write_file_var_sizes(Buffer* buff) {
   return Status::Ok();
 }
 
+// ===== FORMAT =====
+// format_version (uint32_t)
+Status FragmentMetadata::write_format_version(Buffer* buff) {
+  auto st = buff->write(&constants::format_version, sizeof(uint32_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot serialize fragment metadata; Writing format version failed"));
+  }
+  return Status::Ok();
+}
+
 // ===== FORMAT =====
 // last_tile_cell_num(uint64_t)
 Status FragmentMetadata::write_last_tile_cell_num(Buffer* buff) {
@@ -898,7 +1006,7 @@ Status FragmentMetadata::write_last_tile_cell_num(Buffer* buff) {
 Status FragmentMetadata::write_mbrs(Buffer* buff) {
   Status st;
   uint64_t mbr_size = 2 * array_schema_->coords_size();
-  uint64_t mbr_num = mbrs_.size();
+  uint64_t mbr_num = mbrs_.size() / mbr_size;
 
   // Write number of MBRs
   st = buff->write(&mbr_num, sizeof(uint64_t));
@@ -908,8 +1016,8 @@ Status FragmentMetadata::write_mbrs(Buffer* buff) {
   }
 
   // Write MBRs
-  for (uint64_t i = 0; i < mbr_num; ++i) {
-    st = buff->write(mbrs_[i], mbr_size);
+  if (mbr_num > 0) {
+    st = buff->write(&mbrs_[0], mbrs_.size());
     if (!st.ok()) {
       return LOG_STATUS(Status::FragmentMetadataError(
           "Cannot serialize fragment metadata; Writing MBR failed"));
@@ -1056,6 +1164,40 @@ Status FragmentMetadata::write_tile_var_sizes(Buffer* buff) {
   return Status::Ok();
 }
 
+// ===== FORMAT =====
+// tile_var_decoded_sizes_attr#0_num (uint64_t)
+// tile_var_decoded_sizes_attr#0_#1 (uint64_t)
+//     tile_var_decoded_sizes_attr#0_#2 (uint64_t) ...
+// ...
+// tile_var_decoded_sizes_attr#<attribute_num-1>_num (uint64_t)
+// tile_var_decoded_sizes_attr#<attribute_num-1>_#1 (uint64_t)
+//     tile_var_decoded_sizes_attr#<attribute_num-1>_#2 (uint64_t) ...
+Status FragmentMetadata::write_tile_var_decoded_sizes(Buffer* buff) {
+  unsigned int attribute_num = array_schema_->attribute_num();
+
+  for (unsigned int i = 0; i < attribute_num; ++i) {
+    uint64_t sizes_num = tile_var_decoded_sizes_[i].size();
+    auto st = buff->write(&sizes_num, sizeof(uint64_t));
+    if (!st.ok()) {
+      return LOG_STATUS(Status::FragmentMetadataError(
+          "Cannot serialize fragment metadata; Writing number of decoded "
+          "variable tile sizes failed"));
+    }
+
+    if (sizes_num == 0)
+      continue;
+
+    st = buff->write(
+        &tile_var_decoded_sizes_[i][0], sizes_num * sizeof(uint64_t));
+    if (!st.ok()) {
+      return LOG_STATUS(Status::FragmentMetadataError(
+          "Cannot serialize fragment metadata; Writing decoded variable "
+          "tile sizes failed"));
+    }
+  }
+  return Status::Ok();
+}
+
 // ===== FORMAT =====
 // version (int[3])
 Status FragmentMetadata::write_version(Buffer* buff) {
@@ -1064,16 +1206,26 @@ Status FragmentMetadata::write_version(Buffer* buff) {
 }
 
 // Explicit template instantiations
-template Status FragmentMetadata::append_mbr<int8_t>(const void* mbr);
-template Status FragmentMetadata::append_mbr<uint8_t>(const void* mbr);
-template Status FragmentMetadata::append_mbr<int16_t>(const void* mbr);
-template Status FragmentMetadata::append_mbr<uint16_t>(const void* mbr);
-template Status FragmentMetadata::append_mbr<int32_t>(const void* mbr);
-template Status FragmentMetadata::append_mbr<uint32_t>(const void* mbr);
-template Status FragmentMetadata::append_mbr<int64_t>(const void* mbr);
-template Status FragmentMetadata::append_mbr<uint64_t>(const void* mbr);
-template Status FragmentMetadata::append_mbr<float>(const void* mbr);
-template Status FragmentMetadata::append_mbr<double>(const void* mbr);
+template Status FragmentMetadata::append_mbrs<int8_t>(
+    const void* mbrs, uint64_t mbr_num);
+template Status FragmentMetadata::append_mbrs<uint8_t>(
+    const void* mbrs, uint64_t mbr_num);
+template Status FragmentMetadata::append_mbrs<int16_t>(
+    const void* mbrs, uint64_t mbr_num);
+template Status FragmentMetadata::append_mbrs<uint16_t>(
+    const void* mbrs, uint64_t mbr_num);
+template Status FragmentMetadata::append_mbrs<int32_t>(
+    const void* mbrs, uint64_t mbr_num);
+template Status FragmentMetadata::append_mbrs<uint32_t>(
+    const void* mbrs, uint64_t mbr_num);
+template Status FragmentMetadata::append_mbrs<int64_t>(
+    const void* mbrs, uint64_t mbr_num);
+template Status FragmentMetadata::append_mbrs<uint64_t>(
+    const void* mbrs, uint64_t mbr_num);
+template Status FragmentMetadata::append_mbrs<float>(
+    const void* mbrs, uint64_t mbr_num);
+template Status FragmentMetadata::append_mbrs<double>(
+    const void* mbrs, uint64_t mbr_num);
 
 template Status FragmentMetadata::add_max_read_buffer_sizes<int8_t>(
     const int8_t* subarray,
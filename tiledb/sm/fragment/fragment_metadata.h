@@ -87,15 +87,26 @@ class FragmentMetadata {
   Status append_mbr(const void* mbr);
 
   /**
-   * Appends the input MBR to the fragment metadata. It also expands the
-   * non-empty domain of the fragment.
+   * Appends the input MBRs, stored one after the other, to the fragment
+   * metadata. It also expands the non-empty domain of the fragment.
+   *
+   * @param mbrs The MBRs to be appended.
+   * @param mbr_num The number of MBRs in `mbrs`.
+   * @return Status
+   */
+  Status append_mbrs(const void* mbrs, uint64_t mbr_num);
+
+  /**
+   * Appends the input MBRs, stored one after the other, to the fragment
+   * metadata. It also expands the non-empty domain of the fragment.
    *
    * @tparam T The coordinates type.
-   * @param mbr The MBR to be appended.
+   * @param mbrs The MBRs to be appended.
+   * @param mbr_num The number of MBRs in `mbrs`.
    * @return Status
    */
   template <class T>
-  Status append_mbr(const void* mbr);
+  Status append_mbrs(const void* mbrs, uint64_t mbr_num);
 
   /**
    * Appends a tile offset for the input attribute.
@@ -126,6 +137,17 @@ class FragmentMetadata {
    */
   void append_tile_var_size(const std::string& attribute, uint64_t size);
 
+  /**
+   * Appends the decoded size of a variable tile for the input
+   * (dictionary-encoded) attribute.
+   *
+   * @param attribute The attribute for which the size is appended.
+   * @param size The size to be appended.
+   * @return void
+   */
+  void append_tile_var_decoded_size(
+      const std::string& attribute, uint64_t size);
+
   /** Returns the number of cells in the tile at the input position. */
   uint64_t cell_num(uint64_t tile_pos) const;
 
@@ -211,6 +233,9 @@ class FragmentMetadata {
   /** Returns the size of the input variable attribute. */
   uint64_t file_var_sizes(const std::string& attribute) const;
 
+  /** Returns the format version the fragment tiles were written in. */
+  uint32_t format_version() const;
+
   /** Returns the fragment URI. */
   const URI& fragment_uri() const;
 
@@ -237,8 +262,8 @@ class FragmentMetadata {
   /** Returns the number of cells in the last tile. */
   uint64_t last_tile_cell_num() const;
 
-  /** Returns the MBRs. */
-  const std::vector<void*>& mbrs() const;
+  /** Returns the MBR of the input tile. */
+  const void* mbr(uint64_t tile_idx) const;
 
   /** Returns the non-empty domain in which the fragment is constrained. */
   const void* non_empty_domain() const;
@@ -334,6 +359,18 @@ class FragmentMetadata {
    */
   uint64_t tile_var_size(const std::string& attribute, uint64_t tile_idx) const;
 
+  /**
+   * Returns the size of the variable-sized values a given tile decodes to.
+   * This differs from `tile_var_size` only for dictionary-encoded
+   * attributes.
+   *
+   * @param attribute The input attribute.
+   * @param tile_idx The index of the tile in the metadata.
+   * @return The decoded tile size.
+   */
+  uint64_t tile_var_decoded_size(
+      const std::string& attribute, uint64_t tile_idx) const;
+
  private:
   /* ********************************* */
   /*         PRIVATE ATTRIBUTES        */
@@ -371,8 +408,11 @@ class FragmentMetadata {
   /** Number of cells in the last tile (meaningful only in the sparse case). */
   uint64_t last_tile_cell_num_;
 
-  /** The MBRs (applicable only to the sparse case with irregular tiles). */
-  std::vector<void*> mbrs_;
+  /**
+   * The MBRs, stored contiguously one after the other (applicable only to
+   * the sparse case with irregular tiles).
+   */
+  std::vector<unsigned char> mbrs_;
 
   /** The offsets of the next tile for each attribute. */
   std::vector<uint64_t> next_tile_offsets_;
@@ -404,6 +444,15 @@ class FragmentMetadata {
    */
   std::vector<std::vector<uint64_t>> tile_var_sizes_;
 
+  /**
+   * The decoded sizes of the variable tiles. Stored only for
+   * dictionary-encoded attributes (empty otherwise).
+   */
+  std::vector<std::vector<uint64_t>> tile_var_decoded_sizes_;
+
+  /** The format version the fragment tiles were written in. */
+  uint32_t format_version_;
+
   /** The version of the library that created this metadata. */
   int version_[3];
 
@@ -451,6 +500,9 @@ class FragmentMetadata {
   /** Loads the sizes of each variable attribute file from the buffer. */
   Status load_file_var_sizes(ConstBuffer* buff);
 
+  /** Loads the format version of the fragment tiles from the buffer. */
+  Status load_format_version(ConstBuffer* buff);
+
   /**
    * Loads the cell number of the last tile from the fragment metadata buffer.
    *
@@ -499,6 +551,14 @@ class FragmentMetadata {
    */
   Status load_tile_var_sizes(ConstBuffer* buff);
 
+  /**
+   * Loads the decoded variable tile sizes from the fragment metadata.
+   *
+   * @param buff Metadata buffer.
+   * @return Status
+   */
+  Status load_tile_var_decoded_sizes(ConstBuffer* buff);
+
   /** Loads the library version from the buffer. */
   Status load_version(ConstBuffer* buff);
 
@@ -516,6 +576,9 @@ class FragmentMetadata {
   /** Writes the sizes of each variable attribute file in the buffer. */
   Status write_file_var_sizes(Buffer* buff);
 
+  /** Writes the format version of the fragment tiles to the buffer. */
+  Status write_format_version(Buffer* buff);
+
   /**
    * Writes the cell number of the last tile to the fragment metadata buffer.
    *
@@ -564,6 +627,14 @@ class FragmentMetadata {
    */
   Status write_tile_var_sizes(Buffer* buff);
 
+  /**
+   * Writes the decoded variable tile sizes to the fragment metadata buffer.
+   *
+   * @param buff Metadata buffer.
+   * @return Status
+   */
+  Status write_tile_var_decoded_sizes(Buffer* buff);
+
   /** Writes the library version to the buffer. */
   Status write_version(Buffer* buff);
 };
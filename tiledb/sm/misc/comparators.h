@@ -203,6 +203,64 @@ class GlobalCmp {
   unsigned dim_num_;
 };
 
+/**
+ * Wrapper of comparison function for sorting serialized cell records on the
+ * global order of some domain. Each record starts with its size (`uint64_t`),
+ * followed by the cell coordinates.
+ */
+template <class T>
+class GlobalRecordCmp {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param domain The array domain.
+   * @param buff The buffer the records are stored in.
+   */
+  GlobalRecordCmp(const Domain* domain, const unsigned char* buff = nullptr)
+      : domain_(domain)
+      , buff_(buff) {
+  }
+
+  /**
+   * Comparison operator for a vector of record offsets in `buff_`.
+   *
+   * @param a The offset of the first record.
+   * @param b The offset of the second record.
+   * @return `true` if the record at `a` precedes the record at `b`, and
+   *     `false` otherwise.
+   */
+  bool operator()(uint64_t a, uint64_t b) const {
+    return precedes(buff_ + a, buff_ + b);
+  }
+
+  /**
+   * Returns `true` if record `a` precedes record `b` in the global order,
+   * and `false` otherwise.
+   */
+  bool precedes(const unsigned char* a, const unsigned char* b) const {
+    auto coords_a = (const T*)(a + sizeof(uint64_t));
+    auto coords_b = (const T*)(b + sizeof(uint64_t));
+
+    // Compare tile order first
+    auto tile_cmp = domain_->tile_order_cmp<T>(coords_a, coords_b);
+    if (tile_cmp == -1)
+      return true;
+    if (tile_cmp == 1)
+      return false;
+    // else tile_cmp == 0 --> continue
+
+    // Compare cell order
+    return domain_->cell_order_cmp(coords_a, coords_b) == -1;
+  }
+
+ private:
+  /** The domain. */
+  const Domain* domain_;
+  /** The buffer the records are stored in. */
+  const unsigned char* buff_;
+};
+
 /** Wrapper of comparison function for sorting dense cell ranges. */
 template <class T>
 class DenseCellRangeCmp {
@@ -47,6 +47,7 @@
 
 #include "tiledb/sm/enums/compressor.h"
 #include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/enums/filter.h"
 
 namespace tiledb {
 namespace sm {
@@ -80,6 +81,9 @@ Compressor cell_var_offsets_compression = Compressor::BLOSC_ZSTD;
 /** The default compression level for the offsets of variable-sized cells. */
 int cell_var_offsets_compression_level = -1;
 
+/** The default filter for the offsets of variable-sized cells. */
+Filter cell_var_offsets_filter = Filter::FILTER_COMPACT_OFFSETS;
+
 /** Special name reserved for the coordinates attribute. */
 const char* coords = "__coords";
 
@@ -211,6 +215,67 @@ const uint64_t fragment_metadata_cache_size = 10000000;
 /** The tile cache size. */
 const uint64_t tile_cache_size = 10000000;
 
+/** The compressed tile cache size. */
+const uint64_t compressed_tile_cache_size = 50000000;
+
+/** The number of shards of the tile caches. */
+const uint64_t tile_cache_shard_num = 8;
+
+/** The eviction policy of the tile caches. */
+const char* tile_cache_policy = "slru";
+
+/**
+ * The maximum size (in bytes) of the chunks a tile is split into upon
+ * compression.
+ */
+const uint64_t tile_chunk_size = 1048576;
+
+/**
+ * The maximum size (in bytes) a per-thread staging or scratch buffer
+ * retains between uses; larger ones are released after use.
+ */
+const uint64_t max_staging_buffer_size = 10485760;
+
+/**
+ * The default candidate compressors (with their levels) that the
+ * `AUTO_COMPRESSION` compressor picks from for every chunk.
+ */
+const char* auto_compression_candidates =
+    "NO_COMPRESSION,LZ4,ZSTD:1,ZSTD:9,RLE,DOUBLE_DELTA,GORILLA";
+
+/**
+ * The maximum number of bytes of a chunk that every candidate compressor
+ * is tried on, when the chunk is compressed with `AUTO_COMPRESSION`.
+ */
+const uint64_t auto_compression_sample_size = 65536;
+
+/**
+ * The maximum number of decimal digits that a quantized real attribute can
+ * retain.
+ */
+const int max_quantization_digits = 15;
+
+/** The default size of the array write buffers (0 means no buffering). */
+const uint64_t write_buffer_size = 0;
+
+/** The default maximum age of the cells in the array write buffers. */
+const uint64_t write_buffer_max_age_ms = 0;
+
+/** The default memory budget of unordered writes (0 means no external sort). */
+const uint64_t unordered_write_memory_budget = 0;
+
+/** The default scratch directory of unordered writes. */
+const char* unordered_write_scratch_dir = "";
+
+/** The default number of threads in the storage manager compute pool. */
+const uint64_t num_compute_threads = std::thread::hardware_concurrency();
+
+/**
+ * The default maximum number of pending background tile writes of a
+ * global-order write (0 means that the writes are synchronous).
+ */
+const uint64_t global_write_queue_depth = 0;
+
 /** String describing GZIP. */
 const char* gzip_str = "GZIP";
 
@@ -247,6 +312,39 @@ const char* bzip2_str = "BZIP2";
 /** String describing DOUBLE_DELTA. */
 const char* double_delta_str = "DOUBLE_DELTA";
 
+/** String describing FRAME_OF_REFERENCE. */
+const char* frame_of_reference_str = "FRAME_OF_REFERENCE";
+
+/** String describing GORILLA. */
+const char* gorilla_str = "GORILLA";
+
+/** String describing AUTO_COMPRESSION. */
+const char* auto_compression_str = "AUTO_COMPRESSION";
+
+/** String describing FILTER_BYTESHUFFLE. */
+const char* filter_byteshuffle_str = "BYTESHUFFLE";
+
+/** String describing FILTER_BITSHUFFLE. */
+const char* filter_bitshuffle_str = "BITSHUFFLE";
+
+/** String describing FILTER_DELTA. */
+const char* filter_delta_str = "DELTA";
+
+/** String describing FILTER_DOUBLE_DELTA. */
+const char* filter_double_delta_str = "DOUBLE_DELTA";
+
+/** String describing FILTER_BIT_WIDTH_REDUCTION. */
+const char* filter_bit_width_reduction_str = "BIT_WIDTH_REDUCTION";
+
+/** String describing FILTER_FRAME_OF_REFERENCE. */
+const char* filter_frame_of_reference_str = "FRAME_OF_REFERENCE";
+
+/** String describing FILTER_COMPACT_OFFSETS. */
+const char* filter_compact_offsets_str = "COMPACT_OFFSETS";
+
+/** The number of values in a window of the bit-width reduction filter. */
+const uint64_t bit_width_reduction_window = 256;
+
 /** The string representation for type int32. */
 const char* int32_str = "INT32";
 
@@ -322,13 +420,25 @@ const char* unordered_str = "unordered";
 /** The string representation of null. */
 const char* null_str = "null";
 
+/**
+ * The version of the format of the tile data written, stored in the fragment
+ * metadata. Version 1 stores RLE run lengths as varints; fragments without
+ * a stored format version are of version 0.
+ */
+const uint32_t format_version = 1;
+
+/**
+ * The version of the format of the array schema, stored after the
+ * attributes. Version 1 adds the filters, dictionary encoding, compression
+ * dictionaries and quantization; array schemas without a stored format
+ * version are of version 0.
+ */
+const uint32_t array_schema_version = 1;
+
 /** The version in format { major, minor, revision }. */
 const int version[3] = {
     TILEDB_VERSION_MAJOR, TILEDB_VERSION_MINOR, TILEDB_VERSION_PATCH};
 
-/** The size of a tile chunk. */
-const uint64_t tile_chunk_size = (uint64_t)std::numeric_limits<int>::max();
-
 /** The default attribute name prefix. */
 const char* default_attr_name = "__attr";
 
@@ -40,6 +40,7 @@ namespace sm {
 
 enum class Datatype : char;
 enum class Compressor : char;
+enum class Filter : char;
 
 namespace constants {
 
@@ -70,6 +71,9 @@ extern Compressor cell_var_offsets_compression;
 /** The default compression level for the offsets of variable-sized cells. */
 extern int cell_var_offsets_compression_level;
 
+/** The default filter for the offsets of variable-sized cells. */
+extern Filter cell_var_offsets_filter;
+
 /** The default compressor for the coordinates. */
 extern Compressor coords_compression;
 
@@ -199,6 +203,66 @@ extern const uint64_t fragment_metadata_cache_size;
 /** The tile cache size. */
 extern const uint64_t tile_cache_size;
 
+/** The compressed tile cache size. */
+extern const uint64_t compressed_tile_cache_size;
+
+/** The number of shards of the tile caches. */
+extern const uint64_t tile_cache_shard_num;
+
+/** The eviction policy of the tile caches. */
+extern const char* tile_cache_policy;
+
+/**
+ * The maximum size (in bytes) of the chunks a tile is split into upon
+ * compression.
+ */
+extern const uint64_t tile_chunk_size;
+
+/**
+ * The maximum size (in bytes) a per-thread staging or scratch buffer
+ * retains between uses; larger ones are released after use.
+ */
+extern const uint64_t max_staging_buffer_size;
+
+/**
+ * The default candidate compressors (with their levels) that the
+ * `AUTO_COMPRESSION` compressor picks from for every chunk.
+ */
+extern const char* auto_compression_candidates;
+
+/**
+ * The maximum number of bytes of a chunk that every candidate compressor
+ * is tried on, when the chunk is compressed with `AUTO_COMPRESSION`.
+ */
+extern const uint64_t auto_compression_sample_size;
+
+/**
+ * The maximum number of decimal digits that a quantized real attribute can
+ * retain.
+ */
+extern const int max_quantization_digits;
+
+/** The default size of the array write buffers (0 means no buffering). */
+extern const uint64_t write_buffer_size;
+
+/** The default maximum age of the cells in the array write buffers. */
+extern const uint64_t write_buffer_max_age_ms;
+
+/** The default memory budget of unordered writes (0 means no external sort). */
+extern const uint64_t unordered_write_memory_budget;
+
+/** The default scratch directory of unordered writes. */
+extern const char* unordered_write_scratch_dir;
+
+/** The default number of threads in the storage manager compute pool. */
+extern const uint64_t num_compute_threads;
+
+/**
+ * The default maximum number of pending background tile writes of a
+ * global-order write (0 means that the writes are synchronous).
+ */
+extern const uint64_t global_write_queue_depth;
+
 /** String describing GZIP. */
 extern const char* gzip_str;
 
@@ -235,6 +299,39 @@ extern const char* bzip2_str;
 /** String describing DOUBLE_DELTA. */
 extern const char* double_delta_str;
 
+/** String describing FRAME_OF_REFERENCE. */
+extern const char* frame_of_reference_str;
+
+/** String describing GORILLA. */
+extern const char* gorilla_str;
+
+/** String describing AUTO_COMPRESSION. */
+extern const char* auto_compression_str;
+
+/** String describing FILTER_BYTESHUFFLE. */
+extern const char* filter_byteshuffle_str;
+
+/** String describing FILTER_BITSHUFFLE. */
+extern const char* filter_bitshuffle_str;
+
+/** String describing FILTER_DELTA. */
+extern const char* filter_delta_str;
+
+/** String describing FILTER_DOUBLE_DELTA. */
+extern const char* filter_double_delta_str;
+
+/** String describing FILTER_BIT_WIDTH_REDUCTION. */
+extern const char* filter_bit_width_reduction_str;
+
+/** String describing FILTER_FRAME_OF_REFERENCE. */
+extern const char* filter_frame_of_reference_str;
+
+/** String describing FILTER_COMPACT_OFFSETS. */
+extern const char* filter_compact_offsets_str;
+
+/** The number of values in a window of the bit-width reduction filter. */
+extern const uint64_t bit_width_reduction_window;
+
 /** The string representation for type int32. */
 extern const char* int32_str;
 
@@ -310,12 +407,24 @@ extern const char* unordered_str;
 /** The string representation of null. */
 extern const char* null_str;
 
+/**
+ * The version of the format of the tile data written, stored in the fragment
+ * metadata. Version 1 stores RLE run lengths as varints; fragments without
+ * a stored format version are of version 0.
+ */
+extern const uint32_t format_version;
+
+/**
+ * The version of the format of the array schema, stored after the
+ * attributes. Version 1 adds the filters, dictionary encoding, compression
+ * dictionaries and quantization; array schemas without a stored format
+ * version are of version 0.
+ */
+extern const uint32_t array_schema_version;
+
 /** The version in format { major, minor, revision }. */
 extern const int version[3];
 
-/** The size of a tile chunk. */
-extern const uint64_t tile_chunk_size;
-
 /** The default attribute name prefix. */
 extern const char* default_attr_name;
 
@@ -195,6 +195,9 @@ std::string Status::code_to_string() const {
     case StatusCode::DenseCellRangeIter:
       type = "[TileDB::DenseCellRangeIter] Error";
       break;
+    case StatusCode::Filter:
+      type = "[TileDB::Filter] Error";
+      break;
     default:
       type = "[TileDB::?] Error:";
   }
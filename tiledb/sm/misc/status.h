@@ -112,6 +112,7 @@ enum class StatusCode : char {
   Attribute,
   SparseReader,
   DenseCellRangeIter,
+  Filter,
 };
 
 class Status {
@@ -324,6 +325,11 @@ class Status {
     return Status(StatusCode::DenseCellRangeIter, msg, -1);
   }
 
+  /** Return a FilterError error class Status with a given message **/
+  static Status FilterError(const std::string& msg) {
+    return Status(StatusCode::Filter, msg, -1);
+  }
+
   /** Returns true iff the status indicates success **/
   bool ok() const {
     return (state_ == nullptr);
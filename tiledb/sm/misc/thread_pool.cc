@@ -72,6 +72,15 @@ std::future<Status> ThreadPool::enqueue(
   return future;
 }
 
+bool ThreadPool::is_worker() const {
+  auto id = std::this_thread::get_id();
+  for (const auto& t : threads_) {
+    if (t.get_id() == id)
+      return true;
+  }
+  return false;
+}
+
 uint64_t ThreadPool::num_threads() const {
   return threads_.size();
 }
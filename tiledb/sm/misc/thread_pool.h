@@ -68,6 +68,13 @@ class ThreadPool {
    */
   std::future<Status> enqueue(const std::function<Status()>& function);
 
+  /**
+   * Return true if the calling thread is one of the threads of this pool.
+   * A task running on the pool must not wait on other tasks of the same
+   * pool, since all threads may end up waiting.
+   */
+  bool is_worker() const;
+
   /** Return the number of threads in this pool. */
   uint64_t num_threads() const;
 
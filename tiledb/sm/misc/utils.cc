@@ -34,9 +34,12 @@
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/misc/logger.h"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <set>
 #include <sstream>
+#include <type_traits>
 
 #ifdef _WIN32
 #include <sys/timeb.h>
@@ -92,6 +95,49 @@ Status convert(const std::string& str, uint64_t* value) {
   return Status::Ok();
 }
 
+Status convert(const std::string& str, Compressor* compressor) {
+  // GORILLA is the last compressor
+  for (int i = 0; i <= (int)Compressor::GORILLA; ++i) {
+    if (str == compressor_str((Compressor)i)) {
+      *compressor = (Compressor)i;
+      return Status::Ok();
+    }
+  }
+
+  return LOG_STATUS(Status::UtilsError(
+      std::string("Failed to convert string to compressor; Unknown "
+                  "compressor '") +
+      str + "'"));
+}
+
+Status convert(
+    const std::string& str, std::vector<std::pair<Compressor, int>>* value) {
+  std::vector<std::pair<Compressor, int>> compressors;
+  std::stringstream ss(str);
+  std::string entry;
+  while (std::getline(ss, entry, ',')) {
+    auto colon = entry.find(':');
+    Compressor compressor;
+    RETURN_NOT_OK(convert(entry.substr(0, colon), &compressor));
+    if (compressor == Compressor::AUTO_COMPRESSION)
+      return LOG_STATUS(Status::UtilsError(
+          "Failed to convert string to compressors; AUTO_COMPRESSION cannot "
+          "be a candidate compressor"));
+
+    long level = -1;
+    if (colon != std::string::npos)
+      RETURN_NOT_OK(convert(entry.substr(colon + 1), &level));
+    compressors.emplace_back(compressor, (int)level);
+  }
+
+  if (compressors.empty())
+    return LOG_STATUS(Status::UtilsError(
+        "Failed to convert string to compressors; Empty list"));
+
+  *value = std::move(compressors);
+  return Status::Ok();
+}
+
 bool is_int(const std::string& str) {
   // Check if empty
   if (str.empty())
@@ -344,6 +390,184 @@ void expand_mbr(T* mbr, const T* coords, unsigned int dim_num) {
   }
 }
 
+/**
+ * Computes the MBR of `cell_num` coordinates of `D` dimensions. The branch-
+ * free min/max over the `D` accumulators lets the compiler keep them in
+ * vector registers.
+ */
+template <class T, unsigned D>
+static inline void compute_mbr_fixed(
+    const T* coords, uint64_t cell_num, T* mbr) {
+  T low[D], high[D];
+  for (unsigned d = 0; d < D; ++d)
+    low[d] = high[d] = coords[d];
+
+  for (uint64_t i = 1; i < cell_num; ++i) {
+    const T* c = &coords[i * D];
+    for (unsigned d = 0; d < D; ++d) {
+      low[d] = (c[d] < low[d]) ? c[d] : low[d];
+      high[d] = (c[d] > high[d]) ? c[d] : high[d];
+    }
+  }
+
+  for (unsigned d = 0; d < D; ++d) {
+    mbr[2 * d] = low[d];
+    mbr[2 * d + 1] = high[d];
+  }
+}
+
+template <class T>
+void compute_mbr(
+    const T* coords, uint64_t cell_num, unsigned int dim_num, T* mbr) {
+  assert(cell_num > 0);
+  switch (dim_num) {
+    case 1:
+      return compute_mbr_fixed<T, 1>(coords, cell_num, mbr);
+    case 2:
+      return compute_mbr_fixed<T, 2>(coords, cell_num, mbr);
+    case 3:
+      return compute_mbr_fixed<T, 3>(coords, cell_num, mbr);
+    case 4:
+      return compute_mbr_fixed<T, 4>(coords, cell_num, mbr);
+    default:
+      break;
+  }
+
+  for (unsigned d = 0; d < dim_num; ++d) {
+    T low = coords[d], high = coords[d];
+    for (uint64_t i = 1; i < cell_num; ++i) {
+      T c = coords[i * dim_num + d];
+      low = (c < low) ? c : low;
+      high = (c > high) ? c : high;
+    }
+    mbr[2 * d] = low;
+    mbr[2 * d + 1] = high;
+  }
+}
+
+/**
+ * Replicates the `N`-byte `value` `num` times in `buffer`. The fixed-size
+ * memcpy compiles to a single (potentially unaligned) store, which lets the
+ * compiler vectorize the loop.
+ */
+template <size_t N>
+static inline void fill_fixed(
+    unsigned char* buffer, const void* value, uint64_t num) {
+  unsigned char v[N];
+  std::memcpy(v, value, N);
+  for (uint64_t i = 0; i < num; ++i)
+    std::memcpy(buffer + i * N, v, N);
+}
+
+void fill(void* buffer, const void* value, uint64_t value_size, uint64_t num) {
+  if (num == 0 || value_size == 0)
+    return;
+
+  auto buff = (unsigned char*)buffer;
+  switch (value_size) {
+    case 1:
+      std::memset(buff, *(const unsigned char*)value, num);
+      return;
+    case 2:
+      fill_fixed<2>(buff, value, num);
+      return;
+    case 4:
+      fill_fixed<4>(buff, value, num);
+      return;
+    case 8:
+      fill_fixed<8>(buff, value, num);
+      return;
+    default:
+      break;
+  }
+
+  // Arbitrary value size: copy the value once and then keep doubling the
+  // filled prefix
+  uint64_t total = num * value_size;
+  std::memcpy(buff, value, value_size);
+  uint64_t filled = value_size;
+  while (filled < total) {
+    auto to_copy = std::min(filled, total - filled);
+    std::memcpy(buff + filled, buff, to_copy);
+    filled += to_copy;
+  }
+}
+
+void fill_offsets(
+    uint64_t* offsets, uint64_t num, uint64_t start, uint64_t step) {
+  for (uint64_t i = 0; i < num; ++i)
+    offsets[i] = start + i * step;
+}
+
+void set_bits(uint8_t* bitmap, uint64_t start, uint64_t num) {
+  if (num == 0)
+    return;
+
+  uint64_t end = start + num;  // Exclusive
+  uint64_t first_byte = start / 8;
+  uint64_t last_byte = (end - 1) / 8;
+  auto head_mask = (uint8_t)(0xFF << (start % 8));
+  auto tail_mask = (uint8_t)(0xFF >> (7 - (end - 1) % 8));
+
+  // The whole range falls in a single byte
+  if (first_byte == last_byte) {
+    bitmap[first_byte] |= (uint8_t)(head_mask & tail_mask);
+    return;
+  }
+
+  // Boundary bytes bit-wise, whole bytes in between in bulk
+  bitmap[first_byte] |= head_mask;
+  if (last_byte - first_byte > 1)
+    std::memset(bitmap + first_byte + 1, 0xFF, last_byte - first_byte - 1);
+  bitmap[last_byte] |= tail_mask;
+}
+
+void pack_bits(
+    const uint64_t* in, uint64_t num, unsigned int width, uint64_t* words) {
+  uint64_t bit = 0;
+  for (uint64_t i = 0; width > 0 && i < num; ++i, bit += width) {
+    auto word = bit >> 6;
+    auto shift = bit & 63;
+    words[word] |= in[i] << shift;
+    if (shift + width > 64)
+      words[word + 1] |= in[i] >> (64 - shift);
+  }
+}
+
+void unpack_bits(
+    const uint64_t* words, uint64_t num, unsigned int width, uint64_t* out) {
+  if (width == 0) {
+    std::memset(out, 0, num * sizeof(uint64_t));
+    return;
+  }
+
+  uint64_t mask = (width == 64) ? ~uint64_t(0) : ((uint64_t(1) << width) - 1);
+
+  // No value straddles two words
+  if (64 % width == 0) {
+    auto per_word = 64 / width;
+    auto whole_words = num / per_word;
+    for (uint64_t w = 0; w < whole_words; ++w) {
+      auto word = words[w];
+      for (uint64_t k = 0; k < per_word; ++k)
+        out[w * per_word + k] = (word >> (k * width)) & mask;
+    }
+    for (uint64_t i = whole_words * per_word; i < num; ++i)
+      out[i] = (words[i / per_word] >> ((i % per_word) * width)) & mask;
+    return;
+  }
+
+  uint64_t bit = 0;
+  for (uint64_t i = 0; i < num; ++i, bit += width) {
+    auto word = bit >> 6;
+    auto shift = bit & 63;
+    auto value = words[word] >> shift;
+    if (shift + width > 64)
+      value |= words[word + 1] << (64 - shift);
+    out[i] = value & mask;
+  }
+}
+
 template <class T>
 bool has_duplicates(const std::vector<T>& v) {
   std::set<T> s(v.begin(), v.end());
@@ -526,6 +750,22 @@ uint64_t ceil(uint64_t x, uint64_t y) {
   return x / y + (x % y != 0);
 }
 
+template <class T>
+T wrapping_add(T a, T b) {
+  typedef typename std::make_unsigned<T>::type U;
+  return (T)(U)((U)a + (U)b);
+}
+
+template <>
+float wrapping_add<float>(float a, float b) {
+  return a + b;
+}
+
+template <>
+double wrapping_add<double>(double a, double b) {
+  return a + b;
+}
+
 // Explicit template instantiations
 template uint64_t cell_num_in_subarray<int>(
     const int* subarray, unsigned int dim_num);
@@ -754,6 +994,45 @@ template void expand_mbr<uint32_t>(
 template void expand_mbr<uint64_t>(
     uint64_t* mbr, const uint64_t* coords, unsigned int dim_num);
 
+template void compute_mbr<int8_t>(
+    const int8_t* coords, uint64_t cell_num, unsigned int dim_num, int8_t* mbr);
+template void compute_mbr<uint8_t>(
+    const uint8_t* coords,
+    uint64_t cell_num,
+    unsigned int dim_num,
+    uint8_t* mbr);
+template void compute_mbr<int16_t>(
+    const int16_t* coords,
+    uint64_t cell_num,
+    unsigned int dim_num,
+    int16_t* mbr);
+template void compute_mbr<uint16_t>(
+    const uint16_t* coords,
+    uint64_t cell_num,
+    unsigned int dim_num,
+    uint16_t* mbr);
+template void compute_mbr<int>(
+    const int* coords, uint64_t cell_num, unsigned int dim_num, int* mbr);
+template void compute_mbr<unsigned>(
+    const unsigned* coords,
+    uint64_t cell_num,
+    unsigned int dim_num,
+    unsigned* mbr);
+template void compute_mbr<int64_t>(
+    const int64_t* coords,
+    uint64_t cell_num,
+    unsigned int dim_num,
+    int64_t* mbr);
+template void compute_mbr<uint64_t>(
+    const uint64_t* coords,
+    uint64_t cell_num,
+    unsigned int dim_num,
+    uint64_t* mbr);
+template void compute_mbr<float>(
+    const float* coords, uint64_t cell_num, unsigned int dim_num, float* mbr);
+template void compute_mbr<double>(
+    const double* coords, uint64_t cell_num, unsigned int dim_num, double* mbr);
+
 template bool has_duplicates<std::string>(const std::vector<std::string>& v);
 
 template bool inside_subarray<int>(
@@ -840,6 +1119,15 @@ template bool overlap<float>(const float* a, const float* b, unsigned dim_num);
 template bool overlap<double>(
     const double* a, const double* b, unsigned dim_num);
 
+template int8_t wrapping_add<int8_t>(int8_t a, int8_t b);
+template uint8_t wrapping_add<uint8_t>(uint8_t a, uint8_t b);
+template int16_t wrapping_add<int16_t>(int16_t a, int16_t b);
+template uint16_t wrapping_add<uint16_t>(uint16_t a, uint16_t b);
+template int wrapping_add<int>(int a, int b);
+template unsigned wrapping_add<unsigned>(unsigned a, unsigned b);
+template int64_t wrapping_add<int64_t>(int64_t a, int64_t b);
+template uint64_t wrapping_add<uint64_t>(uint64_t a, uint64_t b);
+
 }  // namespace utils
 
 }  // namespace sm
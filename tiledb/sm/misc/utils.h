@@ -61,6 +61,17 @@ Status convert(const std::string& str, long* value);
 /** Converts the input string into a `uint64_t` value. */
 Status convert(const std::string& str, uint64_t* value);
 
+/** Converts the input string (e.g., `"ZSTD"`) into a compressor. */
+Status convert(const std::string& str, Compressor* compressor);
+
+/**
+ * Converts the input comma-separated list of `<compressor>[:<level>]`
+ * entries (e.g., `"LZ4,ZSTD:9"`) into compressor and compression level
+ * pairs. The level of an entry without one is `-1` (the default level).
+ */
+Status convert(
+    const std::string& str, std::vector<std::pair<Compressor, int>>* value);
+
 /** Returns `true` if the input string is a (potentially signed) integer. */
 bool is_int(const std::string& str);
 
@@ -202,6 +213,91 @@ Status expand_buffer(void*& buffer, uint64_t* buffer_allocated_size);
 template <class T>
 void expand_mbr(T* mbr, const T* coords, unsigned int dim_num);
 
+/**
+ * Computes the MBR of a tile of coordinates, stored one cell after the
+ * other. The min/max reductions of 1 to 4 dimensions are unrolled over
+ * per-dimension accumulators, which the compiler can vectorize; more
+ * dimensions are reduced one dimension at a time.
+ *
+ * @tparam T The type of the MBR and coordinates.
+ * @param coords The coordinates.
+ * @param cell_num The number of cells in `coords`. It must be at least 1.
+ * @param dim_num The number of dimensions.
+ * @param mbr The MBR to be computed, as a (low, high) pair per dimension.
+ * @return void
+ */
+template <class T>
+void compute_mbr(
+    const T* coords, uint64_t cell_num, unsigned int dim_num, T* mbr);
+
+/**
+ * Fills `buffer` with `num` consecutive copies of `value`. Fill values of
+ * 1, 2, 4 and 8 bytes are handled with fixed-width loops that the compiler
+ * can vectorize; any other size is handled by a memcpy that doubles the
+ * already-filled prefix at every step.
+ *
+ * @param buffer The buffer to be filled (must hold `num * value_size` bytes).
+ * @param value The value to be replicated.
+ * @param value_size The size of `value` in bytes.
+ * @param num The number of copies of `value` to write.
+ * @return void
+ */
+void fill(void* buffer, const void* value, uint64_t value_size, uint64_t num);
+
+/**
+ * Writes the `num` offsets `start, start + step, start + 2 * step, ...`
+ * into `offsets`.
+ *
+ * @param offsets The output offsets (must hold `num` values).
+ * @param num The number of offsets to generate.
+ * @param start The first offset.
+ * @param step The distance between two consecutive offsets.
+ * @return void
+ */
+void fill_offsets(
+    uint64_t* offsets, uint64_t num, uint64_t start, uint64_t step);
+
+/**
+ * Sets the bits `[start, start + num)` of `bitmap` to 1. Bit `i` is stored
+ * in byte `i / 8` at position `i % 8` (least significant bit first). Only the
+ * two boundary bytes are updated bit-wise; all whole bytes in between are set
+ * with a single memset.
+ *
+ * @param bitmap The bitmap to be updated.
+ * @param start The position of the first bit to set.
+ * @param num The number of bits to set.
+ * @return void
+ */
+void set_bits(uint8_t* bitmap, uint64_t start, uint64_t num);
+
+/**
+ * Packs `num` values of `width` bits each into consecutive 64-bit words,
+ * least significant bits first. A value may straddle two words.
+ *
+ * @param in The values to pack (only their lower `width` bits are set).
+ * @param num The number of values.
+ * @param width The number of bits per value (at most 64).
+ * @param words The words to pack into (must hold
+ *     `ceil(num * width / 64)` words, zeroed by the caller).
+ * @return void
+ */
+void pack_bits(
+    const uint64_t* in, uint64_t num, unsigned int width, uint64_t* words);
+
+/**
+ * Unpacks `num` values of `width` bits each packed by `pack_bits`. Widths
+ * that divide 64 take a path without values straddling words, which the
+ * compiler can vectorize.
+ *
+ * @param words The packed words.
+ * @param num The number of values.
+ * @param width The number of bits per value (at most 64).
+ * @param out The unpacked values (must hold `num` values).
+ * @return void
+ */
+void unpack_bits(
+    const uint64_t* words, uint64_t num, unsigned int width, uint64_t* out);
+
 /**
  * Checks if there are duplicates in the input vector.
  *
@@ -285,6 +381,17 @@ uint64_t timestamp_ms();
 /** Returns the value of x/y (integer division) rounded up. */
 uint64_t ceil(uint64_t x, uint64_t y);
 
+/**
+ * Returns the sum of two values. Integer sums wrap around on overflow
+ * (i.e., they are computed modulo 2^bits, as for unsigned integers).
+ */
+template <class T>
+T wrapping_add(T a, T b);
+template <>
+float wrapping_add<float>(float a, float b);
+template <>
+double wrapping_add<double>(double a, double b);
+
 }  // namespace utils
 
 }  // namespace sm
@@ -34,10 +34,13 @@
 #include "tiledb/sm/misc/comparators.h"
 #include "tiledb/sm/misc/logger.h"
 #include "tiledb/sm/misc/utils.h"
+#include "tiledb/sm/tile/dictionary_encoding.h"
 #include "tiledb/sm/tile/tile_io.h"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <cstring>
 #include <iostream>
 #include <queue>
 #include <set>
@@ -62,13 +65,30 @@ Query::Query() {
   array_schema_ = nullptr;
   callback_ = nullptr;
   callback_data_ = nullptr;
+  cache_fill_ = true;
   storage_manager_ = nullptr;
   status_ = QueryStatus::INPROGRESS;
   layout_ = Layout::ROW_MAJOR;
+  use_write_buffer_ = true;
+  dedup_ = Dedup::NO_DEDUP;
   global_write_state_.reset(nullptr);
+  unordered_write_state_.reset(nullptr);
 }
 
 Query::~Query() {
+  // Background tile writes refer to the query state. The query was not
+  // finalized, so a failed write is only logged.
+  if (global_write_state_ != nullptr) {
+    auto st = global_write_wait(0);
+    if (!st.ok())
+      LOG_STATUS(Status::QueryError(
+          "Background tile write of an unfinalized query failed; " +
+          st.message()));
+  }
+
+  // Remove the spilled runs of an unfinalized unordered write
+  clear_unordered_write_state();
+
   if (subarray_ != nullptr)
     std::free(subarray_);
 }
@@ -238,6 +258,59 @@ Status Query::finalize_global_write_state() {
   return Status::Ok();
 }
 
+Status Query::finalize_unordered_write_state() {
+  auto coords_type = array_schema_->coords_type();
+  switch (coords_type) {
+    case Datatype::INT8:
+      return finalize_unordered_write_state<int8_t>();
+    case Datatype::UINT8:
+      return finalize_unordered_write_state<uint8_t>();
+    case Datatype::INT16:
+      return finalize_unordered_write_state<int16_t>();
+    case Datatype::UINT16:
+      return finalize_unordered_write_state<uint16_t>();
+    case Datatype::INT32:
+      return finalize_unordered_write_state<int>();
+    case Datatype::UINT32:
+      return finalize_unordered_write_state<unsigned>();
+    case Datatype::INT64:
+      return finalize_unordered_write_state<int64_t>();
+    case Datatype::UINT64:
+      return finalize_unordered_write_state<uint64_t>();
+    case Datatype::FLOAT32:
+      return finalize_unordered_write_state<float>();
+    case Datatype::FLOAT64:
+      return finalize_unordered_write_state<double>();
+    default:
+      return LOG_STATUS(Status::QueryError(
+          "Cannot finalize unordered write state; Unsupported domain type"));
+  }
+
+  return Status::Ok();
+}
+
+template <class T>
+Status Query::finalize_unordered_write_state() {
+  assert(type_ == QueryType::WRITE && layout_ == Layout::UNORDERED);
+
+  // Merge the runs into a single fragment, written through the global write
+  // state, and flush the fragment metadata
+  auto st = unordered_write_merge<T>();
+  if (!st.ok() && global_write_state_ != nullptr) {
+    global_write_wait(0);
+    auto meta = global_write_state_->frag_meta_.get();
+    close_files(meta);
+    storage_manager_->vfs()->remove_dir(meta->fragment_uri());
+    global_write_state_.reset(nullptr);
+  }
+  if (st.ok() && global_write_state_ != nullptr)
+    st = finalize_global_write_state<T>();
+
+  clear_unordered_write_state();
+
+  return st;
+}
+
 Status Query::close_files(FragmentMetadata* meta) const {
   for (const auto& attr : attributes_) {
     RETURN_NOT_OK(storage_manager_->close_file(meta->attr_uri(attr)));
@@ -250,11 +323,15 @@ Status Query::close_files(FragmentMetadata* meta) const {
 
 template <class T>
 Status Query::finalize_global_write_state() {
-  assert(type_ == QueryType ::WRITE && layout_ == Layout::GLOBAL_ORDER);
+  assert(
+      type_ == QueryType ::WRITE &&
+      (layout_ == Layout::GLOBAL_ORDER || layout_ == Layout::UNORDERED));
   auto meta = global_write_state_->frag_meta_.get();
 
-  // Handle last tile
-  Status st = global_write_handle_last_tile<T>();
+  // Wait for the pending background writes and handle last tile
+  Status st = global_write_wait(0);
+  if (st.ok())
+    st = global_write_handle_last_tile<T>();
   if (!st.ok()) {
     close_files(meta);
     storage_manager_->vfs()->remove_dir(meta->fragment_uri());
@@ -307,6 +384,8 @@ Status Query::finalize_global_write_state() {
 }
 
 Status Query::finalize() {
+  if (unordered_write_state_ != nullptr)
+    return finalize_unordered_write_state();
   if (global_write_state_ != nullptr)
     return finalize_global_write_state();
   return Status::Ok();
@@ -459,6 +538,9 @@ Status Query::dense_read() {
   for (const auto& attr : attributes_)
     RETURN_NOT_OK(copy_cells(attr, overlapping_cell_ranges));
 
+  // Compute the validity bitmaps
+  RETURN_NOT_OK(copy_validity(overlapping_cell_ranges));
+
   return Status::Ok();
 }
 
@@ -544,10 +626,11 @@ Status Query::compute_overlapping_tiles(OverlappingTileVec* tiles) const {
     if (fragment_metadata_[i]->dense())
       continue;
 
-    auto mbrs = fragment_metadata_[i]->mbrs();
-    auto mbr_num = (uint64_t)mbrs.size();
+    auto meta = fragment_metadata_[i];
+    auto mbr_num = meta->tile_num();
     for (uint64_t j = 0; j < mbr_num; ++j) {
-      if (overlap(&subarray[0], (const T*)(mbrs[j]), dim_num, &full_overlap)) {
+      auto mbr = (const T*)meta->mbr(j);
+      if (overlap(&subarray[0], mbr, dim_num, &full_overlap)) {
         auto tile = std::make_shared<OverlappingTile>(i, j, full_overlap);
         tiles->emplace_back(tile);
       }
@@ -765,13 +848,18 @@ Status Query::read_tiles(
   for (const auto& f : fragment_metadata_) {
     tile_io.emplace_back(std::make_shared<TileIO>(
         storage_manager_, f->attr_uri(attribute), f->file_sizes(attribute)));
-    if (var_size)
+    tile_io.back()->set_format_version(f->format_version());
+    tile_io.back()->set_cache_fill(cache_fill_);
+    if (var_size) {
       tile_io_var.emplace_back(std::make_shared<TileIO>(
           storage_manager_,
           f->attr_var_uri(attribute),
           f->file_var_sizes(attribute)));
-    else
+      tile_io_var.back()->set_format_version(f->format_version());
+      tile_io_var.back()->set_cache_fill(cache_fill_);
+    } else {
       tile_io_var.emplace_back();
+    }
   }
   // For each fragment, read the tiles
   for (auto& tile : *tiles) {
@@ -998,10 +1086,8 @@ Status Query::copy_fixed_cells(
     // Copy
     if (cr->tile_ == nullptr) {  // Empty range
       auto fill_num = bytes_to_copy / fill_size;
-      for (uint64_t i = 0; i < fill_num; ++i) {
-        std::memcpy(buffer + buffer_offset, fill_value, fill_size);
-        buffer_offset += fill_size;
-      }
+      utils::fill(buffer + buffer_offset, fill_value, fill_size, fill_num);
+      buffer_offset += bytes_to_copy;
     } else {  // Non-empty range
       const auto& tile = cr->tile_->attr_tiles_.find(attribute)->second.first;
       auto data = (unsigned char*)tile->data();
@@ -1034,6 +1120,7 @@ Status Query::copy_var_cells(
   auto fill_size = datatype_size(type);
   auto fill_value = this->fill_value(type);
   assert(fill_value != nullptr);
+  auto dictionary_encoding = array_schema_->dictionary_encoding(attribute);
 
   // Copy cells
   for (const auto& cr : cell_ranges) {
@@ -1052,16 +1139,20 @@ Status Query::copy_var_cells(
             std::string("Cannot copy cell data for var-sized attribute '") +
             attribute + "'; Result buffer overflowed"));
 
-      // Fill with empty
-      for (auto i = cr->start_; i <= cr->end_; ++i) {
-        // Offsets
-        std::memcpy(buffer + buffer_offset, &buffer_var_offset, offset_size);
-        buffer_offset += offset_size;
-
-        // Values
-        std::memcpy(buffer_var + buffer_var_offset, fill_value, fill_size);
-        buffer_var_offset += fill_size;
-      }
+      // Fill with empty, writing the offsets through a buffer that wraps
+      // their (already checked) position in the result buffer
+      Buffer offsets(
+          buffer + buffer_offset, cell_num_in_range * offset_size, false);
+      offsets.reset_size();
+      RETURN_NOT_OK(offsets.write_offsets(
+          buffer_var_offset, fill_size, cell_num_in_range));
+      buffer_offset += cell_num_in_range * offset_size;
+      utils::fill(
+          buffer_var + buffer_var_offset,
+          fill_value,
+          fill_size,
+          cell_num_in_range);
+      buffer_var_offset += cell_num_in_range * fill_size;
 
       continue;
     }
@@ -1074,27 +1165,33 @@ Status Query::copy_var_cells(
     auto data = (unsigned char*)tile_var->data();
     auto cell_num = tile->cell_num();
     auto tile_var_size = tile_var->size();
+    const unsigned char* cell;
 
     for (auto i = cr->start_; i <= cr->end_; ++i) {
       // Copy offsets
       std::memcpy(buffer + buffer_offset, &buffer_var_offset, offset_size);
       buffer_offset += offset_size;
 
-      // Check if next variable-sized cell fits in the result buffer
-      cell_var_size = (i != cell_num - 1) ?
-                          offsets[i + 1] - offsets[i] :
-                          tile_var_size - (offsets[i] - offsets[0]);
+      // Locate the next variable-sized cell, whose "offset" is a code into
+      // the tile dictionary in the case of dictionary encoding
+      if (dictionary_encoding) {
+        RETURN_NOT_OK(DictionaryEncoding::cell(
+            tile_var.get(), offsets[i], &cell, &cell_var_size));
+      } else {
+        cell = &data[offsets[i] - offsets[0]];
+        cell_var_size = (i != cell_num - 1) ?
+                            offsets[i + 1] - offsets[i] :
+                            tile_var_size - (offsets[i] - offsets[0]);
+      }
 
+      // Check if next variable-sized cell fits in the result buffer
       if (buffer_var_offset + cell_var_size > *buffer_var_size)
         return LOG_STATUS(Status::QueryError(
             std::string("Cannot copy cell data for var-sized attribute '") +
             attribute + "'; Result buffer overflowed"));
 
       // Copy variable-sized values
-      std::memcpy(
-          buffer_var + buffer_var_offset,
-          &data[offsets[i] - offsets[0]],
-          cell_var_size);
+      std::memcpy(buffer_var + buffer_var_offset, cell, cell_var_size);
       buffer_var_offset += cell_var_size;
     }
   }
@@ -1106,6 +1203,45 @@ Status Query::copy_var_cells(
   return Status::Ok();
 }
 
+Status Query::copy_validity(
+    const OverlappingCellRangeList& cell_ranges) const {
+  // Trivial case
+  if (validity_buffers_.empty())
+    return Status::Ok();
+
+  // Check for overflow
+  uint64_t cell_num = 0;
+  for (const auto& cr : cell_ranges)
+    cell_num += cr->end_ - cr->start_ + 1;
+  uint64_t bitmap_size = utils::ceil(cell_num, 8);
+  for (const auto& vb : validity_buffers_) {
+    if (bitmap_size > *(vb.second.buffer_size_))
+      return LOG_STATUS(Status::QueryError(
+          std::string("Cannot copy validity bitmap for attribute '") +
+          vb.first + "'; Result buffer overflowed"));
+  }
+
+  // Compute the bitmap on the first buffer
+  auto first = validity_buffers_.begin()->second.buffer_;
+  std::memset(first, 0, bitmap_size);
+  uint64_t pos = 0;
+  for (const auto& cr : cell_ranges) {
+    auto cell_num_in_range = cr->end_ - cr->start_ + 1;
+    if (cr->tile_ != nullptr)
+      utils::set_bits(first, pos, cell_num_in_range);
+    pos += cell_num_in_range;
+  }
+
+  // Copy the bitmap to the rest of the buffers and update buffer sizes
+  for (const auto& vb : validity_buffers_) {
+    if (vb.second.buffer_ != first)
+      std::memcpy(vb.second.buffer_, first, bitmap_size);
+    *(vb.second.buffer_size_) = bitmap_size;
+  }
+
+  return Status::Ok();
+}
+
 Status Query::read() {
   // Check attributes
   RETURN_NOT_OK(check_attributes());
@@ -1139,6 +1275,7 @@ Status Query::set_buffers(
         Status::QueryError("Cannot set buffers; Buffers not provided"));
 
   RETURN_NOT_OK(set_attributes(attributes, attribute_num));
+  validity_buffers_.clear();
   set_buffers(buffers, buffer_sizes);
 
   return Status::Ok();
@@ -1166,12 +1303,63 @@ void Query::set_buffers(void** buffers, uint64_t* buffer_sizes) {
   }
 }
 
+Status Query::set_validity_buffer(
+    const std::string& attribute, uint8_t* buffer, uint64_t* buffer_size) {
+  if (buffer == nullptr || buffer_size == nullptr)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot set validity buffer; Buffer not provided"));
+  if (type_ != QueryType::READ || !array_schema_->dense())
+    return LOG_STATUS(
+        Status::QueryError("Cannot set validity buffer; Validity buffers are "
+                           "applicable only to dense reads"));
+  if (attr_buffers_.find(attribute) == attr_buffers_.end())
+    return LOG_STATUS(Status::QueryError(
+        std::string("Cannot set validity buffer; Attribute '") + attribute +
+        "' has no buffers set"));
+
+  validity_buffers_.erase(attribute);
+  validity_buffers_.emplace(attribute, ValidityBuffer(buffer, buffer_size));
+
+  return Status::Ok();
+}
+
 void Query::set_callback(
     const std::function<void(void*)>& callback, void* callback_data) {
   callback_ = callback;
   callback_data_ = callback_data;
 }
 
+Status Query::set_cache_fill(bool cache_fill) {
+  if (type_ != QueryType::READ)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot set cache fill; Applicable only to read queries"));
+
+  cache_fill_ = cache_fill;
+
+  return Status::Ok();
+}
+
+Status Query::set_dedup(Dedup dedup) {
+  if (type_ != QueryType::WRITE)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot set dedup; Applicable only to write queries"));
+
+  switch (dedup) {
+    case Dedup::NO_DEDUP:
+    case Dedup::DEDUP_LAST:
+    case Dedup::DEDUP_SUM:
+    case Dedup::DEDUP_MIN:
+    case Dedup::DEDUP_MAX:
+      break;
+    default:
+      return LOG_STATUS(
+          Status::QueryError("Cannot set dedup; Invalid dedup mode"));
+  }
+  dedup_ = dedup;
+
+  return Status::Ok();
+}
+
 Status Query::set_fragment_metadata(
     const std::vector<FragmentMetadata*>& fragment_metadata) {
   fragment_metadata_ = fragment_metadata;
@@ -1229,6 +1417,10 @@ void Query::set_type(QueryType type) {
   type_ = type;
 }
 
+void Query::set_use_write_buffer(bool use_write_buffer) {
+  use_write_buffer_ = use_write_buffer;
+}
+
 QueryStatus Query::status() const {
   return status_;
 }
@@ -1644,6 +1836,8 @@ void Query::zero_out_buffer_sizes() {
     *(attr_buffer.second.buffer_size_) = 0;
     *(attr_buffer.second.buffer_var_size_) = 0;
   }
+  for (auto& validity_buffer : validity_buffers_)
+    *(validity_buffer.second.buffer_size_) = 0;
 }
 
 Status Query::global_write() {
@@ -1708,6 +1902,34 @@ Status Query::init_tile(const std::string& attribute, Tile* tile) const {
   // Initialize
   RETURN_NOT_OK(tile->init(
       type, compressor, compression_level, tile_size, cell_size, dim_num));
+  tile->set_filters(array_schema_->filters(attribute));
+  tile->set_compression_dictionary(array_schema_->zstd_dictionary(attribute));
+  tile->set_quantization(
+      array_schema_->quantized(attribute),
+      array_schema_->quantization_digits(attribute));
+
+  return Status::Ok();
+}
+
+Status Query::init_tile(
+    const std::string& attribute,
+    void* data,
+    uint64_t size,
+    Tile* tile) const {
+  assert(attribute != constants::coords);
+  RETURN_NOT_OK(tile->init(
+      array_schema_->type(attribute),
+      array_schema_->compression(attribute),
+      array_schema_->compression_level(attribute),
+      array_schema_->cell_size(attribute),
+      0,
+      data,
+      size));
+  tile->set_filters(array_schema_->filters(attribute));
+  tile->set_compression_dictionary(array_schema_->zstd_dictionary(attribute));
+  tile->set_quantization(
+      array_schema_->quantized(attribute),
+      array_schema_->quantization_digits(attribute));
 
   return Status::Ok();
 }
@@ -1734,6 +1956,11 @@ Status Query::init_tile(
       0));
   RETURN_NOT_OK(tile_var->init(
       type, compressor, compression_level, tile_size, datatype_size(type), 0));
+  tile->set_filters(array_schema_->cell_var_offsets_filters());
+  tile_var->set_filters(array_schema_->filters(attribute));
+  tile_var->set_compression_dictionary(
+      array_schema_->zstd_dictionary(attribute));
+
   return Status::Ok();
 }
 
@@ -1748,6 +1975,22 @@ Status Query::init_global_write_state() {
   RETURN_NOT_OK(
       create_fragment(!has_coords(), &(global_write_state_->frag_meta_)));
 
+  // Create the background writer, if writes are asynchronous
+  auto queue_depth =
+      storage_manager_->config().sm_params().global_write_queue_depth_;
+  if (queue_depth > 0) {
+    global_write_state_->queue_depth_ = queue_depth;
+    global_write_state_->writer_ =
+        std::unique_ptr<ThreadPool>(new (std::nothrow) ThreadPool(1));
+    if (global_write_state_->writer_ == nullptr) {
+      storage_manager_->vfs()->remove_dir(
+          global_write_state_->frag_meta_->fragment_uri());
+      global_write_state_.reset(nullptr);
+      return LOG_STATUS(Status::QueryError(
+          "Cannot initialize global write state; Failed to allocate writer"));
+    }
+  }
+
   Status st = Status::Ok();
   for (const auto& attr : attributes_) {
     // Initialize last tiles
@@ -1790,26 +2033,35 @@ Status Query::global_write() {
   auto frag_meta = global_write_state_->frag_meta_.get();
   auto uri = frag_meta->fragment_uri();
 
-  // Prepare tiles for all attributes and write
+  // Prepare tiles for all attributes
   auto st = Status::Ok();
-  for (const auto& attr : attributes_) {
-    std::vector<Tile> full_tiles;
-    st = prepare_full_tiles(attr, &full_tiles);
+  auto full_tiles =
+      std::make_shared<std::vector<std::vector<Tile>>>(attributes_.size());
+  for (size_t i = 0; i < attributes_.size(); ++i) {
+    st = prepare_full_tiles(attributes_[i], &(*full_tiles)[i]);
     if (!st.ok())
       break;
+  }
 
-    if (attr == constants::coords) {
-      st = compute_coords_metadata<T>(full_tiles, frag_meta);
-      if (!st.ok())
-        break;
+  // Write the tiles, either in place or in the background. In the latter
+  // case, the user buffers have already been consumed and the query returns
+  // as soon as there is room in the queue of pending writes.
+  if (st.ok()) {
+    auto writer = global_write_state_->writer_.get();
+    if (writer == nullptr) {
+      st = global_write_tiles<T>(full_tiles.get());
+    } else {
+      st = global_write_wait(global_write_state_->queue_depth_ - 1);
+      if (st.ok())
+        global_write_state_->pending_writes_.push(writer->enqueue(
+            [this, full_tiles]() {
+              return global_write_tiles<T>(full_tiles.get());
+            }));
     }
-
-    st = write_tiles(attr, frag_meta, full_tiles);
-    if (!st.ok())
-      break;
   }
 
   if (!st.ok()) {
+    global_write_wait(0);
     storage_manager_->vfs()->remove_dir(uri);
     global_write_state_.reset(nullptr);
   }
@@ -1817,10 +2069,60 @@ Status Query::global_write() {
   return st;
 }
 
+template <class T>
+Status Query::global_write_tiles(std::vector<std::vector<Tile>>* tiles) {
+  auto frag_meta = global_write_state_->frag_meta_.get();
+  for (size_t i = 0; i < attributes_.size(); ++i) {
+    const auto& attr = attributes_[i];
+    if (attr == constants::coords)
+      RETURN_NOT_OK(compute_coords_metadata<T>((*tiles)[i], frag_meta));
+    RETURN_NOT_OK(write_tiles(attr, frag_meta, (*tiles)[i]));
+
+    // Release the tile memory as soon as it is written
+    (*tiles)[i].clear();
+  }
+
+  return Status::Ok();
+}
+
+Status Query::global_write_wait(uint64_t max_pending) {
+  auto st = Status::Ok();
+  auto& pending_writes = global_write_state_->pending_writes_;
+  while (pending_writes.size() > max_pending) {
+    auto task_st = pending_writes.front().get();
+    pending_writes.pop();
+    if (st.ok() && !task_st.ok())
+      st = task_st;
+  }
+
+  return st;
+}
+
 Status Query::unordered_write() {
   // Applicable only to unordered write on dense/sparse arrays
   assert(layout_ == Layout::UNORDERED);
 
+  // Append the cells to the array write buffer, unless they are sorted
+  // externally or their duplicates must be collapsed
+  auto sm_params = storage_manager_->config().sm_params();
+  if (use_write_buffer_ && sm_params.write_buffer_size_ > 0 &&
+      sm_params.unordered_write_memory_budget_ == 0 &&
+      dedup_ == Dedup::NO_DEDUP) {
+    std::vector<void*> buffers;
+    std::vector<uint64_t> buffer_sizes;
+    for (const auto& attr : attributes_) {
+      const auto& buff = attr_buffers_.find(attr)->second;
+      buffers.push_back(buff.buffer_);
+      buffer_sizes.push_back(*buff.buffer_size_);
+      if (array_schema_->var_size(attr)) {
+        buffers.push_back(buff.buffer_var_);
+        buffer_sizes.push_back(*buff.buffer_var_size_);
+      }
+    }
+    return storage_manager_->write_buffer_append(
+        array_schema_, attributes_, &buffers[0], &buffer_sizes[0]);
+  }
+
   auto coords_type = array_schema_->coords_type();
   switch (coords_type) {
     case Datatype::INT8:
@@ -1874,12 +2176,155 @@ Status Query::sort_coords(std::vector<uint64_t>* cell_pos) const {
   return Status::Ok();
 }
 
+template <class T>
+Status Query::dedup_cells(
+    std::vector<uint64_t>* cell_pos,
+    std::unordered_map<std::string, std::vector<unsigned char>>*
+        reduced_buffers) const {
+  // For easy reference
+  uint64_t coords_size = array_schema_->coords_size();
+  auto it = attr_buffers_.find(constants::coords);
+  auto coords = (const unsigned char*)it->second.buffer_;
+  auto cell_num = (uint64_t)cell_pos->size();
+
+  // Find the runs of cells with the same coordinates, which are adjacent
+  // in the global order
+  std::vector<uint64_t> run_starts;
+  for (uint64_t i = 0; i < cell_num; ++i) {
+    if (i == 0 || std::memcmp(
+                      &coords[(*cell_pos)[i] * coords_size],
+                      &coords[(*cell_pos)[i - 1] * coords_size],
+                      coords_size))
+      run_starts.push_back(i);
+  }
+
+  // Nothing to do if there are no duplicates
+  auto run_num = (uint64_t)run_starts.size();
+  if (run_num == cell_num)
+    return Status::Ok();
+  run_starts.push_back(cell_num);
+
+  // Reduce the values of the numeric fixed-sized attributes
+  if (dedup_ != Dedup::DEDUP_LAST) {
+    for (const auto& attr : attributes_) {
+      if (attr == constants::coords || array_schema_->var_size(attr))
+        continue;
+
+      auto reduced = &(*reduced_buffers)[attr];
+      switch (array_schema_->type(attr)) {
+        case Datatype::INT8:
+          reduce_cells<int8_t>(attr, *cell_pos, run_starts, reduced);
+          break;
+        case Datatype::UINT8:
+          reduce_cells<uint8_t>(attr, *cell_pos, run_starts, reduced);
+          break;
+        case Datatype::INT16:
+          reduce_cells<int16_t>(attr, *cell_pos, run_starts, reduced);
+          break;
+        case Datatype::UINT16:
+          reduce_cells<uint16_t>(attr, *cell_pos, run_starts, reduced);
+          break;
+        case Datatype::INT32:
+          reduce_cells<int>(attr, *cell_pos, run_starts, reduced);
+          break;
+        case Datatype::UINT32:
+          reduce_cells<unsigned>(attr, *cell_pos, run_starts, reduced);
+          break;
+        case Datatype::INT64:
+          reduce_cells<int64_t>(attr, *cell_pos, run_starts, reduced);
+          break;
+        case Datatype::UINT64:
+          reduce_cells<uint64_t>(attr, *cell_pos, run_starts, reduced);
+          break;
+        case Datatype::FLOAT32:
+          reduce_cells<float>(attr, *cell_pos, run_starts, reduced);
+          break;
+        case Datatype::FLOAT64:
+          reduce_cells<double>(attr, *cell_pos, run_starts, reduced);
+          break;
+        default:  // Non-numeric attributes keep the last values
+          reduced_buffers->erase(attr);
+          break;
+      }
+    }
+  }
+
+  // Keep the last cell of each run, i.e., the one with the largest position
+  // in the user buffers
+  std::vector<uint64_t> last_pos(run_num);
+  for (uint64_t r = 0; r < run_num; ++r) {
+    last_pos[r] = (*cell_pos)[run_starts[r]];
+    for (auto i = run_starts[r] + 1; i < run_starts[r + 1]; ++i)
+      last_pos[r] = std::max(last_pos[r], (*cell_pos)[i]);
+  }
+  cell_pos->swap(last_pos);
+
+  return Status::Ok();
+}
+
+template <class V>
+void Query::reduce_cells(
+    const std::string& attribute,
+    const std::vector<uint64_t>& cell_pos,
+    const std::vector<uint64_t>& run_starts,
+    std::vector<unsigned char>* reduced) const {
+  // For easy reference
+  auto it = attr_buffers_.find(attribute);
+  auto values = (const V*)it->second.buffer_;
+  auto cell_val_num = array_schema_->cell_val_num(attribute);
+  auto run_num = run_starts.size() - 1;
+
+  reduced->resize(run_num * cell_val_num * sizeof(V));
+  auto out = (V*)&(*reduced)[0];
+  for (uint64_t r = 0; r < run_num; ++r, out += cell_val_num) {
+    auto first = &values[cell_pos[run_starts[r]] * cell_val_num];
+    std::memcpy(out, first, cell_val_num * sizeof(V));
+    for (auto i = run_starts[r] + 1; i < run_starts[r + 1]; ++i) {
+      auto in = &values[cell_pos[i] * cell_val_num];
+      for (unsigned v = 0; v < cell_val_num; ++v) {
+        if (dedup_ == Dedup::DEDUP_SUM)
+          out[v] = utils::wrapping_add(out[v], in[v]);
+        else if (dedup_ == Dedup::DEDUP_MIN)
+          out[v] = (in[v] < out[v]) ? in[v] : out[v];
+        else if (dedup_ == Dedup::DEDUP_MAX)
+          out[v] = (in[v] > out[v]) ? in[v] : out[v];
+      }
+    }
+  }
+}
+
 template <class T>
 Status Query::unordered_write() {
+  // Buffer the cells if they are sorted externally across submissions
+  if (storage_manager_->config().sm_params().unordered_write_memory_budget_ >
+      0) {
+    if (dedup_ != Dedup::NO_DEDUP)
+      return LOG_STATUS(Status::QueryError(
+          "Cannot write in unordered layout; Dedup is not supported with an "
+          "unordered write memory budget"));
+    auto st = unordered_write_buffer<T>();
+    if (!st.ok())
+      clear_unordered_write_state();
+    return st;
+  }
+
   // Sort coordinates first
   std::vector<uint64_t> cell_pos;
   RETURN_NOT_OK(sort_coords<T>(&cell_pos));
 
+  // Collapse the cells with duplicate coordinates
+  std::unordered_map<std::string, std::vector<unsigned char>> reduced_buffers;
+  if (dedup_ != Dedup::NO_DEDUP)
+    RETURN_NOT_OK(dedup_cells<T>(&cell_pos, &reduced_buffers));
+
+  // The reduced values are already in the global order
+  std::vector<uint64_t> reduced_pos;
+  if (!reduced_buffers.empty()) {
+    reduced_pos.resize(cell_pos.size());
+    for (uint64_t i = 0; i < reduced_pos.size(); ++i)
+      reduced_pos[i] = i;
+  }
+
   // Create new fragment
   std::shared_ptr<FragmentMetadata> frag_meta;
   RETURN_NOT_OK(create_fragment(false, &frag_meta));
@@ -1888,9 +2333,22 @@ Status Query::unordered_write() {
   // Prepare tiles for all attributes and write
   for (const auto& attr : attributes_) {
     std::vector<Tile> tiles;
-    RETURN_NOT_OK_ELSE(
-        prepare_tiles(attr, cell_pos, &tiles),
-        storage_manager_->vfs()->remove_dir(uri));
+    auto reduced = reduced_buffers.find(attr);
+    if (reduced == reduced_buffers.end()) {
+      RETURN_NOT_OK_ELSE(
+          prepare_tiles(attr, cell_pos, &tiles),
+          storage_manager_->vfs()->remove_dir(uri));
+    } else {
+      // Prepare the tiles from the reduced values instead of the user buffer
+      auto& attr_buffer = attr_buffers_.find(attr)->second;
+      auto user_buffer = attr_buffer;
+      uint64_t reduced_size = reduced->second.size();
+      attr_buffer.buffer_ = &(reduced->second)[0];
+      attr_buffer.buffer_size_ = &reduced_size;
+      auto st = prepare_tiles(attr, reduced_pos, &tiles);
+      attr_buffer = user_buffer;
+      RETURN_NOT_OK_ELSE(st, storage_manager_->vfs()->remove_dir(uri));
+    }
     if (attr == constants::coords)
       RETURN_NOT_OK_ELSE(
           compute_coords_metadata<T>(tiles, frag_meta.get()),
@@ -1908,6 +2366,340 @@ Status Query::unordered_write() {
   return Status::Ok();
 }
 
+void Query::clear_unordered_write_state() {
+  if (unordered_write_state_ == nullptr)
+    return;
+
+  if (!unordered_write_state_->runs_.empty())
+    storage_manager_->vfs()->remove_dir(unordered_write_state_->runs_dir_);
+  unordered_write_state_.reset(nullptr);
+}
+
+Status Query::init_unordered_write_state() {
+  auto sm_params = storage_manager_->config().sm_params();
+  unordered_write_state_.reset(new UnorderedWriteState);
+  auto state = unordered_write_state_.get();
+  state->memory_budget_ = sm_params.unordered_write_memory_budget_;
+
+  // The runs directory is hidden, so that it is never mistaken for a
+  // fragment when it is placed inside the array directory
+  auto runs_dir_name =
+      "." + URI(new_fragment_name()).last_path_part() + "_runs";
+  const auto& scratch_dir = sm_params.unordered_write_scratch_dir_;
+  state->runs_dir_ =
+      (scratch_dir.empty()) ?
+          array_schema_->array_uri().join_path(runs_dir_name) :
+          URI(scratch_dir).join_path(runs_dir_name);
+
+  for (const auto& attr : attributes_) {
+    state->cell_sizes_.push_back(
+        array_schema_->var_size(attr) ? constants::var_size :
+                                        array_schema_->cell_size(attr));
+  }
+
+  return Status::Ok();
+}
+
+template <class T>
+Status Query::unordered_write_buffer() {
+  // Initialize the state if this is the first invocation
+  if (unordered_write_state_ == nullptr)
+    RETURN_NOT_OK(init_unordered_write_state());
+  auto state = unordered_write_state_.get();
+  auto& records = state->records_;
+
+  // For easy reference
+  auto attribute_num = attributes_.size();
+  auto coords_size = array_schema_->coords_size();
+  auto coords_it = attr_buffers_.find(constants::coords);
+  auto coords = (unsigned char*)coords_it->second.buffer_;
+  auto cell_num = *coords_it->second.buffer_size_ / coords_size;
+  std::vector<const AttributeBuffer*> buffers;
+  for (const auto& attr : attributes_)
+    buffers.push_back(&attr_buffers_.find(attr)->second);
+  const uint64_t padding = 0;
+
+  // Serialize every cell into a record
+  for (uint64_t i = 0; i < cell_num; ++i) {
+    uint64_t record_offset = records.size();
+    uint64_t record_size = 0;
+    RETURN_NOT_OK(records.write(&record_size, sizeof(uint64_t)));
+    RETURN_NOT_OK(records.write(coords + i * coords_size, coords_size));
+    for (size_t a = 0; a < attribute_num; ++a) {
+      if (attributes_[a] == constants::coords)
+        continue;
+
+      auto cell_size = state->cell_sizes_[a];
+      auto buff = buffers[a];
+      if (cell_size != constants::var_size) {
+        RETURN_NOT_OK(records.write(
+            (unsigned char*)buff->buffer_ + i * cell_size, cell_size));
+      } else {
+        auto offsets = (uint64_t*)buff->buffer_;
+        uint64_t var_size = (i == cell_num - 1) ?
+                                *buff->buffer_var_size_ - offsets[i] :
+                                offsets[i + 1] - offsets[i];
+        RETURN_NOT_OK(records.write(&var_size, sizeof(uint64_t)));
+        RETURN_NOT_OK(records.write(
+            (unsigned char*)buff->buffer_var_ + offsets[i], var_size));
+      }
+    }
+
+    // Pad the record and store its size
+    auto unpadded_size = records.size() - record_offset;
+    record_size = utils::ceil(unpadded_size, sizeof(uint64_t)) *
+                  sizeof(uint64_t);
+    RETURN_NOT_OK(records.write(&padding, record_size - unpadded_size));
+    std::memcpy(records.data(record_offset), &record_size, sizeof(uint64_t));
+    state->record_offsets_.push_back(record_offset);
+
+    // Spill a sorted run if the buffered records exceed half the budget
+    auto buffered_size =
+        records.size() + state->record_offsets_.size() * sizeof(uint64_t);
+    if (buffered_size > state->memory_budget_ / 2)
+      RETURN_NOT_OK(unordered_write_spill<T>());
+  }
+
+  return Status::Ok();
+}
+
+template <class T>
+Status Query::unordered_write_merge() {
+  auto state = unordered_write_state_.get();
+  auto merge_batch_size = state->memory_budget_ / 2;
+  std::vector<std::pair<Buffer, Buffer>> buffers(attributes_.size());
+  auto merged_size = [&buffers]() -> uint64_t {
+    uint64_t size = 0;
+    for (const auto& buff : buffers)
+      size += buff.first.size() + buff.second.size();
+    return size;
+  };
+
+  // Simple case - no spilled runs, the buffered records are merged in memory
+  if (state->runs_.empty()) {
+    unordered_write_sort_records<T>();
+    auto records = (const unsigned char*)state->records_.data();
+    for (auto offset : state->record_offsets_) {
+      RETURN_NOT_OK(unordered_write_merge_record(records + offset, &buffers));
+      if (merged_size() >= merge_batch_size)
+        RETURN_NOT_OK(unordered_write_merge_flush<T>(&buffers));
+    }
+    return unordered_write_merge_flush<T>(&buffers);
+  }
+
+  // Spill the rest of the buffered records, so that all runs are on disk
+  RETURN_NOT_OK(unordered_write_spill<T>());
+
+  // Each run is read in chunks, which share half the memory budget
+  struct RunCursor {
+    Buffer chunk_;
+    uint64_t pos_ = 0;
+    uint64_t file_offset_ = 0;
+    uint64_t file_size_ = 0;
+  };
+  auto vfs = storage_manager_->vfs();
+  auto run_num = state->runs_.size();
+  auto chunk_size = std::max<uint64_t>(merge_batch_size / run_num, 1);
+  std::vector<RunCursor> cursors(run_num);
+  for (size_t r = 0; r < run_num; ++r)
+    RETURN_NOT_OK(vfs->file_size(state->runs_[r], &cursors[r].file_size_));
+
+  // Makes sure that the next `nbytes` of run `r` are loaded in its chunk
+  auto load = [&](size_t r, uint64_t nbytes) -> Status {
+    auto& cursor = cursors[r];
+    auto avail = cursor.chunk_.size() - cursor.pos_;
+    if (avail >= nbytes)
+      return Status::Ok();
+    auto to_read = std::min(
+        std::max(chunk_size, nbytes) - avail,
+        cursor.file_size_ - cursor.file_offset_);
+    if (avail + to_read < nbytes)
+      return LOG_STATUS(Status::QueryError(
+          "Cannot merge unordered write runs; Run is truncated"));
+
+    // Move the unconsumed bytes to the beginning of the chunk
+    RETURN_NOT_OK(cursor.chunk_.realloc(avail + to_read));
+    auto data = (unsigned char*)cursor.chunk_.data();
+    if (avail > 0)
+      std::memmove(data, data + cursor.pos_, avail);
+    RETURN_NOT_OK(vfs->read(
+        state->runs_[r], cursor.file_offset_, data + avail, to_read));
+    cursor.chunk_.set_size(avail + to_read);
+    cursor.pos_ = 0;
+    cursor.file_offset_ += to_read;
+
+    return Status::Ok();
+  };
+
+  // The current record of run `r` and its size
+  auto record = [&](size_t r) {
+    return (const unsigned char*)cursors[r].chunk_.data(cursors[r].pos_);
+  };
+  auto record_size = [&](size_t r) -> uint64_t {
+    uint64_t size;
+    std::memcpy(&size, record(r), sizeof(uint64_t));
+    return size;
+  };
+
+  // Loads the next record of run `r`, if there is one
+  auto next_record = [&](size_t r, bool* has_record) -> Status {
+    auto& cursor = cursors[r];
+    *has_record = cursor.pos_ < cursor.chunk_.size() ||
+                  cursor.file_offset_ < cursor.file_size_;
+    if (!*has_record)
+      return Status::Ok();
+    RETURN_NOT_OK(load(r, sizeof(uint64_t)));
+    return load(r, record_size(r));
+  };
+
+  // Merge the runs with a heap, whose top is the run with the first record
+  // in the global order. Ties are broken by run creation order.
+  GlobalRecordCmp<T> cmp(array_schema_->domain());
+  auto heap_cmp = [&](size_t a, size_t b) -> bool {
+    if (cmp.precedes(record(b), record(a)))
+      return true;
+    return !cmp.precedes(record(a), record(b)) && a > b;
+  };
+  std::priority_queue<size_t, std::vector<size_t>, decltype(heap_cmp)> heap(
+      heap_cmp);
+  bool has_record;
+  for (size_t r = 0; r < run_num; ++r) {
+    RETURN_NOT_OK(next_record(r, &has_record));
+    if (has_record)
+      heap.push(r);
+  }
+  while (!heap.empty()) {
+    auto r = heap.top();
+    heap.pop();
+    RETURN_NOT_OK(unordered_write_merge_record(record(r), &buffers));
+    cursors[r].pos_ += record_size(r);
+    if (merged_size() >= merge_batch_size)
+      RETURN_NOT_OK(unordered_write_merge_flush<T>(&buffers));
+    RETURN_NOT_OK(next_record(r, &has_record));
+    if (has_record)
+      heap.push(r);
+  }
+
+  return unordered_write_merge_flush<T>(&buffers);
+}
+
+Status Query::unordered_write_merge_record(
+    const unsigned char* record,
+    std::vector<std::pair<Buffer, Buffer>>* buffers) const {
+  auto state = unordered_write_state_.get();
+  auto coords_size = array_schema_->coords_size();
+  auto coords = record + sizeof(uint64_t);
+  auto cur = coords + coords_size;
+  for (size_t a = 0; a < attributes_.size(); ++a) {
+    auto& buff = (*buffers)[a];
+    auto cell_size = state->cell_sizes_[a];
+    if (attributes_[a] == constants::coords) {
+      RETURN_NOT_OK(buff.first.write(coords, coords_size));
+    } else if (cell_size != constants::var_size) {
+      RETURN_NOT_OK(buff.first.write(cur, cell_size));
+      cur += cell_size;
+    } else {
+      uint64_t var_size, offset = buff.second.size();
+      std::memcpy(&var_size, cur, sizeof(uint64_t));
+      cur += sizeof(uint64_t);
+      RETURN_NOT_OK(buff.first.write(&offset, sizeof(uint64_t)));
+      RETURN_NOT_OK(buff.second.write(cur, var_size));
+      cur += var_size;
+    }
+  }
+
+  return Status::Ok();
+}
+
+template <class T>
+Status Query::unordered_write_merge_flush(
+    std::vector<std::pair<Buffer, Buffer>>* buffers) {
+  if ((*buffers)[0].first.size() == 0)
+    return Status::Ok();
+
+  // Point the query buffers to the merge buffers, and write them in the
+  // global order
+  auto user_buffers = attr_buffers_;
+  std::vector<std::pair<uint64_t, uint64_t>> sizes(attributes_.size());
+  attr_buffers_.clear();
+  for (size_t a = 0; a < attributes_.size(); ++a) {
+    auto& buff = (*buffers)[a];
+    sizes[a].first = buff.first.size();
+    sizes[a].second = buff.second.size();
+    attr_buffers_.emplace(
+        attributes_[a],
+        AttributeBuffer(
+            buff.first.data(),
+            buff.second.data(),
+            &sizes[a].first,
+            &sizes[a].second));
+  }
+  auto st = global_write<T>();
+  attr_buffers_ = user_buffers;
+
+  for (auto& buff : *buffers) {
+    buff.first.reset_size();
+    buff.first.reset_offset();
+    buff.second.reset_size();
+    buff.second.reset_offset();
+  }
+
+  return st;
+}
+
+template <class T>
+void Query::unordered_write_sort_records() {
+  auto state = unordered_write_state_.get();
+  std::stable_sort(
+      state->record_offsets_.begin(),
+      state->record_offsets_.end(),
+      GlobalRecordCmp<T>(
+          array_schema_->domain(),
+          (const unsigned char*)state->records_.data()));
+}
+
+template <class T>
+Status Query::unordered_write_spill() {
+  auto state = unordered_write_state_.get();
+  if (state->record_offsets_.empty())
+    return Status::Ok();
+
+  // Create the runs directory upon the first spill
+  if (state->runs_.empty())
+    RETURN_NOT_OK(storage_manager_->create_dir(state->runs_dir_));
+  std::stringstream ss;
+  ss << "run_" << state->runs_.size();
+  auto uri = state->runs_dir_.join_path(ss.str());
+  state->runs_.push_back(uri);
+
+  // Write the records in the global order, in pieces of at most a quarter
+  // of the memory budget
+  unordered_write_sort_records<T>();
+  auto records = (const unsigned char*)state->records_.data();
+  auto max_piece_size = std::max<uint64_t>(state->memory_budget_ / 4, 1);
+  Buffer piece;
+  for (auto offset : state->record_offsets_) {
+    uint64_t record_size;
+    std::memcpy(&record_size, records + offset, sizeof(uint64_t));
+    RETURN_NOT_OK(piece.write(records + offset, record_size));
+    if (piece.size() >= max_piece_size) {
+      RETURN_NOT_OK(storage_manager_->write(uri, &piece));
+      piece.reset_size();
+      piece.reset_offset();
+    }
+  }
+  if (piece.size() > 0)
+    RETURN_NOT_OK(storage_manager_->write(uri, &piece));
+  RETURN_NOT_OK(storage_manager_->close_file(uri));
+
+  // Release the buffered records
+  state->records_.clear();
+  state->record_offsets_.clear();
+  state->record_offsets_.shrink_to_fit();
+
+  return Status::Ok();
+}
+
 Status Query::ordered_write() {
   // Applicable only to ordered write on dense arrays
   assert(layout_ == Layout::ROW_MAJOR || layout_ == Layout::COL_MAJOR);
@@ -2132,29 +2924,38 @@ Status Query::prepare_full_tiles_fixed(
   // Initialize full tiles and set previous last tile as first tile
   auto full_tile_num =
       (cell_num - cell_idx) / cell_num_per_tile + (int)last_tile.full();
-  auto cell_num_to_write =
-      (full_tile_num - last_tile.full()) * cell_num_per_tile;
 
   if (full_tile_num > 0) {
     tiles->resize(full_tile_num);
-    for (auto& tile : (*tiles))
-      RETURN_NOT_OK(init_tile(attribute, &tile));
 
     // Handle last tile (it must be either full or empty)
+    uint64_t first_tile_idx = 0;
     if (last_tile.full()) {
       (*tiles)[0] = last_tile;
       last_tile.reset();
+      first_tile_idx = 1;
     } else {
       assert(last_tile.empty());
     }
 
-    // Write all remaining cells one by one
-    for (uint64_t tile_idx = 0, i = 0; i < cell_num_to_write; ++cell_idx, ++i) {
-      if ((*tiles)[tile_idx].full())
-        ++tile_idx;
-
-      RETURN_NOT_OK(
-          (*tiles)[tile_idx].write(buffer + cell_idx * cell_size, cell_size));
+    // The remaining full tiles are contiguous slices of the user buffer.
+    // They are wrapped instead of copied, unless they are written in the
+    // background after the query returns, or they store coordinates, which
+    // are split in place upon compression.
+    bool zero_copy = global_write_state_->writer_ == nullptr &&
+                     attribute != constants::coords;
+    auto tile_size = cell_num_per_tile * cell_size;
+    for (auto tile_idx = first_tile_idx; tile_idx < full_tile_num;
+         ++tile_idx) {
+      auto data = buffer + cell_idx * cell_size;
+      auto& tile = (*tiles)[tile_idx];
+      if (zero_copy) {
+        RETURN_NOT_OK(init_tile(attribute, data, tile_size, &tile));
+      } else {
+        RETURN_NOT_OK(init_tile(attribute, &tile));
+        RETURN_NOT_OK(tile.write(data, tile_size));
+      }
+      cell_idx += cell_num_per_tile;
     }
   }
 
@@ -2289,26 +3090,17 @@ Status Query::compute_coords_metadata(
   // For easy reference
   auto coords_size = array_schema_->coords_size();
   auto dim_num = array_schema_->dim_num();
-  std::vector<T> mbr;
-  mbr.resize(2 * dim_num);
+  auto tile_num = tiles.size();
+  std::vector<T> mbrs(2 * dim_num * tile_num);
 
-  // Compute MBRs
-  for (const auto& tile : tiles) {
-    // Initialize MBR with the first coords
-    auto data = (T*)tile.data();
-    auto cell_num = tile.size() / coords_size;
+  // Compute the MBRs of all tiles and append them at once
+  for (size_t t = 0; t < tile_num; ++t) {
+    auto data = (const T*)tiles[t].data();
+    auto cell_num = tiles[t].size() / coords_size;
     assert(cell_num > 0);
-    for (unsigned i = 0; i < dim_num; ++i) {
-      mbr[2 * i] = data[i];
-      mbr[2 * i + 1] = data[i];
-    }
-
-    // Expand the MBR with the rest coords
-    for (uint64_t i = 1; i < cell_num; ++i)
-      utils::expand_mbr(&mbr[0], &data[i * dim_num], dim_num);
-
-    meta->append_mbr(&mbr[0]);
+    utils::compute_mbr(data, cell_num, dim_num, &mbrs[2 * dim_num * t]);
   }
+  RETURN_NOT_OK(meta->append_mbrs(&mbrs[0], tile_num));
 
   // Compute bounding coordinates
   std::vector<T> bcoords;
@@ -2345,19 +3137,31 @@ Status Query::prepare_tiles_fixed(
   auto capacity = array_schema_->capacity();
   auto tile_num = utils::ceil(cell_num, capacity);
   auto cell_size = array_schema_->cell_size(attribute);
+  bool is_coords = (attribute == constants::coords);
 
-  // Initialize tiles
+  // Populate the tiles. A tile whose cells are contiguous in the user buffer
+  // wraps that slice instead of copying it, unless it stores coordinates,
+  // which are split in place upon compression.
   tiles->resize(tile_num);
-  for (auto& tile : (*tiles))
-    RETURN_NOT_OK(init_tile(attribute, &tile));
-
-  // Write all cells one by one
-  for (uint64_t i = 0, tile_idx = 0; i < cell_num; ++i) {
-    if ((*tiles)[tile_idx].full())
-      ++tile_idx;
-
-    RETURN_NOT_OK(
-        (*tiles)[tile_idx].write(buffer + cell_pos[i] * cell_size, cell_size));
+  for (uint64_t tile_idx = 0; tile_idx < tile_num; ++tile_idx) {
+    auto& tile = (*tiles)[tile_idx];
+    auto start = tile_idx * capacity;
+    auto end = std::min(start + capacity, cell_num);
+    bool contiguous = !is_coords;
+    for (auto i = start + 1; contiguous && i < end; ++i)
+      contiguous = (cell_pos[i] == cell_pos[i - 1] + 1);
+
+    if (contiguous) {
+      RETURN_NOT_OK(init_tile(
+          attribute,
+          buffer + cell_pos[start] * cell_size,
+          (end - start) * cell_size,
+          &tile));
+    } else {
+      RETURN_NOT_OK(init_tile(attribute, &tile));
+      for (auto i = start; i < end; ++i)
+        RETURN_NOT_OK(tile.write(buffer + cell_pos[i] * cell_size, cell_size));
+    }
   }
 
   return Status::Ok();
@@ -2431,7 +3235,21 @@ Status Query::prepare_tiles(
 
   // Populate each tile with the write cell ranges
   uint64_t end_pos = array_schema_->domain()->cell_num_per_tile() - 1;
+  auto cell_size = array_schema_->cell_size(attribute);
   for (size_t i = 0, t = 0; i < tile_num; ++i, t += (var_size) ? 2 : 1) {
+    // A fixed-sized tile covered by a single range is a contiguous slice
+    // of the user buffer, which the tile wraps instead of copying
+    const auto& wcrs = write_cell_ranges[i];
+    if (!var_size && wcrs.size() == 1 && wcrs[0].pos_ == 0 &&
+        wcrs[0].end_ - wcrs[0].start_ == end_pos) {
+      RETURN_NOT_OK(init_tile(
+          attribute,
+          (unsigned char*)buffer + wcrs[0].start_ * cell_size,
+          (end_pos + 1) * cell_size,
+          &(*tiles)[t]));
+      continue;
+    }
+
     uint64_t pos = 0;
     for (const auto& wcr : write_cell_ranges[i]) {
       // Write empty range
@@ -2514,10 +3332,7 @@ Status Query::write_empty_cell_range_to_tile(uint64_t num, Tile* tile) const {
   auto fill_value = this->fill_value(type);
   assert(fill_value != nullptr);
 
-  for (uint64_t i = 0; i < num; ++i)
-    RETURN_NOT_OK(tile->write(fill_value, fill_size));
-
-  return Status::Ok();
+  return tile->write_fill(fill_value, fill_size, num);
 }
 
 Status Query::write_empty_cell_range_to_tile_var(
@@ -2527,16 +3342,9 @@ Status Query::write_empty_cell_range_to_tile_var(
   auto fill_value = this->fill_value(type);
   assert(fill_value != nullptr);
 
-  for (uint64_t i = 0; i < num; ++i) {
-    // Write next offset
-    uint64_t next_offset = tile_var->size();
-    RETURN_NOT_OK(tile->write(&next_offset, sizeof(uint64_t)));
-
-    // Write variable-sized empty value
-    RETURN_NOT_OK(tile_var->write(fill_value, fill_size));
-  }
-
-  return Status::Ok();
+  // Write the offsets of the empty values, followed by the values
+  RETURN_NOT_OK(tile->write_offsets(tile_var->size(), fill_size, num));
+  return tile_var->write_fill(fill_value, fill_size, num);
 }
 
 Status Query::init_tiles(
@@ -2568,32 +3376,88 @@ Status Query::write_tiles(
 
   // For easy reference
   auto var_size = array_schema_->var_size(attribute);
+  auto pool = storage_manager_->compute_thread_pool();
+  auto tile_num = tiles.size();
 
-  // Prepare TileIO
-  auto tile_io = std::make_shared<TileIO>(
-      storage_manager_, frag_meta->attr_uri(attribute));
-  auto tile_io_var =
-      (!var_size) ? nullptr :
-                    std::make_shared<TileIO>(
-                        storage_manager_, frag_meta->attr_var_uri(attribute));
+  // Dictionary-encode each (offsets, values) tile pair in parallel,
+  // recording the size of the values it decodes to
+  if (var_size && array_schema_->dictionary_encoding(attribute)) {
+    std::vector<std::future<Status>> tasks;
+    for (uint64_t i = 0; i < tile_num; i += 2) {
+      frag_meta->append_tile_var_decoded_size(attribute, tiles[i + 1].size());
+      auto tile = &tiles[i];
+      auto tile_var = &tiles[i + 1];
+      tasks.emplace_back(pool->enqueue([tile, tile_var]() {
+        return DictionaryEncoding::encode(tile, tile_var);
+      }));
+    }
+    auto st = Status::Ok();
+    for (auto& task : tasks) {
+      auto task_st = task.get();
+      if (st.ok() && !task_st.ok())
+        st = task_st;
+    }
+    RETURN_NOT_OK(st);
+  }
+
+  // Tiles are compressed in parallel in batches, with one TileIO object per
+  // tile in the batch, and then appended to the files in order. For
+  // var-sized attributes, each (offsets, values) tile pair is adjacent in
+  // `tiles`, so the even batch slots write to the attribute file and the odd
+  // slots to the var-sized file.
+  auto tiles_per_cell = (var_size) ? 2u : 1u;
+  auto batch_size = pool->num_threads() * tiles_per_cell;
+  std::vector<std::unique_ptr<TileIO>> tile_ios;
+  for (uint64_t i = 0; i < batch_size && i < tile_num; ++i) {
+    auto uri = (i % tiles_per_cell == 0) ? frag_meta->attr_uri(attribute) :
+                                           frag_meta->attr_var_uri(attribute);
+    tile_ios.emplace_back(new TileIO(storage_manager_, uri));
+  }
 
   // Write tiles
-  auto tile_num = tiles.size();
   uint64_t bytes_written, bytes_written_var;
-  for (size_t i = 0; i < tile_num; ++i) {
-    RETURN_NOT_OK(tile_io->write(&(tiles[i]), &bytes_written));
-    frag_meta->append_tile_offset(attribute, bytes_written);
+  for (uint64_t b = 0; b < tile_num; b += batch_size) {
+    auto batch_end = std::min<uint64_t>(b + batch_size, tile_num);
 
-    if (var_size) {
-      ++i;
-      RETURN_NOT_OK(tile_io_var->write(&(tiles[i]), &bytes_written_var));
-      frag_meta->append_tile_var_offset(attribute, bytes_written_var);
-      frag_meta->append_tile_var_size(attribute, tiles[i].size());
+    // Compress the batch
+    if (batch_end - b == 1) {
+      RETURN_NOT_OK(tile_ios[0]->compress(&tiles[b]));
+    } else {
+      std::vector<std::future<Status>> tasks;
+      for (uint64_t i = b; i < batch_end; ++i) {
+        auto tile_io = tile_ios[i - b].get();
+        auto tile = &tiles[i];
+        tasks.emplace_back(pool->enqueue(
+            [tile_io, tile]() { return tile_io->compress(tile); }));
+      }
+      auto st = Status::Ok();
+      for (auto& task : tasks) {
+        auto task_st = task.get();
+        if (st.ok() && !task_st.ok())
+          st = task_st;
+      }
+      RETURN_NOT_OK(st);
+    }
+
+    // Append the batch to the files in order
+    for (uint64_t i = b; i < batch_end; ++i) {
+      RETURN_NOT_OK(
+          tile_ios[i - b]->write_compressed(&tiles[i], &bytes_written));
+      frag_meta->append_tile_offset(attribute, bytes_written);
+
+      if (var_size) {
+        ++i;
+        RETURN_NOT_OK(
+            tile_ios[i - b]->write_compressed(&tiles[i], &bytes_written_var));
+        frag_meta->append_tile_var_offset(attribute, bytes_written_var);
+        frag_meta->append_tile_var_size(attribute, tiles[i].size());
+      }
     }
   }
 
-  // Close files, except in the case of global order
-  if (layout_ != Layout::GLOBAL_ORDER) {
+  // Close files, except in the case of global writes, which append to the
+  // same files across invocations
+  if (global_write_state_ == nullptr) {
     RETURN_NOT_OK(storage_manager_->close_file(frag_meta->attr_uri(attribute)));
     if (var_size)
       RETURN_NOT_OK(
@@ -33,16 +33,20 @@
 #ifndef TILEDB_QUERY_H
 #define TILEDB_QUERY_H
 
+#include "tiledb/sm/enums/dedup.h"
 #include "tiledb/sm/enums/query_status.h"
 #include "tiledb/sm/enums/query_type.h"
 #include "tiledb/sm/fragment/fragment_metadata.h"
 #include "tiledb/sm/misc/status.h"
+#include "tiledb/sm/misc/thread_pool.h"
 #include "tiledb/sm/query/dense_cell_range_iter.h"
 #include "tiledb/sm/storage_manager/storage_manager.h"
 #include "tiledb/sm/tile/tile.h"
 
 #include <functional>
+#include <future>
 #include <memory>
+#include <queue>
 #include <unordered_map>
 #include <vector>
 
@@ -87,6 +91,23 @@ class Query {
     }
   };
 
+  /**
+   * A validity bitmap buffer of an attribute, holding one bit per result
+   * cell that is set to 1 if the cell is non-empty.
+   */
+  struct ValidityBuffer {
+    /** The bitmap buffer. */
+    uint8_t* buffer_;
+    /** The size (in bytes) of `buffer_`. */
+    uint64_t* buffer_size_;
+
+    /** Constructor. */
+    ValidityBuffer(uint8_t* buffer, uint64_t* buffer_size)
+        : buffer_(buffer)
+        , buffer_size_(buffer_size) {
+    }
+  };
+
   struct GlobalWriteState {
     /**
      * Stores the last tile of each attribute for each write operation.
@@ -104,6 +125,56 @@ class Query {
 
     /** The fragment metadata. */
     std::shared_ptr<FragmentMetadata> frag_meta_;
+
+    /**
+     * The maximum number of pending background tile writes. If it is 0,
+     * the full tiles are compressed and written in the submitting thread.
+     */
+    uint64_t queue_depth_ = 0;
+
+    /** The futures of the pending background tile writes, in order. */
+    std::queue<std::future<Status>> pending_writes_;
+
+    /**
+     * A single-threaded pool that compresses and writes the full tiles in
+     * the background, so that the tiles of every attribute are appended
+     * in submission order. It is `nullptr` if `queue_depth_` is 0. Declared
+     * last so that it is destroyed before the state its tasks refer to.
+     */
+    std::unique_ptr<ThreadPool> writer_;
+  };
+
+  /**
+   * The state of an unordered write that sorts its cells externally, which
+   * is the case when `sm.unordered_write_memory_budget` is not 0. The cells
+   * of each submission are serialized into records that are buffered in
+   * memory, and spilled to scratch storage as sorted runs. Each record
+   * consists of its size (`uint64_t`), the cell coordinates and the values
+   * of the rest of the attributes in the order of `attributes_`, where
+   * var-sized values are prefixed by their size (`uint64_t`). Records are
+   * padded to a multiple of 8 bytes, so that the coordinates are aligned.
+   */
+  struct UnorderedWriteState {
+    /** The memory budget (in bytes). */
+    uint64_t memory_budget_ = 0;
+
+    /**
+     * The cell size of each attribute in `attributes_`, which is
+     * `constants::var_size` for var-sized attributes.
+     */
+    std::vector<uint64_t> cell_sizes_;
+
+    /** The buffered records that have not been spilled yet. */
+    Buffer records_;
+
+    /** The offsets of the buffered records in `records_`. */
+    std::vector<uint64_t> record_offsets_;
+
+    /** The directory where the sorted runs are spilled. */
+    URI runs_dir_;
+
+    /** The URIs of the spilled sorted runs, in the order of creation. */
+    std::vector<URI> runs_;
   };
 
   /**
@@ -382,6 +453,18 @@ class Query {
       const std::string& attribute,
       const OverlappingCellRangeList& cell_ranges) const;
 
+  /**
+   * Fills the validity bitmaps set by the user for the query attributes
+   * from the input cell ranges. Each bit corresponds to a result cell and
+   * is set to 1 if the cell belongs to a non-empty range. The bitmap is
+   * computed once with whole ranges set at a time, and then copied to the
+   * rest of the validity buffers.
+   *
+   * @param cell_ranges The cell ranges to compute the bitmap from.
+   * @return Status
+   */
+  Status copy_validity(const OverlappingCellRangeList& cell_ranges) const;
+
   /**
    * Checks whether two hyper-rectangles overlap, and determines whether
    * the first rectangle contains the second.
@@ -468,6 +551,22 @@ class Query {
   /** Sets the query buffers. */
   void set_buffers(void** buffers, uint64_t* buffer_sizes);
 
+  /**
+   * Sets a validity bitmap buffer for an attribute of a dense read query.
+   * Upon a read, the buffer will hold one bit per result cell (least
+   * significant bit first), which is 1 if the cell is non-empty and 0 if
+   * it was filled with the empty (fill) value. The attribute must have
+   * been already set with `set_buffers`.
+   *
+   * @param attribute The attribute the bitmap refers to.
+   * @param buffer The bitmap buffer.
+   * @param buffer_size Initially the allocated size of `buffer`. After the
+   *     read, it holds the size of the useful bitmap bytes.
+   * @return Status
+   */
+  Status set_validity_buffer(
+      const std::string& attribute, uint8_t* buffer, uint64_t* buffer_size);
+
   /**
    * Sets the callback function and its data input that will be called
    * upon the completion of an asynchronous query.
@@ -475,6 +574,32 @@ class Query {
   void set_callback(
       const std::function<void(void*)>& callback, void* callback_data);
 
+  /**
+   * Sets whether the tiles a read query fetches from storage are inserted
+   * into the tile caches. It is `true` by default. Disabling it is useful
+   * for reads that touch each tile once (e.g., bulk exports), which would
+   * otherwise evict the tiles that other queries read frequently. Tiles
+   * already cached are still read from the caches, but are not promoted to
+   * their protected segments.
+   *
+   * @param cache_fill Whether the tiles are inserted into the caches.
+   * @return Status
+   */
+  Status set_cache_fill(bool cache_fill);
+
+  /**
+   * Sets how the cells with duplicate coordinates within a single unordered
+   * write are handled. By default, they are all stored in the fragment.
+   * Otherwise, they are collapsed into one cell right after sorting, which
+   * keeps the last of the duplicates. With a reduction (sum, min or max),
+   * each numeric fixed-sized attribute stores the reduction of the values
+   * of the duplicates instead. Integer sums wrap around on overflow.
+   *
+   * @param dedup The dedup mode.
+   * @return Status
+   */
+  Status set_dedup(Dedup dedup);
+
   /** Sets and initializes the fragment metadata. */
   Status set_fragment_metadata(
       const std::vector<FragmentMetadata*>& fragment_metadata);
@@ -501,6 +626,13 @@ class Query {
   /** Sets the query type. */
   void set_type(QueryType type);
 
+  /**
+   * Sets whether the cells of an unordered write are appended to the array
+   * write buffer (if `sm.write_buffer_size` is not 0) instead of being
+   * written to a new fragment. It is `true` by default.
+   */
+  void set_use_write_buffer(bool use_write_buffer);
+
   /** Returns the query status. */
   QueryStatus status() const;
 
@@ -521,6 +653,9 @@ class Query {
   /** The state associated with global writes. */
   std::unique_ptr<GlobalWriteState> global_write_state_;
 
+  /** The state associated with externally sorted unordered writes. */
+  std::unique_ptr<UnorderedWriteState> unordered_write_state_;
+
   /** The names of the attributes involved in the query. */
   std::vector<std::string> attributes_;
 
@@ -530,12 +665,18 @@ class Query {
   /** Maps attribute names to their buffers. */
   std::unordered_map<std::string, AttributeBuffer> attr_buffers_;
 
+  /** Maps attribute names to their validity bitmap buffers. */
+  std::unordered_map<std::string, ValidityBuffer> validity_buffers_;
+
   /** A function that will be called upon the completion of an async query. */
   std::function<void(void*)> callback_;
 
   /** The data input to the callback function. */
   void* callback_data_;
 
+  /** Whether the tiles read from storage are inserted into the caches. */
+  bool cache_fill_;
+
   /** The query status. */
   QueryStatus status_;
 
@@ -557,6 +698,12 @@ class Query {
   /** The query type. */
   QueryType type_;
 
+  /** How cells with duplicate coordinates are handled in unordered writes. */
+  Dedup dedup_;
+
+  /** Whether unordered writes are appended to the array write buffer. */
+  bool use_write_buffer_;
+
   /* ********************************* */
   /*           PRIVATE METHODS         */
   /* ********************************* */
@@ -698,12 +845,74 @@ class Query {
   template <class T>
   Status sort_coords(std::vector<uint64_t>* cell_pos) const;
 
+  /**
+   * Collapses the cells with duplicate coordinates of an unordered write,
+   * based on `dedup_`. The sorted cell positions are replaced by the
+   * positions of the last cells of the duplicates. In the case of a
+   * reduction, the reduced values of the numeric fixed-sized attributes
+   * are created in `reduced_buffers`, in the order of the collapsed cells.
+   *
+   * @tparam T The domain type.
+   * @param cell_pos The cell positions sorted in the global order.
+   * @param reduced_buffers The buffers of the reduced attribute values.
+   * @return Status
+   */
+  template <class T>
+  Status dedup_cells(
+      std::vector<uint64_t>* cell_pos,
+      std::unordered_map<std::string, std::vector<unsigned char>>*
+          reduced_buffers) const;
+
+  /**
+   * Reduces the values of an attribute over each run of cells with the same
+   * coordinates, based on `dedup_`.
+   *
+   * @tparam V The attribute type.
+   * @param attribute The attribute whose values are reduced.
+   * @param cell_pos The cell positions sorted in the global order.
+   * @param run_starts The index in `cell_pos` where each run starts,
+   *     followed by the number of cells.
+   * @param reduced The buffer of the reduced values, one cell per run.
+   * @return void
+   */
+  template <class V>
+  void reduce_cells(
+      const std::string& attribute,
+      const std::vector<uint64_t>& cell_pos,
+      const std::vector<uint64_t>& run_starts,
+      std::vector<unsigned char>* reduced) const;
+
   /** Initializes the global write state. */
   Status init_global_write_state();
 
   /** Finalizes the global write state. */
   Status finalize_global_write_state();
 
+  /**
+   * Deletes the state of an externally sorted unordered write, removing the
+   * spilled runs from scratch storage.
+   */
+  void clear_unordered_write_state();
+
+  /** Initializes the state of an externally sorted unordered write. */
+  Status init_unordered_write_state();
+
+  /**
+   * Finalizes the state of an externally sorted unordered write, merging
+   * all the buffered and spilled cells into a single fragment.
+   */
+  Status finalize_unordered_write_state();
+
+  /**
+   * Finalizes the state of an externally sorted unordered write, merging
+   * all the buffered and spilled cells into a single fragment.
+   *
+   * @tparam T The domain type.
+   * @return Status
+   */
+  template <class T>
+  Status finalize_unordered_write_state();
+
   /**
    * Finalizes the global write state.
    *
@@ -836,7 +1045,9 @@ class Query {
       const std::vector<Tile>& tiles, FragmentMetadata* meta) const;
 
   /**
-   * Writes the input tiles for the input attribute to storage.
+   * Writes the input tiles for the input attribute to storage. The tiles
+   * are compressed in parallel using the storage manager compute thread
+   * pool, and appended to the attribute files in their original order.
    *
    * @param attribute The attribute the tiles belong to.
    * @param frag_meta The fragment metadata.
@@ -906,6 +1117,29 @@ class Query {
   template <class T>
   Status global_write_handle_last_tile();
 
+  /**
+   * Applicable only to global writes. Computes the coordinates metadata
+   * (if applicable) and writes the input full tiles, which are given in
+   * the same order as `attributes_`.
+   *
+   * @tparam T The domain type.
+   * @param tiles The full tiles of each attribute.
+   * @return Status
+   */
+  template <class T>
+  Status global_write_tiles(std::vector<std::vector<Tile>>* tiles);
+
+  /**
+   * Applicable only to global writes. Waits for the oldest pending
+   * background tile writes to complete, until at most `max_pending`
+   * remain.
+   *
+   * @param max_pending The maximum number of writes left pending.
+   * @return Status The first error encountered, or `Ok` if all the waited
+   *     writes succeeded.
+   */
+  Status global_write_wait(uint64_t max_pending);
+
   /**
    * Writes an empty cell range to the input tile.
    * Applicable to **fixed-sized** attributes.
@@ -1001,6 +1235,74 @@ class Query {
   template <class T>
   Status unordered_write();
 
+  /**
+   * Serializes the cells of the user buffers into records, and appends them
+   * to the buffered records of the unordered write state. The buffered
+   * records are spilled as a sorted run if they exceed half the memory
+   * budget.
+   *
+   * @tparam T The domain type.
+   * @return Status
+   */
+  template <class T>
+  Status unordered_write_buffer();
+
+  /**
+   * Merges the buffered and spilled records of the unordered write state in
+   * the global order, and writes them in batches of half the memory budget
+   * through the global write path.
+   *
+   * @tparam T The domain type.
+   * @return Status
+   */
+  template <class T>
+  Status unordered_write_merge();
+
+  /**
+   * Appends a record to the per-attribute merge buffers, which have the
+   * layout of the user buffers.
+   *
+   * @param record The record to be appended.
+   * @param buffers The merge buffers, one (offsets, values) pair per
+   *     attribute in `attributes_`. The values buffer is used only for
+   *     var-sized attributes.
+   * @return Status
+   */
+  Status unordered_write_merge_record(
+      const unsigned char* record,
+      std::vector<std::pair<Buffer, Buffer>>* buffers) const;
+
+  /**
+   * Writes the per-attribute merge buffers through the global write path,
+   * and then resets them.
+   *
+   * @tparam T The domain type.
+   * @param buffers The merge buffers (see `unordered_write_merge_record`).
+   * @return Status
+   */
+  template <class T>
+  Status unordered_write_merge_flush(
+      std::vector<std::pair<Buffer, Buffer>>* buffers);
+
+  /**
+   * Sorts the buffered records of the unordered write state in the global
+   * order, by sorting `record_offsets_`.
+   *
+   * @tparam T The domain type.
+   */
+  template <class T>
+  void unordered_write_sort_records();
+
+  /**
+   * Sorts the buffered records of the unordered write state and writes
+   * them to scratch storage as a new run.
+   *
+   * @tparam T The domain type.
+   * @return Status
+   */
+  template <class T>
+  Status unordered_write_spill();
+
   /** Performs a read on a sparse array. */
   Status sparse_read();
 
@@ -1028,6 +1330,24 @@ class Query {
    */
   Status init_tile(const std::string& attribute, Tile* tile) const;
 
+  /**
+   * Initializes a fixed-sized tile that wraps a slice of a user buffer,
+   * without copying it. The tile must be written before the user buffer
+   * is released.
+   *
+   * @param attribute The attribute the tile belongs to. It cannot be the
+   *     coordinates.
+   * @param data The start of the slice.
+   * @param size The size of the slice in bytes.
+   * @param tile The tile to be initialized.
+   * @return Status
+   */
+  Status init_tile(
+      const std::string& attribute,
+      void* data,
+      uint64_t size,
+      Tile* tile) const;
+
   /**
    * Initializes a var-sized tile.
    *
@@ -154,10 +154,32 @@ Status Config::set(const std::string& param, const std::string& value) {
 
   if (param == "sm.tile_cache_size") {
     RETURN_NOT_OK(set_sm_tile_cache_size(value));
+  } else if (param == "sm.compressed_tile_cache_size") {
+    RETURN_NOT_OK(set_sm_compressed_tile_cache_size(value));
+  } else if (param == "sm.tile_cache_shard_num") {
+    RETURN_NOT_OK(set_sm_tile_cache_shard_num(value));
+  } else if (param == "sm.tile_cache_policy") {
+    RETURN_NOT_OK(set_sm_tile_cache_policy(value));
   } else if (param == "sm.array_schema_cache_size") {
     RETURN_NOT_OK(set_sm_array_schema_cache_size(value));
   } else if (param == "sm.fragment_metadata_cache_size") {
     RETURN_NOT_OK(set_sm_fragment_metadata_cache_size(value));
+  } else if (param == "sm.global_write_queue_depth") {
+    RETURN_NOT_OK(set_sm_global_write_queue_depth(value));
+  } else if (param == "sm.num_compute_threads") {
+    RETURN_NOT_OK(set_sm_num_compute_threads(value));
+  } else if (param == "sm.unordered_write_memory_budget") {
+    RETURN_NOT_OK(set_sm_unordered_write_memory_budget(value));
+  } else if (param == "sm.unordered_write_scratch_dir") {
+    RETURN_NOT_OK(set_sm_unordered_write_scratch_dir(value));
+  } else if (param == "sm.write_buffer_size") {
+    RETURN_NOT_OK(set_sm_write_buffer_size(value));
+  } else if (param == "sm.write_buffer_max_age_ms") {
+    RETURN_NOT_OK(set_sm_write_buffer_max_age_ms(value));
+  } else if (param == "sm.tile_chunk_size") {
+    RETURN_NOT_OK(set_sm_tile_chunk_size(value));
+  } else if (param == "sm.auto_compression_candidates") {
+    RETURN_NOT_OK(set_sm_auto_compression_candidates(value));
   } else if (param == "vfs.max_parallel_ops") {
     RETURN_NOT_OK(set_vfs_max_parallel_ops(value));
   } else if (param == "vfs.min_parallel_size") {
@@ -222,6 +244,22 @@ Status Config::unset(const std::string& param) {
     value << sm_params_.tile_cache_size_;
     param_values_["sm.tile_cache_size"] = value.str();
     value.str(std::string());
+  } else if (param == "sm.compressed_tile_cache_size") {
+    sm_params_.compressed_tile_cache_size_ =
+        constants::compressed_tile_cache_size;
+    value << sm_params_.compressed_tile_cache_size_;
+    param_values_["sm.compressed_tile_cache_size"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.tile_cache_shard_num") {
+    sm_params_.tile_cache_shard_num_ = constants::tile_cache_shard_num;
+    value << sm_params_.tile_cache_shard_num_;
+    param_values_["sm.tile_cache_shard_num"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.tile_cache_policy") {
+    sm_params_.tile_cache_policy_ = constants::tile_cache_policy;
+    value << sm_params_.tile_cache_policy_;
+    param_values_["sm.tile_cache_policy"] = value.str();
+    value.str(std::string());
   } else if (param == "sm.array_schema_cache_size") {
     sm_params_.array_schema_cache_size_ = constants::array_schema_cache_size;
     value << sm_params_.array_schema_cache_size_;
@@ -233,6 +271,49 @@ Status Config::unset(const std::string& param) {
     value << sm_params_.fragment_metadata_cache_size_;
     param_values_["sm.fragment_metadata_cache_size"] = value.str();
     value.str(std::string());
+  } else if (param == "sm.global_write_queue_depth") {
+    sm_params_.global_write_queue_depth_ = constants::global_write_queue_depth;
+    value << sm_params_.global_write_queue_depth_;
+    param_values_["sm.global_write_queue_depth"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.num_compute_threads") {
+    sm_params_.num_compute_threads_ = constants::num_compute_threads;
+    value << sm_params_.num_compute_threads_;
+    param_values_["sm.num_compute_threads"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.unordered_write_memory_budget") {
+    sm_params_.unordered_write_memory_budget_ =
+        constants::unordered_write_memory_budget;
+    value << sm_params_.unordered_write_memory_budget_;
+    param_values_["sm.unordered_write_memory_budget"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.unordered_write_scratch_dir") {
+    sm_params_.unordered_write_scratch_dir_ =
+        constants::unordered_write_scratch_dir;
+    value << sm_params_.unordered_write_scratch_dir_;
+    param_values_["sm.unordered_write_scratch_dir"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.write_buffer_size") {
+    sm_params_.write_buffer_size_ = constants::write_buffer_size;
+    value << sm_params_.write_buffer_size_;
+    param_values_["sm.write_buffer_size"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.write_buffer_max_age_ms") {
+    sm_params_.write_buffer_max_age_ms_ = constants::write_buffer_max_age_ms;
+    value << sm_params_.write_buffer_max_age_ms_;
+    param_values_["sm.write_buffer_max_age_ms"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.tile_chunk_size") {
+    sm_params_.tile_chunk_size_ = constants::tile_chunk_size;
+    value << sm_params_.tile_chunk_size_;
+    param_values_["sm.tile_chunk_size"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.auto_compression_candidates") {
+    sm_params_.auto_compression_candidates_ =
+        constants::auto_compression_candidates;
+    value << sm_params_.auto_compression_candidates_;
+    param_values_["sm.auto_compression_candidates"] = value.str();
+    value.str(std::string());
   } else if (param == "vfs.max_parallel_ops") {
     vfs_params_.max_parallel_ops_ = constants::vfs_max_parallel_ops;
     value << vfs_params_.max_parallel_ops_;
@@ -327,6 +408,18 @@ void Config::set_default_param_values() {
   param_values_["sm.tile_cache_size"] = value.str();
   value.str(std::string());
 
+  value << sm_params_.compressed_tile_cache_size_;
+  param_values_["sm.compressed_tile_cache_size"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.tile_cache_shard_num_;
+  param_values_["sm.tile_cache_shard_num"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.tile_cache_policy_;
+  param_values_["sm.tile_cache_policy"] = value.str();
+  value.str(std::string());
+
   value << sm_params_.array_schema_cache_size_;
   param_values_["sm.array_schema_cache_size"] = value.str();
   value.str(std::string());
@@ -335,6 +428,38 @@ void Config::set_default_param_values() {
   param_values_["sm.fragment_metadata_cache_size"] = value.str();
   value.str(std::string());
 
+  value << sm_params_.global_write_queue_depth_;
+  param_values_["sm.global_write_queue_depth"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.num_compute_threads_;
+  param_values_["sm.num_compute_threads"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.unordered_write_memory_budget_;
+  param_values_["sm.unordered_write_memory_budget"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.unordered_write_scratch_dir_;
+  param_values_["sm.unordered_write_scratch_dir"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.write_buffer_size_;
+  param_values_["sm.write_buffer_size"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.write_buffer_max_age_ms_;
+  param_values_["sm.write_buffer_max_age_ms"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.tile_chunk_size_;
+  param_values_["sm.tile_chunk_size"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.auto_compression_candidates_;
+  param_values_["sm.auto_compression_candidates"] = value.str();
+  value.str(std::string());
+
   value << vfs_params_.max_parallel_ops_;
   param_values_["vfs.max_parallel_ops"] = value.str();
   value.str(std::string());
@@ -430,6 +555,97 @@ Status Config::set_sm_tile_cache_size(const std::string& value) {
   return Status::Ok();
 }
 
+Status Config::set_sm_compressed_tile_cache_size(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.compressed_tile_cache_size_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_tile_cache_shard_num(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  if (v == 0)
+    return LOG_STATUS(Status::ConfigError(
+        "Cannot set parameter; The number of tile cache shards must be "
+        "positive"));
+  sm_params_.tile_cache_shard_num_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_tile_cache_policy(const std::string& value) {
+  if (value != "lru" && value != "slru")
+    return LOG_STATUS(Status::ConfigError(
+        "Cannot set parameter; Invalid tile cache policy"));
+  sm_params_.tile_cache_policy_ = value;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_global_write_queue_depth(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.global_write_queue_depth_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_num_compute_threads(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.num_compute_threads_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_unordered_write_memory_budget(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.unordered_write_memory_budget_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_unordered_write_scratch_dir(const std::string& value) {
+  sm_params_.unordered_write_scratch_dir_ = value;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_write_buffer_size(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.write_buffer_size_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_write_buffer_max_age_ms(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.write_buffer_max_age_ms_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_tile_chunk_size(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.tile_chunk_size_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_auto_compression_candidates(const std::string& value) {
+  std::vector<std::pair<Compressor, int>> v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.auto_compression_candidates_ = value;
+
+  return Status::Ok();
+}
+
 Status Config::set_vfs_max_parallel_ops(const std::string& value) {
   uint64_t v;
   RETURN_NOT_OK(utils::parse::convert(value, &v));
@@ -242,6 +242,9 @@ Status Consolidator::create_queries(
       buffers,
       buffer_sizes));
 
+  // The consolidated tiles are read only once, so they are not cached
+  RETURN_NOT_OK(query_r->set_cache_fill(false));
+
   // Get fragment num and terminate with success if it is <=1
   *fragment_num = query_r->fragment_num();
   if (*fragment_num <= 1)
@@ -32,6 +32,7 @@
  */
 
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <sstream>
 
@@ -56,20 +57,32 @@ namespace sm {
 StorageManager::StorageManager() {
   async_done_ = false;
   async_thread_ = nullptr;
+  compute_thread_pool_ = nullptr;
   consolidator_ = nullptr;
   array_schema_cache_ = nullptr;
   fragment_metadata_cache_ = nullptr;
   tile_cache_ = nullptr;
+  compressed_tile_cache_ = nullptr;
+  tile_chunk_size_ = constants::tile_chunk_size;
   vfs_ = nullptr;
 }
 
 StorageManager::~StorageManager() {
   async_stop();
+
+  // The write buffers are normally flushed by `tiledb_ctx_free`, which
+  // reports the errors
+  auto st = write_buffers_flush();
+  if (!st.ok())
+    LOG_STATUS(st);
+
   delete async_thread_;
+  delete compute_thread_pool_;
   delete array_schema_cache_;
   delete consolidator_;
   delete fragment_metadata_cache_;
   delete tile_cache_;
+  delete compressed_tile_cache_;
   delete vfs_;
   for (auto& open_array : open_arrays_)
     delete open_array.second;
@@ -412,10 +425,23 @@ Status StorageManager::async_push_query(Query* query) {
   return Status::Ok();
 }
 
+ThreadPool* StorageManager::compute_thread_pool() const {
+  return compute_thread_pool_;
+}
+
 Config StorageManager::config() const {
   return config_;
 }
 
+uint64_t StorageManager::tile_chunk_size() const {
+  return tile_chunk_size_;
+}
+
+const std::vector<std::pair<Compressor, int>>&
+StorageManager::auto_compression_candidates() const {
+  return auto_compression_candidates_;
+}
+
 Status StorageManager::create_dir(const URI& uri) {
   return vfs_->create_dir(uri);
 }
@@ -432,7 +458,9 @@ Status StorageManager::delete_fragment(const URI& uri) const {
         "Cannot delete fragment; '" + uri.to_string() +
         "' is not a TileDB fragment"));
   }
-  return vfs_->remove_dir(uri);
+  RETURN_NOT_OK(vfs_->remove_dir(uri));
+  invalidate_cache(uri);
+  return Status::Ok();
 }
 
 Status StorageManager::object_remove(const char* path) const {
@@ -448,7 +476,9 @@ Status StorageManager::object_remove(const char* path) const {
         std::string("Cannot remove object '") + path +
         "'; Invalid TileDB object"));
 
-  return vfs_->remove_dir(uri);
+  RETURN_NOT_OK(vfs_->remove_dir(uri));
+  invalidate_cache(uri);
+  return Status::Ok();
 }
 
 Status StorageManager::object_move(
@@ -470,7 +500,10 @@ Status StorageManager::object_move(
         std::string("Cannot move object '") + old_path +
         "'; Invalid TileDB object"));
 
-  return vfs_->move_dir(old_uri, new_uri);
+  RETURN_NOT_OK(vfs_->move_dir(old_uri, new_uri));
+  invalidate_cache(old_uri);
+  invalidate_cache(new_uri);
+  return Status::Ok();
 }
 
 Status StorageManager::group_create(const std::string& group) {
@@ -512,16 +545,47 @@ Status StorageManager::init(Config* config) {
     config_ = *config;
   consolidator_ = new Consolidator(this);
   Config::SMParams sm_params = config_.sm_params();
-  array_schema_cache_ = new LRUCache(sm_params.array_schema_cache_size_);
+  RETURN_NOT_OK(utils::parse::convert(
+      sm_params.auto_compression_candidates_, &auto_compression_candidates_));
+  tile_chunk_size_ = sm_params.tile_chunk_size_;
+  array_schema_cache_ =
+      new ShardedLRUCache(sm_params.array_schema_cache_size_, 1);
   fragment_metadata_cache_ =
-      new LRUCache(sm_params.fragment_metadata_cache_size_);
-  tile_cache_ = new LRUCache(sm_params.tile_cache_size_);
+      new ShardedLRUCache(sm_params.fragment_metadata_cache_size_, 1);
+  auto shard_num = (unsigned)sm_params.tile_cache_shard_num_;
+  auto policy = (sm_params.tile_cache_policy_ == "lru") ?
+                    LRUCache::Policy::LRU :
+                    LRUCache::Policy::SEGMENTED_LRU;
+  tile_cache_ = new ShardedLRUCache(
+      sm_params.tile_cache_size_, shard_num, nullptr, nullptr, policy);
+  compressed_tile_cache_ = new ShardedLRUCache(
+      sm_params.compressed_tile_cache_size_,
+      shard_num,
+      nullptr,
+      nullptr,
+      policy);
+  compute_thread_pool_ =
+      new ThreadPool(std::max<uint64_t>(1, sm_params.num_compute_threads_));
   async_thread_ = new std::thread(async_start, this);
   vfs_ = new VFS();
   RETURN_NOT_OK(vfs_->init(config_.vfs_params()));
   return Status::Ok();
 }
 
+void StorageManager::invalidate_cache(const URI& uri) const {
+  // The cache keys start with the URIs of the files the objects belong to
+  auto prefix = uri.to_string();
+  if (!prefix.empty() && prefix.back() == '/')
+    prefix.pop_back();
+  for (auto cache : {array_schema_cache_,
+                     fragment_metadata_cache_,
+                     tile_cache_,
+                     compressed_tile_cache_}) {
+    if (cache != nullptr)
+      cache->invalidate(prefix);
+  }
+}
+
 Status StorageManager::is_array(const URI& uri, bool* is_array) const {
   RETURN_NOT_OK(
       vfs_->is_file(uri.join_path(constants::array_schema_filename), is_array));
@@ -602,7 +666,8 @@ Status StorageManager::load_array_schema(
   }
 
   // Store in cache
-  if (st.ok() && !in_cache && buff->size() <= array_schema_cache_->max_size()) {
+  if (st.ok() && !in_cache &&
+      buff->size() <= array_schema_cache_->max_object_size()) {
     buff->disown_data();
     st = array_schema_cache_->insert(
         schema_uri.to_string(), buff->data(), buff->size());
@@ -653,7 +718,7 @@ Status StorageManager::load_fragment_metadata(
 
   // Store in cache
   if (st.ok() && !in_cache &&
-      buff->size() <= fragment_metadata_cache_->max_size()) {
+      buff->size() <= fragment_metadata_cache_->max_object_size()) {
     buff->disown_data();
     st = fragment_metadata_cache_->insert(
         fragment_metadata_uri.to_string(), buff->data(), buff->size());
@@ -928,18 +993,25 @@ Status StorageManager::query_submit_async(
 Status StorageManager::read_from_cache(
     const URI& uri,
     uint64_t offset,
-    Buffer* buffer,
-    uint64_t nbytes,
-    bool* in_cache) const {
-  std::stringstream key;
-  key << uri.to_string() << "+" << offset;
-  RETURN_NOT_OK(buffer->realloc(nbytes));
-  RETURN_NOT_OK(
-      tile_cache_->read(key.str(), buffer->data(), 0, nbytes, in_cache));
-  buffer->set_size(nbytes);
-  buffer->reset_offset();
+    std::shared_ptr<Buffer>* buffer,
+    bool* in_cache,
+    bool promote) const {
+  return tile_cache_->read_shared(
+      cache_key(uri, offset), buffer, in_cache, promote);
+}
 
-  return Status::Ok();
+Status StorageManager::read_from_compressed_cache(
+    const URI& uri,
+    uint64_t offset,
+    std::shared_ptr<Buffer>* buffer,
+    bool* in_cache,
+    bool promote) const {
+  return compressed_tile_cache_->read_shared(
+      cache_key(uri, offset), buffer, in_cache, promote);
+}
+
+uint64_t StorageManager::compressed_cache_max_size() const {
+  return compressed_tile_cache_->max_object_size();
 }
 
 Status StorageManager::read(
@@ -1041,37 +1113,128 @@ VFS* StorageManager::vfs() const {
 }
 
 Status StorageManager::write_to_cache(
-    const URI& uri, uint64_t offset, Buffer* buffer) const {
-  // Do nothing if the object size is larger than the cache size
-  uint64_t object_size = buffer->size();
-  if (object_size > tile_cache_->max_size())
-    return Status::Ok();
+    const URI& uri,
+    uint64_t offset,
+    const std::shared_ptr<Buffer>& buffer,
+    bool overwrite) const {
+  return cache_insert(tile_cache_, uri, offset, buffer, overwrite);
+}
 
-  // Do not write metadata to cache
-  std::string filename = uri.last_path_part();
-  if (filename == constants::fragment_metadata_filename ||
-      filename == constants::array_schema_filename ||
-      filename == constants::kv_schema_filename) {
-    return Status::Ok();
-  }
+Status StorageManager::write_to_compressed_cache(
+    const URI& uri,
+    uint64_t offset,
+    const std::shared_ptr<Buffer>& buffer,
+    bool overwrite) const {
+  return cache_insert(compressed_tile_cache_, uri, offset, buffer, overwrite);
+}
 
-  // Generate key (uri + offset)
-  std::stringstream key;
-  key << uri.to_string() << "+" << offset;
+Status StorageManager::write(const URI& uri, Buffer* buffer) const {
+  return vfs_->write(uri, buffer->data(), buffer->size());
+}
 
-  // Insert to cache
-  void* object = std::malloc(object_size);
-  if (object == nullptr)
+Status StorageManager::write_buffer_append(
+    const ArraySchema* array_schema,
+    const std::vector<std::string>& attributes,
+    void** buffers,
+    const uint64_t* buffer_sizes) {
+  auto array_uri = array_schema->array_uri().to_string();
+  auto sm_params = config_.sm_params();
+
+  // Report a failed flush of previously buffered cells to the writer
+  write_buffers_mtx_.lock();
+  auto err = write_buffer_errors_.find(array_uri);
+  if (err != write_buffer_errors_.end()) {
+    auto st = err->second;
+    write_buffer_errors_.erase(err);
+    write_buffers_mtx_.unlock();
     return LOG_STATUS(Status::StorageManagerError(
-        "Cannot write to cache; Object memory allocation failed"));
-  std::memcpy(object, buffer->data(), object_size);
-  RETURN_NOT_OK(tile_cache_->insert(key.str(), object, object_size, false));
+        "Cannot buffer write; Previously buffered cells were lost: " +
+        st.message()));
+  }
+  auto it = write_buffers_.find(array_uri);
+  if (it == write_buffers_.end())
+    it = write_buffers_
+             .emplace(
+                 array_uri,
+                 std::make_shared<WriteBuffer>(array_schema, attributes))
+             .first;
+  auto write_buffer = it->second;
+  write_buffers_mtx_.unlock();
+
+  // Only the write buffer of this array is locked from now on. The buffered
+  // cells are flushed first if they were written to other attributes
+  write_buffer->mtx_lock();
+  auto st = Status::Ok();
+  if (write_buffer->attributes() != attributes) {
+    st = write_buffer_flush(array_uri, write_buffer.get());
+    write_buffer->set_attributes(array_schema, attributes);
+  }
 
-  return Status::Ok();
+  // Buffer the cells and flush them if a threshold is exceeded
+  if (st.ok())
+    st = write_buffer->append(buffers, buffer_sizes);
+  auto max_age_ms = sm_params.write_buffer_max_age_ms_;
+  if (st.ok() &&
+      (write_buffer->size() >= sm_params.write_buffer_size_ ||
+       (max_age_ms > 0 &&
+        utils::timestamp_ms() - write_buffer->first_append_ms() >=
+            max_age_ms)))
+    st = write_buffer_flush(array_uri, write_buffer.get());
+  write_buffer->mtx_unlock();
+
+  return st;
 }
 
-Status StorageManager::write(const URI& uri, Buffer* buffer) const {
-  return vfs_->write(uri, buffer->data(), buffer->size());
+Status StorageManager::write_buffer_flush(const URI& array_uri) {
+  write_buffers_mtx_.lock();
+  auto it = write_buffers_.find(array_uri.to_string());
+  if (it == write_buffers_.end()) {
+    write_buffers_mtx_.unlock();
+    return Status::Ok();
+  }
+  auto write_buffer = it->second;
+  write_buffers_mtx_.unlock();
+
+  // The error is also reported to the next writer of the array
+  write_buffer->mtx_lock();
+  auto st = write_buffer_flush(array_uri.to_string(), write_buffer.get());
+  if (!st.ok()) {
+    std::unique_lock<std::mutex> lck(write_buffers_mtx_);
+    write_buffer_errors_[array_uri.to_string()] = st;
+  }
+  write_buffer->mtx_unlock();
+
+  return st;
+}
+
+Status StorageManager::write_buffers_flush() {
+  write_buffers_mtx_.lock();
+  auto write_buffers = std::move(write_buffers_);
+  write_buffers_.clear();
+  write_buffers_mtx_.unlock();
+
+  // Flush all buffers, returning the first error
+  auto st = Status::Ok();
+  for (auto& write_buffer : write_buffers) {
+    write_buffer.second->mtx_lock();
+    auto st_flush =
+        write_buffer_flush(write_buffer.first, write_buffer.second.get());
+    write_buffer.second->mtx_unlock();
+    if (st.ok())
+      st = st_flush;
+  }
+
+  // Report the errors that no writer received
+  std::unique_lock<std::mutex> lck(write_buffers_mtx_);
+  for (auto& err : write_buffer_errors_) {
+    if (st.ok())
+      st = LOG_STATUS(Status::StorageManagerError(
+          "Cannot flush write buffer; Buffered cells were lost: " +
+          err.second.message()));
+  }
+  write_buffer_errors_.clear();
+
+  return st;
 }
 
 /* ****************************** */
@@ -1196,6 +1359,10 @@ Status StorageManager::array_open(
         Status::StorageManagerError("Cannot open array; Array does not exist"));
   }
 
+  // Reads must see the buffered cells of previous writes
+  if (type == QueryType::READ)
+    RETURN_NOT_OK(write_buffer_flush(array_uri));
+
   // Lock the array in shared mode
   RETURN_NOT_OK(object_lock(array_uri, SLOCK));
 
@@ -1250,16 +1417,33 @@ void StorageManager::async_process_query(Query* query) {
 }
 
 void StorageManager::async_process_queries() {
+  // With a maximum write buffer age, the thread also wakes up to flush the
+  // expired write buffers
+  auto sm_params = config_.sm_params();
+  auto max_age_ms = (sm_params.write_buffer_size_ > 0) ?
+                        sm_params.write_buffer_max_age_ms_ :
+                        0;
+  uint64_t wait_ms = max_age_ms;
+
   while (!async_done_) {
     std::unique_lock<std::mutex> lock(async_mtx_);
-    async_cv_.wait(
-        lock, [this] { return !async_queue_.empty() || async_done_; });
+    auto ready = [this] { return !async_queue_.empty() || async_done_; };
+    if (max_age_ms > 0)
+      async_cv_.wait_for(lock, std::chrono::milliseconds(wait_ms), ready);
+    else
+      async_cv_.wait(lock, ready);
     if (async_done_)
       break;
-    auto query = async_queue_.front();
-    async_queue_.pop();
+    Query* query = nullptr;
+    if (!async_queue_.empty()) {
+      query = async_queue_.front();
+      async_queue_.pop();
+    }
     lock.unlock();
-    async_process_query(query);
+    if (query != nullptr)
+      async_process_query(query);
+    if (max_age_ms > 0)
+      wait_ms = write_buffers_flush_expired(max_age_ms);
   }
 }
 
@@ -1267,6 +1451,38 @@ void StorageManager::async_start(StorageManager* storage_manager) {
   storage_manager->async_process_queries();
 }
 
+Status StorageManager::cache_insert(
+    ShardedLRUCache* cache,
+    const URI& uri,
+    uint64_t offset,
+    const std::shared_ptr<Buffer>& buffer,
+    bool overwrite) const {
+  // Do nothing if the object size is larger than the cache size
+  if (buffer->size() > cache->max_object_size())
+    return Status::Ok();
+
+  // Do not write metadata to cache
+  std::string filename = uri.last_path_part();
+  if (filename == constants::fragment_metadata_filename ||
+      filename == constants::array_schema_filename ||
+      filename == constants::kv_schema_filename) {
+    return Status::Ok();
+  }
+
+  // Insert to cache (the cache shares the buffer, without copying it).
+  // Unless it is known to be stale, a cached object with the same key is
+  // identical, so it is kept along with its segment, e.g., after
+  // concurrent misses on the same tile
+  return cache->insert(cache_key(uri, offset), buffer, overwrite);
+}
+
+std::string StorageManager::cache_key(const URI& uri, uint64_t offset) {
+  // Generate key (uri + offset)
+  std::stringstream key;
+  key << uri.to_string() << "+" << offset;
+  return key.str();
+}
+
 void StorageManager::async_stop() {
   if (async_thread_ == nullptr)
     return;
@@ -1276,6 +1492,80 @@ void StorageManager::async_stop() {
   async_thread_->join();
 }
 
+uint64_t StorageManager::write_buffers_flush_expired(uint64_t max_age_ms) {
+  write_buffers_mtx_.lock();
+  auto write_buffers = write_buffers_;
+  write_buffers_mtx_.unlock();
+
+  // Each buffer is locked only while it is checked and flushed
+  auto wait_ms = max_age_ms;
+  for (auto& write_buffer : write_buffers) {
+    auto buffer = write_buffer.second;
+    buffer->mtx_lock();
+    if (buffer->empty()) {
+      buffer->mtx_unlock();
+      continue;
+    }
+    auto age_ms = utils::timestamp_ms() - buffer->first_append_ms();
+    if (age_ms < max_age_ms) {
+      wait_ms = std::min(wait_ms, max_age_ms - age_ms);
+      buffer->mtx_unlock();
+      continue;
+    }
+
+    // The error is reported to the next writer of the array
+    auto st = write_buffer_flush(write_buffer.first, buffer.get());
+    if (!st.ok()) {
+      std::unique_lock<std::mutex> lck(write_buffers_mtx_);
+      write_buffer_errors_[write_buffer.first] = st;
+    }
+    buffer->mtx_unlock();
+  }
+
+  return wait_ms;
+}
+
+Status StorageManager::write_buffer_flush(
+    const std::string& array_uri, WriteBuffer* write_buffer) {
+  if (write_buffer->empty())
+    return Status::Ok();
+
+  // Write the buffered cells with an unordered write query that bypasses
+  // the write buffers
+  std::vector<const char*> attributes;
+  for (const auto& attr : write_buffer->attributes())
+    attributes.push_back(attr.c_str());
+  std::vector<void*> buffers;
+  std::vector<uint64_t> buffer_sizes;
+  write_buffer->get_buffers(&buffers, &buffer_sizes);
+  Query query;
+  query.set_use_write_buffer(false);
+  auto st = query_init(
+      &query,
+      array_uri.c_str(),
+      QueryType::WRITE,
+      Layout::UNORDERED,
+      nullptr,
+      &attributes[0],
+      (unsigned)attributes.size(),
+      &buffers[0],
+      &buffer_sizes[0]);
+  if (st.ok()) {
+    st = query.init();
+    if (st.ok())
+      st = query.process();
+    auto st_finalize = query_finalize(&query);
+    if (st.ok())
+      st = st_finalize;
+  }
+
+  // The cells are discarded even if the flush failed, so that the error is
+  // reported once instead of failing every later flush
+  write_buffer->clear();
+
+  return st;
+}
+
 Status StorageManager::get_fragment_uris(
     const URI& array_uri, std::vector<URI>* fragment_uris) const {
   // Get all uris in the array directory
@@ -38,23 +38,26 @@
 #include <functional>
 #include <list>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <string>
 #include <thread>
 
 #include "tiledb/sm/array_schema/array_schema.h"
-#include "tiledb/sm/cache/lru_cache.h"
+#include "tiledb/sm/cache/sharded_lru_cache.h"
 #include "tiledb/sm/enums/object_type.h"
 #include "tiledb/sm/enums/walk_order.h"
 #include "tiledb/sm/filesystem/vfs.h"
 #include "tiledb/sm/misc/status.h"
+#include "tiledb/sm/misc/thread_pool.h"
 #include "tiledb/sm/misc/uri.h"
 #include "tiledb/sm/query/query.h"
 #include "tiledb/sm/storage_manager/config.h"
 #include "tiledb/sm/storage_manager/consolidator.h"
 #include "tiledb/sm/storage_manager/locked_object.h"
 #include "tiledb/sm/storage_manager/open_array.h"
+#include "tiledb/sm/storage_manager/write_buffer.h"
 
 namespace tiledb {
 namespace sm {
@@ -203,9 +206,29 @@ class StorageManager {
    */
   Status async_push_query(Query* query);
 
+  /**
+   * Returns the thread pool used for CPU-bound tasks, such as compressing
+   * tiles.
+   */
+  ThreadPool* compute_thread_pool() const;
+
   /** Returns the configuration parameters. */
   Config config() const;
 
+  /**
+   * Returns the maximum size of the chunks a tile is split into upon
+   * compression (the `sm.tile_chunk_size` config parameter).
+   */
+  uint64_t tile_chunk_size() const;
+
+  /**
+   * Returns the candidate compressors (with their levels) that the
+   * `AUTO_COMPRESSION` compressor picks from for every chunk (the
+   * `sm.auto_compression_candidates` config parameter).
+   */
+  const std::vector<std::pair<Compressor, int>>& auto_compression_candidates()
+      const;
+
   /** Creates a directory with the input URI. */
   Status create_dir(const URI& uri);
 
@@ -234,6 +257,15 @@ class StorageManager {
    */
   Status init(Config* config);
 
+  /**
+   * Removes from the caches all the objects of the input file, or of the
+   * files under the input directory, e.g., upon their removal. Objects of
+   * other files whose URI starts with the input URI may be removed as well.
+   *
+   * @param uri The URI of the file or directory.
+   */
+  void invalidate_cache(const URI& uri) const;
+
   /**
    * Checks if the input URI represents an array.
    *
@@ -464,19 +496,34 @@ class StorageManager {
    *
    * @param uri The URI of the cached object.
    * @param offset The offset of the cached object.
-   * @param buffer The buffer to write into. The function reallocates memory
-   *     for the buffer, sets its size to *nbytes* and resets its offset.
-   * @param nbytes Number of bytes to be read.
+   * @param buffer Set to the cached buffer, which is shared with the cache
+   *     (no data is copied) and must not be modified.
    * @param in_cache This is set to `true` if the object is in the cache,
    *     and `false` otherwise.
+   * @param promote If `false`, the object is not promoted to the protected
+   *     segment of a segmented LRU cache (see `LRUCache::read_shared`).
    * @return Status.
    */
   Status read_from_cache(
       const URI& uri,
       uint64_t offset,
-      Buffer* buffer,
-      uint64_t nbytes,
-      bool* in_cache) const;
+      std::shared_ptr<Buffer>* buffer,
+      bool* in_cache,
+      bool promote = true) const;
+
+  /**
+   * Same as `read_from_cache`, but for the compressed tile cache, which
+   * holds tiles as they are stored (i.e., compressed and/or filtered).
+   */
+  Status read_from_compressed_cache(
+      const URI& uri,
+      uint64_t offset,
+      std::shared_ptr<Buffer>* buffer,
+      bool* in_cache,
+      bool promote = true) const;
+
+  /** Returns the maximum size of an object in the compressed tile cache. */
+  uint64_t compressed_cache_max_size() const;
 
   /**
    * Reads from a file into the input buffer.
@@ -525,10 +572,28 @@ class StorageManager {
    *
    * @param uri The URI of the cached object.
    * @param offset The offset of the cached object.
-   * @param buffer The buffer whose contents will be cached.
+   * @param buffer The buffer to be cached. The cache shares the buffer
+   *     instead of copying its contents, so it must not be modified after
+   *     this call.
+   * @param overwrite If `true`, an object cached with the same key is
+   *     replaced (e.g., because it is stale). Otherwise, it is kept.
    * @return Status.
    */
-  Status write_to_cache(const URI& uri, uint64_t offset, Buffer* buffer) const;
+  Status write_to_cache(
+      const URI& uri,
+      uint64_t offset,
+      const std::shared_ptr<Buffer>& buffer,
+      bool overwrite = false) const;
+
+  /**
+   * Same as `write_to_cache`, but for the compressed tile cache, which
+   * holds tiles as they are stored (i.e., compressed and/or filtered).
+   */
+  Status write_to_compressed_cache(
+      const URI& uri,
+      uint64_t offset,
+      const std::shared_ptr<Buffer>& buffer,
+      bool overwrite = false) const;
 
   /**
    * Writes the contents of a buffer into a URI file.
@@ -539,13 +604,55 @@ class StorageManager {
    */
   Status write(const URI& uri, Buffer* buffer) const;
 
+  /**
+   * Appends the cells of an unordered write to the write buffer of the
+   * array. The buffer is flushed into a new fragment if it exceeds the
+   * `sm.write_buffer_size` or `sm.write_buffer_max_age_ms` thresholds,
+   * or if the cells are written to a different set of attributes than
+   * the buffered cells. If an earlier flush of the array that was not
+   * triggered by a writer failed (e.g., upon opening the array for
+   * reading), its error is returned instead and the cells are not
+   * buffered.
+   *
+   * @param array_schema The array schema.
+   * @param attributes The attributes the cells are written to.
+   * @param buffers The user buffers, one per fixed-sized attribute and two
+   *     per var-sized attribute, in the order of `attributes`.
+   * @param buffer_sizes The sizes (in bytes) of `buffers`.
+   * @return Status
+   */
+  Status write_buffer_append(
+      const ArraySchema* array_schema,
+      const std::vector<std::string>& attributes,
+      void** buffers,
+      const uint64_t* buffer_sizes);
+
+  /**
+   * Flushes the write buffer of an array (if any) into a new fragment. The
+   * buffered cells are discarded if the flush fails, and the error is also
+   * returned to the next writer of the array.
+   *
+   * @param array_uri The array URI.
+   * @return Status
+   */
+  Status write_buffer_flush(const URI& array_uri);
+
+  /**
+   * Flushes the write buffers of all arrays and deletes them. It returns
+   * the first flush error, including the errors of earlier flushes that
+   * were not returned to any writer.
+   *
+   * @return Status
+   */
+  Status write_buffers_flush();
+
  private:
   /* ********************************* */
   /*        PRIVATE ATTRIBUTES         */
   /* ********************************* */
 
   /** An array schema cache. */
-  LRUCache* array_schema_cache_;
+  ShardedLRUCache* array_schema_cache_;
 
   /** Mutex for providing thread-safety upon creating TileDB objects. */
   std::mutex object_create_mtx_;
@@ -565,14 +672,23 @@ class StorageManager {
   /** Thread that handles all async queries. */
   std::thread* async_thread_;
 
+  /** Thread pool for CPU-bound tasks, such as compressing tiles. */
+  ThreadPool* compute_thread_pool_;
+
   /** Stores the TileDB configuration parameters. */
   Config config_;
 
+  /** The parsed `sm.auto_compression_candidates` config parameter. */
+  std::vector<std::pair<Compressor, int>> auto_compression_candidates_;
+
+  /** The `sm.tile_chunk_size` config parameter. */
+  uint64_t tile_chunk_size_;
+
   /** Object that handles array consolidation. */
   Consolidator* consolidator_;
 
   /** A fragment metadata cache. */
-  LRUCache* fragment_metadata_cache_;
+  ShardedLRUCache* fragment_metadata_cache_;
 
   /** Used for object shared and exclusive locking. */
   std::mutex locked_object_mtx_;
@@ -593,7 +709,14 @@ class StorageManager {
   std::map<std::string, OpenArray*> open_arrays_;
 
   /** A tile cache. */
-  LRUCache* tile_cache_;
+  ShardedLRUCache* tile_cache_;
+
+  /**
+   * A cache of tiles as they are stored (i.e., compressed and/or filtered),
+   * backing `tile_cache_`. It is larger than `tile_cache_` in the number of
+   * tiles it holds, and its hits still save the reads from storage.
+   */
+  ShardedLRUCache* compressed_tile_cache_;
 
   /**
    * Virtual filesystem handler. It directs queries to the appropriate
@@ -601,10 +724,46 @@ class StorageManager {
    */
   VFS* vfs_;
 
+  /**
+   * Mutex for accessing `write_buffers_` and `write_buffer_errors_`. A
+   * write buffer is appended to and flushed under its own mutex, which is
+   * always locked before this one.
+   */
+  std::mutex write_buffers_mtx_;
+
+  /** The write buffers, indexed by array URI string. */
+  std::map<std::string, std::shared_ptr<WriteBuffer>> write_buffers_;
+
+  /**
+   * The errors of the failed write buffer flushes that were not triggered
+   * by a writer, indexed by array URI string. Each is returned to the next
+   * writer of the array.
+   */
+  std::map<std::string, Status> write_buffer_errors_;
+
   /* ********************************* */
   /*         PRIVATE METHODS           */
   /* ********************************* */
 
+  /**
+   * Flushes the write buffers that are older than `max_age_ms`.
+   *
+   * @param max_age_ms The maximum write buffer age.
+   * @return The time (in ms) until the next write buffer expires.
+   */
+  uint64_t write_buffers_flush_expired(uint64_t max_age_ms);
+
+  /**
+   * Flushes a write buffer into a new fragment of its array, clearing it
+   * even if the flush fails. The caller must hold the write buffer mutex.
+   *
+   * @param array_uri The array URI.
+   * @param write_buffer The write buffer to be flushed.
+   * @return Status
+   */
+  Status write_buffer_flush(
+      const std::string& array_uri, WriteBuffer* write_buffer);
+
   /** Closes an array. */
   Status array_close(URI array);
 
@@ -660,6 +819,27 @@ class StorageManager {
   /** Starts handling async queries. */
   void async_process_queries();
 
+  /**
+   * Inserts a buffer into the input tile cache, without copying it. Objects
+   * larger than the cache and the array and fragment metadata are skipped.
+   *
+   * @param cache The cache to insert into.
+   * @param uri The URI of the cached object.
+   * @param offset The offset of the cached object.
+   * @param buffer The buffer to be cached.
+   * @param overwrite Whether to replace an object cached with the same key.
+   * @return Status.
+   */
+  Status cache_insert(
+      ShardedLRUCache* cache,
+      const URI& uri,
+      uint64_t offset,
+      const std::shared_ptr<Buffer>& buffer,
+      bool overwrite) const;
+
+  /** Returns the key of the cached object at `offset` in file `uri`. */
+  static std::string cache_key(const URI& uri, uint64_t offset);
+
   /** Retrieves all the fragment URI's of an array. */
   Status get_fragment_uris(
       const URI& array_uri, std::vector<URI>* fragment_uris) const;
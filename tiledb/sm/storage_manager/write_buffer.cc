@@ -0,0 +1,139 @@
+/**
+ * @file   write_buffer.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ * @copyright Copyright (c) 2016 MIT and Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements the WriteBuffer class.
+ */
+
+#include "tiledb/sm/storage_manager/write_buffer.h"
+#include "tiledb/sm/misc/utils.h"
+
+namespace tiledb {
+namespace sm {
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+WriteBuffer::WriteBuffer(
+    const ArraySchema* array_schema,
+    const std::vector<std::string>& attributes) {
+  first_append_ms_ = 0;
+  set_attributes(array_schema, attributes);
+}
+
+WriteBuffer::~WriteBuffer() = default;
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status WriteBuffer::append(void** buffers, const uint64_t* buffer_sizes) {
+  if (empty())
+    first_append_ms_ = utils::timestamp_ms();
+
+  auto buffer_num = buffers_.size();
+  for (size_t b = 0; b < buffer_num; ++b) {
+    // Shift the offsets of var-sized cells past the already buffered values
+    if (offsets_[b]) {
+      auto offsets = (const uint64_t*)buffers[b];
+      auto offset_num = buffer_sizes[b] / sizeof(uint64_t);
+      auto shift = buffers_[b + 1].size();
+      for (uint64_t i = 0; i < offset_num; ++i) {
+        uint64_t offset = offsets[i] + shift;
+        RETURN_NOT_OK(buffers_[b].write(&offset, sizeof(uint64_t)));
+      }
+    } else {
+      RETURN_NOT_OK(buffers_[b].write(buffers[b], buffer_sizes[b]));
+    }
+  }
+
+  return Status::Ok();
+}
+
+const std::vector<std::string>& WriteBuffer::attributes() const {
+  return attributes_;
+}
+
+void WriteBuffer::get_buffers(
+    std::vector<void*>* buffers, std::vector<uint64_t>* buffer_sizes) const {
+  buffers->clear();
+  buffer_sizes->clear();
+  for (const auto& buffer : buffers_) {
+    buffers->push_back(buffer.data());
+    buffer_sizes->push_back(buffer.size());
+  }
+}
+
+void WriteBuffer::clear() {
+  for (auto& buffer : buffers_)
+    buffer.clear();
+  first_append_ms_ = 0;
+}
+
+bool WriteBuffer::empty() const {
+  return buffers_.empty() || buffers_[0].size() == 0;
+}
+
+uint64_t WriteBuffer::first_append_ms() const {
+  return first_append_ms_;
+}
+
+void WriteBuffer::mtx_lock() {
+  mtx_.lock();
+}
+
+void WriteBuffer::mtx_unlock() {
+  mtx_.unlock();
+}
+
+void WriteBuffer::set_attributes(
+    const ArraySchema* array_schema,
+    const std::vector<std::string>& attributes) {
+  attributes_ = attributes;
+  offsets_.clear();
+  for (const auto& attr : attributes_) {
+    auto var_size = array_schema->var_size(attr);
+    offsets_.push_back(var_size);
+    if (var_size)
+      offsets_.push_back(false);
+  }
+  buffers_.clear();
+  buffers_.resize(offsets_.size());
+}
+
+uint64_t WriteBuffer::size() const {
+  uint64_t size = 0;
+  for (const auto& buffer : buffers_)
+    size += buffer.size();
+  return size;
+}
+
+}  // namespace sm
+}  // namespace tiledb
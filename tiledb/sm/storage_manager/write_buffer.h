@@ -0,0 +1,168 @@
+/**
+ * @file   write_buffer.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ * @copyright Copyright (c) 2016 MIT and Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class WriteBuffer.
+ */
+
+#ifndef TILEDB_WRITE_BUFFER_H
+#define TILEDB_WRITE_BUFFER_H
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/misc/status.h"
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * An in-memory buffer that absorbs the cells of small unordered writes to
+ * an array, so that they can be flushed into a single fragment. The cells
+ * are appended in the layout of the user buffers, i.e., one buffer per
+ * fixed-sized attribute and an (offsets, values) buffer pair per var-sized
+ * attribute, in the order of the buffered attributes.
+ */
+class WriteBuffer {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param array_schema The schema of the array the cells are written to.
+   * @param attributes The attributes of the buffered cells, which must
+   *     include the coordinates.
+   */
+  WriteBuffer(
+      const ArraySchema* array_schema,
+      const std::vector<std::string>& attributes);
+
+  /** Destructor. */
+  ~WriteBuffer();
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Appends cells to the write buffer.
+   *
+   * @param buffers The user buffers, one per fixed-sized attribute and two
+   *     per var-sized attribute, in the order of the buffered attributes.
+   * @param buffer_sizes The sizes (in bytes) of `buffers`.
+   * @return Status
+   */
+  Status append(void** buffers, const uint64_t* buffer_sizes);
+
+  /** Returns the attributes of the buffered cells. */
+  const std::vector<std::string>& attributes() const;
+
+  /**
+   * Retrieves the buffers of the buffered cells, in the format expected by
+   * `Query::set_buffers`. They remain valid until the next `append` or
+   * `clear`.
+   *
+   * @param buffers The buffers to be retrieved.
+   * @param buffer_sizes The buffer sizes to be retrieved.
+   */
+  void get_buffers(
+      std::vector<void*>* buffers, std::vector<uint64_t>* buffer_sizes) const;
+
+  /** Discards the buffered cells. */
+  void clear();
+
+  /** Returns `true` if there are no buffered cells. */
+  bool empty() const;
+
+  /**
+   * Returns the timestamp (in ms) of the first append after the buffer was
+   * created or cleared.
+   */
+  uint64_t first_append_ms() const;
+
+  /** Locks the write buffer mutex. */
+  void mtx_lock();
+
+  /** Unlocks the write buffer mutex. */
+  void mtx_unlock();
+
+  /**
+   * Sets the attributes of the buffered cells. The buffer must be empty.
+   *
+   * @param array_schema The schema of the array the cells are written to.
+   * @param attributes The attributes of the buffered cells, which must
+   *     include the coordinates.
+   */
+  void set_attributes(
+      const ArraySchema* array_schema,
+      const std::vector<std::string>& attributes);
+
+  /** Returns the total size (in bytes) of the buffered cells. */
+  uint64_t size() const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The attributes of the buffered cells. */
+  std::vector<std::string> attributes_;
+
+  /**
+   * One buffer per fixed-sized attribute and an (offsets, values) buffer
+   * pair per var-sized attribute, in the order of `attributes_`.
+   */
+  std::vector<Buffer> buffers_;
+
+  /** The timestamp (in ms) of the first append. */
+  uint64_t first_append_ms_;
+
+  /**
+   * A mutex used to lock the write buffer while cells are appended to or
+   * flushed from it, without blocking the writers of other arrays.
+   */
+  std::mutex mtx_;
+
+  /**
+   * For each buffer in `buffers_`, it is `true` if it is the offsets buffer
+   * of a var-sized attribute.
+   */
+  std::vector<bool> offsets_;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_WRITE_BUFFER_H
@@ -0,0 +1,122 @@
+/**
+ * @file   dictionary_encoding.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class DictionaryEncoding.
+ */
+
+#include "tiledb/sm/tile/dictionary_encoding.h"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/misc/logger.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status DictionaryEncoding::cell(
+    const Tile* tile_var,
+    uint64_t code,
+    const unsigned char** cell,
+    uint64_t* cell_size) {
+  auto data = (const unsigned char*)tile_var->data();
+  auto size = tile_var->size();
+  if (size < sizeof(uint64_t))
+    return LOG_STATUS(Status::TileError(
+        "Cannot decode cell; Dictionary-encoded tile is too small"));
+
+  auto entry_num = *(const uint64_t*)data;
+  auto entry_offsets = (const uint64_t*)data + 1;
+  if (code >= entry_num || entry_num > size / sizeof(uint64_t) - 1)
+    return LOG_STATUS(
+        Status::TileError("Cannot decode cell; Invalid dictionary code"));
+
+  auto entries = data + (entry_num + 1) * sizeof(uint64_t);
+  auto entries_size = size - (entry_num + 1) * sizeof(uint64_t);
+  auto end = (code + 1 < entry_num) ? entry_offsets[code + 1] : entries_size;
+  if (entry_offsets[code] > end || end > entries_size)
+    return LOG_STATUS(
+        Status::TileError("Cannot decode cell; Invalid dictionary entry"));
+
+  *cell = entries + entry_offsets[code];
+  *cell_size = end - entry_offsets[code];
+
+  return Status::Ok();
+}
+
+Status DictionaryEncoding::encode(Tile* tile, Tile* tile_var) {
+  auto cell_num = tile->cell_num();
+  if (cell_num == 0)
+    return Status::Ok();
+
+  // Assign a code to every distinct cell value, in order of first
+  // appearance, overwriting each offset with the code of its cell. Offset
+  // `i + 1` is still intact when cell `i` is processed.
+  auto offsets = (uint64_t*)tile->data();
+  auto data = (const char*)tile_var->data();
+  auto data_size = tile_var->size();
+  auto first_offset = offsets[0];
+  std::unordered_map<std::string, uint64_t> codes;
+  std::vector<uint64_t> entry_offsets;
+  Buffer entries;
+  for (uint64_t i = 0; i < cell_num; ++i) {
+    auto start = offsets[i] - first_offset;
+    auto end =
+        (i + 1 < cell_num) ? offsets[i + 1] - first_offset : data_size;
+    if (start > end || end > data_size)
+      return LOG_STATUS(
+          Status::TileError("Cannot encode tile; Invalid cell offsets"));
+
+    auto code = (uint64_t)codes.size();
+    auto it = codes.emplace(std::string(data + start, end - start), code);
+    if (it.second) {
+      entry_offsets.push_back(entries.size());
+      RETURN_NOT_OK(entries.write(data + start, end - start));
+    }
+    offsets[i] = it.first->second;
+  }
+
+  // Replace the values with the dictionary
+  uint64_t entry_num = entry_offsets.size();
+  tile_var->reset();
+  RETURN_NOT_OK(tile_var->write(&entry_num, sizeof(uint64_t)));
+  RETURN_NOT_OK(
+      tile_var->write(&entry_offsets[0], entry_num * sizeof(uint64_t)));
+  RETURN_NOT_OK(tile_var->write(entries.data(), entries.size()));
+
+  return Status::Ok();
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,88 @@
+/**
+ * @file   dictionary_encoding.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class DictionaryEncoding.
+ */
+
+#ifndef TILEDB_DICTIONARY_ENCODING_H
+#define TILEDB_DICTIONARY_ENCODING_H
+
+#include "tiledb/sm/misc/status.h"
+#include "tiledb/sm/tile/tile.h"
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * Dictionary-encodes the (offsets, values) tile pair of a variable-sized
+ * attribute. Each distinct cell value is stored once in the values tile,
+ * and the offsets tile stores for every cell the code (index) of its value
+ * in the dictionary instead of its offset.
+ *
+ * The encoded values tile has the format:
+ * entry_num (uint64_t)
+ * entry_offset#1 (uint64_t) entry_offset#2 (uint64_t) ...
+ * entry#1 entry#2 ...
+ *
+ * where the entry offsets are relative to the first entry. The codes keep
+ * the offsets tile size unchanged, and (being small integers) compress
+ * well with the offsets compressor and filters.
+ */
+class DictionaryEncoding {
+ public:
+  /**
+   * Retrieves the value of a cell from a dictionary-encoded values tile.
+   *
+   * @param tile_var The encoded values tile.
+   * @param code The code of the cell.
+   * @param cell Set to point to the cell value in `tile_var`.
+   * @param cell_size Set to the size of the cell value in bytes.
+   * @return Status
+   */
+  static Status cell(
+      const Tile* tile_var,
+      uint64_t code,
+      const unsigned char** cell,
+      uint64_t* cell_size);
+
+  /**
+   * Dictionary-encodes a tile pair in place. On return, `tile` holds the
+   * codes of the cells and `tile_var` the dictionary.
+   *
+   * @param tile The offsets tile.
+   * @param tile_var The values tile.
+   * @return Status
+   */
+  static Status encode(Tile* tile, Tile* tile_var);
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_DICTIONARY_ENCODING_H
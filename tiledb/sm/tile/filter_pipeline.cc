@@ -0,0 +1,591 @@
+/**
+ * @file   filter_pipeline.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class FilterPipeline.
+ */
+
+#include "tiledb/sm/tile/filter_pipeline.h"
+#include "tiledb/sm/compressors/for_compressor.h"
+#include "tiledb/sm/misc/constants.h"
+#include "tiledb/sm/misc/logger.h"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace tiledb {
+namespace sm {
+
+/* ****************************** */
+/*         STATIC HELPERS         */
+/* ****************************** */
+
+/** Loads a value from a (potentially unaligned) address. */
+template <class T>
+static inline T load(const unsigned char* p) {
+  T v;
+  std::memcpy(&v, p, sizeof(T));
+  return v;
+}
+
+/** Stores a value to a (potentially unaligned) address. */
+template <class T>
+static inline void store(unsigned char* p, T v) {
+  std::memcpy(p, &v, sizeof(T));
+}
+
+/**
+ * Maps a (two's complement) difference to an unsigned value, such that
+ * differences of small magnitude map to small values.
+ */
+template <class T>
+static inline T zigzag(T d) {
+  typedef typename std::make_signed<T>::type S;
+  return (T)((T)(d << 1) ^ (T)((S)d >> (sizeof(T) * 8 - 1)));
+}
+
+/** Inverse of `zigzag`. */
+template <class T>
+static inline T unzigzag(T z) {
+  return (T)((T)(z >> 1) ^ (T)(T(0) - (T)(z & 1)));
+}
+
+/** Returns true if the input datatype is a signed integer type. */
+static inline bool is_signed_integer(Datatype type) {
+  return type == Datatype::INT8 || type == Datatype::INT16 ||
+         type == Datatype::INT32 || type == Datatype::INT64;
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status FilterPipeline::run_forward(
+    const std::vector<Filter>& filters,
+    Datatype type,
+    ConstBuffer* input,
+    Buffer* output) {
+  auto value_size = datatype_size(type);
+  auto is_signed = is_signed_integer(type);
+
+  // Run the filters one after the other, alternating between two
+  // intermediate buffers
+  Buffer tmp[2];
+  ConstBuffer cur_input(input->data(), input->size());
+  auto filter_num = filters.size();
+  for (size_t i = 0; i < filter_num; ++i) {
+    auto cur_output = (i == filter_num - 1) ? output : &tmp[i % 2];
+    if (cur_output != output)
+      cur_output->reset_size();
+    RETURN_NOT_OK(
+        run(filters[i], value_size, is_signed, false, &cur_input, cur_output));
+    cur_input = ConstBuffer(cur_output->data(), cur_output->size());
+
+    // Deltas are stored zigzag-encoded, i.e., as unsigned values
+    if (filters[i] == Filter::FILTER_DELTA ||
+        filters[i] == Filter::FILTER_DOUBLE_DELTA)
+      is_signed = false;
+  }
+
+  return Status::Ok();
+}
+
+Status FilterPipeline::run_reverse(
+    const std::vector<Filter>& filters,
+    Datatype type,
+    ConstBuffer* input,
+    Buffer* output) {
+  auto value_size = datatype_size(type);
+
+  // Compute whether the input of each filter consisted of signed values
+  auto filter_num = filters.size();
+  std::vector<bool> is_signed(filter_num);
+  auto cur_signed = is_signed_integer(type);
+  for (size_t i = 0; i < filter_num; ++i) {
+    is_signed[i] = cur_signed;
+    if (filters[i] == Filter::FILTER_DELTA ||
+        filters[i] == Filter::FILTER_DOUBLE_DELTA)
+      cur_signed = false;
+  }
+
+  // Revert the filters in reverse order, alternating between two
+  // intermediate buffers
+  Buffer tmp[2];
+  ConstBuffer cur_input(input->data(), input->size());
+  for (size_t i = filter_num; i-- > 0;) {
+    auto cur_output = (i == 0) ? output : &tmp[i % 2];
+    if (cur_output != output)
+      cur_output->reset_size();
+    RETURN_NOT_OK(run(
+        filters[i], value_size, is_signed[i], true, &cur_input, cur_output));
+    cur_input = ConstBuffer(cur_output->data(), cur_output->size());
+  }
+
+  return Status::Ok();
+}
+
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
+Status FilterPipeline::run(
+    Filter filter,
+    uint64_t value_size,
+    bool is_signed,
+    bool reverse,
+    ConstBuffer* input,
+    Buffer* output) {
+  auto size = input->size();
+  auto in = (const unsigned char*)input->data();
+
+  // The bit-width reduction filter changes the size of the data
+  if (filter == Filter::FILTER_BIT_WIDTH_REDUCTION) {
+    switch (value_size) {
+      case 1:
+        return reverse ? bit_width_expand<uint8_t>(input, output) :
+                         bit_width_reduce<uint8_t>(is_signed, input, output);
+      case 2:
+        return reverse ? bit_width_expand<uint16_t>(input, output) :
+                         bit_width_reduce<uint16_t>(is_signed, input, output);
+      case 4:
+        return reverse ? bit_width_expand<uint32_t>(input, output) :
+                         bit_width_reduce<uint32_t>(is_signed, input, output);
+      case 8:
+        return reverse ? bit_width_expand<uint64_t>(input, output) :
+                         bit_width_reduce<uint64_t>(is_signed, input, output);
+      default:
+        return LOG_STATUS(Status::FilterError(
+            "Cannot run bit-width reduction filter; Unsupported value size"));
+    }
+  }
+
+  if (filter == Filter::FILTER_FRAME_OF_REFERENCE)
+    return frame_of_reference(value_size, is_signed, reverse, input, output);
+
+  if (filter == Filter::FILTER_COMPACT_OFFSETS)
+    return compact_offsets(value_size, reverse, input, output);
+
+  // The rest of the filters preserve the size of the data
+  if (size == 0)
+    return Status::Ok();
+  RETURN_NOT_OK(output->realloc(output->size() + size));
+  auto out = (unsigned char*)output->cur_data();
+  switch (filter) {
+    case Filter::FILTER_BYTESHUFFLE:
+      byteshuffle(value_size, reverse, in, size, out);
+      break;
+    case Filter::FILTER_BITSHUFFLE:
+      bitshuffle(value_size, reverse, in, size, out);
+      break;
+    case Filter::FILTER_DELTA:
+    case Filter::FILTER_DOUBLE_DELTA: {
+      auto order = (filter == Filter::FILTER_DELTA) ? 1u : 2u;
+      switch (value_size) {
+        case 1:
+          delta<uint8_t>(order, reverse, in, size, out);
+          break;
+        case 2:
+          delta<uint16_t>(order, reverse, in, size, out);
+          break;
+        case 4:
+          delta<uint32_t>(order, reverse, in, size, out);
+          break;
+        case 8:
+          delta<uint64_t>(order, reverse, in, size, out);
+          break;
+        default:
+          return LOG_STATUS(Status::FilterError(
+              "Cannot run delta filter; Unsupported value size"));
+      }
+      break;
+    }
+    default:
+      return LOG_STATUS(
+          Status::FilterError("Cannot run filter; Unknown filter type"));
+  }
+  output->advance_size(size);
+  output->advance_offset(size);
+
+  return Status::Ok();
+}
+
+void FilterPipeline::byteshuffle(
+    uint64_t value_size,
+    bool reverse,
+    const unsigned char* input,
+    uint64_t size,
+    unsigned char* output) {
+  uint64_t value_num = size / value_size;
+  for (uint64_t b = 0; b < value_size; ++b) {
+    auto plane = b * value_num;
+    if (!reverse) {
+      for (uint64_t i = 0; i < value_num; ++i)
+        output[plane + i] = input[i * value_size + b];
+    } else {
+      for (uint64_t i = 0; i < value_num; ++i)
+        output[i * value_size + b] = input[plane + i];
+    }
+  }
+
+  // Trailing bytes
+  auto shuffled = value_num * value_size;
+  std::memcpy(output + shuffled, input + shuffled, size - shuffled);
+}
+
+void FilterPipeline::bitshuffle(
+    uint64_t value_size,
+    bool reverse,
+    const unsigned char* input,
+    uint64_t size,
+    unsigned char* output) {
+  // Values are shuffled in groups of 8, so that every bit plane of a group
+  // forms a byte. The bit planes of all groups are stored one after the
+  // other.
+  uint64_t group_num = size / value_size / 8;
+  uint64_t bit_num = value_size * 8;
+  uint64_t values[8];
+  for (uint64_t g = 0; g < group_num; ++g) {
+    if (!reverse) {
+      for (int k = 0; k < 8; ++k) {
+        values[k] = 0;
+        std::memcpy(&values[k], input + (8 * g + k) * value_size, value_size);
+      }
+      for (uint64_t p = 0; p < bit_num; ++p) {
+        unsigned char byte = 0;
+        for (int k = 0; k < 8; ++k)
+          byte |= (unsigned char)(((values[k] >> p) & 1) << k);
+        output[p * group_num + g] = byte;
+      }
+    } else {
+      for (int k = 0; k < 8; ++k)
+        values[k] = 0;
+      for (uint64_t p = 0; p < bit_num; ++p) {
+        unsigned char byte = input[p * group_num + g];
+        for (int k = 0; k < 8; ++k)
+          values[k] |= (uint64_t)((byte >> k) & 1) << p;
+      }
+      for (int k = 0; k < 8; ++k)
+        std::memcpy(output + (8 * g + k) * value_size, &values[k], value_size);
+    }
+  }
+
+  // Values that do not form a whole group, and trailing bytes
+  auto shuffled = group_num * 8 * value_size;
+  std::memcpy(output + shuffled, input + shuffled, size - shuffled);
+}
+
+template <class T>
+void FilterPipeline::delta(
+    unsigned order,
+    bool reverse,
+    const unsigned char* input,
+    uint64_t size,
+    unsigned char* output) {
+  uint64_t value_num = size / sizeof(T);
+  if (value_num > 0)
+    store<T>(output, load<T>(input));
+
+  if (!reverse) {
+    T prev = (value_num > 0) ? load<T>(input) : T(0);
+    T prev_delta = 0;
+    for (uint64_t i = 1; i < value_num; ++i) {
+      auto cur = load<T>(input + i * sizeof(T));
+      auto cur_delta = (T)(cur - prev);
+      auto value =
+          (order == 1 || i == 1) ? cur_delta : (T)(cur_delta - prev_delta);
+      store<T>(output + i * sizeof(T), zigzag<T>(value));
+      prev = cur;
+      prev_delta = cur_delta;
+    }
+  } else {
+    T prev = (value_num > 0) ? load<T>(input) : T(0);
+    T prev_delta = 0;
+    for (uint64_t i = 1; i < value_num; ++i) {
+      auto value = unzigzag<T>(load<T>(input + i * sizeof(T)));
+      auto cur_delta =
+          (order == 1 || i == 1) ? value : (T)(value + prev_delta);
+      auto cur = (T)(prev + cur_delta);
+      store<T>(output + i * sizeof(T), cur);
+      prev = cur;
+      prev_delta = cur_delta;
+    }
+  }
+
+  // Trailing bytes
+  auto filtered = value_num * sizeof(T);
+  std::memcpy(output + filtered, input + filtered, size - filtered);
+}
+
+// ===== FORMAT =====
+// value_num (uint64_t)
+// window #1
+//   min (T)
+//   width (uint8_t)
+//   value #1 - min (width bytes)
+//   value #2 - min (width bytes)
+//   ...
+// window #2
+// ...
+// trailing bytes
+template <class T>
+Status FilterPipeline::bit_width_reduce(
+    bool is_signed, ConstBuffer* input, Buffer* output) {
+  typedef typename std::make_signed<T>::type S;
+  auto size = input->size();
+  auto in = (const unsigned char*)input->data();
+  uint64_t value_num = size / sizeof(T);
+  uint64_t window = constants::bit_width_reduction_window;
+  uint64_t window_num = (value_num + window - 1) / window;
+
+  // Reserve space for the worst case
+  RETURN_NOT_OK(output->realloc(
+      output->size() + sizeof(uint64_t) + size +
+      window_num * (sizeof(T) + sizeof(uint8_t))));
+  auto out = (unsigned char*)output->cur_data();
+  auto out_start = out;
+  store<uint64_t>(out, value_num);
+  out += sizeof(uint64_t);
+
+  for (uint64_t w = 0; w < window_num; ++w) {
+    auto start = w * window;
+    auto end = std::min(start + window, value_num);
+
+    // Compute the range of the window values
+    T min = load<T>(in + start * sizeof(T)), max = min;
+    for (uint64_t i = start + 1; i < end; ++i) {
+      auto v = load<T>(in + i * sizeof(T));
+      if (is_signed) {
+        if ((S)v < (S)min)
+          min = v;
+        if ((S)v > (S)max)
+          max = v;
+      } else {
+        if (v < min)
+          min = v;
+        if (v > max)
+          max = v;
+      }
+    }
+    auto range = (uint64_t)(T)(max - min);
+    uint8_t width = (range <= 0xff) ?
+                        1 :
+                        (range <= 0xffff) ? 2 : (range <= 0xffffffff) ? 4 : 8;
+
+    // Write the window
+    store<T>(out, min);
+    out += sizeof(T);
+    store<uint8_t>(out, width);
+    out += sizeof(uint8_t);
+    for (uint64_t i = start; i < end; ++i) {
+      auto offset = (uint64_t)(T)(load<T>(in + i * sizeof(T)) - min);
+      std::memcpy(out, &offset, width);
+      out += width;
+    }
+  }
+
+  // Trailing bytes
+  auto filtered = value_num * sizeof(T);
+  std::memcpy(out, in + filtered, size - filtered);
+  out += size - filtered;
+
+  auto nbytes = (uint64_t)(out - out_start);
+  output->advance_size(nbytes);
+  output->advance_offset(nbytes);
+
+  return Status::Ok();
+}
+
+template <class T>
+Status FilterPipeline::bit_width_expand(ConstBuffer* input, Buffer* output) {
+  auto in = (const unsigned char*)input->data();
+  auto in_end = in + input->size();
+  uint64_t window = constants::bit_width_reduction_window;
+
+  // Read the number of values
+  if (input->size() < sizeof(uint64_t))
+    return LOG_STATUS(Status::FilterError(
+        "Cannot revert bit-width reduction filter; Invalid input size"));
+  auto value_num = load<uint64_t>(in);
+  in += sizeof(uint64_t);
+  if (value_num > input->size())
+    return LOG_STATUS(Status::FilterError(
+        "Cannot revert bit-width reduction filter; Invalid value number"));
+
+  RETURN_NOT_OK(output->realloc(
+      output->size() + value_num * sizeof(T) + (in_end - in)));
+  auto out = (unsigned char*)output->cur_data();
+  auto out_start = out;
+
+  for (uint64_t start = 0; start < value_num; start += window) {
+    auto end = std::min(start + window, value_num);
+
+    // Read the window header
+    if ((uint64_t)(in_end - in) < sizeof(T) + sizeof(uint8_t))
+      return LOG_STATUS(Status::FilterError(
+          "Cannot revert bit-width reduction filter; Truncated input"));
+    auto min = load<T>(in);
+    in += sizeof(T);
+    auto width = load<uint8_t>(in);
+    in += sizeof(uint8_t);
+    if (width > sizeof(T) || (uint64_t)(in_end - in) < (end - start) * width)
+      return LOG_STATUS(Status::FilterError(
+          "Cannot revert bit-width reduction filter; Truncated input"));
+
+    // Read the window values
+    for (uint64_t i = start; i < end; ++i) {
+      uint64_t offset = 0;
+      std::memcpy(&offset, in, width);
+      in += width;
+      store<T>(out, (T)(min + (T)offset));
+      out += sizeof(T);
+    }
+  }
+
+  // Trailing bytes
+  std::memcpy(out, in, in_end - in);
+  out += in_end - in;
+
+  auto nbytes = (uint64_t)(out - out_start);
+  output->advance_size(nbytes);
+  output->advance_offset(nbytes);
+
+  return Status::Ok();
+}
+
+Status FilterPipeline::compact_offsets(
+    uint64_t value_size, bool reverse, ConstBuffer* input, Buffer* output) {
+  if (value_size != sizeof(uint64_t))
+    return LOG_STATUS(Status::FilterError(
+        "Cannot run compact offsets filter; Unsupported value size"));
+
+  // Format: mode (uint8_t), followed by the first value and the frame of
+  // reference compressed lengths (LENGTHS mode), or by the frame of
+  // reference compressed values (VALUES mode), and the trailing bytes
+  const uint8_t VALUES = 0, LENGTHS = 1;
+
+  if (reverse) {
+    uint8_t mode;
+    RETURN_NOT_OK(input->read(&mode, sizeof(uint8_t)));
+    if (mode == VALUES) {
+      RETURN_NOT_OK(
+          FrameOfReference::decompress(Datatype::UINT64, input, output));
+    } else {
+      // Rebuild the offsets from the first one with a prefix sum
+      auto start = output->size();
+      uint64_t first;
+      RETURN_NOT_OK(input->read(&first, sizeof(uint64_t)));
+      RETURN_NOT_OK(output->write(&first, sizeof(uint64_t)));
+      RETURN_NOT_OK(
+          FrameOfReference::decompress(Datatype::UINT64, input, output));
+      auto out = (unsigned char*)output->data() + start;
+      auto num = (output->size() - start) / sizeof(uint64_t);
+      auto prev = first;
+      for (uint64_t i = 1; i < num; ++i) {
+        prev += load<uint64_t>(out + i * sizeof(uint64_t));
+        store<uint64_t>(out + i * sizeof(uint64_t), prev);
+      }
+    }
+    return output->write(input, input->nbytes_left_to_read());
+  }
+
+  // Offsets are non-decreasing, in which case the lengths (differences of
+  // consecutive offsets) are stored, since they need far fewer bits.
+  // Otherwise (e.g., dictionary codes), the values are stored as is.
+  auto size = input->size();
+  auto num = size / sizeof(uint64_t);
+  auto whole_size = num * sizeof(uint64_t);
+  auto in = (const unsigned char*)input->data();
+  bool monotonic = num > 0;
+  for (uint64_t i = 1; i < num && monotonic; ++i)
+    monotonic = load<uint64_t>(in + i * sizeof(uint64_t)) >=
+                load<uint64_t>(in + (i - 1) * sizeof(uint64_t));
+
+  auto mode = monotonic ? LENGTHS : VALUES;
+  RETURN_NOT_OK(output->write(&mode, sizeof(uint8_t)));
+  if (monotonic) {
+    std::vector<uint64_t> lengths(num - 1);
+    auto prev = load<uint64_t>(in);
+    for (uint64_t i = 1; i < num; ++i) {
+      auto cur = load<uint64_t>(in + i * sizeof(uint64_t));
+      lengths[i - 1] = cur - prev;
+      prev = cur;
+    }
+    RETURN_NOT_OK(output->write(in, sizeof(uint64_t)));
+    ConstBuffer values(lengths.data(), lengths.size() * sizeof(uint64_t));
+    RETURN_NOT_OK(
+        FrameOfReference::compress(Datatype::UINT64, &values, output));
+  } else {
+    ConstBuffer values(in, whole_size);
+    RETURN_NOT_OK(
+        FrameOfReference::compress(Datatype::UINT64, &values, output));
+  }
+  return output->write(in + whole_size, size - whole_size);
+}
+
+Status FilterPipeline::frame_of_reference(
+    uint64_t value_size,
+    bool is_signed,
+    bool reverse,
+    ConstBuffer* input,
+    Buffer* output) {
+  Datatype type;
+  switch (value_size) {
+    case 1:
+      type = is_signed ? Datatype::INT8 : Datatype::UINT8;
+      break;
+    case 2:
+      type = is_signed ? Datatype::INT16 : Datatype::UINT16;
+      break;
+    case 4:
+      type = is_signed ? Datatype::INT32 : Datatype::UINT32;
+      break;
+    case 8:
+      type = is_signed ? Datatype::INT64 : Datatype::UINT64;
+      break;
+    default:
+      return LOG_STATUS(Status::FilterError(
+          "Cannot run frame of reference filter; Unsupported value size"));
+  }
+
+  // The compressed values are followed by the trailing bytes
+  if (reverse) {
+    RETURN_NOT_OK(FrameOfReference::decompress(type, input, output));
+    return output->write(input, input->nbytes_left_to_read());
+  }
+
+  auto size = input->size();
+  auto whole_size = size - size % value_size;
+  ConstBuffer values(input->data(), whole_size);
+  RETURN_NOT_OK(FrameOfReference::compress(type, &values, output));
+  return output->write(
+      (const char*)input->data() + whole_size, size - whole_size);
+}
+
+}  // namespace sm
+}  // namespace tiledb
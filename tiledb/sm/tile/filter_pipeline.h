@@ -0,0 +1,191 @@
+/**
+ * @file   filter_pipeline.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class FilterPipeline.
+ */
+
+#ifndef TILEDB_FILTER_PIPELINE_H
+#define TILEDB_FILTER_PIPELINE_H
+
+#include <vector>
+
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/buffer/const_buffer.h"
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/enums/filter.h"
+#include "tiledb/sm/misc/status.h"
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * Runs an ordered list of filters on the data of a tile prior to
+ * compression, and in reverse order after decompression. Each filter
+ * operates on the values of the tile datatype; any trailing bytes that do
+ * not form a whole value are passed through unchanged.
+ *
+ * The filters are:
+ *   - FILTER_BYTESHUFFLE: Stores the i-th bytes of all values together.
+ *   - FILTER_BITSHUFFLE: Stores the i-th bits of (groups of 8) values
+ *     together.
+ *   - FILTER_DELTA: Stores the first value, followed by the zigzag-encoded
+ *     differences of consecutive values.
+ *   - FILTER_DOUBLE_DELTA: Stores the first value and the first delta,
+ *     followed by the zigzag-encoded differences of consecutive deltas.
+ *   - FILTER_BIT_WIDTH_REDUCTION: Stores every window of
+ *     `constants::bit_width_reduction_window` values as offsets from the
+ *     window minimum, in the fewest bytes (1, 2, 4 or 8) that fit them.
+ *   - FILTER_FRAME_OF_REFERENCE: Compresses the values with the frame of
+ *     reference codec (see `FrameOfReference`), e.g., ahead of a general
+ *     purpose compressor.
+ *   - FILTER_COMPACT_OFFSETS: For (uint64) offsets of variable-sized
+ *     cells, stores the first offset followed by the cell lengths, bit-packed
+ *     with the frame of reference codec. Values that are not
+ *     non-decreasing (e.g., dictionary codes) are bit-packed as is.
+ */
+class FilterPipeline {
+ public:
+  /**
+   * Runs the filters in order on the input, appending the result to
+   * `output`.
+   *
+   * @param filters The filters to run.
+   * @param type The datatype of the input values.
+   * @param input The input data.
+   * @param output The buffer the filtered data are appended to.
+   * @return Status
+   */
+  static Status run_forward(
+      const std::vector<Filter>& filters,
+      Datatype type,
+      ConstBuffer* input,
+      Buffer* output);
+
+  /**
+   * Reverts the filters (in reverse order) on the input, appending the
+   * result to `output`.
+   *
+   * @param filters The filters the input was produced with.
+   * @param type The datatype of the original values.
+   * @param input The filtered data.
+   * @param output The buffer the original data are appended to.
+   * @return Status
+   */
+  static Status run_reverse(
+      const std::vector<Filter>& filters,
+      Datatype type,
+      ConstBuffer* input,
+      Buffer* output);
+
+ private:
+  /**
+   * Runs (or reverts, if `reverse` is true) a single filter on the input,
+   * appending the result to `output`.
+   *
+   * @param filter The filter to run.
+   * @param value_size The size of a value in bytes.
+   * @param is_signed Whether the values are signed integers.
+   * @param reverse Whether the filter is reverted.
+   * @param input The input data.
+   * @param output The buffer the result is appended to.
+   * @return Status
+   */
+  static Status run(
+      Filter filter,
+      uint64_t value_size,
+      bool is_signed,
+      bool reverse,
+      ConstBuffer* input,
+      Buffer* output);
+
+  /** Runs (or reverts) the byte-shuffle filter. */
+  static void byteshuffle(
+      uint64_t value_size,
+      bool reverse,
+      const unsigned char* input,
+      uint64_t size,
+      unsigned char* output);
+
+  /** Runs (or reverts) the bit-shuffle filter. */
+  static void bitshuffle(
+      uint64_t value_size,
+      bool reverse,
+      const unsigned char* input,
+      uint64_t size,
+      unsigned char* output);
+
+  /**
+   * Runs (or reverts) the delta filter, with `order` 1, or the double-delta
+   * filter, with `order` 2.
+   */
+  template <class T>
+  static void delta(
+      unsigned order,
+      bool reverse,
+      const unsigned char* input,
+      uint64_t size,
+      unsigned char* output);
+
+  /**
+   * Runs the bit-width reduction filter, appending the result to `output`.
+   */
+  template <class T>
+  static Status bit_width_reduce(
+      bool is_signed, ConstBuffer* input, Buffer* output);
+
+  /**
+   * Reverts the bit-width reduction filter, appending the result to
+   * `output`.
+   */
+  template <class T>
+  static Status bit_width_expand(ConstBuffer* input, Buffer* output);
+
+  /**
+   * Runs (or reverts) the compact offsets filter, appending the result to
+   * `output`.
+   */
+  static Status compact_offsets(
+      uint64_t value_size, bool reverse, ConstBuffer* input, Buffer* output);
+
+  /**
+   * Runs (or reverts) the frame of reference filter, appending the result
+   * to `output`.
+   */
+  static Status frame_of_reference(
+      uint64_t value_size,
+      bool is_signed,
+      bool reverse,
+      ConstBuffer* input,
+      Buffer* output);
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_FILTER_PIPELINE_H
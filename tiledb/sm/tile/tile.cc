@@ -31,13 +31,145 @@
  */
 
 #include "tiledb/sm/tile/tile.h"
+#include "tiledb/sm/misc/constants.h"
 #include "tiledb/sm/misc/logger.h"
 
 #include <iostream>
+#include <vector>
 
 namespace tiledb {
 namespace sm {
 
+/* ****************************** */
+/*      COORDINATE TRANSPOSES     */
+/* ****************************** */
+
+/**
+ * Scratch space the coordinates are copied into prior to being split or
+ * zipped in place, reused by all the tiles of a thread (up to
+ * `constants::max_staging_buffer_size`).
+ */
+static thread_local std::vector<char> coords_scratch;
+
+/**
+ * Splits `cell_num` coordinate tuples of `D` values of type `T`, so that
+ * the values of each dimension appear contiguously in `out`.
+ */
+template <class T, unsigned D>
+static inline void split_coords(const T* in, T* out, uint64_t cell_num) {
+  for (uint64_t i = 0; i < cell_num; ++i) {
+    for (unsigned j = 0; j < D; ++j)
+      out[j * cell_num + i] = in[i * D + j];
+  }
+}
+
+/** Reverts `split_coords`. */
+template <class T, unsigned D>
+static inline void zip_coords(const T* in, T* out, uint64_t cell_num) {
+  for (uint64_t i = 0; i < cell_num; ++i) {
+    for (unsigned j = 0; j < D; ++j)
+      out[i * D + j] = in[j * cell_num + i];
+  }
+}
+
+/**
+ * Splits (or zips) the coordinates of values of type `T`, with kernels
+ * specialized for up to 4 dimensions.
+ */
+template <class T>
+static void transpose_coords(
+    bool split,
+    const T* in,
+    T* out,
+    uint64_t cell_num,
+    unsigned int dim_num) {
+  switch (dim_num) {
+    case 2:
+      if (split)
+        split_coords<T, 2>(in, out, cell_num);
+      else
+        zip_coords<T, 2>(in, out, cell_num);
+      return;
+    case 3:
+      if (split)
+        split_coords<T, 3>(in, out, cell_num);
+      else
+        zip_coords<T, 3>(in, out, cell_num);
+      return;
+    case 4:
+      if (split)
+        split_coords<T, 4>(in, out, cell_num);
+      else
+        zip_coords<T, 4>(in, out, cell_num);
+      return;
+    default:
+      for (uint64_t i = 0; i < cell_num; ++i) {
+        for (unsigned int j = 0; j < dim_num; ++j) {
+          if (split)
+            out[j * cell_num + i] = in[i * dim_num + j];
+          else
+            out[i * dim_num + j] = in[j * cell_num + i];
+        }
+      }
+  }
+}
+
+/**
+ * Splits (or zips) in place the coordinates stored in `data`, dispatching
+ * on the coordinate size.
+ */
+static void transpose_coords(
+    bool split,
+    char* data,
+    uint64_t size,
+    uint64_t coord_size,
+    unsigned int dim_num) {
+  // A single dimension is stored the same either way
+  uint64_t cell_size = coord_size * dim_num;
+  if (dim_num < 2 || size < cell_size)
+    return;
+  uint64_t cell_num = size / cell_size;
+
+  auto& scratch = coords_scratch;
+  if (scratch.size() < size)
+    scratch.resize(size);
+  std::memcpy(scratch.data(), data, size);
+  auto in = scratch.data();
+
+  switch (coord_size) {
+    case sizeof(uint8_t):
+      transpose_coords<uint8_t>(
+          split, (uint8_t*)in, (uint8_t*)data, cell_num, dim_num);
+      break;
+    case sizeof(uint16_t):
+      transpose_coords<uint16_t>(
+          split, (uint16_t*)in, (uint16_t*)data, cell_num, dim_num);
+      break;
+    case sizeof(uint32_t):
+      transpose_coords<uint32_t>(
+          split, (uint32_t*)in, (uint32_t*)data, cell_num, dim_num);
+      break;
+    case sizeof(uint64_t):
+      transpose_coords<uint64_t>(
+          split, (uint64_t*)in, (uint64_t*)data, cell_num, dim_num);
+      break;
+    default:
+      for (uint64_t i = 0; i < cell_num; ++i) {
+        for (unsigned int j = 0; j < dim_num; ++j) {
+          auto split_pos = (j * cell_num + i) * coord_size;
+          auto zip_pos = (i * dim_num + j) * coord_size;
+          std::memcpy(
+              data + (split ? split_pos : zip_pos),
+              in + (split ? zip_pos : split_pos),
+              coord_size);
+        }
+      }
+  }
+
+  if (scratch.capacity() > constants::max_staging_buffer_size)
+    std::vector<char>().swap(scratch);
+}
+
 /* ****************************** */
 /*   CONSTRUCTORS & DESTRUCTORS   */
 /* ****************************** */
@@ -136,6 +268,31 @@ Status Tile::init(
   return Status::Ok();
 }
 
+Status Tile::init(
+    Datatype type,
+    Compressor compressor,
+    int compression_level,
+    uint64_t cell_size,
+    unsigned int dim_num,
+    void* data,
+    uint64_t size) {
+  cell_size_ = cell_size;
+  compressor_ = compressor;
+  compression_level_ = compression_level;
+  dim_num_ = dim_num;
+  type_ = type;
+
+  if (owns_buff_)
+    delete buffer_;
+  owns_buff_ = true;
+  buffer_ = new Buffer(data, size, false);
+  if (buffer_ == nullptr)
+    return LOG_STATUS(
+        Status::TileError("Cannot initialize tile; Buffer allocation failed"));
+
+  return Status::Ok();
+}
+
 void Tile::advance_offset(uint64_t nbytes) {
   buffer_->advance_offset(nbytes);
 }
@@ -176,6 +333,14 @@ bool Tile::empty() const {
   return (buffer_ == nullptr) || (buffer_->size() == 0);
 }
 
+const std::shared_ptr<ZStdDictionary>& Tile::compression_dictionary() const {
+  return compression_dictionary_;
+}
+
+const std::vector<Filter>& Tile::filters() const {
+  return filters_;
+}
+
 bool Tile::full() const {
   return (buffer_->size() != 0) &&
          (buffer_->offset() == buffer_->alloced_size());
@@ -185,6 +350,14 @@ uint64_t Tile::offset() const {
   return buffer_->offset();
 }
 
+bool Tile::quantized() const {
+  return quantized_;
+}
+
+int Tile::quantization_digits() const {
+  return quantization_digits_;
+}
+
 Status Tile::realloc(uint64_t nbytes) {
   return buffer_->realloc(nbytes);
 }
@@ -208,43 +381,47 @@ void Tile::reset_size() {
   buffer_->reset_size();
 }
 
+void Tile::set_compression_dictionary(
+    const std::shared_ptr<ZStdDictionary>& dictionary) {
+  compression_dictionary_ = dictionary;
+}
+
+void Tile::set_filters(const std::vector<Filter>& filters) {
+  filters_ = filters;
+}
+
 void Tile::set_offset(uint64_t offset) {
   buffer_->set_offset(offset);
 }
 
+void Tile::set_quantization(bool quantized, int digits) {
+  quantized_ = quantized;
+  quantization_digits_ = digits;
+}
+
 void Tile::set_size(uint64_t size) {
   buffer_->set_size(size);
 }
 
+void Tile::share_buff(const std::shared_ptr<Buffer>& buff) {
+  if (owns_buff_)
+    delete buffer_;
+  shared_buff_ = buff;
+  buffer_ = buff.get();
+  owns_buff_ = false;
+}
+
 uint64_t Tile::size() const {
   return buffer_->size();
 }
 void Tile::split_coordinates() {
   assert(dim_num_ > 0);
-
-  // For easy reference
-  uint64_t tile_size = buffer_->size();
-  uint64_t coord_size = cell_size_ / dim_num_;
-  uint64_t cell_num = tile_size / cell_size_;
-  auto tile_c = (char*)buffer_->data();
-  uint64_t ptr = 0, ptr_tmp = 0;
-
-  // Create a tile clone
-  auto tile_tmp = (char*)malloc(tile_size);
-  std::memcpy(tile_tmp, tile_c, tile_size);
-
-  // Split coordinates
-  for (unsigned int j = 0; j < dim_num_; ++j) {
-    ptr_tmp = j * coord_size;
-    for (uint64_t i = 0; i < cell_num; ++i) {
-      std::memcpy(tile_c + ptr, tile_tmp + ptr_tmp, coord_size);
-      ptr += coord_size;
-      ptr_tmp += cell_size_;
-    }
-  }
-
-  // Clean up
-  std::free((void*)tile_tmp);
+  transpose_coords(
+      true,
+      (char*)buffer_->data(),
+      buffer_->size(),
+      cell_size_ / dim_num_,
+      dim_num_);
 }
 
 bool Tile::stores_coords() const {
@@ -271,6 +448,15 @@ Status Tile::write(const void* data, uint64_t nbytes) {
   return buffer_->write(data, nbytes);
 }
 
+Status Tile::write_fill(
+    const void* value, uint64_t value_size, uint64_t num) {
+  return buffer_->write_fill(value, value_size, num);
+}
+
+Status Tile::write_offsets(uint64_t start, uint64_t step, uint64_t num) {
+  return buffer_->write_offsets(start, step, num);
+}
+
 Status Tile::write_with_shift(ConstBuffer* buf, uint64_t offset) {
   buffer_->write_with_shift(buf, offset);
 
@@ -279,55 +465,42 @@ Status Tile::write_with_shift(ConstBuffer* buf, uint64_t offset) {
 
 void Tile::zip_coordinates() {
   assert(dim_num_ > 0);
-
-  // For easy reference
-  uint64_t tile_size = buffer_->size();
-  uint64_t coord_size = cell_size_ / dim_num_;
-  uint64_t cell_num = tile_size / cell_size_;
-  auto tile_c = (char*)buffer_->data();
-  uint64_t ptr = 0, ptr_tmp = 0;
-
-  // Create a tile clone
-  auto tile_tmp = (char*)malloc(tile_size);
-  std::memcpy(tile_tmp, tile_c, tile_size);
-
-  // Zip coordinates
-  for (unsigned int j = 0; j < dim_num_; ++j) {
-    ptr = j * coord_size;
-    for (uint64_t i = 0; i < cell_num; ++i) {
-      std::memcpy(tile_c + ptr, tile_tmp + ptr_tmp, coord_size);
-      ptr += cell_size_;
-      ptr_tmp += coord_size;
-    }
-  }
-
-  // Clean up
-  std::free((void*)tile_tmp);
+  transpose_coords(
+      false,
+      (char*)buffer_->data(),
+      buffer_->size(),
+      cell_size_ / dim_num_,
+      dim_num_);
 }
 
 Tile& Tile::operator=(const Tile& tile) {
-  if (owns_buff_) {
+  if (this == &tile)
+    return *this;
+
+  // A shared buffer (e.g., from the tile cache) is only released, since
+  // other tiles may read it
+  if (owns_buff_)
     delete buffer_;
-    buffer_ = nullptr;
-  }
+  buffer_ = nullptr;
+  shared_buff_.reset();
 
   cell_size_ = tile.cell_size_;
   compressor_ = tile.compressor_;
   compression_level_ = tile.compression_level_;
+  compression_dictionary_ = tile.compression_dictionary_;
   dim_num_ = tile.dim_num_;
+  filters_ = tile.filters_;
   owns_buff_ = tile.owns_buff_;
+  shared_buff_ = tile.shared_buff_;
+  quantized_ = tile.quantized_;
+  quantization_digits_ = tile.quantization_digits_;
   type_ = tile.type_;
 
   if (!tile.owns_buff_) {
     buffer_ = tile.buffer_;
-  } else {
-    if (tile.buffer_ == nullptr)
-      buffer_ = nullptr;
-    else {
-      if (buffer_ == nullptr)
-        buffer_ = new Buffer();
-      *buffer_ = *tile.buffer_;
-    }
+  } else if (tile.buffer_ != nullptr) {
+    buffer_ = new Buffer();
+    *buffer_ = *tile.buffer_;
   }
 
   return *this;
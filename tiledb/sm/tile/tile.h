@@ -36,9 +36,12 @@
 #include "tiledb/sm/array_schema/attribute.h"
 #include "tiledb/sm/buffer/buffer.h"
 #include "tiledb/sm/buffer/const_buffer.h"
+#include "tiledb/sm/enums/filter.h"
 #include "tiledb/sm/misc/status.h"
 
 #include <cinttypes>
+#include <memory>
+#include <vector>
 
 namespace tiledb {
 namespace sm {
@@ -140,6 +143,32 @@ class Tile {
       uint64_t cell_size,
       unsigned int dim_num);
 
+  /**
+   * Tile initializer that wraps existing data instead of allocating a new
+   * buffer. The data are not copied and not freed by the tile, so they
+   * must outlive it, and they must not be modified through the tile (e.g.,
+   * a coordinates tile cannot be wrapped, since its coordinates are split
+   * in place upon compression).
+   *
+   * @param type The type of the data to be stored.
+   * @param compression The compression type.
+   * @param compression_level The compression level.
+   * @param cell_size The cell size.
+   * @param dim_num The number of dimensions in case the tile stores
+   *      coordinates.
+   * @param data The data to be wrapped.
+   * @param size The size of `data` in bytes.
+   * @return Status
+   */
+  Status init(
+      Datatype type,
+      Compressor compression,
+      int compression_level,
+      uint64_t cell_size,
+      unsigned int dim_num,
+      void* data,
+      uint64_t size);
+
   /** Advances the buffer offset. */
   void advance_offset(uint64_t nbytes);
 
@@ -173,12 +202,29 @@ class Tile {
   /** Checks if the tile is empty. */
   bool empty() const;
 
+  /**
+   * Returns the dictionary used by the compressor (`nullptr` if none).
+   */
+  const std::shared_ptr<ZStdDictionary>& compression_dictionary() const;
+
+  /** Returns the filters applied to the tile data prior to compression. */
+  const std::vector<Filter>& filters() const;
+
   /** Checks if the tile is full. */
   bool full() const;
 
   /** The current offset in the tile. */
   uint64_t offset() const;
 
+  /**
+   * Returns true if the (real) tile values are quantized to integers prior
+   * to filtering and compression.
+   */
+  bool quantized() const;
+
+  /** Returns the number of decimal digits retained by quantization. */
+  int quantization_digits() const;
+
   /** Reallocates nbytes for the internal tile buffer. */
   Status realloc(uint64_t nbytes);
 
@@ -194,12 +240,35 @@ class Tile {
   /** Resets the tile size. */
   void reset_size();
 
+  /**
+   * Sets the dictionary used by the compressor, which is shared with the
+   * attribute it was set on.
+   */
+  void set_compression_dictionary(
+      const std::shared_ptr<ZStdDictionary>& dictionary);
+
+  /** Sets the filters applied to the tile data prior to compression. */
+  void set_filters(const std::vector<Filter>& filters);
+
   /** Sets the tile offset. */
   void set_offset(uint64_t offset);
 
+  /** Sets whether the tile values are quantized, retaining `digits` digits. */
+  void set_quantization(bool quantized, int digits);
+
   /** Sets the internal buffer size. */
   void set_size(uint64_t size);
 
+  /**
+   * Makes the tile use the input buffer, shared with other owners (e.g.,
+   * the tile cache), instead of its own. Any buffer owned by the tile is
+   * deleted. Once the shared buffer is published to other owners, it must
+   * be treated as read-only.
+   *
+   * @param buff The buffer to be shared.
+   */
+  void share_buff(const std::shared_ptr<Buffer>& buff);
+
   /** Returns the tile size. */
   uint64_t size() const;
 
@@ -239,6 +308,15 @@ class Tile {
   /** Writes `nbytes` from `data` to the tile. */
   Status write(const void* data, uint64_t nbytes);
 
+  /** Writes `num` copies of the `value_size`-byte `value` to the tile. */
+  Status write_fill(const void* value, uint64_t value_size, uint64_t num);
+
+  /**
+   * Writes the `num` uint64_t offsets `start, start + step, ...` to the
+   * tile.
+   */
+  Status write_offsets(uint64_t start, uint64_t step, uint64_t num);
+
   /**
    * Writes as much data as possibly can be read from the input buffer.
    * Note that this is a special function where each read value (of type
@@ -264,6 +342,12 @@ class Tile {
   /** Local buffer that stores the tile data. */
   Buffer* buffer_ = nullptr;
 
+  /**
+   * Keeps `buffer_` alive when it is shared with other owners (see
+   * `share_buff`), in which case the tile does not own it.
+   */
+  std::shared_ptr<Buffer> shared_buff_;
+
   /** The cell size. */
   uint64_t cell_size_;
 
@@ -273,18 +357,30 @@ class Tile {
   /** The compression level. */
   int compression_level_;
 
+  /** The dictionary used by the compressor (`nullptr` if none). */
+  std::shared_ptr<ZStdDictionary> compression_dictionary_;
+
   /**
    * The number of dimensions, in case the tile stores coordinates. It is 0
    * in case the tile stores attributes.
    */
   unsigned int dim_num_;
 
+  /** The filters applied to the tile data prior to compression. */
+  std::vector<Filter> filters_;
+
   /**
    * If *true* the tile object will delete *buff* upon
    * destruction, otherwise it will not delete it.
    */
   bool owns_buff_;
 
+  /** Whether the tile values are quantized prior to compression. */
+  bool quantized_ = false;
+
+  /** The number of decimal digits retained by quantization. */
+  int quantization_digits_ = 0;
+
   /** The tile data type. */
   Datatype type_;
 
@@ -34,11 +34,20 @@
 #include "tiledb/sm/compressors/blosc_compressor.h"
 #include "tiledb/sm/compressors/bzip_compressor.h"
 #include "tiledb/sm/compressors/dd_compressor.h"
+#include "tiledb/sm/compressors/for_compressor.h"
+#include "tiledb/sm/compressors/gorilla_compressor.h"
 #include "tiledb/sm/compressors/gzip_compressor.h"
 #include "tiledb/sm/compressors/lz4_compressor.h"
 #include "tiledb/sm/compressors/rle_compressor.h"
 #include "tiledb/sm/compressors/zstd_compressor.h"
 #include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/tile/filter_pipeline.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <limits>
+#include <memory>
 
 /* ****************************** */
 /*             MACROS             */
@@ -49,22 +58,54 @@
 namespace tiledb {
 namespace sm {
 
+/* ****************************** */
+/*         STAGING BUFFERS        */
+/* ****************************** */
+
+/**
+ * Releases a per-thread staging buffer upon leaving the scope (including
+ * error returns) if it grew beyond `constants::max_staging_buffer_size`.
+ */
+class StagingBufferRelease {
+ public:
+  explicit StagingBufferRelease(Buffer* staging)
+      : staging_(staging) {
+  }
+
+  ~StagingBufferRelease() {
+    if (staging_->alloced_size() > constants::max_staging_buffer_size)
+      staging_->clear();
+  }
+
+ private:
+  Buffer* staging_;
+};
+
 /* ****************************** */
 /*   CONSTRUCTORS & DESTRUCTORS   */
 /* ****************************** */
 
 TileIO::TileIO() {
+  auto_compression_candidates_ = nullptr;
   buffer_ = nullptr;
+  cache_fill_ = true;
   file_size_ = 0;
+  format_version_ = constants::format_version;
   storage_manager_ = nullptr;
+  tile_chunk_size_ = constants::tile_chunk_size;
   uri_ = URI("");
 }
 
 TileIO::TileIO(StorageManager* storage_manager, const URI& uri)
     : storage_manager_(storage_manager)
     , uri_(uri) {
+  cache_fill_ = true;
   file_size_ = 0;
+  format_version_ = constants::format_version;
   buffer_ = new Buffer();
+  tile_chunk_size_ = storage_manager_->tile_chunk_size();
+  auto_compression_candidates_ =
+      &storage_manager_->auto_compression_candidates();
 }
 
 TileIO::TileIO(
@@ -72,7 +113,12 @@ TileIO::TileIO(
     : file_size_(file_size)
     , storage_manager_(storage_manager)
     , uri_(uri) {
+  cache_fill_ = true;
+  format_version_ = constants::format_version;
   buffer_ = new Buffer();
+  tile_chunk_size_ = storage_manager_->tile_chunk_size();
+  auto_compression_candidates_ =
+      &storage_manager_->auto_compression_candidates();
 }
 
 TileIO::~TileIO() {
@@ -83,6 +129,19 @@ TileIO::~TileIO() {
 /*               API              */
 /* ****************************** */
 
+Status TileIO::compress(Tile* tile) {
+  // Reset the tile and buffer offset
+  tile->reset_offset();
+  buffer_->reset_size();
+  buffer_->reset_offset();
+
+  // Compress tile
+  if (encoded(tile))
+    RETURN_NOT_OK(compress_tile(tile));
+
+  return Status::Ok();
+}
+
 uint64_t TileIO::file_size() const {
   return file_size_;
 }
@@ -92,32 +151,28 @@ Status TileIO::read(
     uint64_t file_offset,
     uint64_t compressed_size,
     uint64_t tile_size) {
-  // Try to read from cache
+  // Try to read from cache. Cached objects are invalidated upon removing
+  // their files, but a file may also be replaced outside of TileDB, so an
+  // object of a different size is stale and replaced
+  std::shared_ptr<Buffer> cached;
   bool in_cache;
   RETURN_NOT_OK(storage_manager_->read_from_cache(
-      uri_, file_offset, tile->buffer(), tile_size, &in_cache));
-  if (in_cache)
+      uri_, file_offset, &cached, &in_cache, cache_fill_));
+  auto stale = in_cache && cached->size() != tile_size;
+  if (in_cache && !stale) {
+    tile->share_buff(cached);
     return Status::Ok();
-
-  // No compression
-  if (tile->compressor() == Compressor::NO_COMPRESSION) {
-    RETURN_NOT_OK(
-        storage_manager_->read(uri_, file_offset, tile->buffer(), tile_size));
-  } else {  // Compression
-    RETURN_NOT_OK(
-        storage_manager_->read(uri_, file_offset, buffer_, compressed_size));
-
-    // Decompress tile
-    tile->reset_offset();
-    tile->reset_size();
-    buffer_->reset_offset();
-    RETURN_NOT_OK(tile->realloc(tile_size));
-    RETURN_NOT_OK(decompress_tile(tile));
-    tile->reset_offset();
   }
 
+  // Read directly into a new buffer that is shared with the cache
+  auto buff = std::make_shared<Buffer>();
+  tile->share_buff(buff);
+  RETURN_NOT_OK(load(tile, file_offset, compressed_size, tile_size, true));
+
   // Store tile in cache
-  return (storage_manager_->write_to_cache(uri_, file_offset, tile->buffer()));
+  if (!cache_fill_)
+    return Status::Ok();
+  return storage_manager_->write_to_cache(uri_, file_offset, buff, stale);
 }
 
 Status TileIO::read_generic(Tile** tile, uint64_t file_offset) {
@@ -127,8 +182,11 @@ Status TileIO::read_generic(Tile** tile, uint64_t file_offset) {
 
   RETURN_NOT_OK(read_generic_tile_header(
       tile, file_offset, &tile_size, &compressed_size, &header_size));
+  // Generic tiles are not cached, and their buffer may be disowned by the
+  // caller, so they are read into the buffer owned by the tile
   RETURN_NOT_OK_ELSE(
-      read(*tile, file_offset + header_size, compressed_size, tile_size),
+      load(
+          *tile, file_offset + header_size, compressed_size, tile_size, false),
       delete *tile);
 
   return Status::Ok();
@@ -177,20 +235,21 @@ Status TileIO::read_generic_tile_header(
   return Status::Ok();
 }
 
-Status TileIO::write(Tile* tile, uint64_t* bytes_written) {
-  // Reset the tile and buffer offset
-  tile->reset_offset();
-  buffer_->reset_size();
-  buffer_->reset_offset();
+void TileIO::set_cache_fill(bool cache_fill) {
+  cache_fill_ = cache_fill;
+}
 
-  // Compress tile
-  Compressor compressor = tile->compressor();
-  if (compressor != Compressor::NO_COMPRESSION)
-    RETURN_NOT_OK(compress_tile(tile));
+void TileIO::set_format_version(uint32_t format_version) {
+  format_version_ = format_version;
+}
 
-  // Prepare to write
-  auto buffer =
-      (compressor == Compressor::NO_COMPRESSION) ? tile->buffer() : buffer_;
+Status TileIO::write(Tile* tile, uint64_t* bytes_written) {
+  RETURN_NOT_OK(compress(tile));
+  return write_compressed(tile, bytes_written);
+}
+
+Status TileIO::write_compressed(Tile* tile, uint64_t* bytes_written) {
+  auto buffer = encoded(tile) ? buffer_ : tile->buffer();
   *bytes_written = buffer->size();
 
   RETURN_NOT_OK(storage_manager_->write(uri_, buffer));
@@ -205,12 +264,10 @@ Status TileIO::write_generic(Tile* tile) {
   buffer_->reset_offset();
 
   // Compress tile
-  Compressor compressor = tile->compressor();
-  if (compressor != Compressor::NO_COMPRESSION)
+  if (encoded(tile))
     RETURN_NOT_OK(compress_tile(tile));
 
-  auto buffer =
-      (compressor == Compressor::NO_COMPRESSION) ? tile->buffer() : buffer_;
+  auto buffer = encoded(tile) ? buffer_ : tile->buffer();
 
   RETURN_NOT_OK(write_generic_tile_header(tile, buffer->size()));
   RETURN_NOT_OK(storage_manager_->write(uri_, buffer));
@@ -248,34 +305,295 @@ Status TileIO::write_generic_tile_header(Tile* tile, uint64_t compressed_size) {
 /*          PRIVATE METHODS       */
 /* ****************************** */
 
+ThreadPool* TileIO::chunk_thread_pool() const {
+  if (storage_manager_ == nullptr)
+    return nullptr;
+
+  auto pool = storage_manager_->compute_thread_pool();
+  if (pool == nullptr || pool->num_threads() < 2 || pool->is_worker())
+    return nullptr;
+
+  return pool;
+}
+
+Status TileIO::compress_chunk(
+    Tile* tile, ConstBuffer* input, Buffer* output) const {
+  if (tile->compressor() == Compressor::AUTO_COMPRESSION)
+    return compress_chunk_auto(tile, input, output);
+
+  return compress_chunk(
+      tile, tile->compressor(), tile->compression_level(), input, output);
+}
+
+Status TileIO::compress_chunk(
+    Tile* tile,
+    Compressor compressor,
+    int level,
+    ConstBuffer* input,
+    Buffer* output) const {
+  // For easy reference
+  const auto& dict = tile->compression_dictionary();
+  auto type_size = datatype_size(tile->type());
+
+  // Invoke the proper compressor
+  switch (compressor) {
+    case Compressor::NO_COMPRESSION:
+      return output->write(input, input->size());
+    case Compressor::GZIP:
+      return GZip::compress(level, input, output);
+    case Compressor::ZSTD:
+      return ZStd::compress(level, dict.get(), input, output);
+    case Compressor::LZ4:
+      return LZ4::compress(level, input, output);
+    case Compressor::BLOSC_LZ:
+      return Blosc::compress("blosclz", type_size, level, input, output);
+#undef BLOSC_LZ4
+    case Compressor::BLOSC_LZ4:
+      return Blosc::compress("lz4", type_size, level, input, output);
+#undef BLOSC_LZ4HC
+    case Compressor::BLOSC_LZ4HC:
+      return Blosc::compress("lz4hc", type_size, level, input, output);
+#undef BLOSC_SNAPPY
+    case Compressor::BLOSC_SNAPPY:
+      return Blosc::compress("snappy", type_size, level, input, output);
+#undef BLOSC_ZLIB
+    case Compressor::BLOSC_ZLIB:
+      return Blosc::compress("zlib", type_size, level, input, output);
+#undef BLOSC_ZSTD
+    case Compressor::BLOSC_ZSTD:
+      return Blosc::compress("zstd", type_size, level, input, output);
+    case Compressor::RLE:
+      return RLE::compress(tile->cell_size(), input, output);
+    case Compressor::BZIP2:
+      return BZip::compress(level, input, output);
+    case Compressor::DOUBLE_DELTA:
+      return DoubleDelta::compress(tile->type(), input, output);
+    case Compressor::FRAME_OF_REFERENCE:
+      return FrameOfReference::compress(tile->type(), input, output);
+    case Compressor::GORILLA:
+      return Gorilla::compress(tile->type(), input, output);
+    default:
+      assert(0);
+  }
+
+  return Status::Ok();
+}
+
+Status TileIO::compress_chunk_auto(
+    Tile* tile, ConstBuffer* input, Buffer* output) const {
+  // The sample consists of whole cells from the beginning of the chunk
+  auto cell_size = tile->cell_size();
+  auto sample_size =
+      MIN(input->size(), constants::auto_compression_sample_size);
+  sample_size = sample_size / cell_size * cell_size;
+  if (sample_size == 0)
+    sample_size = input->size();
+
+  // Try every applicable candidate on the sample. Without any candidate,
+  // the chunk is stored uncompressed.
+  auto candidate_num = (auto_compression_candidates_ != nullptr) ?
+                           auto_compression_candidates_->size() :
+                           0;
+  std::vector<Buffer> sample_outputs(candidate_num);
+  auto best_compressor = Compressor::NO_COMPRESSION;
+  int best_level = -1;
+  size_t best = candidate_num;
+  double best_cost = 0;
+  for (size_t i = 0; i < candidate_num; ++i) {
+    auto compressor = (*auto_compression_candidates_)[i].first;
+    auto level = (*auto_compression_candidates_)[i].second;
+    if (!auto_compression_candidate(tile, compressor))
+      continue;
+
+    // A candidate that fails on the sample is skipped
+    ConstBuffer sample(input->data(), sample_size);
+    auto sample_output = &sample_outputs[i];
+    auto st = sample_output->realloc(
+        sample_size + overhead(tile, compressor, sample_size));
+    if (st.ok())
+      st = compress_chunk(tile, compressor, level, &sample, sample_output);
+    if (!st.ok())
+      continue;
+
+    auto cost = (double)sample_output->size() +
+                decompression_cost(compressor) * sample_size;
+    if (best == candidate_num || cost < best_cost) {
+      best = i;
+      best_compressor = compressor;
+      best_level = level;
+      best_cost = cost;
+    }
+  }
+
+  // Write the chosen compressor and the compressed chunk, which is the
+  // compressed sample if the sample is the whole chunk
+  auto start = output->offset();
+  auto compressor_c = (char)best_compressor;
+  RETURN_NOT_OK(output->write(&compressor_c, sizeof(char)));
+  if (best != candidate_num && sample_size == input->size())
+    return output->write(
+        sample_outputs[best].data(), sample_outputs[best].size());
+  auto st = compress_chunk(tile, best_compressor, best_level, input, output);
+  if (st.ok() || best_compressor == Compressor::NO_COMPRESSION)
+    return st;
+
+  // The chosen compressor failed on the rest of the chunk, which is then
+  // stored uncompressed
+  output->set_offset(start);
+  output->set_size(start);
+  compressor_c = (char)Compressor::NO_COMPRESSION;
+  RETURN_NOT_OK(output->write(&compressor_c, sizeof(char)));
+  return output->write(input, input->size());
+}
+
 Status TileIO::compress_tile(Tile* tile) {
-  // Simple case - No coordinates
-  if (!tile->stores_coords())
-    return compress_one_tile(tile);
-
-  // Split coordinates
-  tile->split_coordinates();
-
-  // Compress each dimension tile
-  auto dim_num = tile->dim_num();
-  auto dim_tile_size = tile->size() / dim_num;
-  auto coord_size = tile->cell_size() / dim_num;
-  Status st;
-  for (unsigned int i = 0; i < dim_num; ++i) {
-    auto buff = new Buffer(tile->cur_data(), dim_tile_size, false);
-    auto dim_tile = new Tile(
-        tile->type(),
-        tile->compressor(),
-        tile->compression_level(),
-        coord_size,
-        dim_num,
-        buff,
-        false);
-    st = compress_one_tile(dim_tile);
-    delete buff;
-    delete dim_tile;
+  // Collect the tiles to be compressed, i.e., the tile itself or, in the
+  // case of coordinates, one tile per dimension on top of the split
+  // coordinates
+  std::vector<Tile> dim_tiles;
+  std::vector<Tile*> tiles;
+  if (!tile->stores_coords()) {
+    tiles.push_back(tile);
+  } else {
+    // Split coordinates
+    tile->split_coordinates();
+
+    auto dim_num = tile->dim_num();
+    auto dim_tile_size = tile->size() / dim_num;
+    auto coord_size = tile->cell_size() / dim_num;
+    dim_tiles.resize(dim_num);
+    tiles.reserve(dim_num);
+    for (unsigned int i = 0; i < dim_num; ++i) {
+      RETURN_NOT_OK(dim_tiles[i].init(
+          tile->type(),
+          tile->compressor(),
+          tile->compression_level(),
+          coord_size,
+          dim_num,
+          tile->cur_data(),
+          dim_tile_size));
+      tiles.push_back(&dim_tiles[i]);
+      tile->advance_offset(dim_tile_size);
+    }
+  }
+
+  // Quantize real attribute values, which are then filtered and compressed
+  // as integers
+  Buffer quantized;
+  Tile quantized_tile;
+  if (tile->quantized() && !tile->stores_coords()) {
+    auto st = (tile->type() == Datatype::FLOAT32) ?
+                  quantize<float, int32_t>(tile, &quantized) :
+                  quantize<double, int64_t>(tile, &quantized);
     RETURN_NOT_OK(st);
-    tile->advance_offset(dim_tile_size);
+    RETURN_NOT_OK(init_quantized_tile(
+        tile, quantized.data(), quantized.size(), &quantized_tile));
+    tiles[0] = &quantized_tile;
+  }
+
+  // Simple case - No filters
+  if (tile->filters().empty())
+    return compress_tiles(tiles);
+
+  // Run the filters on every tile and write the filtered sizes upfront
+  auto tile_num = tiles.size();
+  std::vector<Buffer> filtered(tile_num);
+  std::vector<Tile> filtered_tiles(tile_num);
+  std::vector<Tile*> filtered_tile_ptrs;
+  filtered_tile_ptrs.reserve(tile_num);
+  for (size_t i = 0; i < tile_num; ++i) {
+    ConstBuffer input(tiles[i]->data(), tiles[i]->size());
+    RETURN_NOT_OK(FilterPipeline::run_forward(
+        tile->filters(), tiles[i]->type(), &input, &filtered[i]));
+    auto filtered_size = filtered[i].size();
+    RETURN_NOT_OK(buffer_->write(&filtered_size, sizeof(uint64_t)));
+    RETURN_NOT_OK(init_filtered_tile(
+        tiles[i],
+        tiles[i]->cell_size(),
+        filtered[i].data(),
+        filtered_size,
+        &filtered_tiles[i]));
+    filtered_tile_ptrs.push_back(&filtered_tiles[i]);
+  }
+
+  // Without a compressor, the filtered tiles are stored as is
+  if (tile->compressor() == Compressor::NO_COMPRESSION) {
+    for (auto& f : filtered)
+      RETURN_NOT_OK(buffer_->write(f.data(), f.size()));
+    return Status::Ok();
+  }
+
+  // Compress the filtered tiles
+  return compress_tiles(filtered_tile_ptrs);
+}
+
+Status TileIO::compress_tiles(const std::vector<Tile*>& tiles) {
+  // Compute the chunking info of all tiles
+  auto tile_num = tiles.size();
+  std::vector<uint64_t> chunk_nums(tile_num);
+  std::vector<uint64_t> max_chunk_sizes(tile_num);
+  uint64_t total_chunk_num = 0, chunking_overhead;
+  for (size_t i = 0; i < tile_num; ++i) {
+    RETURN_NOT_OK(compute_chunking_info(
+        tiles[i], &chunk_nums[i], &max_chunk_sizes[i], &chunking_overhead));
+    total_chunk_num += chunk_nums[i];
+  }
+
+  // Compress sequentially if there is nothing to parallelize
+  auto pool = chunk_thread_pool();
+  if (pool == nullptr || total_chunk_num < 2) {
+    for (auto tile : tiles)
+      RETURN_NOT_OK(compress_one_tile(tile));
+    return Status::Ok();
+  }
+
+  // Compress every chunk of every tile in parallel, each into its own buffer
+  std::vector<Buffer> chunk_buffers(total_chunk_num);
+  std::vector<uint64_t> chunk_sizes(total_chunk_num);
+  std::vector<std::future<Status>> tasks;
+  tasks.reserve(total_chunk_num);
+  for (size_t i = 0, c = 0; i < tile_num; ++i) {
+    auto tile = tiles[i];
+    auto chunk_data = (const char*)tile->cur_data();
+    uint64_t left_to_compress = tile->size();
+    for (uint64_t j = 0; j < chunk_nums[i]; ++j, ++c) {
+      auto chunk_size = MIN(left_to_compress, max_chunk_sizes[i]);
+      auto output = &chunk_buffers[c];
+      chunk_sizes[c] = chunk_size;
+      tasks.emplace_back(
+          pool->enqueue([this, tile, chunk_data, chunk_size, output]() {
+            RETURN_NOT_OK(
+                output->realloc(chunk_size + overhead(tile, chunk_size)));
+            ConstBuffer input(chunk_data, chunk_size);
+            return compress_chunk(tile, &input, output);
+          }));
+      chunk_data += chunk_size;
+      left_to_compress -= chunk_size;
+    }
+    assert(left_to_compress == 0);
+  }
+
+  auto st = Status::Ok();
+  for (auto& task : tasks) {
+    auto task_st = task.get();
+    if (st.ok() && !task_st.ok())
+      st = task_st;
+  }
+  RETURN_NOT_OK(st);
+
+  // Write the compressed chunks in order, each preceded by its original
+  // and compressed size, and the chunks of each tile preceded by their
+  // number
+  for (size_t i = 0, c = 0; i < tile_num; ++i) {
+    RETURN_NOT_OK(buffer_->write(&chunk_nums[i], sizeof(uint64_t)));
+    for (uint64_t j = 0; j < chunk_nums[i]; ++j, ++c) {
+      uint64_t compressed_chunk_size = chunk_buffers[c].size();
+      RETURN_NOT_OK(buffer_->write(&chunk_sizes[c], sizeof(uint64_t)));
+      RETURN_NOT_OK(buffer_->write(&compressed_chunk_size, sizeof(uint64_t)));
+      RETURN_NOT_OK(
+          buffer_->write(chunk_buffers[c].data(), compressed_chunk_size));
+    }
+    tiles[i]->advance_offset(tiles[i]->size());
   }
 
   return Status::Ok();
@@ -283,11 +601,6 @@ Status TileIO::compress_tile(Tile* tile) {
 
 Status TileIO::compress_one_tile(Tile* tile) {
   // For easy reference
-  auto level = tile->compression_level();
-  auto type_size = datatype_size(tile->type());
-  auto compressor = tile->compressor();
-  auto type = tile->type();
-  auto cell_size = tile->cell_size();
   auto tile_size = tile->size();
 
   // Compute necessary info for chunking
@@ -302,7 +615,6 @@ Status TileIO::compress_one_tile(Tile* tile) {
   RETURN_NOT_OK(buffer_->write(&chunk_num, sizeof(uint64_t)));
 
   // Compress in chunks
-  Status st;
   uint64_t compressed_chunk_size = 0;
   uint64_t left_to_compress = tile_size;
   for (uint64_t i = 0; i < chunk_num; ++i) {
@@ -313,59 +625,9 @@ Status TileIO::compress_one_tile(Tile* tile) {
     uint64_t buffer_offset = buffer_->offset();  // Will be used later
     RETURN_NOT_OK(buffer_->write(&compressed_chunk_size, sizeof(uint64_t)));
 
-    // Create const buffer
-    auto input_buffer = new ConstBuffer(tile->cur_data(), chunk_size);
-
-    // Invoke the proper compressor
-    switch (compressor) {
-      case Compressor::GZIP:
-        st = GZip::compress(level, input_buffer, buffer_);
-        break;
-      case Compressor::ZSTD:
-        st = ZStd::compress(level, input_buffer, buffer_);
-        break;
-      case Compressor::LZ4:
-        st = LZ4::compress(level, input_buffer, buffer_);
-        break;
-      case Compressor::BLOSC_LZ:
-        st =
-            Blosc::compress("blosclz", type_size, level, input_buffer, buffer_);
-        break;
-#undef BLOSC_LZ4
-      case Compressor::BLOSC_LZ4:
-        st = Blosc::compress("lz4", type_size, level, input_buffer, buffer_);
-        break;
-#undef BLOSC_LZ4HC
-      case Compressor::BLOSC_LZ4HC:
-        st = Blosc::compress("lz4hc", type_size, level, input_buffer, buffer_);
-        break;
-#undef BLOSC_SNAPPY
-      case Compressor::BLOSC_SNAPPY:
-        st = Blosc::compress("snappy", type_size, level, input_buffer, buffer_);
-        break;
-#undef BLOSC_ZLIB
-      case Compressor::BLOSC_ZLIB:
-        st = Blosc::compress("zlib", type_size, level, input_buffer, buffer_);
-        break;
-#undef BLOSC_ZSTD
-      case Compressor::BLOSC_ZSTD:
-        st = Blosc::compress("zstd", type_size, level, input_buffer, buffer_);
-        break;
-      case Compressor::RLE:
-        st = RLE::compress(cell_size, input_buffer, buffer_);
-        break;
-      case Compressor::BZIP2:
-        st = BZip::compress(level, input_buffer, buffer_);
-        break;
-      case Compressor::DOUBLE_DELTA:
-        st = DoubleDelta::compress(type, input_buffer, buffer_);
-        break;
-      default:
-        assert(0);
-    }
-
-    delete input_buffer;
-    RETURN_NOT_OK(st);
+    // Compress chunk
+    ConstBuffer input_buffer(tile->cur_data(), chunk_size);
+    RETURN_NOT_OK(compress_chunk(tile, &input_buffer, buffer_));
 
     // Write compressed chunk size
     compressed_chunk_size =
@@ -392,23 +654,31 @@ Status TileIO::compute_chunking_info(
   auto cell_size = tile->cell_size();
   auto tile_size = tile->size();
 
-  // Compute max chunk size
-  *max_chunk_size = MIN(constants::tile_chunk_size, tile_size);
+  // The compressors operate on `int` sizes, so a chunk along with its
+  // compression overhead must not exceed INT_MAX
+  const uint64_t chunk_size_limit = INT_MAX;
+
+  // Compute max chunk size (a multiple of the cell size, holding at least
+  // one cell)
+  *max_chunk_size = MIN(MIN(tile_chunk_size_, chunk_size_limit), tile_size);
   *max_chunk_size = *max_chunk_size / cell_size * cell_size;
+  if (*max_chunk_size == 0)
+    *max_chunk_size = MIN(cell_size, tile_size);
   uint64_t chunk_overhead = this->overhead(tile, *max_chunk_size);
 
   // Adjust max chunk size
-  if (*max_chunk_size + chunk_overhead > constants::tile_chunk_size) {
+  if (*max_chunk_size + chunk_overhead > chunk_size_limit) {
     *max_chunk_size -= chunk_overhead;
     *max_chunk_size = (*max_chunk_size) / cell_size * cell_size;
     chunk_overhead = this->overhead(tile, *max_chunk_size);
   }
 
   // Handle special error
-  if (*max_chunk_size + chunk_overhead > constants::tile_chunk_size) {
+  if (*max_chunk_size == 0 ||
+      *max_chunk_size + chunk_overhead > chunk_size_limit) {
     return LOG_STATUS(
         Status::TileIOError("Compute chunking info failed; Consider adjusting "
-                            "constants::tile_chunk_size"));
+                            "the sm.tile_chunk_size config parameter"));
   }
 
   // Compute number of chunks
@@ -424,89 +694,472 @@ Status TileIO::compute_chunking_info(
   return Status::Ok();
 }
 
-Status TileIO::decompress_tile(Tile* tile) {
-  // Simple case - No coordinates
-  if (!tile->stores_coords())
-    return decompress_one_tile(tile);
+Status TileIO::decompress_chunk(
+    Tile* tile, ConstBuffer* input, Buffer* output) const {
+  if (tile->compressor() != Compressor::AUTO_COMPRESSION)
+    return decompress_chunk(tile, tile->compressor(), input, output);
 
-  // Decompress each dimension tile
-  auto dim_num = tile->dim_num();
-  for (unsigned int i = 0; i < dim_num; ++i)
-    RETURN_NOT_OK(decompress_one_tile(tile));
+  // Read the compressor the chunk was compressed with
+  char compressor;
+  RETURN_NOT_OK(input->read(&compressor, sizeof(char)));
+  if (compressor == (char)Compressor::AUTO_COMPRESSION ||
+      (unsigned char)compressor > (unsigned char)Compressor::GORILLA)
+    return LOG_STATUS(Status::TileIOError(
+        "Cannot decompress chunk; Invalid chunk compressor"));
+
+  ConstBuffer chunk(
+      (const char*)input->data() + sizeof(char), input->size() - sizeof(char));
+  return decompress_chunk(tile, (Compressor)compressor, &chunk, output);
+}
 
-  // Zip coordinates
-  tile->zip_coordinates();
+Status TileIO::decompress_chunk(
+    Tile* tile,
+    Compressor compressor,
+    ConstBuffer* input,
+    Buffer* output) const {
+  // Invoke the proper decompressor
+  switch (compressor) {
+    case Compressor::NO_COMPRESSION:
+      return output->write(input, input->size());
+    case Compressor::GZIP:
+      return GZip::decompress(input, output);
+    case Compressor::ZSTD:
+      return ZStd::decompress(
+          tile->compression_dictionary().get(), input, output);
+    case Compressor::LZ4:
+      return LZ4::decompress(input, output);
+    case Compressor::BLOSC_LZ:
+#undef BLOSC_LZ4
+    case Compressor::BLOSC_LZ4:
+#undef BLOSC_LZ4HC
+    case Compressor::BLOSC_LZ4HC:
+#undef BLOSC_SNAPPY
+    case Compressor::BLOSC_SNAPPY:
+#undef BLOSC_ZLIB
+    case Compressor::BLOSC_ZLIB:
+#undef BLOSC_ZSTD
+    case Compressor::BLOSC_ZSTD:
+      return Blosc::decompress(input, output);
+    case Compressor::RLE:
+      return RLE::decompress(
+          tile->cell_size(), format_version_, input, output);
+    case Compressor::BZIP2:
+      return BZip::decompress(input, output);
+    case Compressor::DOUBLE_DELTA:
+      return DoubleDelta::decompress(tile->type(), input, output);
+    case Compressor::FRAME_OF_REFERENCE:
+      return FrameOfReference::decompress(tile->type(), input, output);
+    case Compressor::GORILLA:
+      return Gorilla::decompress(tile->type(), input, output);
+    case Compressor::AUTO_COMPRESSION:
+      assert(0);
+      break;
+  }
 
   return Status::Ok();
 }
 
-Status TileIO::decompress_one_tile(Tile* tile) {
-  // Read number of chunks
-  uint64_t chunk_num;
-
-  RETURN_NOT_OK(buffer_->read(&chunk_num, sizeof(uint64_t)));
-  assert(chunk_num > 0);
-
-  Status st;
-  Datatype type = tile->type();
-  for (uint64_t i = 0; i < chunk_num; ++i) {
-    // Read original and compressed chunk size
-    uint64_t chunk_size, compressed_chunk_size;
-    RETURN_NOT_OK(buffer_->read(&chunk_size, sizeof(uint64_t)));
-    RETURN_NOT_OK(buffer_->read(&compressed_chunk_size, sizeof(uint64_t)));
-
-    auto input_buffer =
-        new ConstBuffer(buffer_->cur_data(), compressed_chunk_size);
-
-    // Invoke the proper decompressor
-    switch (tile->compressor()) {
-      case Compressor::NO_COMPRESSION:
-        assert(0);
-        break;
-      case Compressor::GZIP:
-        st = GZip::decompress(input_buffer, tile->buffer());
-        break;
-      case Compressor::ZSTD:
-        st = ZStd::decompress(input_buffer, tile->buffer());
-        break;
-      case Compressor::LZ4:
-        st = LZ4::decompress(input_buffer, tile->buffer());
-        break;
-      case Compressor::BLOSC_LZ:
+double TileIO::decompression_cost(Compressor compressor) {
+  // Rough relative costs: LZ4-class codecs decode close to memory
+  // bandwidth, whereas the entropy coders are several times slower
+  switch (compressor) {
+    case Compressor::NO_COMPRESSION:
+      return 0;
+    case Compressor::LZ4:
+    case Compressor::RLE:
+    case Compressor::FRAME_OF_REFERENCE:
+      return 0.05;
+    case Compressor::DOUBLE_DELTA:
+    case Compressor::GORILLA:
+    case Compressor::BLOSC_LZ:
 #undef BLOSC_LZ4
-      case Compressor::BLOSC_LZ4:
+    case Compressor::BLOSC_LZ4:
 #undef BLOSC_LZ4HC
-      case Compressor::BLOSC_LZ4HC:
+    case Compressor::BLOSC_LZ4HC:
 #undef BLOSC_SNAPPY
-      case Compressor::BLOSC_SNAPPY:
-#undef BLOSC_ZLIB
-      case Compressor::BLOSC_ZLIB:
+    case Compressor::BLOSC_SNAPPY:
+      return 0.1;
+    case Compressor::ZSTD:
 #undef BLOSC_ZSTD
-      case Compressor::BLOSC_ZSTD:
-        st = Blosc::decompress(input_buffer, tile->buffer());
-        break;
-      case Compressor::RLE:
-        st = RLE::decompress(tile->cell_size(), input_buffer, tile->buffer());
-        break;
-      case Compressor::BZIP2:
-        st = BZip::decompress(input_buffer, tile->buffer());
-        break;
-      case Compressor::DOUBLE_DELTA:
-        st = DoubleDelta::decompress(type, input_buffer, tile->buffer());
-        break;
+    case Compressor::BLOSC_ZSTD:
+      return 0.15;
+    case Compressor::GZIP:
+#undef BLOSC_ZLIB
+    case Compressor::BLOSC_ZLIB:
+      return 0.4;
+    default:
+      return 1;
+  }
+}
+
+Status TileIO::decompress_tile(Tile* tile, Buffer* input) {
+  // For easy reference
+  unsigned int tile_num = tile->stores_coords() ? tile->dim_num() : 1;
+  auto filtered = !tile->filters().empty();
+  auto compressed = tile->compressor() != Compressor::NO_COMPRESSION;
+  auto quantized = tile->quantized() && !tile->stores_coords();
+
+  // Quantized real values are filtered and compressed as integers, so the
+  // data are decoded with the parameters of an integer tile
+  Tile quantized_tile;
+  auto codec_tile = tile;
+  if (quantized) {
+    RETURN_NOT_OK(init_quantized_tile(tile, nullptr, 0, &quantized_tile));
+    codec_tile = &quantized_tile;
+  }
+
+  // Read the filtered sizes and create one tile on top of each filtered
+  // (dimension) tile, either in a staging buffer the chunks are
+  // decompressed into (reused by all the tiles of this thread, up to a
+  // maximum size), or directly in the input buffer if uncompressed
+  static thread_local Buffer staging;
+  StagingBufferRelease staging_release(&staging);
+  staging.reset_size();
+  std::vector<Tile> filtered_tiles;
+  std::vector<uint64_t> filtered_sizes;
+  uint64_t filtered_total = 0;
+  if (filtered) {
+    filtered_sizes.resize(tile_num);
+    for (unsigned int i = 0; i < tile_num; ++i) {
+      RETURN_NOT_OK(input->read(&filtered_sizes[i], sizeof(uint64_t)));
+      filtered_total += filtered_sizes[i];
     }
 
-    delete input_buffer;
-    RETURN_NOT_OK(st);
+    char* filtered_data;
+    if (compressed) {
+      RETURN_NOT_OK(staging.realloc(filtered_total));
+      filtered_data = (char*)staging.data();
+    } else {
+      if (filtered_total > input->size() - input->offset())
+        return LOG_STATUS(Status::TileIOError(
+            "Cannot decompress tile; Invalid filtered tile size"));
+      filtered_data = (char*)input->cur_data();
+      input->advance_offset(filtered_total);
+    }
+
+    // The filtered tiles of coordinates hold one dimension each
+    auto cell_size = tile->cell_size() / tile_num;
+    filtered_tiles.resize(tile_num);
+    for (unsigned int i = 0; i < tile_num; ++i) {
+      RETURN_NOT_OK(init_filtered_tile(
+          codec_tile,
+          cell_size,
+          filtered_data,
+          filtered_sizes[i],
+          &filtered_tiles[i]));
+      filtered_data += filtered_sizes[i];
+    }
+  }
 
-    buffer_->advance_offset(compressed_chunk_size);
+  // Decompress
+  if (compressed) {
+    auto output = filtered ? &staging : tile->buffer();
+    RETURN_NOT_OK(decompress_chunks(
+        codec_tile,
+        filtered ? &filtered_tiles : nullptr,
+        tile_num,
+        input,
+        output));
+    if (filtered && staging.size() != filtered_total)
+      return LOG_STATUS(Status::TileIOError(
+          "Cannot decompress tile; Unexpected decompressed size"));
   }
 
-  return st;
+  // Reverse the filters
+  for (unsigned int i = 0; filtered && i < tile_num; ++i) {
+    ConstBuffer input(filtered_tiles[i].data(), filtered_sizes[i]);
+    RETURN_NOT_OK(FilterPipeline::run_reverse(
+        tile->filters(), codec_tile->type(), &input, tile->buffer()));
+  }
+
+  // Dequantize
+  if (quantized) {
+    if (tile->type() == Datatype::FLOAT32)
+      dequantize<float, int32_t>(tile);
+    else
+      dequantize<double, int64_t>(tile);
+  }
+
+  // Zip coordinates
+  if (tile->stores_coords())
+    tile->zip_coordinates();
+
+  return Status::Ok();
+}
+
+template <class T, class I>
+void TileIO::dequantize(Tile* tile) {
+  auto scale = std::pow(T(10), T(tile->quantization_digits()));
+  auto data = (char*)tile->data();
+  auto value_num = tile->size() / sizeof(T);
+  for (uint64_t i = 0; i < value_num; ++i) {
+    I q;
+    std::memcpy(&q, data + i * sizeof(T), sizeof(I));
+    auto v = (q == std::numeric_limits<I>::min()) ?
+                 std::numeric_limits<T>::max() :
+                 T(q) / scale;
+    std::memcpy(data + i * sizeof(T), &v, sizeof(T));
+  }
+}
+
+Status TileIO::decompress_chunks(
+    Tile* tile,
+    std::vector<Tile>* filtered_tiles,
+    unsigned int tile_num,
+    Buffer* input,
+    Buffer* output) {
+  // Parse the chunk headers of all (dimension) tiles
+  std::vector<Tile*> chunk_tiles;
+  std::vector<const void*> chunk_data;
+  std::vector<uint64_t> chunk_sizes, compressed_chunk_sizes;
+  uint64_t total_size = 0;
+  for (unsigned int i = 0; i < tile_num; ++i) {
+    // Read number of chunks
+    uint64_t chunk_num;
+    RETURN_NOT_OK(input->read(&chunk_num, sizeof(uint64_t)));
+    assert(chunk_num > 0);
+
+    auto chunk_tile =
+        (filtered_tiles != nullptr) ? &(*filtered_tiles)[i] : tile;
+    for (uint64_t j = 0; j < chunk_num; ++j) {
+      // Read original and compressed chunk size
+      uint64_t chunk_size, compressed_chunk_size;
+      RETURN_NOT_OK(input->read(&chunk_size, sizeof(uint64_t)));
+      RETURN_NOT_OK(input->read(&compressed_chunk_size, sizeof(uint64_t)));
+      if (compressed_chunk_size > input->size() - input->offset())
+        return LOG_STATUS(Status::TileIOError(
+            "Cannot decompress tile; Invalid compressed chunk size"));
+
+      chunk_tiles.push_back(chunk_tile);
+      chunk_data.push_back(input->cur_data());
+      chunk_sizes.push_back(chunk_size);
+      compressed_chunk_sizes.push_back(compressed_chunk_size);
+      total_size += chunk_size;
+      input->advance_offset(compressed_chunk_size);
+    }
+  }
+
+  // Each chunk is decompressed directly into its (disjoint) position in the
+  // output, through a buffer that wraps that position and thus bounds the
+  // decompressed chunk size
+  if (total_size > output->free_space())
+    return LOG_STATUS(Status::TileIOError(
+        "Cannot decompress tile; Tile buffer is too small"));
+
+  auto chunk_num = chunk_data.size();
+  auto dest = (char*)output->cur_data();
+  auto pool = chunk_thread_pool();
+  if (pool == nullptr || chunk_num < 2) {
+    // Sequentially
+    for (size_t c = 0; c < chunk_num; ++c) {
+      Buffer chunk_output(dest, chunk_sizes[c], false);
+      chunk_output.reset_size();
+      ConstBuffer input_buffer(chunk_data[c], compressed_chunk_sizes[c]);
+      RETURN_NOT_OK(
+          decompress_chunk(chunk_tiles[c], &input_buffer, &chunk_output));
+      if (chunk_output.size() != chunk_sizes[c])
+        return LOG_STATUS(Status::TileIOError(
+            "Cannot decompress tile; Unexpected decompressed chunk size"));
+      dest += chunk_sizes[c];
+    }
+    output->advance_size(total_size);
+    output->advance_offset(total_size);
+    return Status::Ok();
+  }
+
+  // In parallel
+  std::vector<std::future<Status>> tasks;
+  tasks.reserve(chunk_num);
+  for (size_t c = 0; c < chunk_num; ++c) {
+    auto chunk_tile = chunk_tiles[c];
+    auto input_data = chunk_data[c];
+    auto input_size = compressed_chunk_sizes[c];
+    auto chunk_size = chunk_sizes[c];
+    tasks.emplace_back(pool->enqueue(
+        [this, chunk_tile, input_data, input_size, chunk_size, dest]() {
+          Buffer chunk_output(dest, chunk_size, false);
+          chunk_output.reset_size();
+          ConstBuffer input(input_data, input_size);
+          RETURN_NOT_OK(decompress_chunk(chunk_tile, &input, &chunk_output));
+          if (chunk_output.size() != chunk_size)
+            return LOG_STATUS(Status::TileIOError(
+                "Cannot decompress tile; Unexpected decompressed chunk "
+                "size"));
+          return Status::Ok();
+        }));
+    dest += chunk_size;
+  }
+
+  auto st = Status::Ok();
+  for (auto& task : tasks) {
+    auto task_st = task.get();
+    if (st.ok() && !task_st.ok())
+      st = task_st;
+  }
+  RETURN_NOT_OK(st);
+
+  output->advance_size(total_size);
+  output->advance_offset(total_size);
+
+  return Status::Ok();
+}
+
+bool TileIO::encoded(const Tile* tile) const {
+  return tile->compressor() != Compressor::NO_COMPRESSION ||
+         !tile->filters().empty();
+}
+
+Status TileIO::init_filtered_tile(
+    const Tile* tile,
+    uint64_t cell_size,
+    void* data,
+    uint64_t size,
+    Tile* filtered_tile) const {
+  auto whole_cells = (cell_size != 0 && size % cell_size == 0);
+  return filtered_tile->init(
+      whole_cells ? tile->type() : Datatype::UINT8,
+      tile->compressor(),
+      tile->compression_level(),
+      whole_cells ? cell_size : 1,
+      0,
+      data,
+      size);
+}
+
+Status TileIO::init_quantized_tile(
+    const Tile* tile, void* data, uint64_t size, Tile* quantized_tile) const {
+  RETURN_NOT_OK(quantized_tile->init(
+      (tile->type() == Datatype::FLOAT32) ? Datatype::INT32 : Datatype::INT64,
+      tile->compressor(),
+      tile->compression_level(),
+      tile->cell_size(),
+      0,
+      data,
+      size));
+  quantized_tile->set_compression_dictionary(tile->compression_dictionary());
+  return Status::Ok();
+}
+
+Status TileIO::load(
+    Tile* tile,
+    uint64_t file_offset,
+    uint64_t compressed_size,
+    uint64_t tile_size,
+    bool cached) {
+  // No compression
+  if (!encoded(tile))
+    return storage_manager_->read(uri_, file_offset, tile->buffer(), tile_size);
+
+  // Compression - try the compressed tile cache first, treating an object
+  // of a different size as stale (see `read`)
+  std::shared_ptr<Buffer> compressed;
+  bool in_cache = false, stale = false;
+  if (cached) {
+    RETURN_NOT_OK(storage_manager_->read_from_compressed_cache(
+        uri_, file_offset, &compressed, &in_cache, cache_fill_));
+    if (in_cache && compressed->size() != compressed_size) {
+      in_cache = false;
+      stale = true;
+      compressed.reset();
+    }
+  }
+
+  // Read the compressed data into a new buffer shared with the compressed
+  // tile cache if they fit, or else into a staging buffer that is reused
+  // by all the reads of this thread (up to a maximum size)
+  static thread_local Buffer staging;
+  StagingBufferRelease staging_release(&staging);
+  if (!in_cache && cached && cache_fill_ &&
+      compressed_size <= storage_manager_->compressed_cache_max_size()) {
+    compressed = std::make_shared<Buffer>();
+    RETURN_NOT_OK(storage_manager_->read(
+        uri_, file_offset, compressed.get(), compressed_size));
+    RETURN_NOT_OK(storage_manager_->write_to_compressed_cache(
+        uri_, file_offset, compressed, stale));
+  } else if (!in_cache) {
+    RETURN_NOT_OK(
+        storage_manager_->read(uri_, file_offset, &staging, compressed_size));
+  }
+
+  // Shared buffers are read through a view, since other readers may use
+  // them concurrently
+  Buffer view(
+      compressed != nullptr ? compressed->data() : nullptr,
+      compressed != nullptr ? compressed->size() : 0,
+      false);
+  auto input = compressed != nullptr ? &view : &staging;
+
+  // Decompress tile
+  tile->reset_offset();
+  tile->reset_size();
+  RETURN_NOT_OK(tile->realloc(tile_size));
+  RETURN_NOT_OK(decompress_tile(tile, input));
+  tile->reset_offset();
+
+  return Status::Ok();
+}
+
+template <class T, class I>
+Status TileIO::quantize(const Tile* tile, Buffer* output) {
+  static_assert(sizeof(T) == sizeof(I), "Quantized values must keep width");
+
+  // Scaled values must lie in (-2^b, 2^b), where b is the number of value
+  // bits of I. The lowest value of I, -2^b, is reserved for the value that
+  // fills empty dense cells (`constants::empty_float32/64`, i.e., the
+  // maximum value of T), which does not fit otherwise
+  auto scale = std::pow(T(10), T(tile->quantization_digits()));
+  auto limit = std::ldexp(T(1), std::numeric_limits<I>::digits);
+  auto data = (const char*)tile->data();
+  auto value_num = tile->size() / sizeof(T);
+  RETURN_NOT_OK(output->realloc(output->size() + value_num * sizeof(I)));
+  for (uint64_t i = 0; i < value_num; ++i) {
+    T v;
+    std::memcpy(&v, data + i * sizeof(T), sizeof(T));
+    if (v == std::numeric_limits<T>::max()) {
+      auto q = std::numeric_limits<I>::min();
+      RETURN_NOT_OK(output->write(&q, sizeof(I)));
+      continue;
+    }
+    auto scaled = std::round(v * scale);
+    if (!(scaled > -limit && scaled < limit))
+      return LOG_STATUS(Status::TileIOError(
+          "Cannot quantize tile; Value is not finite or out of range for the "
+          "quantization precision"));
+    auto q = (I)scaled;
+    RETURN_NOT_OK(output->write(&q, sizeof(I)));
+  }
+
+  return Status::Ok();
+}
+
+bool TileIO::auto_compression_candidate(
+    const Tile* tile, Compressor compressor) const {
+  auto real = tile->type() == Datatype::FLOAT32 ||
+              tile->type() == Datatype::FLOAT64;
+  auto integer_only = compressor == Compressor::DOUBLE_DELTA ||
+                      compressor == Compressor::FRAME_OF_REFERENCE;
+  if (compressor == Compressor::GORILLA)
+    return real;
+  return !(real && integer_only);
 }
 
 uint64_t TileIO::overhead(Tile* tile, uint64_t nbytes) const {
-  switch (tile->compressor()) {
+  if (tile->compressor() != Compressor::AUTO_COMPRESSION)
+    return overhead(tile, tile->compressor(), nbytes);
+
+  // The chosen compressor byte, plus the largest candidate overhead
+  uint64_t max_overhead = 0;
+  if (auto_compression_candidates_ != nullptr) {
+    for (const auto& candidate : *auto_compression_candidates_)
+      max_overhead =
+          std::max(max_overhead, overhead(tile, candidate.first, nbytes));
+  }
+  return sizeof(char) + max_overhead;
+}
+
+uint64_t TileIO::overhead(
+    Tile* tile, Compressor compressor, uint64_t nbytes) const {
+  switch (compressor) {
     case Compressor::GZIP:
       return GZip::overhead(nbytes);
     case Compressor::ZSTD:
@@ -531,6 +1184,10 @@ uint64_t TileIO::overhead(Tile* tile, uint64_t nbytes) const {
       return BZip::overhead(nbytes);
     case Compressor::DOUBLE_DELTA:
       return DoubleDelta::overhead(nbytes);
+    case Compressor::FRAME_OF_REFERENCE:
+      return FrameOfReference::overhead(nbytes);
+    case Compressor::GORILLA:
+      return Gorilla::overhead(nbytes);
     default:
       // No compression
       return 0;
@@ -33,6 +33,8 @@
 #ifndef TILEDB_TILE_IO_H
 #define TILEDB_TILE_IO_H
 
+#include <vector>
+
 #include "tiledb/sm/misc/uri.h"
 #include "tiledb/sm/storage_manager/storage_manager.h"
 #include "tiledb/sm/tile/tile.h"
@@ -80,7 +82,15 @@ class TileIO {
   uint64_t file_size() const;
 
   /**
-   * Reads into a tile from the file.
+   * Reads into a tile from the file. The tile data are shared with the tile
+   * cache: on a cache hit the tile simply references the cached buffer,
+   * and on a miss the tile is decompressed directly into a new buffer that
+   * is then inserted into the cache without copying. The tile data must
+   * therefore be treated as read-only. On a miss, the compressed data are
+   * taken from the compressed tile cache if possible, which promotes the
+   * tile to the tile cache without reading from the file. If cache fill is
+   * disabled (see `set_cache_fill`), the caches are only looked up, and
+   * the tiles found are not promoted to their protected segments.
    *
    * @param tile The tile to read into.
    * @param file_offset The offset in the file to read from.
@@ -126,6 +136,29 @@ class TileIO {
       uint64_t* compressed_size,
       uint64_t* header_size);
 
+  /**
+   * Sets whether the tiles read from the file are inserted into the tile
+   * caches (by default `true`).
+   */
+  void set_cache_fill(bool cache_fill);
+
+  /**
+   * Sets the format version the tiles to be read were written in (by
+   * default the current `constants::format_version`).
+   */
+  void set_format_version(uint32_t format_version);
+
+  /**
+   * Compresses a tile into the internal buffer, without writing it to the
+   * file. The result is written with `write_compressed`. This allows
+   * compressing multiple tiles in parallel (each with its own TileIO
+   * object), and then appending them to the file in order.
+   *
+   * @param tile The tile to be compressed.
+   * @return Status
+   */
+  Status compress(Tile* tile);
+
   /**
    * Writes (appends) a tile into the file.
    *
@@ -137,6 +170,16 @@ class TileIO {
    */
   Status write(Tile* tile, uint64_t* bytes_written);
 
+  /**
+   * Writes (appends) a tile that was previously prepared with `compress`
+   * into the file.
+   *
+   * @param tile The tile to be written.
+   * @param bytes_written The actual number of bytes written.
+   * @return Status
+   */
+  Status write_compressed(Tile* tile, uint64_t* bytes_written);
+
   /**
    * Writes a tile generically to the file. This means that a header will be
    * prepended to the file before writing the tile contents. The reason is
@@ -169,30 +212,116 @@ class TileIO {
    */
   Buffer* buffer_;
 
+  /** Whether the tiles read from the file are inserted into the caches. */
+  bool cache_fill_;
+
   /** The size of the file pointed by `uri_`. */
   uint64_t file_size_;
 
+  /** The format version the tiles read were written in. */
+  uint32_t format_version_;
+
   /** The storage manager object. */
   StorageManager* storage_manager_;
 
+  /**
+   * The maximum size of the chunks a tile is split into upon compression
+   * (set from the `sm.tile_chunk_size` config parameter).
+   */
+  uint64_t tile_chunk_size_;
+
   /** The file URI. */
   URI uri_;
 
+  /**
+   * The candidate compressors (with their levels) that the
+   * `AUTO_COMPRESSION` compressor picks from for every chunk (set from the
+   * `sm.auto_compression_candidates` config parameter).
+   */
+  const std::vector<std::pair<Compressor, int>>* auto_compression_candidates_;
+
   /* ********************************* */
   /*          PRIVATE METHODS          */
   /* ********************************* */
 
+  /**
+   * Returns the thread pool the chunks of a tile are (de)compressed on, or
+   * `nullptr` if the chunks must be processed sequentially. The latter is
+   * the case when the pool has a single thread, or when the caller is
+   * itself a task of the pool (e.g., a query compressing multiple tiles in
+   * parallel), since a task must not wait on other tasks of its own pool.
+   */
+  ThreadPool* chunk_thread_pool() const;
+
+  /**
+   * Compresses a single chunk with the compressor of the input tile,
+   * appending the compressed data to `output`.
+   *
+   * @param tile The tile the chunk belongs to.
+   * @param input The chunk to be compressed.
+   * @param output The buffer the compressed chunk is appended to.
+   * @return Status
+   */
+  Status compress_chunk(Tile* tile, ConstBuffer* input, Buffer* output) const;
+
+  /**
+   * Compresses a single chunk of the input tile with the input compressor
+   * and level, appending the compressed data to `output`.
+   *
+   * @param tile The tile the chunk belongs to.
+   * @param compressor The compressor to use.
+   * @param level The compression level to use.
+   * @param input The chunk to be compressed.
+   * @param output The buffer the compressed chunk is appended to.
+   * @return Status
+   */
+  Status compress_chunk(
+      Tile* tile,
+      Compressor compressor,
+      int level,
+      ConstBuffer* input,
+      Buffer* output) const;
+
+  /**
+   * Compresses a single chunk of an `AUTO_COMPRESSION` tile. Every
+   * applicable candidate compressor is tried on a sample of the chunk and
+   * the one with the lowest estimated read cost (the compressed size plus
+   * the decompression cost, see `decompression_cost`) is used on the whole
+   * chunk. The chosen compressor is written as a single byte before the
+   * compressed data.
+   *
+   * @param tile The tile the chunk belongs to.
+   * @param input The chunk to be compressed.
+   * @param output The buffer the compressed chunk is appended to.
+   * @return Status
+   */
+  Status compress_chunk_auto(
+      Tile* tile, ConstBuffer* input, Buffer* output) const;
+
   /**
    * Compresses a tile. The compressed data are written in buffer_.
    * Note that a coordinates tile must be split into one tile per
-   * dimension. In that case *compress_one_tile* will be invoked
-   * for each dimension sub-tile.
+   * dimension. In that case *compress_tiles* will be invoked
+   * on the dimension sub-tiles. If the tile has filters, each (dimension)
+   * tile is first run through the filter pipeline, the filtered sizes are
+   * written in buffer_, and the filtered tiles are then compressed (or
+   * stored as is if the tile has no compressor).
    *
    * @param tile The tile to be compressed.
    * @return Status
    */
   Status compress_tile(Tile* tile);
 
+  /**
+   * Compresses the input tiles one after the other into buffer_. The
+   * chunks of all tiles are compressed in parallel when possible (see
+   * `chunk_thread_pool`).
+   *
+   * @param tiles The tiles to be compressed.
+   * @return Status
+   */
+  Status compress_tiles(const std::vector<Tile*>& tiles);
+
   /**
    * Compresses a single tile. The compressed data are written in buffer_.
    *
@@ -217,26 +346,169 @@ class TileIO {
       uint64_t* overhead);
 
   /**
-   * Decompresses buffer_ into a tile.
-   * Note that a coordinates tile was split into one tile per
-   * dimension. In that case *decompress_one_tile* will be invoked
-   * for each dimension sub-tile.
+   * Decompresses a single chunk with the compressor of the input tile,
+   * appending the decompressed data to `output`.
    *
-   * @param tile The tile where the decompressed data will be stored.
+   * @param tile The tile the chunk belongs to.
+   * @param input The chunk to be decompressed.
+   * @param output The buffer the decompressed chunk is appended to.
    * @return Status
    */
-  Status decompress_tile(Tile* tile);
+  Status decompress_chunk(
+      Tile* tile, ConstBuffer* input, Buffer* output) const;
 
   /**
-   * Decompresses buffer_ into a tile.
+   * Decompresses a single chunk of the input tile with the input
+   * compressor, appending the decompressed data to `output`.
+   *
+   * @param tile The tile the chunk belongs to.
+   * @param compressor The compressor the chunk was compressed with.
+   * @param input The chunk to be decompressed.
+   * @param output The buffer the decompressed chunk is appended to.
+   * @return Status
+   */
+  Status decompress_chunk(
+      Tile* tile,
+      Compressor compressor,
+      ConstBuffer* input,
+      Buffer* output) const;
+
+  /**
+   * Returns the estimated cost of decompressing one byte with the input
+   * compressor, expressed in bytes read, i.e., a chunk compressed into
+   * `n` bytes out of `m` is estimated to cost as much to read as
+   * `n + decompression_cost * m` uncompressed bytes.
+   */
+  static double decompression_cost(Compressor compressor);
+
+  /**
+   * Decompresses the input buffer into a tile, reversing its filters if
+   * any. Note that a coordinates tile was split into one tile per
+   * dimension, each compressed in its own chunks; the coordinates are
+   * zipped back after decompression.
    *
    * @param tile The tile where the decompressed data will be stored.
+   * @param input The buffer holding the encoded tile, read from its
+   *     current offset.
+   * @return Status
+   */
+  Status decompress_tile(Tile* tile, Buffer* input);
+
+  /**
+   * Reverts the quantization of the (real) values of the input tile in
+   * place, dividing each integer of type `I` by `10^digits`. The lowest
+   * integer is restored to the empty fill value.
+   */
+  template <class T, class I>
+  static void dequantize(Tile* tile);
+
+  /**
+   * Parses the chunk headers of `tile_num` (dimension) tiles from `input`
+   * and decompresses the chunks into `output`, in parallel when possible
+   * (see `chunk_thread_pool`).
+   *
+   * @param tile The tile being decompressed.
+   * @param filtered_tiles If not `nullptr`, the tiles on top of the
+   *     filtered data, which the chunks of each (dimension) tile are
+   *     decompressed with instead of `tile`.
+   * @param tile_num The number of (dimension) tiles.
+   * @param input The buffer holding the chunks, read from its current
+   *     offset.
+   * @param output The buffer the decompressed chunks are appended to.
    * @return Status
    */
-  Status decompress_one_tile(Tile* tile);
+  Status decompress_chunks(
+      Tile* tile,
+      std::vector<Tile>* filtered_tiles,
+      unsigned int tile_num,
+      Buffer* input,
+      Buffer* output);
+
+  /** Returns true if the tile data are stored compressed and/or filtered. */
+  bool encoded(const Tile* tile) const;
+
+  /**
+   * Initializes a tile on top of filtered data. The tile keeps the type
+   * and cell size of the original tile if the filtered data consist of
+   * whole cells, and holds plain bytes otherwise (e.g., after bit width
+   * reduction).
+   *
+   * @param tile The original tile.
+   * @param cell_size The cell size of the original (dimension) tile.
+   * @param data The filtered data.
+   * @param size The size of the filtered data.
+   * @param filtered_tile The tile to be initialized.
+   * @return Status
+   */
+  Status init_filtered_tile(
+      const Tile* tile,
+      uint64_t cell_size,
+      void* data,
+      uint64_t size,
+      Tile* filtered_tile) const;
+
+  /**
+   * Initializes a tile that carries the parameters the quantized values of
+   * the input (real) tile are filtered and compressed with, i.e., those of
+   * the input tile with the integer type of the same width.
+   *
+   * @param tile The quantized tile.
+   * @param data The quantized values.
+   * @param size The size of the quantized values.
+   * @param quantized_tile The tile to be initialized.
+   * @return Status
+   */
+  Status init_quantized_tile(
+      const Tile* tile, void* data, uint64_t size, Tile* quantized_tile) const;
+
+  /**
+   * Reads a tile from the file into the current buffer of the tile,
+   * decompressing it if necessary. If `cached` is `true`, the compressed
+   * data are first looked up in the compressed tile cache, and are inserted
+   * into it after being read from the file if cache fill is enabled.
+   * Otherwise (or if they do not fit in the cache) they are read into a
+   * per-thread staging buffer that is reused across reads.
+   *
+   * @param tile The tile to read into.
+   * @param file_offset The offset in the file to read from.
+   * @param compressed_size The size of the compressed tile.
+   * @param tile_size The size of the decompressed tile.
+   * @param cached Whether the compressed tile cache is used.
+   * @return Status.
+   */
+  Status load(
+      Tile* tile,
+      uint64_t file_offset,
+      uint64_t compressed_size,
+      uint64_t tile_size,
+      bool cached);
+
+  /**
+   * Quantizes the (real) values of type `T` of the input tile, i.e., scales
+   * them by `10^digits` and rounds them to the nearest integer of type `I`,
+   * appending the result to `output`. The empty fill value (the maximum
+   * value of `T`) is mapped to the lowest integer of `I`, which is reserved
+   * for it. Returns an error for other non-finite values and values that do
+   * not fit in `I` after scaling.
+   */
+  template <class T, class I>
+  static Status quantize(const Tile* tile, Buffer* output);
+
+  /**
+   * Returns true if the input compressor can be picked by
+   * `AUTO_COMPRESSION` for the input tile, i.e., it supports the tile type.
+   */
+  bool auto_compression_candidate(
+      const Tile* tile, Compressor compressor) const;
 
   /** Computes the compression overhead on *nbytes* of the input tile. */
   uint64_t overhead(Tile* tile, uint64_t nbytes) const;
+
+  /**
+   * Computes the overhead of the input compressor on *nbytes* of the
+   * input tile.
+   */
+  uint64_t overhead(Tile* tile, Compressor compressor, uint64_t nbytes) const;
 };
 
 }  // namespace sm